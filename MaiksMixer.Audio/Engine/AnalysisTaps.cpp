@@ -0,0 +1,219 @@
+#include "AnalysisTaps.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace emp {
+
+    // Constructor
+    AnalysisTaps::AnalysisTaps()
+        : _numChannels(0), _numOutputs(0), _enabledCount(0), _sampleRate(48000), _running(false)
+    {
+    }
+
+    // Destructor
+    AnalysisTaps::~AnalysisTaps()
+    {
+        Stop();
+    }
+
+    // Reserve
+    void AnalysisTaps::Reserve(int numChannels, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        _numChannels = std::max(numChannels, 0);
+        _numOutputs = std::max(numOutputs, 0);
+        const int slots = _numChannels + _numOutputs;
+
+        _slots.reset(new std::atomic<Tap*>[slots]);
+        for (int i = 0; i < slots; i++) {
+            _slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        _taps.clear();
+        _taps.resize(slots);
+        _enabledCount.store(0, std::memory_order_relaxed);
+    }
+
+    // Set Sample Rate
+    void AnalysisTaps::SetSampleRate(uint32_t sampleRate)
+    {
+        if (sampleRate > 0) _sampleRate.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    // Set Enabled
+    bool AnalysisTaps::SetEnabled(TapSource source, int index, bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        const int slot = GetSlot(source, index);
+        if (slot < 0) return false;
+
+        if (enabled && !_taps[slot]) {
+            auto tap = std::make_unique<Tap>();
+            tap->ring.Reserve(kRingFrames);
+            tap->scratch.resize(kReadFrames);
+            tap->frames.ForEach([](AnalysisFrame& frame) {
+                frame.spectrum.assign(SpectrumAnalyzer::kBins, SpectrumAnalyzer::kFloorDb);
+            });
+
+            // Fully built before the audio thread and the workers can see it
+            _slots[slot].store(tap.get(), std::memory_order_release);
+            _taps[slot] = std::move(tap);
+        }
+
+        Tap* tap = _taps[slot].get();
+        if (tap == nullptr || tap->enabled.load(std::memory_order_relaxed) == enabled) return true;
+
+        // The workers restart the tap's measurements when they see a new generation
+        if (enabled) tap->generation.fetch_add(1, std::memory_order_release);
+        tap->enabled.store(enabled, std::memory_order_release);
+        _enabledCount.fetch_add(enabled ? 1 : -1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Is Enabled
+    bool AnalysisTaps::IsEnabled(TapSource source, int index) const
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        const int slot = GetSlot(source, index);
+        return slot >= 0 && _taps[slot] && _taps[slot]->enabled.load(std::memory_order_relaxed);
+    }
+
+    // Start
+    void AnalysisTaps::Start(int workerCount)
+    {
+        Stop();
+
+        workerCount = std::max(workerCount, 1);
+        _running.store(true, std::memory_order_relaxed);
+        for (int i = 0; i < workerCount; i++) {
+            _workers.emplace_back(&AnalysisTaps::Run, this, i, workerCount);
+        }
+    }
+
+    // Stop
+    void AnalysisTaps::Stop()
+    {
+        _running.store(false, std::memory_order_relaxed);
+        for (auto& worker : _workers) {
+            if (worker.joinable()) worker.join();
+        }
+        _workers.clear();
+    }
+
+    // Capture (real-time thread)
+    void AnalysisTaps::Capture(const float* const* channels, int numChannels, const float* const* outputs, int numOutputs,
+                               uint32_t nframes)
+    {
+        if (_enabledCount.load(std::memory_order_relaxed) == 0) return;
+
+        const int channelTaps = std::min(numChannels, _numChannels);
+        const int outputTaps = std::min(numOutputs, _numOutputs);
+
+        for (int slot = 0; slot < _numChannels + _numOutputs; slot++) {
+            const float* samples;
+            if (slot < _numChannels) {
+                if (slot >= channelTaps) continue;
+                samples = channels[slot];
+            }
+            else {
+                if (slot - _numChannels >= outputTaps) continue;
+                samples = outputs[slot - _numChannels];
+            }
+
+            Tap* tap = _slots[slot].load(std::memory_order_acquire);
+            if (tap == nullptr || !tap->enabled.load(std::memory_order_relaxed) || samples == nullptr) continue;
+
+            if (!tap->ring.TryWrite(samples, nframes)) {
+                tap->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Get Frame
+    bool AnalysisTaps::GetFrame(TapSource source, int index, AnalysisFrame& frame)
+    {
+        Tap* tap;
+        {
+            std::lock_guard<std::mutex> lock(_controlMutex);
+            const int slot = GetSlot(source, index);
+            if (slot < 0 || !_taps[slot]) return false;
+            tap = _taps[slot].get();
+        }
+
+        // Taps live until the next Reserve(), which may not run concurrently
+        std::lock_guard<std::mutex> lock(tap->readerMutex);
+        const AnalysisFrame& latest = tap->frames.Read();
+        frame.spectrum.assign(latest.spectrum.begin(), latest.spectrum.end());
+        frame.sampleRate = latest.sampleRate;
+        frame.momentaryLufs = latest.momentaryLufs;
+        frame.shortTermLufs = latest.shortTermLufs;
+        frame.integratedLufs = latest.integratedLufs;
+        frame.truePeakDb = latest.truePeakDb;
+        frame.droppedBlocks = latest.droppedBlocks;
+        frame.sequence = latest.sequence;
+        return true;
+    }
+
+    int AnalysisTaps::GetSlot(TapSource source, int index) const
+    {
+        switch (source) {
+        case TapSource::Channel:
+            return index >= 0 && index < _numChannels ? index : -1;
+        case TapSource::Output:
+            return index >= 0 && index < _numOutputs ? _numChannels + index : -1;
+        }
+
+        return -1;
+    }
+
+    void AnalysisTaps::Run(int worker, int workerCount)
+    {
+        while (_running.load(std::memory_order_relaxed)) {
+            const int slots = _numChannels + _numOutputs;
+            for (int slot = worker; slot < slots; slot += workerCount) {
+                Tap* tap = _slots[slot].load(std::memory_order_acquire);
+                if (tap != nullptr && tap->enabled.load(std::memory_order_acquire)) Analyze(*tap);
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        }
+    }
+
+    // Analyze everything a tap's ring holds and publish the results (worker thread)
+    void AnalysisTaps::Analyze(Tap& tap)
+    {
+        // A re-enabled tap or a new rate starts over; samples from before are discarded
+        const uint32_t generation = tap.generation.load(std::memory_order_acquire);
+        const uint32_t sampleRate = _sampleRate.load(std::memory_order_relaxed);
+        if (generation != tap.analyzedGeneration || sampleRate != tap.analyzedRate) {
+            tap.ring.Discard();
+            tap.spectrum.Reset();
+            tap.loudness.Reset(sampleRate);
+            tap.analyzedGeneration = generation;
+            tap.analyzedRate = sampleRate;
+        }
+
+        bool analyzed = false;
+        size_t count;
+        while ((count = tap.ring.Read(tap.scratch.data(), tap.scratch.size())) > 0) {
+            tap.spectrum.Process(tap.scratch.data(), count);
+            tap.loudness.Process(tap.scratch.data(), count);
+            analyzed = true;
+        }
+        if (!analyzed) return;
+
+        AnalysisFrame& frame = tap.frames.WriteBuffer();
+        std::copy(tap.spectrum.GetSpectrum(), tap.spectrum.GetSpectrum() + SpectrumAnalyzer::kBins, frame.spectrum.begin());
+        frame.sampleRate = sampleRate;
+        frame.momentaryLufs = tap.loudness.GetMomentary();
+        frame.shortTermLufs = tap.loudness.GetShortTerm();
+        frame.integratedLufs = tap.loudness.GetIntegrated();
+        frame.truePeakDb = tap.loudness.GetTruePeakDb();
+        frame.droppedBlocks = tap.dropped.load(std::memory_order_relaxed);
+        frame.sequence = ++tap.sequence;
+        tap.frames.Publish();
+    }
+}
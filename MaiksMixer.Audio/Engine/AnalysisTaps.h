@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LoudnessMeter.h"
+#include "SampleRing.h"
+#include "SpectrumAnalyzer.h"
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Signal an analysis tap copies (matches the managed TapSource)
+    /// </summary>
+    enum class TapSource : int32_t
+    {
+        Channel = 0,    // Input channel, pre-fader
+        Output = 1      // Output port as sent to the server
+    };
+
+    /// <summary>
+    /// Analysis results of one tap, published together
+    /// </summary>
+    struct AnalysisFrame
+    {
+        std::vector<float> spectrum;    // SpectrumAnalyzer::kBins values in dBFS
+        uint32_t sampleRate = 0;        // Rate the bins and loudness were measured at
+        float momentaryLufs = LoudnessMeter::kFloorDb;
+        float shortTermLufs = LoudnessMeter::kFloorDb;
+        float integratedLufs = LoudnessMeter::kFloorDb;
+        float truePeakDb = LoudnessMeter::kFloorDb;
+        uint64_t droppedBlocks = 0;     // Cycles lost because the workers fell behind
+        uint64_t sequence = 0;          // Increments with every publish, 0 before the first
+    };
+
+    /// <summary>
+    /// Taps that hand channel and output blocks from the process callback to analysis
+    /// workers. The audio thread only copies each enabled tap's block into that tap's
+    /// sample ring (no allocation, no locks); worker threads compute spectra and loudness
+    /// from the rings and publish the results through a triple buffer per tap. A tap's
+    /// ring and analyzers are allocated the first time it is enabled and kept until the
+    /// next Reserve(), so only the taps being displayed cost memory and time.
+    /// </summary>
+    class AnalysisTaps
+    {
+    public:
+        // Samples buffered per tap between the audio thread and the workers
+        static constexpr size_t kRingFrames = 32768;
+
+        // Worker poll interval, and the samples analyzed per ring read
+        static constexpr int kPollIntervalMs = 10;
+        static constexpr size_t kReadFrames = 4096;
+
+        static constexpr int kDefaultWorkerCount = 1;
+
+        AnalysisTaps();
+        ~AnalysisTaps();
+
+        AnalysisTaps(const AnalysisTaps&) = delete;
+        AnalysisTaps& operator=(const AnalysisTaps&) = delete;
+
+        /// <summary>
+        /// Sizes the bank for up to numChannels channel taps and numOutputs output taps and
+        /// removes every tap. Must not be called while the process callback or the workers
+        /// may be running.
+        /// </summary>
+        void Reserve(int numChannels, int numOutputs);
+
+        /// <summary>
+        /// Sets the sample rate the analyzers measure at; running taps restart
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Enables or disables a tap (control threads). Enabling restarts its measurements.
+        /// Returns false if the index is out of range.
+        /// </summary>
+        bool SetEnabled(TapSource source, int index, bool enabled);
+        bool IsEnabled(TapSource source, int index) const;
+
+        /// <summary>
+        /// Starts workerCount analysis threads (at least one); taps are split between them
+        /// by index
+        /// </summary>
+        void Start(int workerCount = kDefaultWorkerCount);
+
+        /// <summary>
+        /// Stops the analysis threads
+        /// </summary>
+        void Stop();
+
+        bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Copies one cycle of every enabled tap's signal into its ring (audio thread). A
+        /// block that does not fit is dropped and counted.
+        /// </summary>
+        void Capture(const float* const* channels, int numChannels, const float* const* outputs, int numOutputs,
+                     uint32_t nframes);
+
+        /// <summary>
+        /// Copies the latest results of a tap into frame, reusing its storage. Returns false
+        /// if the tap has never been enabled.
+        /// </summary>
+        bool GetFrame(TapSource source, int index, AnalysisFrame& frame);
+
+    private:
+        struct Tap
+        {
+            std::atomic<bool> enabled{ false };
+            std::atomic<uint32_t> generation{ 0 };     // Bumped on every enable
+            std::atomic<uint64_t> dropped{ 0 };
+            SampleRing ring;
+
+            // Worker state
+            uint32_t analyzedGeneration = 0;
+            uint32_t analyzedRate = 0;
+            uint64_t sequence = 0;
+            std::vector<float> scratch;
+            SpectrumAnalyzer spectrum;
+            LoudnessMeter loudness;
+
+            TripleBuffer<AnalysisFrame> frames;
+            std::mutex readerMutex;     // The triple buffer has a single reader side
+        };
+
+        int GetSlot(TapSource source, int index) const;
+        void Run(int worker, int workerCount);
+        void Analyze(Tap& tap);
+
+        // Channel taps first, then output taps; slots stay null until first enabled
+        std::unique_ptr<std::atomic<Tap*>[]> _slots;
+        std::vector<std::unique_ptr<Tap>> _taps;
+        int _numChannels;
+        int _numOutputs;
+        std::atomic<int> _enabledCount;
+        std::atomic<uint32_t> _sampleRate;
+
+        // Serializes control threads; the audio thread and the workers never take it
+        mutable std::mutex _controlMutex;
+
+        std::vector<std::thread> _workers;
+        std::atomic<bool> _running;
+    };
+}
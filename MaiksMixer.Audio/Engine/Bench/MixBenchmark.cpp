@@ -0,0 +1,330 @@
+// Offline mix path benchmark: sweeps channel count, buffer size and routing density over
+// the JACK-free OfflineRenderer (optionally with a full insert chain on every channel, a
+// bus graph fed by every channel, or with every channel fed by resampled virtual sources) and reports ns/frame, cycles/sample
+// and the share of the real-time budget each configuration uses.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../OfflineRenderer.h"
+
+#if EMP_KERNELS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // Outputs used by the matrix-routed configurations
+    constexpr int kMatrixOutputs = 8;
+
+    // Minimum audio rendered per configuration
+    constexpr double kMinSecondsOfAudio = 2.0;
+
+    struct Options
+    {
+        bool quick = false;
+        bool csv = false;
+        bool inserts = false;
+        bool buses = false;
+        int virtualQuality = -1;    // emp::ResamplerQuality, < 0 for port inputs
+        uint32_t sampleRate = 48000;
+        int workers = 0;
+        const emp::MixKernels* kernels = nullptr;
+    };
+
+    // Routing density: < 0 means matrix disabled (default stereo pan mix)
+    struct Density
+    {
+        const char* name;
+        double fraction;
+    };
+
+    uint64_t ReadCycleCounter()
+    {
+#if EMP_KERNELS_X86
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    void ConfigureRouting(emp::OfflineRenderer& renderer, const Density& density)
+    {
+        emp::MixEngine& engine = renderer.Engine();
+        if (density.fraction < 0.0) return;
+
+        const int inputs = renderer.GetInputCount();
+        const int outputs = renderer.GetOutputCount();
+
+        // Spread routes evenly so every density is deterministic; at least one per input
+        const int perInput = std::max(1, static_cast<int>(density.fraction * outputs + 0.5));
+        engine.Routing().Apply([&](std::vector<float>& gains, int, int numOutputs) {
+            for (int i = 0; i < inputs; i++) {
+                for (int r = 0; r < perInput; r++) {
+                    gains[static_cast<size_t>(i) * numOutputs + (i + r) % numOutputs] = 0.5f;
+                }
+            }
+        });
+        engine.Routing().SetEnabled(true);
+    }
+
+    // Gives every channel a full insert chain: four EQ bands, gate and compressor
+    void ConfigureInserts(emp::OfflineRenderer& renderer)
+    {
+        emp::ChannelInsertParams inserts;
+        for (int b = 0; b < emp::ChannelInsertParams::kEqBands; b++) {
+            inserts.eq[b].enabled = true;
+            inserts.eq[b].frequency = 100.0f * (b + 1) * (b + 1);
+            inserts.eq[b].gainDb = b % 2 == 0 ? 3.0f : -3.0f;
+        }
+        inserts.gate.enabled = true;
+        inserts.compressor.enabled = true;
+
+        for (int i = 0; i < renderer.GetInputCount(); i++) {
+            renderer.Engine().Inserts().SetChannel(i, inserts);
+        }
+    }
+
+    // Builds a typical live bus graph on the first two outputs: four stereo subgroups into a
+    // master, and two mono pre-fader monitor auxes and a stereo post-fader effect aux that
+    // every channel sends to, with the effect aux returned to the master
+    void ConfigureBuses(emp::OfflineRenderer& renderer)
+    {
+        emp::BusGraph& graph = renderer.Engine().Buses();
+
+        emp::BusConfig config;
+        config.type = emp::BusType::Master;
+        config.firstOutput = 0;
+        const int master = graph.CreateBus(config);
+
+        config.type = emp::BusType::Subgroup;
+        config.firstOutput = -1;
+        int subgroups[4];
+        for (int& subgroup : subgroups) {
+            subgroup = graph.CreateBus(config);
+            graph.SetSend({ emp::SendSource::Bus, subgroup, master, emp::SendTap::PostFader, 1.0f, 0.5f });
+        }
+
+        config.type = emp::BusType::Aux;
+        const int effect = graph.CreateBus(config);
+        graph.SetSend({ emp::SendSource::Bus, effect, master, emp::SendTap::PostFader, 0.3f, 0.5f });
+
+        config.channels = 1;
+        const int monitors[2] = { graph.CreateBus(config), graph.CreateBus(config) };
+
+        for (int i = 0; i < renderer.GetInputCount(); i++) {
+            graph.SetSend({ emp::SendSource::Channel, i, subgroups[i % 4], emp::SendTap::PostFader, 1.0f, 0.5f });
+            graph.SetSend({ emp::SendSource::Channel, i, effect, emp::SendTap::PostFader, 0.25f, 0.5f });
+            for (int monitor : monitors) {
+                graph.SetSend({ emp::SendSource::Channel, i, monitor, emp::SendTap::PreFader, 0.5f, 0.5f });
+            }
+        }
+    }
+
+    // Feeds every channel from stereo 44.1 kHz virtual sources, written in 441-frame packets
+    // stamped as they complete. The writes are timed along with the mix; they are copies into
+    // the sources' rings, small next to the resampling.
+    class VirtualSourceFeed
+    {
+    public:
+        VirtualSourceFeed(emp::OfflineRenderer& renderer, int quality)
+        {
+            if (quality < 0) return;
+
+            emp::VirtualSourceConfig config;
+            config.sampleRate = kDeviceRate;
+            config.quality = static_cast<emp::ResamplerQuality>(quality);
+            config.latencyMs = 1000.0f * renderer.GetBlockSize() / renderer.GetSampleRate() + 20.0f;
+            for (int first = 0; first < renderer.GetInputCount(); first += 2) {
+                config.firstChannel = first;
+                config.channels = std::min(2, renderer.GetInputCount() - first);
+                const int id = renderer.Engine().VirtualSources().Create(config);
+                if (id != 0) _sources.push_back({ id, config.channels });
+            }
+
+            _packet.resize(static_cast<size_t>(kPacketFrames) * 2);
+            for (size_t i = 0; i < _packet.size(); i++) {
+                _packet[i] = 0.25f * static_cast<float>(static_cast<int>(i % 89) - 44) / 44.0f;
+            }
+        }
+
+        void operator()(emp::OfflineRenderer& renderer)
+        {
+            if (_sources.empty()) return;
+
+            _rendered += renderer.GetBlockSize();
+            const double graphRate = renderer.GetSampleRate();
+            for (;;) {
+                const double completed = static_cast<double>(_produced + kPacketFrames) / kDeviceRate * graphRate;
+                if (completed > _rendered) break;
+
+                for (const Source& source : _sources) {
+                    renderer.Engine().VirtualSources().Write(source.id, _packet.data(), kPacketFrames, completed);
+                }
+                _produced += kPacketFrames;
+            }
+        }
+
+    private:
+        static constexpr uint32_t kDeviceRate = 44100;
+        static constexpr uint32_t kPacketFrames = 441;
+
+        struct Source
+        {
+            int id;
+            int channels;
+        };
+
+        std::vector<Source> _sources;
+        std::vector<float> _packet;
+        uint64_t _produced = 0;
+        uint64_t _rendered = 0;
+    };
+
+    void RunConfiguration(const Options& options, int channels, uint32_t blockSize, const Density& density)
+    {
+        const int outputs = density.fraction < 0.0 ? 2 : kMatrixOutputs;
+        emp::OfflineRenderer renderer(channels, outputs, blockSize, options.sampleRate);
+        if (options.kernels != nullptr) renderer.Engine().SetKernels(*options.kernels);
+
+        emp::WorkerPoolConfig workers;
+        workers.workerCount = options.workers;
+        renderer.Engine().Workers().Start(workers);
+
+        renderer.GenerateTestSignals(1, 4096);
+        ConfigureRouting(renderer, density);
+        if (options.inserts) ConfigureInserts(renderer);
+        if (options.buses) ConfigureBuses(renderer);
+        VirtualSourceFeed feed(renderer, options.virtualQuality);
+        auto sink = [&feed](emp::OfflineRenderer& r) { feed(r); };
+
+        const uint64_t totalFrames = static_cast<uint64_t>(kMinSecondsOfAudio * options.sampleRate / (options.quick ? 4 : 1));
+
+        // Warm up caches, the meter bank and the published snapshots
+        renderer.Render(std::min<uint64_t>(totalFrames / 8, 16384), sink);
+
+        const uint64_t startCycles = ReadCycleCounter();
+        const auto start = Clock::now();
+        const uint64_t blocks = renderer.Render(totalFrames, sink);
+        const auto elapsed = Clock::now() - start;
+        const uint64_t cycles = ReadCycleCounter() - startCycles;
+
+        const double frames = static_cast<double>(blocks) * blockSize;
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        const double nsPerFrame = ns / frames;
+        const double cyclesPerSample = cycles != 0 ? static_cast<double>(cycles) / (frames * channels) : 0.0;
+        const double budgetPercent = nsPerFrame * options.sampleRate / 1e9 * 100.0;
+
+        if (options.csv) {
+            std::printf("%d,%u,%s,%.3f,%.3f,%.3f\n", channels, blockSize, density.name,
+                        nsPerFrame, cyclesPerSample, budgetPercent);
+        }
+        else {
+            std::printf("%8d %8u %10s %12.2f %14.3f %10.3f%%\n", channels, blockSize, density.name,
+                        nsPerFrame, cyclesPerSample, budgetPercent);
+        }
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--quick") == 0) {
+                options.quick = true;
+            }
+            else if (std::strcmp(argv[i], "--csv") == 0) {
+                options.csv = true;
+            }
+            else if (std::strcmp(argv[i], "--inserts") == 0) {
+                options.inserts = true;
+            }
+            else if (std::strcmp(argv[i], "--buses") == 0) {
+                options.buses = true;
+            }
+            else if (std::strcmp(argv[i], "--virtual-sources") == 0 && i + 1 < argc) {
+                const std::string quality = argv[++i];
+                if (quality == "low") options.virtualQuality = static_cast<int>(emp::ResamplerQuality::Low);
+                else if (quality == "medium") options.virtualQuality = static_cast<int>(emp::ResamplerQuality::Medium);
+                else if (quality == "high") options.virtualQuality = static_cast<int>(emp::ResamplerQuality::High);
+                else return false;
+            }
+            else if (std::strcmp(argv[i], "--sample-rate") == 0 && i + 1 < argc) {
+                options.sampleRate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+                options.workers = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+                const std::string isa = argv[++i];
+                const emp::KernelIsa kernelIsa =
+                    isa == "sse2" ? emp::KernelIsa::Sse2 :
+                    isa == "avx2" ? emp::KernelIsa::Avx2 :
+                    isa == "avx512" ? emp::KernelIsa::Avx512 : emp::KernelIsa::Scalar;
+                options.kernels = emp::GetMixKernels(kernelIsa);
+                if (options.kernels == nullptr) {
+                    std::fprintf(stderr, "Kernel set '%s' is not supported on this CPU\n", isa.c_str());
+                    return false;
+                }
+            }
+            else {
+                std::fprintf(stderr, "Usage: %s [--quick] [--csv] [--inserts] [--buses] [--virtual-sources low|medium|high] [--sample-rate HZ] [--workers N] [--isa scalar|sse2|avx2|avx512]\n", argv[0]);
+                return false;
+            }
+        }
+
+        return options.sampleRate > 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) return 2;
+
+    const emp::MixKernels& kernels = options.kernels != nullptr ? *options.kernels : emp::GetActiveMixKernels();
+
+    const std::vector<int> channelCounts = options.quick
+        ? std::vector<int>{ 2, 32, 256 }
+        : std::vector<int>{ 2, 8, 16, 32, 64, 128, 256 };
+    const std::vector<uint32_t> blockSizes = options.quick
+        ? std::vector<uint32_t>{ 16, 256, 2048 }
+        : std::vector<uint32_t>{ 16, 32, 64, 128, 256, 512, 1024, 2048 };
+    const std::vector<Density> densities = {
+        { "pan", -1.0 },
+        { "1/out", 0.0 },
+        { "25%", 0.25 },
+        { "100%", 1.0 }
+    };
+
+    if (options.csv) {
+        std::printf("channels,block,routing,ns_per_frame,cycles_per_sample,rt_budget_percent\n");
+    }
+    else {
+        const char* qualities[] = { "low", "medium", "high" };
+        std::printf("Kernels: %s, sample rate: %u Hz, matrix outputs: %d, workers: %d, inserts: %s, buses: %s, virtual sources: %s\n",
+                    kernels.name, options.sampleRate, kMatrixOutputs, options.workers, options.inserts ? "on" : "off",
+                    options.buses ? "on" : "off",
+                    options.virtualQuality >= 0 ? qualities[options.virtualQuality] : "off");
+        std::printf("%8s %8s %10s %12s %14s %11s\n", "channels", "block", "routing", "ns/frame", "cycles/sample", "RT budget");
+    }
+
+    for (int channels : channelCounts) {
+        for (uint32_t blockSize : blockSizes) {
+            for (const Density& density : densities) {
+                RunConfiguration(options, channels, blockSize, density);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,402 @@
+#include "BusGraph.h"
+
+#include <algorithm>
+
+namespace emp {
+
+    namespace {
+
+        // Edge keys: the step type, then the source and destination with their lane within
+        // the bus. Bus ids and channels wrap at 2^20, which at worst starts a ramp from the
+        // wrong gain.
+        uint64_t MakeKey(BusStepType type, int source, int sourceLane, int destination, int destinationLane)
+        {
+            constexpr uint64_t kIdMask = (1ull << 20) - 1;
+            return (static_cast<uint64_t>(type) << 60) |
+                   ((static_cast<uint64_t>(source) & kIdMask) << 36) | (static_cast<uint64_t>(sourceLane) << 35) |
+                   ((static_cast<uint64_t>(destination) & kIdMask) << 1) | static_cast<uint64_t>(destinationLane);
+        }
+    }
+
+    // Constructor
+    BusGraph::BusGraph()
+        : _numChannels(0), _numOutputs(0), _nextId(1), _version(0)
+    {
+    }
+
+    // Reserve
+    void BusGraph::Reserve(int numChannels, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        _numChannels = std::max(numChannels, 0);
+        _numOutputs = std::max(numOutputs, 0);
+        _buses.clear();
+        _sends.clear();
+        _publishedGains.clear();
+
+        _compiled.ForEach([this](CompiledBusPlan& plan) {
+            plan.steps.clear();
+            plan.channelSendCount = 0;
+            plan.laneCount = 0;
+            plan.version = _version;
+        });
+    }
+
+    // Create Bus
+    int BusGraph::CreateBus(const BusConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        if (static_cast<int>(_buses.size()) >= kMaxBuses) return 0;
+        if (ValidateBus(0, config) != BusGraphStatus::Applied) return 0;
+
+        std::vector<Bus> buses = _buses;
+        const int id = _nextId;
+        buses.push_back(Bus{ id, config });
+        buses.back().config.volume = std::clamp(config.volume, 0.0f, 1.0f);
+        if (PublishLocked(std::move(buses), _sends) != BusGraphStatus::Applied) return 0;
+
+        _nextId++;
+        return id;
+    }
+
+    // Remove Bus
+    bool BusGraph::RemoveBus(int id)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        if (FindBus(_buses, id) == nullptr) return false;
+
+        std::vector<Bus> buses = _buses;
+        buses.erase(std::remove_if(buses.begin(), buses.end(), [id](const Bus& bus) { return bus.id == id; }), buses.end());
+
+        std::vector<BusSend> sends = _sends;
+        sends.erase(std::remove_if(sends.begin(), sends.end(),
+                                   [id](const BusSend& send) {
+                                       return send.destination == id || (send.sourceType == SendSource::Bus && send.source == id);
+                                   }),
+                    sends.end());
+
+        // Removing nodes and edges cannot close a cycle
+        PublishLocked(std::move(buses), std::move(sends));
+        return true;
+    }
+
+    // Set Bus
+    BusGraphStatus BusGraph::SetBus(int id, const BusConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        if (FindBus(_buses, id) == nullptr) return BusGraphStatus::NotFound;
+
+        const BusGraphStatus status = ValidateBus(id, config);
+        if (status != BusGraphStatus::Applied) return status;
+
+        std::vector<Bus> buses = _buses;
+        Bus* bus = FindBus(buses, id);
+        bus->config = config;
+        bus->config.volume = std::clamp(config.volume, 0.0f, 1.0f);
+        return PublishLocked(std::move(buses), _sends);
+    }
+
+    // Get Bus
+    bool BusGraph::GetBus(int id, BusConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const Bus* bus = FindBus(_buses, id);
+        if (bus == nullptr) return false;
+
+        config = bus->config;
+        return true;
+    }
+
+    // Get Buses
+    void BusGraph::GetBuses(std::vector<std::pair<int, BusConfig>>& buses)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        buses.clear();
+        for (const Bus& bus : _buses) {
+            buses.emplace_back(bus.id, bus.config);
+        }
+    }
+
+    // Set Send
+    BusGraphStatus BusGraph::SetSend(const BusSend& send)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const BusGraphStatus status = ValidateSend(send);
+        if (status != BusGraphStatus::Applied) return status;
+
+        std::vector<BusSend> sends = _sends;
+        auto existing = std::find_if(sends.begin(), sends.end(), [&send](const BusSend& other) {
+            return other.sourceType == send.sourceType && other.source == send.source && other.destination == send.destination;
+        });
+        if (existing == sends.end()) {
+            if (static_cast<int>(sends.size()) >= kMaxSends) return BusGraphStatus::Full;
+            existing = sends.insert(sends.end(), send);
+        }
+
+        *existing = send;
+        existing->level = std::max(send.level, 0.0f);
+        existing->pan = std::clamp(send.pan, 0.0f, 1.0f);
+        return PublishLocked(_buses, std::move(sends));
+    }
+
+    // Remove Send
+    bool BusGraph::RemoveSend(SendSource sourceType, int source, int destination)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        std::vector<BusSend> sends = _sends;
+        auto existing = std::find_if(sends.begin(), sends.end(), [&](const BusSend& send) {
+            return send.sourceType == sourceType && send.source == source && send.destination == destination;
+        });
+        if (existing == sends.end()) return false;
+
+        sends.erase(existing);
+        PublishLocked(_buses, std::move(sends));
+        return true;
+    }
+
+    // Get Sends
+    void BusGraph::GetSends(std::vector<BusSend>& sends)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        sends = _sends;
+    }
+
+    // Reset Channels From
+    void BusGraph::ResetChannelsFrom(int channelCount)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        auto removed = [channelCount](const BusSend& send) {
+            return send.sourceType == SendSource::Channel && send.source >= channelCount;
+        };
+        if (std::none_of(_sends.begin(), _sends.end(), removed)) return;
+
+        std::vector<BusSend> sends = _sends;
+        sends.erase(std::remove_if(sends.begin(), sends.end(), removed), sends.end());
+        PublishLocked(_buses, std::move(sends));
+    }
+
+    // Check a bus configuration against the rules of its type (id 0 for a new bus)
+    BusGraphStatus BusGraph::ValidateBus(int id, const BusConfig& config) const
+    {
+        if (config.channels < 1 || config.channels > kMaxBusChannels) return BusGraphStatus::Invalid;
+        if (config.firstOutput < -1 || config.firstOutput >= _numOutputs) return BusGraphStatus::Invalid;
+
+        for (const Bus& bus : _buses) {
+            if (bus.id != id && bus.config.type == BusType::Master && config.type == BusType::Master) return BusGraphStatus::Invalid;
+        }
+
+        for (const BusSend& send : _sends) {
+            // The master sends nowhere, and only aux buses take pre-fader channel sends
+            if (config.type == BusType::Master && send.sourceType == SendSource::Bus && send.source == id) return BusGraphStatus::Invalid;
+            if (config.type != BusType::Aux && send.destination == id && send.sourceType == SendSource::Channel &&
+                send.tap == SendTap::PreFader) {
+                return BusGraphStatus::Invalid;
+            }
+        }
+        return BusGraphStatus::Applied;
+    }
+
+    // Check a send's endpoints (cycles are found by the compiler)
+    BusGraphStatus BusGraph::ValidateSend(const BusSend& send) const
+    {
+        const Bus* destination = FindBus(_buses, send.destination);
+        if (destination == nullptr) return BusGraphStatus::NotFound;
+
+        if (send.sourceType == SendSource::Channel) {
+            if (send.source < 0 || send.source >= _numChannels) return BusGraphStatus::NotFound;
+            if (destination->config.type != BusType::Aux && send.tap == SendTap::PreFader) return BusGraphStatus::Invalid;
+            return BusGraphStatus::Applied;
+        }
+
+        const Bus* source = FindBus(_buses, send.source);
+        if (source == nullptr) return BusGraphStatus::NotFound;
+        if (source->config.type == BusType::Master) return BusGraphStatus::Invalid;
+        if (send.source == send.destination) return BusGraphStatus::Cycle;
+        return BusGraphStatus::Applied;
+    }
+
+    // Compile a graph and publish it, keeping it as the staged graph; a graph with a
+    // cycle is dropped
+    BusGraphStatus BusGraph::PublishLocked(std::vector<Bus> buses, std::vector<BusSend> sends)
+    {
+        CompiledBusPlan& plan = _compiled.WriteBuffer();
+        if (!Compile(buses, sends, plan)) return BusGraphStatus::Cycle;
+
+        plan.version = ++_version;
+        _publishedGains.clear();
+        for (const BusStep& step : plan.steps) {
+            _publishedGains.push_back({ step.key, { step.gain[0], step.gain[1] } });
+        }
+        std::sort(_publishedGains.begin(), _publishedGains.end());
+        _compiled.Publish();
+
+        _buses = std::move(buses);
+        _sends = std::move(sends);
+        return BusGraphStatus::Applied;
+    }
+
+    // Order the buses topologically and lay out the steps; returns false on a cycle
+    bool BusGraph::Compile(const std::vector<Bus>& buses, const std::vector<BusSend>& sends, CompiledBusPlan& plan) const
+    {
+        const size_t count = buses.size();
+        auto indexOf = [&buses](int id) {
+            for (size_t i = 0; i < buses.size(); i++) {
+                if (buses[i].id == id) return i;
+            }
+            return buses.size();
+        };
+
+        // Kahn's algorithm, taking the earliest created ready bus first so the plan only
+        // depends on the graph
+        std::vector<int> inDegree(count, 0);
+        for (const BusSend& send : sends) {
+            if (send.sourceType == SendSource::Bus) inDegree[indexOf(send.destination)]++;
+        }
+
+        std::vector<size_t> order;
+        std::vector<bool> placed(count, false);
+        while (order.size() < count) {
+            size_t next = count;
+            for (size_t i = 0; i < count; i++) {
+                if (!placed[i] && inDegree[i] == 0) {
+                    next = i;
+                    break;
+                }
+            }
+
+            // Every remaining bus is fed by another remaining bus
+            if (next == count) return false;
+
+            placed[next] = true;
+            order.push_back(next);
+            for (const BusSend& send : sends) {
+                if (send.sourceType == SendSource::Bus && send.source == buses[next].id) inDegree[indexOf(send.destination)]--;
+            }
+        }
+
+        // Lanes in execution order
+        std::vector<int> firstLane(count, 0);
+        uint32_t lanes = 0;
+        for (size_t i : order) {
+            firstLane[i] = static_cast<int>(lanes);
+            lanes += static_cast<uint32_t>(buses[i].config.channels);
+        }
+
+        auto startGains = [this](BusStep& step) {
+            auto found = std::lower_bound(_publishedGains.begin(), _publishedGains.end(), step.key,
+                                          [](const std::pair<uint64_t, std::pair<float, float>>& entry, uint64_t key) { return entry.first < key; });
+            const bool exists = found != _publishedGains.end() && found->first == step.key;
+            step.startGain[0] = exists ? found->second.first : 0.0f;
+            step.startGain[1] = exists ? found->second.second : 0.0f;
+        };
+
+        plan.steps.clear();
+
+        // Channel sends have no dependencies; ordering them by channel keeps each channel's
+        // buffer hot across its sends
+        std::vector<const BusSend*> channelSends;
+        for (const BusSend& send : sends) {
+            if (send.sourceType == SendSource::Channel) channelSends.push_back(&send);
+        }
+        std::stable_sort(channelSends.begin(), channelSends.end(),
+                         [](const BusSend* a, const BusSend* b) { return a->source < b->source; });
+
+        for (const BusSend* send : channelSends) {
+            const size_t destination = indexOf(send->destination);
+            const bool stereo = buses[destination].config.channels == 2;
+
+            BusStep step;
+            step.type = BusStepType::ChannelSend;
+            step.postFader = send->tap == SendTap::PostFader;
+            step.lanes = stereo ? 2 : 1;
+            step.source = send->source;
+            step.destination = firstLane[destination];
+            if (stereo && !step.postFader) {
+                step.gain[0] = send->level * (1.0f - send->pan);
+                step.gain[1] = send->level * send->pan;
+            }
+            else {
+                step.gain[0] = send->level;
+                step.gain[1] = stereo ? send->level : 0.0f;
+            }
+            step.key = MakeKey(step.type, send->source, 0, send->destination, 0);
+            startGains(step);
+            plan.steps.push_back(step);
+        }
+        plan.channelSendCount = static_cast<uint32_t>(plan.steps.size());
+
+        // Each bus's sends and outputs, once every step into it has run
+        for (size_t i : order) {
+            const Bus& bus = buses[i];
+            const float level = bus.config.mute ? 0.0f : bus.config.volume;
+
+            for (const BusSend& send : sends) {
+                if (send.sourceType != SendSource::Bus || send.source != bus.id) continue;
+
+                const size_t destination = indexOf(send.destination);
+                const int sourceChannels = bus.config.channels;
+                const int destinationChannels = buses[destination].config.channels;
+                const float gain = send.level * (send.tap == SendTap::PostFader ? level : (bus.config.mute ? 0.0f : 1.0f));
+
+                // Mono into stereo is panned, stereo into mono summed at half gain
+                for (int s = 0; s < sourceChannels; s++) {
+                    for (int d = 0; d < destinationChannels; d++) {
+                        float laneGain = gain;
+                        if (sourceChannels == 1 && destinationChannels == 2) laneGain *= d == 0 ? 1.0f - send.pan : send.pan;
+                        else if (sourceChannels == 2 && destinationChannels == 1) laneGain *= 0.5f;
+                        else if (s != d) continue;
+
+                        BusStep step;
+                        step.type = BusStepType::LaneSend;
+                        step.source = firstLane[i] + s;
+                        step.destination = firstLane[destination] + d;
+                        step.gain[0] = laneGain;
+                        step.key = MakeKey(step.type, bus.id, s, send.destination, d);
+                        startGains(step);
+                        plan.steps.push_back(step);
+                    }
+                }
+            }
+
+            if (bus.config.firstOutput < 0) continue;
+            for (int c = 0; c < bus.config.channels && bus.config.firstOutput + c < _numOutputs; c++) {
+                BusStep step;
+                step.type = BusStepType::LaneOutput;
+                step.source = firstLane[i] + c;
+                step.destination = bus.config.firstOutput + c;
+                step.gain[0] = level;
+                step.key = MakeKey(step.type, bus.id, c, step.destination, 0);
+                startGains(step);
+                plan.steps.push_back(step);
+            }
+        }
+
+        plan.laneCount = lanes;
+        return true;
+    }
+
+    BusGraph::Bus* BusGraph::FindBus(std::vector<Bus>& buses, int id)
+    {
+        for (Bus& bus : buses) {
+            if (bus.id == id) return &bus;
+        }
+        return nullptr;
+    }
+
+    const BusGraph::Bus* BusGraph::FindBus(const std::vector<Bus>& buses, int id)
+    {
+        for (const Bus& bus : buses) {
+            if (bus.id == id) return &bus;
+        }
+        return nullptr;
+    }
+}
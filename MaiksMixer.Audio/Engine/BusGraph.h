@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Role of a bus, which decides what may feed it (matches the managed BusType)
+    /// </summary>
+    enum class BusType : int32_t
+    {
+        Aux = 0,            // Monitor or effect mix: pre- or post-fader channel sends
+        Subgroup = 1,       // Post-fader channel assignments, usually sent on to the master
+        Master = 2          // At most one; takes sends but sends nowhere but its outputs
+    };
+
+    /// <summary>
+    /// Where a send leaves its source (matches the managed SendTap)
+    /// </summary>
+    enum class SendTap : int32_t
+    {
+        PreFader = 0,       // After the source's gain and inserts, before its volume
+        PostFader = 1
+    };
+
+    /// <summary>
+    /// Kind of node a send starts from
+    /// </summary>
+    enum class SendSource : int32_t
+    {
+        Channel = 0,
+        Bus = 1
+    };
+
+    /// <summary>
+    /// Result of a bus graph edit (matches the managed BusGraphStatus)
+    /// </summary>
+    enum class BusGraphStatus : int32_t
+    {
+        Applied = 0,
+        NotFound = -1,      // Unknown bus, or a channel beyond the capacity
+        Invalid = -2,       // The edit breaks a rule of the bus types
+        Cycle = -3,         // The edit would make a bus feed itself
+        Full = -4
+    };
+
+    /// <summary>
+    /// Settings of one bus
+    /// </summary>
+    struct BusConfig
+    {
+        BusType type = BusType::Aux;
+        int channels = 2;               // 1 or 2
+        float volume = 1.0f;
+        bool mute = false;
+        int firstOutput = -1;           // Output port of the bus's first channel, -1 for none
+    };
+
+    /// <summary>
+    /// A send from a channel or bus into a bus. There is at most one send per source and
+    /// destination.
+    /// </summary>
+    struct BusSend
+    {
+        SendSource sourceType = SendSource::Channel;
+        int source = 0;                 // Channel index or bus id
+        int destination = 0;            // Bus id
+        SendTap tap = SendTap::PostFader;
+        float level = 1.0f;
+
+        // Mono sources into stereo buses. Post-fader channel sends follow the channel's
+        // own pan instead.
+        float pan = 0.5f;
+    };
+
+    /// <summary>
+    /// Operation of one step of a compiled bus plan
+    /// </summary>
+    enum class BusStepType : uint8_t
+    {
+        ChannelSend,        // A channel into one lane, or across the two lanes of a stereo bus
+        LaneSend,           // One bus lane into a lane of another bus
+        LaneOutput          // One bus lane onto an output port
+    };
+
+    /// <summary>
+    /// One step of a compiled bus plan. Gains are static: post-fader channel sends are
+    /// scaled (and panned) by the channel's fader when they run, and bus volume and mute
+    /// are folded into the gains of the steps leaving the bus.
+    /// </summary>
+    struct BusStep
+    {
+        BusStepType type = BusStepType::LaneSend;
+        bool postFader = false;     // ChannelSend only
+        uint8_t lanes = 1;          // Lanes a ChannelSend writes
+        int32_t source = 0;         // Channel, or lane
+        int32_t destination = 0;    // First lane, or output port
+        float gain[2] = {};         // Per lane written
+        float startGain[2] = {};    // Gain of the same edge in the previous plan, ramped from over the first block
+        uint64_t key = 0;           // Identifies the edge across plans
+    };
+
+    /// <summary>
+    /// Bus graph compiled for the process callback: channel sends first, then the sends
+    /// and outputs of every bus in topological order, so each bus is complete before the
+    /// first step that reads it. The steps run straight through with no lookups.
+    /// </summary>
+    struct CompiledBusPlan
+    {
+        std::vector<BusStep> steps;
+        uint32_t channelSendCount = 0;  // Leading ChannelSend steps
+        uint32_t laneCount = 0;         // Bus lanes used, cleared every block
+        uint64_t version = 0;
+    };
+
+    /// <summary>
+    /// Aux, subgroup and master buses and the sends between channels and buses, a DAG
+    /// edited by control threads. Every edit is compiled into a flat plan off the audio
+    /// thread and published atomically; an edit that would close a cycle is rejected by
+    /// the compiler and leaves the published plan as it was. The engine mixes into bus
+    /// lanes preallocated in its layout and adds bus outputs on top of the main mix.
+    ///
+    /// Channel sends follow the channel's mute and solo whatever their tap, as the bus
+    /// outputs follow the bus's mute.
+    ///
+    /// Gain changes are ramped across the first block that renders a new plan, and new sends
+    /// fade in from silence. Sends and buses that are removed stop at once, so fade their
+    /// level out first if needed.
+    /// Scenes do not capture the bus graph.
+    /// </summary>
+    class BusGraph
+    {
+    public:
+        static constexpr int kMaxBuses = 32;
+        static constexpr int kMaxBusChannels = 2;
+        static constexpr int kMaxLanes = kMaxBuses * kMaxBusChannels;
+        static constexpr int kMaxSends = 4096;
+
+        BusGraph();
+
+        /// <summary>
+        /// Sizes the graph for the port capacity and removes every bus and send. Must not
+        /// be called while the process callback may be running.
+        /// </summary>
+        void Reserve(int numChannels, int numOutputs);
+
+        /// <summary>
+        /// Adds a bus and returns its id, or 0 if the configuration is invalid or the graph
+        /// is full
+        /// </summary>
+        int CreateBus(const BusConfig& config);
+
+        /// <summary>
+        /// Removes a bus with every send into or out of it
+        /// </summary>
+        bool RemoveBus(int id);
+
+        /// <summary>
+        /// Changes a bus's settings (values are clamped to their ranges)
+        /// </summary>
+        BusGraphStatus SetBus(int id, const BusConfig& config);
+
+        bool GetBus(int id, BusConfig& config);
+
+        /// <summary>
+        /// Copies the ids and settings of every bus
+        /// </summary>
+        void GetBuses(std::vector<std::pair<int, BusConfig>>& buses);
+
+        /// <summary>
+        /// Adds a send, or replaces the one with the same source and destination
+        /// </summary>
+        BusGraphStatus SetSend(const BusSend& send);
+
+        bool RemoveSend(SendSource sourceType, int source, int destination);
+
+        /// <summary>
+        /// Copies every send
+        /// </summary>
+        void GetSends(std::vector<BusSend>& sends);
+
+        /// <summary>
+        /// Removes the sends of channels at or beyond a channel count (removed channels)
+        /// </summary>
+        void ResetChannelsFrom(int channelCount);
+
+        /// <summary>
+        /// Returns the plan to render this cycle. Real-time safe.
+        /// </summary>
+        const CompiledBusPlan& AcquirePlan() { return _compiled.Read(); }
+
+    private:
+        struct Bus
+        {
+            int id;
+            BusConfig config;
+        };
+
+        BusGraphStatus ValidateBus(int id, const BusConfig& config) const;
+        BusGraphStatus ValidateSend(const BusSend& send) const;
+        BusGraphStatus PublishLocked(std::vector<Bus> buses, std::vector<BusSend> sends);
+        bool Compile(const std::vector<Bus>& buses, const std::vector<BusSend>& sends, CompiledBusPlan& plan) const;
+        static Bus* FindBus(std::vector<Bus>& buses, int id);
+        static const Bus* FindBus(const std::vector<Bus>& buses, int id);
+
+        // Staged graph, as last compiled without a cycle
+        std::vector<Bus> _buses;
+        std::vector<BusSend> _sends;
+        int _numChannels;
+        int _numOutputs;
+        int _nextId;
+        uint64_t _version;
+
+        // Gains of the latest published plan by edge key, sorted, for the next plan's ramps
+        std::vector<std::pair<uint64_t, std::pair<float, float>>> _publishedGains;
+
+        TripleBuffer<CompiledBusPlan> _compiled;
+
+        // Serializes control threads; the process callback never takes it
+        std::mutex _writerMutex;
+    };
+}
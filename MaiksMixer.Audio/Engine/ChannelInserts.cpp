@@ -0,0 +1,375 @@
+#include "ChannelInserts.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    namespace {
+        constexpr double kPi = 3.14159265358979323846;
+
+        // Level the detector reports for silence, in dB
+        constexpr float kFloorDb = -120.0f;
+
+        // Release of the peak detector ahead of the gain computers
+        constexpr float kDetectorReleaseMs = 50.0f;
+
+        // Filter and detector state below this is flushed to zero after every block, so
+        // decaying tails never reach denormals
+        constexpr float kDenormalFloor = 1.0e-20f;
+
+        // Coefficient of a one-pole smoother reaching 1/e of the distance in ms, when it
+        // is stepped once per period frames
+        float SmoothingCoefficient(float ms, uint32_t period, uint32_t sampleRate)
+        {
+            const double frames = static_cast<double>(ms) * 0.001 * sampleRate;
+            return frames > 0.0 ? static_cast<float>(std::exp(-static_cast<double>(period) / frames)) : 0.0f;
+        }
+
+        // Sets one lane's pass-through coefficients for every band
+        void SetPassThrough(InsertGroup& group, uint32_t lane)
+        {
+            for (auto& biquad : group.biquads) {
+                biquad[lane] = 1.0f;
+                for (uint32_t c = 1; c < 5; c++) {
+                    biquad[c * kInsertLanes + lane] = 0.0f;
+                }
+            }
+        }
+
+        // RBJ cookbook biquad for one band, normalized to a0 = 1
+        void DesignBand(const EqBandParams& band, uint32_t sampleRate, float* biquad, uint32_t lane)
+        {
+            const double w0 = 2.0 * kPi * band.frequency / sampleRate;
+            const double cosW = std::cos(w0);
+            const double alpha = std::sin(w0) / (2.0 * band.q);
+            const double a = std::pow(10.0, band.gainDb / 40.0);
+            const double shelf = 2.0 * std::sqrt(a) * alpha;
+
+            double b0, b1, b2, a0, a1, a2;
+            switch (band.type) {
+            case EqBandType::LowShelf:
+                b0 = a * ((a + 1.0) - (a - 1.0) * cosW + shelf);
+                b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cosW);
+                b2 = a * ((a + 1.0) - (a - 1.0) * cosW - shelf);
+                a0 = (a + 1.0) + (a - 1.0) * cosW + shelf;
+                a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cosW);
+                a2 = (a + 1.0) + (a - 1.0) * cosW - shelf;
+                break;
+            case EqBandType::HighShelf:
+                b0 = a * ((a + 1.0) + (a - 1.0) * cosW + shelf);
+                b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cosW);
+                b2 = a * ((a + 1.0) + (a - 1.0) * cosW - shelf);
+                a0 = (a + 1.0) - (a - 1.0) * cosW + shelf;
+                a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cosW);
+                a2 = (a + 1.0) - (a - 1.0) * cosW - shelf;
+                break;
+            case EqBandType::HighPass:
+                b0 = (1.0 + cosW) / 2.0;
+                b1 = -(1.0 + cosW);
+                b2 = b0;
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alpha;
+                break;
+            case EqBandType::LowPass:
+                b0 = (1.0 - cosW) / 2.0;
+                b1 = 1.0 - cosW;
+                b2 = b0;
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alpha;
+                break;
+            case EqBandType::Peak:
+            default:
+                b0 = 1.0 + alpha * a;
+                b1 = -2.0 * cosW;
+                b2 = 1.0 - alpha * a;
+                a0 = 1.0 + alpha / a;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alpha / a;
+                break;
+            }
+
+            biquad[lane] = static_cast<float>(b0 / a0);
+            biquad[kInsertLanes + lane] = static_cast<float>(b1 / a0);
+            biquad[kInsertLanes * 2 + lane] = static_cast<float>(b2 / a0);
+            biquad[kInsertLanes * 3 + lane] = static_cast<float>(a1 / a0);
+            biquad[kInsertLanes * 4 + lane] = static_cast<float>(a2 / a0);
+        }
+
+        bool HasActiveStage(const ChannelInsertParams& params)
+        {
+            for (const EqBandParams& band : params.eq) {
+                if (band.enabled) return true;
+            }
+            return params.gate.enabled || params.compressor.enabled;
+        }
+
+        // Clamps a chain to the ranges the designs are stable for
+        ChannelInsertParams Clamp(const ChannelInsertParams& params)
+        {
+            ChannelInsertParams result = params;
+            for (EqBandParams& band : result.eq) {
+                if (static_cast<int32_t>(band.type) < 0 || static_cast<int32_t>(band.type) > static_cast<int32_t>(EqBandType::LowPass)) {
+                    band.type = EqBandType::Peak;
+                }
+                band.frequency = std::clamp(band.frequency, 10.0f, 24000.0f);
+                band.gainDb = std::clamp(band.gainDb, -24.0f, 24.0f);
+                band.q = std::clamp(band.q, 0.1f, 18.0f);
+            }
+
+            GateParams& gate = result.gate;
+            gate.thresholdDb = std::clamp(gate.thresholdDb, kFloorDb, 0.0f);
+            gate.rangeDb = std::clamp(gate.rangeDb, kFloorDb, 0.0f);
+            gate.attackMs = std::clamp(gate.attackMs, 0.0f, 1000.0f);
+            gate.releaseMs = std::clamp(gate.releaseMs, 0.0f, 5000.0f);
+
+            CompressorParams& compressor = result.compressor;
+            compressor.thresholdDb = std::clamp(compressor.thresholdDb, -60.0f, 0.0f);
+            compressor.ratio = std::clamp(compressor.ratio, 1.0f, 100.0f);
+            compressor.attackMs = std::clamp(compressor.attackMs, 0.0f, 1000.0f);
+            compressor.releaseMs = std::clamp(compressor.releaseMs, 0.0f, 5000.0f);
+            compressor.makeupDb = std::clamp(compressor.makeupDb, 0.0f, 40.0f);
+            return result;
+        }
+
+        // Evaluates the gate and compressor of every dynamics lane at a segment boundary
+        // and sets the gain ramp of the next segment
+        void UpdateDynamics(const InsertGroup& group, InsertGroupState& state)
+        {
+            for (uint32_t l = 0; l < kInsertLanes; l++) {
+                state.gain[l] = state.targetGain[l];
+                if ((group.dynamicsMask & (1u << l)) == 0) {
+                    state.gateDb[l] = 0.0f;
+                    state.reductionDb[l] = 0.0f;
+                    state.targetGain[l] = 1.0f;
+                    state.gainStep[l] = (1.0f - state.gain[l]) / static_cast<float>(kDynamicsSegmentFrames);
+                    continue;
+                }
+
+                const float envelope = state.envelope[l];
+                const float levelDb = envelope > 1.0e-6f ? 20.0f * std::log10(envelope) : kFloorDb;
+
+                if (group.gateRangeDb[l] < 0.0f) {
+                    const float target = levelDb >= group.gateThresholdDb[l] ? 0.0f : group.gateRangeDb[l];
+                    const float coefficient = target > state.gateDb[l] ? group.gateAttack[l] : group.gateRelease[l];
+                    state.gateDb[l] = target + coefficient * (state.gateDb[l] - target);
+                }
+                else {
+                    state.gateDb[l] = 0.0f;
+                }
+
+                if (group.compressorSlope[l] > 0.0f) {
+                    const float over = levelDb - group.compressorThresholdDb[l];
+                    const float target = over > 0.0f ? -over * group.compressorSlope[l] : 0.0f;
+                    const float coefficient = target < state.reductionDb[l] ? group.compressorAttack[l] : group.compressorRelease[l];
+                    state.reductionDb[l] = target + coefficient * (state.reductionDb[l] - target);
+                }
+                else {
+                    state.reductionDb[l] = 0.0f;
+                }
+
+                const float gainDb = state.gateDb[l] + state.reductionDb[l] + group.makeupDb[l];
+                state.targetGain[l] = gainDb != 0.0f ? std::pow(10.0f, gainDb / 20.0f) : 1.0f;
+                state.gainStep[l] = (state.targetGain[l] - state.gain[l]) / static_cast<float>(kDynamicsSegmentFrames);
+            }
+        }
+
+        void FlushDenormals(float* values, size_t count)
+        {
+            for (size_t i = 0; i < count; i++) {
+                if (std::abs(values[i]) < kDenormalFloor) values[i] = 0.0f;
+            }
+        }
+    }
+
+    // Reset
+    void InsertGroupState::Reset()
+    {
+        for (auto& biquad : biquads) {
+            std::fill(biquad, biquad + 2 * kInsertLanes, 0.0f);
+        }
+        std::fill(envelope, envelope + kInsertLanes, 0.0f);
+        std::fill(gateDb, gateDb + kInsertLanes, 0.0f);
+        std::fill(reductionDb, reductionDb + kInsertLanes, 0.0f);
+        std::fill(gain, gain + kInsertLanes, 1.0f);
+        std::fill(gainStep, gainStep + kInsertLanes, 0.0f);
+        std::fill(targetGain, targetGain + kInsertLanes, 1.0f);
+        segmentPosition = 0;
+    }
+
+    // Process Insert Group
+    void ProcessInsertGroup(const MixKernels& kernels, const InsertGroup& group, InsertGroupState& state,
+                            float* lanes, uint32_t nframes)
+    {
+        for (int s = 0; s < ChannelInsertParams::kEqBands; s++) {
+            if ((group.stageMask & (1u << s)) == 0) continue;
+            kernels.biquadLanes(lanes, nframes, group.biquads[s], state.biquads[s]);
+            FlushDenormals(state.biquads[s], 2 * kInsertLanes);
+        }
+
+        if (group.dynamicsMask == 0) return;
+
+        // Segments continue across blocks, so the gain curve does not depend on the block size
+        for (uint32_t done = 0; done < nframes;) {
+            const uint32_t count = std::min(nframes - done, kDynamicsSegmentFrames - state.segmentPosition);
+            kernels.dynamicsLanes(lanes + static_cast<size_t>(done) * kInsertLanes, count, state.segmentPosition,
+                                  group.detectorDecay, state.gain, state.gainStep, state.envelope);
+
+            state.segmentPosition += count;
+            if (state.segmentPosition == kDynamicsSegmentFrames) {
+                UpdateDynamics(group, state);
+                state.segmentPosition = 0;
+            }
+            done += count;
+        }
+        FlushDenormals(state.envelope, kInsertLanes);
+    }
+
+    // Constructor
+    InsertBank::InsertBank()
+        : _sampleRate(48000), _version(0)
+    {
+    }
+
+    // Reserve
+    void InsertBank::Reserve(int capacity)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const size_t channels = static_cast<size_t>(std::max(capacity, 0));
+        _channels.assign(channels, ChannelInsertParams());
+
+        // Every buffer is sized for the full capacity, so publishing never reallocates
+        const size_t groups = (channels + kInsertLanes - 1) / kInsertLanes;
+        _compiled.ForEach([groups, channels](CompiledInserts& inserts) {
+            inserts.groups.assign(groups, InsertGroup());
+            inserts.enabled.assign(channels, 0);
+            inserts.bypassed.assign(channels, 0);
+        });
+        PublishLocked();
+    }
+
+    // Set Sample Rate
+    void InsertBank::SetSampleRate(uint32_t sampleRate)
+    {
+        if (sampleRate == 0) return;
+
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _sampleRate = sampleRate;
+        PublishLocked();
+    }
+
+    // Set Channel
+    bool InsertBank::SetChannel(int channel, const ChannelInsertParams& params)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (channel < 0 || channel >= static_cast<int>(_channels.size())) return false;
+
+        _channels[channel] = Clamp(params);
+        PublishLocked();
+        return true;
+    }
+
+    // Get Channel
+    bool InsertBank::GetChannel(int channel, ChannelInsertParams& params)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (channel < 0 || channel >= static_cast<int>(_channels.size())) return false;
+
+        params = _channels[channel];
+        return true;
+    }
+
+    // Set Bypass
+    bool InsertBank::SetBypass(int channel, bool bypass)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (channel < 0 || channel >= static_cast<int>(_channels.size())) return false;
+
+        _channels[channel].bypass = bypass;
+        PublishLocked();
+        return true;
+    }
+
+    // Reset From
+    void InsertBank::ResetFrom(int channelCount)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const size_t first = static_cast<size_t>(std::max(channelCount, 0));
+        if (first >= _channels.size()) return;
+
+        std::fill(_channels.begin() + first, _channels.end(), ChannelInsertParams());
+        PublishLocked();
+    }
+
+    // Compile every chain into its group's lanes and publish them
+    void InsertBank::PublishLocked()
+    {
+        CompiledInserts& inserts = _compiled.WriteBuffer();
+        const uint32_t sampleRate = _sampleRate;
+        const float nyquistLimit = 0.45f * static_cast<float>(sampleRate);
+        const float detectorDecay = SmoothingCoefficient(kDetectorReleaseMs, 1, sampleRate);
+
+        inserts.enabledCount = 0;
+        inserts.bypassedCount = 0;
+        for (size_t g = 0; g < inserts.groups.size(); g++) {
+            InsertGroup& group = inserts.groups[g];
+            group.stageMask = 0;
+            group.dynamicsMask = 0;
+
+            for (uint32_t l = 0; l < kInsertLanes; l++) {
+                const size_t channel = g * kInsertLanes + l;
+                SetPassThrough(group, l);
+                group.detectorDecay[l] = detectorDecay;
+                group.gateThresholdDb[l] = kFloorDb;
+                group.gateRangeDb[l] = 0.0f;
+                group.gateAttack[l] = 0.0f;
+                group.gateRelease[l] = 0.0f;
+                group.compressorThresholdDb[l] = 0.0f;
+                group.compressorSlope[l] = 0.0f;
+                group.compressorAttack[l] = 0.0f;
+                group.compressorRelease[l] = 0.0f;
+                group.makeupDb[l] = 0.0f;
+                if (channel >= _channels.size()) continue;
+
+                const ChannelInsertParams& params = _channels[channel];
+                const bool active = HasActiveStage(params);
+                inserts.enabled[channel] = active && !params.bypass;
+                inserts.bypassed[channel] = active && params.bypass;
+                if (inserts.bypassed[channel]) inserts.bypassedCount++;
+                if (!inserts.enabled[channel]) continue;
+                inserts.enabledCount++;
+
+                for (int s = 0; s < ChannelInsertParams::kEqBands; s++) {
+                    EqBandParams band = params.eq[s];
+                    if (!band.enabled) continue;
+
+                    band.frequency = std::min(band.frequency, nyquistLimit);
+                    DesignBand(band, sampleRate, group.biquads[s], l);
+                    group.stageMask |= 1u << s;
+                }
+
+                if (params.gate.enabled) {
+                    group.gateThresholdDb[l] = params.gate.thresholdDb;
+                    group.gateRangeDb[l] = params.gate.rangeDb;
+                    group.gateAttack[l] = SmoothingCoefficient(params.gate.attackMs, kDynamicsSegmentFrames, sampleRate);
+                    group.gateRelease[l] = SmoothingCoefficient(params.gate.releaseMs, kDynamicsSegmentFrames, sampleRate);
+                }
+                if (params.compressor.enabled) {
+                    group.compressorThresholdDb[l] = params.compressor.thresholdDb;
+                    group.compressorSlope[l] = 1.0f - 1.0f / params.compressor.ratio;
+                    group.compressorAttack[l] = SmoothingCoefficient(params.compressor.attackMs, kDynamicsSegmentFrames, sampleRate);
+                    group.compressorRelease[l] = SmoothingCoefficient(params.compressor.releaseMs, kDynamicsSegmentFrames, sampleRate);
+                    group.makeupDb[l] = params.compressor.makeupDb;
+                }
+                if (params.gate.enabled || params.compressor.enabled) group.dynamicsMask |= 1u << l;
+            }
+        }
+        inserts.version = ++_version;
+
+        _compiled.Publish();
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "MixKernels.h"
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Filter shape of a parametric EQ band (matches the managed EqBandType)
+    /// </summary>
+    enum class EqBandType : int32_t
+    {
+        Peak = 0,
+        LowShelf = 1,
+        HighShelf = 2,
+        HighPass = 3,       // 12 dB/octave, gain unused
+        LowPass = 4         // 12 dB/octave, gain unused
+    };
+
+    /// <summary>
+    /// One band of a channel's parametric EQ
+    /// </summary>
+    struct EqBandParams
+    {
+        EqBandType type = EqBandType::Peak;
+        float frequency = 1000.0f;  // Hz
+        float gainDb = 0.0f;
+        float q = 0.707f;           // Bandwidth, or shelf slope
+        bool enabled = false;
+    };
+
+    /// <summary>
+    /// Noise gate: attenuates by rangeDb while the signal stays below thresholdDb
+    /// </summary>
+    struct GateParams
+    {
+        float thresholdDb = -50.0f;
+        float rangeDb = -80.0f;
+        float attackMs = 1.0f;      // Opening time
+        float releaseMs = 100.0f;   // Closing time
+        bool enabled = false;
+    };
+
+    /// <summary>
+    /// Feed-forward compressor with a hard knee
+    /// </summary>
+    struct CompressorParams
+    {
+        float thresholdDb = -20.0f;
+        float ratio = 4.0f;
+        float attackMs = 10.0f;
+        float releaseMs = 100.0f;
+        float makeupDb = 0.0f;
+        bool enabled = false;
+    };
+
+    /// <summary>
+    /// Insert chain of one channel, run before its fader: the EQ bands in order, then the
+    /// gate, then the compressor
+    /// </summary>
+    struct ChannelInsertParams
+    {
+        static constexpr int kEqBands = 4;
+
+        EqBandParams eq[kEqBands];
+        GateParams gate;
+        CompressorParams compressor;
+        bool bypass = false;        // Skips the whole chain, keeping its settings
+    };
+
+    // Frames between two evaluations of the dynamics gain computers; the gain is
+    // interpolated linearly in between
+    constexpr uint32_t kDynamicsSegmentFrames = 32;
+
+    /// <summary>
+    /// Compiled chains of kInsertLanes consecutive channels, stored as structure of arrays:
+    /// every coefficient is an array with one value per lane, so the kernels run the same
+    /// stage of all lanes in one pass. Lanes without a stage get pass-through coefficients.
+    /// </summary>
+    struct InsertGroup
+    {
+        // Bit s: some lane has EQ band s; bit l of dynamicsMask: lane l has a gate or compressor
+        uint32_t stageMask = 0;
+        uint32_t dynamicsMask = 0;
+
+        // b0, b1, b2, a1, a2 of every lane, per band
+        float biquads[ChannelInsertParams::kEqBands][5 * kInsertLanes];
+
+        // Dynamics: the detector decays per sample, the gain computers smooth per segment
+        float detectorDecay[kInsertLanes];
+        float gateThresholdDb[kInsertLanes];
+        float gateRangeDb[kInsertLanes];        // 0 for lanes without a gate
+        float gateAttack[kInsertLanes];
+        float gateRelease[kInsertLanes];
+        float compressorThresholdDb[kInsertLanes];
+        float compressorSlope[kInsertLanes];    // 1 - 1 / ratio, 0 for lanes without a compressor
+        float compressorAttack[kInsertLanes];
+        float compressorRelease[kInsertLanes];
+        float makeupDb[kInsertLanes];
+    };
+
+    /// <summary>
+    /// Insert chains of every channel, compiled for the process callback
+    /// </summary>
+    struct CompiledInserts
+    {
+        std::vector<InsertGroup> groups;    // Channel c is lane c % kInsertLanes of group c / kInsertLanes
+        std::vector<uint8_t> enabled;       // Per channel: has an active stage and is not bypassed
+        std::vector<uint8_t> bypassed;      // Per channel: has an active stage but is bypassed
+        int enabledCount = 0;
+        int bypassedCount = 0;
+        uint64_t version = 0;
+    };
+
+    /// <summary>
+    /// Filter, detector and gain state of one group (audio thread), laid out like InsertGroup
+    /// </summary>
+    struct InsertGroupState
+    {
+        float biquads[ChannelInsertParams::kEqBands][2 * kInsertLanes];
+        float envelope[kInsertLanes];
+        float gateDb[kInsertLanes];
+        float reductionDb[kInsertLanes];
+        float gain[kInsertLanes];           // At the start of the current segment
+        float gainStep[kInsertLanes];
+        float targetGain[kInsertLanes];     // At the end of the current segment
+        uint32_t segmentPosition;           // Frames into the current segment
+
+        /// <summary>
+        /// Clears the filters and detectors and sets unity gain
+        /// </summary>
+        void Reset();
+    };
+
+    /// <summary>
+    /// Runs a group's chains over nframes frames of interleaved lanes, in place. Only the
+    /// enabled EQ stages are run, and the dynamics only if a lane has them. Real-time safe.
+    /// </summary>
+    void ProcessInsertGroup(const MixKernels& kernels, const InsertGroup& group, InsertGroupState& state,
+                            float* lanes, uint32_t nframes);
+
+    /// <summary>
+    /// Per-channel insert settings shared between control threads and the process
+    /// callback. Every edit recompiles the filter coefficients and dynamics constants on
+    /// the calling thread and publishes them through a triple buffer, so the process
+    /// callback only ever reads complete coefficient sets.
+    /// </summary>
+    class InsertBank
+    {
+    public:
+        InsertBank();
+
+        /// <summary>
+        /// Sizes the bank for up to capacity channels and resets every chain. Must not be
+        /// called while the process callback may be running.
+        /// </summary>
+        void Reserve(int capacity);
+
+        /// <summary>
+        /// Sets the sample rate the coefficients are designed for and republishes them
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Replaces a channel's chain (values are clamped to their ranges). Returns false if
+        /// the channel is out of range.
+        /// </summary>
+        bool SetChannel(int channel, const ChannelInsertParams& params);
+
+        /// <summary>
+        /// Copies a channel's chain as clamped. Returns false if the channel is out of range.
+        /// </summary>
+        bool GetChannel(int channel, ChannelInsertParams& params);
+
+        /// <summary>
+        /// Bypasses or restores a channel's whole chain
+        /// </summary>
+        bool SetBypass(int channel, bool bypass);
+
+        /// <summary>
+        /// Resets the chains of channels at or beyond a channel count (removed channels)
+        /// </summary>
+        void ResetFrom(int channelCount);
+
+        /// <summary>
+        /// Returns the chains to render this cycle. Real-time safe.
+        /// </summary>
+        const CompiledInserts& AcquireInserts() { return _compiled.Read(); }
+
+    private:
+        void PublishLocked();
+
+        std::vector<ChannelInsertParams> _channels;
+        uint32_t _sampleRate;
+        uint64_t _version;
+
+        TripleBuffer<CompiledInserts> _compiled;
+
+        // Serializes control threads; the process callback never takes it
+        std::mutex _writerMutex;
+    };
+}
@@ -0,0 +1,473 @@
+#include "DiskRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/types.h>
+#endif
+
+namespace emp {
+
+    namespace {
+
+        // Wave64 chunk ids
+        constexpr uint8_t kW64Riff[16] = { 'r', 'i', 'f', 'f', 0x2E, 0x91, 0xCF, 0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00 };
+        constexpr uint8_t kW64Wave[16] = { 'w', 'a', 'v', 'e', 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+        constexpr uint8_t kW64Format[16] = { 'f', 'm', 't', ' ', 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+        constexpr uint8_t kW64Junk[16] = { 'j', 'u', 'n', 'k', 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+        constexpr uint8_t kW64Data[16] = { 'd', 'a', 't', 'a', 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+
+        // KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+        constexpr uint8_t kFloatSubFormat[16] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+        constexpr uint16_t kFormatIeeeFloat = 3;
+        constexpr uint16_t kFormatExtensible = 0xFFFE;
+        constexpr uint32_t kW64ChunkHeaderBytes = 24;
+
+        // Headers are little-endian, as are the samples on every supported target
+        void Put16(std::vector<uint8_t>& bytes, uint16_t value)
+        {
+            for (int i = 0; i < 2; i++) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+
+        void Put32(std::vector<uint8_t>& bytes, uint32_t value)
+        {
+            for (int i = 0; i < 4; i++) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+
+        void Put64(std::vector<uint8_t>& bytes, uint64_t value)
+        {
+            for (int i = 0; i < 8; i++) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+
+        void PutBytes(std::vector<uint8_t>& bytes, const uint8_t* data, size_t count)
+        {
+            bytes.insert(bytes.end(), data, data + count);
+        }
+
+        void PutTag(std::vector<uint8_t>& bytes, const char* tag)
+        {
+            PutBytes(bytes, reinterpret_cast<const uint8_t*>(tag), 4);
+        }
+
+        // Plain IEEE float up to stereo, WAVE_FORMAT_EXTENSIBLE beyond
+        uint32_t FormatBytes(uint16_t channels)
+        {
+            return channels > 2 ? 40 : 18;
+        }
+
+        void PutFormat(std::vector<uint8_t>& bytes, uint16_t channels, uint32_t sampleRate)
+        {
+            const uint16_t blockAlign = static_cast<uint16_t>(channels * sizeof(float));
+            Put16(bytes, channels > 2 ? kFormatExtensible : kFormatIeeeFloat);
+            Put16(bytes, channels);
+            Put32(bytes, sampleRate);
+            Put32(bytes, sampleRate * blockAlign);
+            Put16(bytes, blockAlign);
+            Put16(bytes, 32);
+
+            if (channels > 2) {
+                Put16(bytes, 22);
+                Put16(bytes, 32);
+                Put32(bytes, 0);    // No speaker positions
+                PutBytes(bytes, kFloatSubFormat, sizeof(kFloatSubFormat));
+            }
+            else {
+                Put16(bytes, 0);
+            }
+        }
+
+        bool Seek(std::FILE* file, uint64_t offset)
+        {
+#ifdef _WIN32
+            return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        // Reserves disk space without changing the file size. Best effort: where the file
+        // system cannot, the file simply grows as it is written.
+        void ReserveSpace(std::FILE* file, uint64_t offset, uint64_t length)
+        {
+#ifdef _WIN32
+            FILE_ALLOCATION_INFO info;
+            info.AllocationSize.QuadPart = static_cast<LONGLONG>(offset + length);
+            SetFileInformationByHandle(reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file))), FileAllocationInfo,
+                                       &info, sizeof(info));
+#elif defined(__linux__)
+            (void)fallocate(fileno(file), FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(length));
+#else
+            (void)file;
+            (void)offset;
+            (void)length;
+#endif
+        }
+
+        std::string TrackFileName(const std::string& path, const RecordTrack& track, const char* extension)
+        {
+            char suffix[32];
+            std::snprintf(suffix, sizeof(suffix), "-%s%02d", track.source == TapSource::Channel ? "in" : "out",
+                          track.index + 1);
+            return path + suffix + extension;
+        }
+    }
+
+    // Constructor
+    DiskRecorder::DiskRecorder()
+        : _numChannels(0), _numOutputs(0), _sampleRate(48000)
+    {
+    }
+
+    // Destructor
+    DiskRecorder::~DiskRecorder()
+    {
+        Stop();
+    }
+
+    // Reserve
+    void DiskRecorder::Reserve(int numChannels, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        StopLocked();
+        _numChannels = std::max(numChannels, 0);
+        _numOutputs = std::max(numOutputs, 0);
+    }
+
+    // Set Sample Rate
+    void DiskRecorder::SetSampleRate(uint32_t sampleRate)
+    {
+        if (sampleRate > 0) _sampleRate.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    // Start
+    bool DiskRecorder::Start(const RecordOptions& options)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        if (_session.Get() != nullptr || options.tracks.empty()) return false;
+        if (options.polyphonic && options.tracks.size() > std::numeric_limits<uint16_t>::max()) return false;
+        for (const RecordTrack& track : options.tracks) {
+            const int count = track.source == TapSource::Channel ? _numChannels
+                            : track.source == TapSource::Output ? _numOutputs : 0;
+            if (track.index < 0 || track.index >= count) return false;
+        }
+
+        auto session = std::make_unique<Session>();
+        session->format = options.format;
+        session->polyphonic = options.polyphonic;
+        session->sampleRate = _sampleRate.load(std::memory_order_relaxed);
+
+        const size_t ringFrames = std::max(static_cast<size_t>(std::max(options.ringSeconds, 0.0f) * session->sampleRate),
+                                           static_cast<size_t>(kWriteFrames) * 2);
+        session->trackCount = static_cast<int>(options.tracks.size());
+        session->tracks.reset(new Track[session->trackCount]);
+        for (int t = 0; t < session->trackCount; t++) {
+            session->tracks[t].source = options.tracks[t].source;
+            session->tracks[t].index = options.tracks[t].index;
+            session->tracks[t].ring.Reserve(ringFrames);
+        }
+
+        session->scratch.resize(kWriteFrames);
+        if (options.polyphonic) session->interleaved.resize(static_cast<size_t>(kWriteFrames) * session->trackCount);
+
+        const uint16_t fileChannels = options.polyphonic ? static_cast<uint16_t>(session->trackCount) : 1;
+        session->maxFrames = options.format == RecordFormat::Wav
+            ? (std::numeric_limits<uint32_t>::max() - kDataAlignment) / (fileChannels * sizeof(float))
+            : std::numeric_limits<uint64_t>::max();
+
+        const char* extension = options.format == RecordFormat::Wav ? ".wav" : ".w64";
+        std::vector<std::string> names;
+        if (options.polyphonic) {
+            names.push_back(options.path + extension);
+        }
+        else {
+            for (const RecordTrack& track : options.tracks) names.push_back(TrackFileName(options.path, track, extension));
+        }
+
+        for (const std::string& name : names) {
+            File file;
+            file.channels = fileChannels;
+            file.handle = std::fopen(name.c_str(), "wb");
+
+            // Writes are already large, so stdio's buffer would only add a copy
+            if (file.handle != nullptr) std::setvbuf(file.handle, nullptr, _IONBF, 0);
+            if (file.handle == nullptr || !WriteHeader(*session, file)) {
+                if (file.handle != nullptr) std::fclose(file.handle);
+                CloseFiles(*session);
+                throw std::runtime_error("Cannot create recording file " + name);
+            }
+            session->files.push_back(file);
+        }
+
+        // The writer only reads rings until Stop() lets it finish
+        _writer = std::thread(&DiskRecorder::Run, session.get());
+        _session.Publish(std::move(session), _rcu);
+        _lastStatus = RecorderStatus();
+        return true;
+    }
+
+    // Stop
+    bool DiskRecorder::Stop()
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+        return StopLocked();
+    }
+
+    // Is Recording
+    bool DiskRecorder::IsRecording() const
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+        return _session.Get() != nullptr;
+    }
+
+    // Capture (real-time thread)
+    void DiskRecorder::Capture(const float* const* channels, int numChannels, const float* const* outputs, int numOutputs,
+                               uint32_t nframes)
+    {
+        RcuDomain::ReadScope cycleScope(_rcu);
+
+        Session* session = _session.Load();
+        if (session == nullptr || !session->capturing.load(std::memory_order_acquire)) return;
+
+        // All tracks or none, so they stay aligned; free space only grows until we write
+        for (int t = 0; t < session->trackCount; t++) {
+            if (session->tracks[t].ring.GetFreeCount() < nframes) {
+                session->droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        for (int t = 0; t < session->trackCount; t++) {
+            Track& track = session->tracks[t];
+            const float* samples = nullptr;
+            if (track.source == TapSource::Channel) {
+                if (track.index < numChannels) samples = channels[track.index];
+            }
+            else if (track.index < numOutputs) {
+                samples = outputs[track.index];
+            }
+
+            if (samples != nullptr) track.ring.TryWrite(samples, nframes);
+            else track.ring.TryWriteSilence(nframes);
+        }
+
+        session->capturedFrames.fetch_add(nframes, std::memory_order_relaxed);
+    }
+
+    // Get Status
+    void DiskRecorder::GetStatus(RecorderStatus& status) const
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        const Session* session = _session.Get();
+        if (session != nullptr) FillStatus(*session, status);
+        else status = _lastStatus;
+    }
+
+    bool DiskRecorder::StopLocked()
+    {
+        Session* session = _session.Get();
+        if (session == nullptr) return false;
+
+        // Once no cycle can still be writing, the rings hold the whole recording
+        session->capturing.store(false, std::memory_order_release);
+        _rcu.Synchronize();
+        session->finishing.store(true, std::memory_order_release);
+        if (_writer.joinable()) _writer.join();
+
+        FillStatus(*session, _lastStatus);
+        _lastStatus.recording = false;
+        _session.Publish(std::unique_ptr<Session>(), _rcu);
+        return true;
+    }
+
+    void DiskRecorder::FillStatus(const Session& session, RecorderStatus& status) const
+    {
+        status.recording = session.capturing.load(std::memory_order_relaxed);
+        status.sampleRate = session.sampleRate;
+        status.capturedFrames = session.capturedFrames.load(std::memory_order_relaxed);
+        status.writtenFrames = session.writtenFrames.load(std::memory_order_relaxed);
+        status.bytesWritten = session.bytesWritten.load(std::memory_order_relaxed);
+        status.droppedBlocks = session.droppedBlocks.load(std::memory_order_relaxed);
+        status.writeFailed = session.writeFailed.load(std::memory_order_relaxed);
+        status.limitReached = session.limitReached.load(std::memory_order_relaxed);
+
+        status.ringFill.resize(session.trackCount);
+        for (int t = 0; t < session.trackCount; t++) {
+            const SampleRing& ring = session.tracks[t].ring;
+            status.ringFill[t] = static_cast<float>(ring.GetPendingCount()) / static_cast<float>(ring.GetCapacity());
+        }
+    }
+
+    // Writer thread: drains full chunks while recording, then everything left
+    void DiskRecorder::Run(Session* session)
+    {
+        for (;;) {
+            const bool finishing = session->finishing.load(std::memory_order_acquire);
+            Drain(*session, finishing);
+            if (finishing) break;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        }
+
+        CloseFiles(*session);
+    }
+
+    void DiskRecorder::Drain(Session& session, bool flush)
+    {
+        const int trackCount = session.trackCount;
+
+        for (;;) {
+            // Every track holds the same frames, but each ring publishes on its own
+            size_t available = session.tracks[0].ring.GetPendingCount();
+            for (int t = 1; t < trackCount; t++) {
+                available = std::min(available, session.tracks[t].ring.GetPendingCount());
+            }
+            if (available == 0 || (!flush && available < kWriteFrames)) break;
+
+            // Frames past a file's size limit are read and discarded
+            const size_t count = std::min(available, static_cast<size_t>(kWriteFrames));
+            const uint64_t written = session.writtenFrames.load(std::memory_order_relaxed);
+            const size_t keep = static_cast<size_t>(std::min<uint64_t>(count, session.maxFrames - written));
+            if (keep < count) session.limitReached.store(true, std::memory_order_relaxed);
+
+            if (session.polyphonic) {
+                for (int t = 0; t < trackCount; t++) {
+                    session.tracks[t].ring.Read(session.scratch.data(), count);
+                    for (size_t i = 0; i < keep; i++) {
+                        session.interleaved[i * trackCount + t] = session.scratch[i];
+                    }
+                }
+                WriteSamples(session, session.files[0], session.interleaved.data(), keep * trackCount);
+            }
+            else {
+                for (int t = 0; t < trackCount; t++) {
+                    session.tracks[t].ring.Read(session.scratch.data(), count);
+                    WriteSamples(session, session.files[t], session.scratch.data(), keep);
+                }
+            }
+
+            if (!session.writeFailed.load(std::memory_order_relaxed)) {
+                session.writtenFrames.store(written + keep, std::memory_order_relaxed);
+            }
+        }
+
+        // Keep the headers describing the data at most a second behind
+        const uint64_t written = session.writtenFrames.load(std::memory_order_relaxed);
+        if (written - session.headerFrames >= session.sampleRate) {
+            for (File& file : session.files) {
+                if (!WriteHeader(session, file)) session.writeFailed.store(true, std::memory_order_relaxed);
+            }
+            session.headerFrames = written;
+        }
+    }
+
+    void DiskRecorder::WriteSamples(Session& session, File& file, const float* samples, size_t count)
+    {
+        if (count == 0 || session.writeFailed.load(std::memory_order_relaxed)) return;
+
+        const uint64_t bytes = count * sizeof(float);
+        const uint64_t end = kDataAlignment + file.dataBytes + bytes;
+        if (end > file.reservedBytes) {
+            const uint64_t extent = static_cast<uint64_t>(session.sampleRate) * kExtentSeconds * file.channels * sizeof(float);
+            uint64_t reserve = std::max(extent, end - file.reservedBytes);
+            reserve = (reserve + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+            ReserveSpace(file.handle, file.reservedBytes, reserve);
+            file.reservedBytes += reserve;
+        }
+
+        if (std::fwrite(samples, sizeof(float), count, file.handle) != count) {
+            session.writeFailed.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        file.dataBytes += bytes;
+        session.bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Rewrites a file's header for the data written so far and returns to the end of the data
+    bool DiskRecorder::WriteHeader(const Session& session, File& file)
+    {
+        std::vector<uint8_t> header;
+        header.reserve(kDataAlignment);
+
+        const uint64_t frames = file.dataBytes / (file.channels * sizeof(float));
+        const uint32_t formatBytes = FormatBytes(file.channels);
+
+        if (session.format == RecordFormat::Wav) {
+            PutTag(header, "RIFF");
+            Put32(header, static_cast<uint32_t>(std::min<uint64_t>(kDataAlignment - 8 + file.dataBytes, std::numeric_limits<uint32_t>::max())));
+            PutTag(header, "WAVE");
+
+            PutTag(header, "fmt ");
+            Put32(header, formatBytes);
+            PutFormat(header, file.channels, session.sampleRate);
+
+            PutTag(header, "fact");
+            Put32(header, 4);
+            Put32(header, static_cast<uint32_t>(std::min<uint64_t>(frames, std::numeric_limits<uint32_t>::max())));
+
+            // Pads the data chunk out to the alignment
+            PutTag(header, "JUNK");
+            const uint32_t junkBytes = kDataAlignment - static_cast<uint32_t>(header.size()) - 4 - 8;
+            Put32(header, junkBytes);
+            header.resize(header.size() + junkBytes, 0);
+
+            PutTag(header, "data");
+            Put32(header, static_cast<uint32_t>(file.dataBytes));
+        }
+        else {
+            // Chunks are 8-byte aligned; the data chunk's padding is written on close
+            const uint64_t dataPadding = (8 - file.dataBytes % 8) % 8;
+
+            PutBytes(header, kW64Riff, sizeof(kW64Riff));
+            Put64(header, kDataAlignment + file.dataBytes + dataPadding);
+            PutBytes(header, kW64Wave, sizeof(kW64Wave));
+
+            PutBytes(header, kW64Format, sizeof(kW64Format));
+            Put64(header, kW64ChunkHeaderBytes + formatBytes);
+            PutFormat(header, file.channels, session.sampleRate);
+            header.resize((header.size() + 7) / 8 * 8, 0);
+
+            PutBytes(header, kW64Junk, sizeof(kW64Junk));
+            const uint32_t junkBytes = kDataAlignment - static_cast<uint32_t>(header.size()) + 16 - kW64ChunkHeaderBytes;
+            Put64(header, junkBytes);
+            header.resize(header.size() + junkBytes - kW64ChunkHeaderBytes, 0);
+
+            PutBytes(header, kW64Data, sizeof(kW64Data));
+            Put64(header, kW64ChunkHeaderBytes + file.dataBytes);
+        }
+
+        return header.size() == kDataAlignment &&
+               Seek(file.handle, 0) &&
+               std::fwrite(header.data(), 1, header.size(), file.handle) == header.size() &&
+               Seek(file.handle, kDataAlignment + file.dataBytes);
+    }
+
+    void DiskRecorder::CloseFiles(Session& session)
+    {
+        for (File& file : session.files) {
+            if (session.format == RecordFormat::Wave64 && file.dataBytes % 8 != 0) {
+                const uint8_t padding[8] = {};
+                std::fwrite(padding, 1, 8 - file.dataBytes % 8, file.handle);
+            }
+            if (!WriteHeader(session, file)) session.writeFailed.store(true, std::memory_order_relaxed);
+
+            std::fclose(file.handle);
+            file.handle = nullptr;
+        }
+        session.files.clear();
+    }
+}
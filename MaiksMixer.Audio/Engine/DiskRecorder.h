@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AnalysisTaps.h"
+#include "RcuDomain.h"
+#include "SampleRing.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Container of a recording (matches the managed RecordFormat). Samples are always
+    /// stored as 32-bit float.
+    /// </summary>
+    enum class RecordFormat : int32_t
+    {
+        Wav = 0,        // RIFF WAVE, limited to 4 GiB per file
+        Wave64 = 1      // Sony Wave64, 64-bit sizes
+    };
+
+    /// <summary>
+    /// Signal recorded to one track
+    /// </summary>
+    struct RecordTrack
+    {
+        TapSource source = TapSource::Channel;  // Input channel (pre-insert, pre-fader) or output bus
+        int index = 0;
+    };
+
+    /// <summary>
+    /// What a recording captures and where it goes
+    /// </summary>
+    struct RecordOptions
+    {
+        // Path without extension. A polyphonic recording writes path.wav/.w64; otherwise every
+        // track gets its own file named after its source, e.g. path-in03.wav or path-out01.wav.
+        std::string path;
+        RecordFormat format = RecordFormat::Wav;
+        bool polyphonic = false;    // One interleaved file instead of one file per track
+        std::vector<RecordTrack> tracks;
+        float ringSeconds = 4.0f;   // Audio buffered per track between the audio thread and the disk
+    };
+
+    /// <summary>
+    /// Progress of the current (or last) recording
+    /// </summary>
+    struct RecorderStatus
+    {
+        bool recording = false;
+        uint32_t sampleRate = 0;
+        uint64_t capturedFrames = 0;    // Frames the audio thread queued per track
+        uint64_t writtenFrames = 0;     // Frames on disk per track
+        uint64_t bytesWritten = 0;      // Sample data, all files
+        uint64_t droppedBlocks = 0;     // Cycles lost because a ring was full
+        std::vector<float> ringFill;    // Per track, 0 to 1
+        bool writeFailed = false;       // A write failed; the rings are still drained
+        bool limitReached = false;      // A WAV file hit its 4 GiB limit
+    };
+
+    /// <summary>
+    /// Multitrack recorder fed by the process callback. The audio thread copies each
+    /// track's block into that track's preallocated sample ring (no allocation, no locks,
+    /// no I/O); a block that does not fit in every ring is dropped from all of them and
+    /// counted, so the tracks stay sample-aligned. A writer thread drains the rings in
+    /// chunks of kWriteFrames and writes them behind a header padded to kDataAlignment,
+    /// so every chunk lands on an aligned file offset. File space is reserved
+    /// kExtentSeconds at a time, and the headers are refreshed every second so an
+    /// interrupted recording stays readable.
+    /// </summary>
+    class DiskRecorder
+    {
+    public:
+        // Frames per track and write, and the file offset the sample data starts at
+        static constexpr uint32_t kWriteFrames = 16384;
+        static constexpr uint32_t kDataAlignment = 4096;
+
+        // Audio per file reserved on disk ahead of the writes
+        static constexpr uint32_t kExtentSeconds = 30;
+
+        // Writer poll interval
+        static constexpr int kPollIntervalMs = 10;
+
+        DiskRecorder();
+        ~DiskRecorder();
+
+        DiskRecorder(const DiskRecorder&) = delete;
+        DiskRecorder& operator=(const DiskRecorder&) = delete;
+
+        /// <summary>
+        /// Sets the channel and output counts tracks may refer to; stops any recording
+        /// </summary>
+        void Reserve(int numChannels, int numOutputs);
+
+        /// <summary>
+        /// Sets the sample rate written to the headers of the next recording
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Creates the files and starts recording with the next cycle. Returns false if a
+        /// recording is running or a track is out of range; throws std::runtime_error if a
+        /// file cannot be created.
+        /// </summary>
+        bool Start(const RecordOptions& options);
+
+        /// <summary>
+        /// Stops capturing, writes everything still buffered, finalizes the headers and
+        /// closes the files. Returns false if nothing was recording.
+        /// </summary>
+        bool Stop();
+
+        bool IsRecording() const;
+
+        /// <summary>
+        /// Queues one cycle of every track (audio thread). Tracks whose source is not bound
+        /// this cycle record silence.
+        /// </summary>
+        void Capture(const float* const* channels, int numChannels, const float* const* outputs, int numOutputs,
+                     uint32_t nframes);
+
+        /// <summary>
+        /// Copies the progress of the running recording, or the final figures of the last
+        /// one, reusing the status' storage
+        /// </summary>
+        void GetStatus(RecorderStatus& status) const;
+
+    private:
+        struct Track
+        {
+            TapSource source = TapSource::Channel;
+            int index = 0;
+            SampleRing ring;
+        };
+
+        struct File
+        {
+            std::FILE* handle = nullptr;
+            uint16_t channels = 1;
+            uint64_t dataBytes = 0;
+            uint64_t reservedBytes = 0;     // File size covered by the reserved extents
+        };
+
+        struct Session
+        {
+            std::unique_ptr<Track[]> tracks;
+            int trackCount = 0;
+            std::vector<File> files;
+            RecordFormat format = RecordFormat::Wav;
+            bool polyphonic = false;
+            uint32_t sampleRate = 0;
+            uint64_t maxFrames = 0;         // Frames a file can hold
+
+            std::atomic<bool> capturing{ true };
+            std::atomic<bool> finishing{ false };   // Set once the audio thread has let go
+            std::atomic<uint64_t> capturedFrames{ 0 };
+            std::atomic<uint64_t> droppedBlocks{ 0 };
+            std::atomic<uint64_t> writtenFrames{ 0 };
+            std::atomic<uint64_t> bytesWritten{ 0 };
+            std::atomic<bool> writeFailed{ false };
+            std::atomic<bool> limitReached{ false };
+
+            // Writer state
+            std::vector<float> scratch;
+            std::vector<float> interleaved;
+            uint64_t headerFrames = 0;      // Written frames the headers last described
+        };
+
+        bool StopLocked();
+        void FillStatus(const Session& session, RecorderStatus& status) const;
+
+        static void Run(Session* session);
+        static void Drain(Session& session, bool flush);
+        static void WriteSamples(Session& session, File& file, const float* samples, size_t count);
+        static bool WriteHeader(const Session& session, File& file);
+        static void CloseFiles(Session& session);
+
+        RcuDomain _rcu;
+        RcuPointer<Session> _session;
+        std::thread _writer;
+
+        int _numChannels;
+        int _numOutputs;
+        std::atomic<uint32_t> _sampleRate;
+        RecorderStatus _lastStatus;
+
+        // Serializes control threads; the audio thread and the writer never take it
+        mutable std::mutex _controlMutex;
+    };
+}
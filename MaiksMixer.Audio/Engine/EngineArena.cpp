@@ -0,0 +1,52 @@
+#include "EngineArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "RtMemoryLock.h"
+
+namespace emp {
+
+    // Constructor
+    EngineArena::EngineArena()
+        : _block(nullptr), _capacity(0), _used(0), _pageSize(kAlignment), _locked(false)
+    {
+    }
+
+    // Destructor
+    EngineArena::~EngineArena()
+    {
+        Release();
+    }
+
+    // Reserve
+    void EngineArena::Reserve(size_t bytes)
+    {
+        Release();
+        if (bytes == 0) return;
+
+        // Whole pages of its own, so locking and unlocking the block never touches a page
+        // another allocation shares
+        _pageSize = std::max(RtMemoryLock::GetPageSize(), kAlignment);
+        _capacity = (bytes + _pageSize - 1) / _pageSize * _pageSize;
+        _block = static_cast<unsigned char*>(::operator new(_capacity, std::align_val_t(_pageSize)));
+
+        // Touch every page now so the first cycles don't take page faults
+        std::memset(_block, 0, _capacity);
+        _locked = RtMemoryLock::LockPages(_block, _capacity);
+    }
+
+    // Release
+    void EngineArena::Release()
+    {
+        if (_block != nullptr) {
+            if (_locked) RtMemoryLock::UnlockPages(_block, _capacity);
+            ::operator delete(_block, std::align_val_t(_pageSize));
+        }
+
+        _block = nullptr;
+        _capacity = 0;
+        _used = 0;
+        _locked = false;
+    }
+}
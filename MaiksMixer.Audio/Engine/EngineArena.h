@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace emp {
+
+    /// <summary>
+    /// Bump allocator backing every per-cycle structure of the engine. The block is sized
+    /// and allocated up front (when ports are created or the client is activated); the
+    /// process path only uses memory carved from it and never touches the heap. Blocks are
+    /// whole pages, prefaulted and, where the process is allowed to, locked in memory until
+    /// they are released.
+    /// </summary>
+    class EngineArena
+    {
+    public:
+        static constexpr size_t kAlignment = 64;
+
+        EngineArena();
+        ~EngineArena();
+
+        EngineArena(const EngineArena&) = delete;
+        EngineArena& operator=(const EngineArena&) = delete;
+
+        /// <summary>
+        /// Releases the current block and allocates a new zeroed, prefaulted and (best
+        /// effort) page-locked block of at least the given size, rounded up to whole pages. Must not be called while
+        /// the process callback may be running.
+        /// </summary>
+        void Reserve(size_t bytes);
+
+        /// <summary>
+        /// Unlocks and releases the block
+        /// </summary>
+        void Release();
+
+        /// <summary>
+        /// Carves a zeroed, cache-line aligned array of count elements from the block.
+        /// Throws std::bad_alloc if the block is exhausted.
+        /// </summary>
+        template <typename T>
+        T* Allocate(size_t count)
+        {
+            size_t bytes = SizeFor<T>(count);
+            if (_used + bytes > _capacity) throw std::bad_alloc();
+
+            T* result = reinterpret_cast<T*>(_block + _used);
+            _used += bytes;
+            return result;
+        }
+
+        /// <summary>
+        /// Bytes an Allocate&lt;T&gt;(count) call consumes, for sizing Reserve()
+        /// </summary>
+        template <typename T>
+        static constexpr size_t SizeFor(size_t count)
+        {
+            return (sizeof(T) * count + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+        size_t GetCapacity() const { return _capacity; }
+        size_t GetUsed() const { return _used; }
+
+        /// <summary>
+        /// True if the block's pages are locked in memory
+        /// </summary>
+        bool IsLocked() const { return _locked; }
+
+    private:
+        unsigned char* _block;
+        size_t _capacity;
+        size_t _used;
+        size_t _pageSize;
+        bool _locked;
+    };
+}
@@ -0,0 +1,66 @@
+#include "EngineCommandQueue.h"
+
+namespace emp {
+
+    // Constructor
+    EngineCommandQueue::EngineCommandQueue()
+        : _nextId(0), _completionWrite(0), _completionRead(0), _droppedCompletions(0)
+    {
+    }
+
+    // Read Completions
+    int EngineCommandQueue::ReadCompletions(EngineCompletion* completions, int capacity)
+    {
+        std::lock_guard<std::mutex> lock(_completionMutex);
+
+        uint64_t read = _completionRead.load(std::memory_order_relaxed);
+        int count = 0;
+        while (count < capacity) {
+            const uint64_t write = _completionWrite.load(std::memory_order_acquire);
+            if (read == write) break;
+
+            // The audio thread lapped the reader: the oldest unread ones are gone
+            if (write - read > kCapacity) read = write - kCapacity;
+
+            const CompletionSlot& slot = _completions[read & (kCapacity - 1)];
+            // Acquire on the fields: seeing any of a newer write also shows its odd sequence
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            EngineCompletion completion;
+            completion.id = slot.id.load(std::memory_order_acquire);
+            completion.status = static_cast<EngineCommandStatus>(slot.status.load(std::memory_order_acquire));
+            completion.cycle = slot.cycle.load(std::memory_order_acquire);
+            const uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+            // Overwritten while being copied: that one is lost as well
+            if (before == 2 * read + 2 && after == before) completions[count++] = completion;
+            _completionRead.store(++read, std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    // Push Completion
+    void EngineCommandQueue::PushCompletion(const EngineCompletion& completion)
+    {
+        const uint64_t write = _completionWrite.load(std::memory_order_relaxed);
+        if (write - _completionRead.load(std::memory_order_relaxed) >= kCapacity) {
+            _droppedCompletions.store(_droppedCompletions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        CompletionSlot& slot = _completions[write & (kCapacity - 1)];
+        slot.sequence.store(2 * write + 1, std::memory_order_relaxed);
+        slot.id.store(completion.id, std::memory_order_release);
+        slot.status.store(static_cast<int32_t>(completion.status), std::memory_order_release);
+        slot.cycle.store(completion.cycle, std::memory_order_release);
+        slot.sequence.store(2 * write + 2, std::memory_order_release);
+
+        _completionWrite.store(write + 1, std::memory_order_release);
+    }
+
+    uint32_t EngineCommandQueue::NextIdLocked()
+    {
+        // 0 is reserved for "not queued"
+        if (++_nextId == 0) _nextId = 1;
+        return _nextId;
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "MixScene.h"
+#include "ParameterRamp.h"
+#include "ParameterState.h"
+#include "SpscRing.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Command executed by the process callback
+    /// </summary>
+    enum class EngineCommandType : uint32_t
+    {
+        SetParameter,       // Applies parameter to the live channel parameters
+        ScheduleParameter,  // Queues timed for the frame it is stamped with
+        RecallScene,        // Swaps in the scene published for recall, optionally crossfading
+        Barrier             // No effect; completes once every earlier command has run
+    };
+
+    /// <summary>
+    /// Fixed-size command record
+    /// </summary>
+    struct EngineCommand
+    {
+        uint32_t id;                // Assigned by Post(), never 0
+        EngineCommandType type;
+        ParameterChange parameter;  // SetParameter only
+        TimedParameterChange timed; // ScheduleParameter only
+        SceneRecall recall;         // RecallScene only
+        bool unacknowledged;        // Executed without an acknowledgement (posters that never read them)
+    };
+
+    /// <summary>
+    /// Result of an executed command (matches the managed CommandStatus)
+    /// </summary>
+    enum class EngineCommandStatus : int32_t
+    {
+        Applied = 0,
+        Rejected = -1
+    };
+
+    /// <summary>
+    /// Acknowledgement sent back by the process callback (matches the managed
+    /// CommandCompletion value struct)
+    /// </summary>
+    struct EngineCompletion
+    {
+        uint32_t id;
+        EngineCommandStatus status;
+        uint64_t cycle;             // Process cycle the command took effect in
+    };
+
+    /// <summary>
+    /// Command path from control/IPC threads to the process callback. Commands travel on
+    /// a wait-free SPSC ring; the process callback drains a bounded number per cycle and
+    /// acknowledges each one on a second ring. Producers and completion readers are
+    /// serialized with mutexes on their own side, so the audio thread never blocks or
+    /// allocates however much traffic arrives. Reading acknowledgements is optional: once
+    /// kCapacity are unread the newest overwrite the oldest, so whether a command runs
+    /// never depends on the reader.
+    /// </summary>
+    class EngineCommandQueue
+    {
+    public:
+        static constexpr size_t kCapacity = 1024;
+
+        // Commands executed per process cycle at most
+        static constexpr int kMaxCommandsPerCycle = 64;
+
+        EngineCommandQueue();
+
+        /// <summary>
+        /// Queues a command and returns its id, or 0 if the queue is full. prepare() runs
+        /// under the producer lock once space is guaranteed, just before the push;
+        /// returning false cancels the command.
+        /// </summary>
+        template <typename Prepare>
+        uint32_t Post(EngineCommand command, Prepare&& prepare)
+        {
+            std::lock_guard<std::mutex> lock(_producerMutex);
+            if (_commands.GetFreeCount() == 0) return 0;
+
+            if (!prepare()) return 0;
+            command.id = NextIdLocked();
+
+            _commands.TryPush(command);
+            return command.id;
+        }
+
+        /// <summary>
+        /// Queues a command and returns its id, or 0 if the queue is full
+        /// </summary>
+        uint32_t Post(const EngineCommand& command)
+        {
+            return Post(command, [] { return true; });
+        }
+
+        /// <summary>
+        /// Number of commands queued (audio thread). Taking the count synchronizes with
+        /// every producer that queued them.
+        /// </summary>
+        int GetPendingCount() const
+        {
+            return static_cast<int>(_commands.GetPendingCount());
+        }
+
+        /// <summary>
+        /// Executes up to limit (at most kMaxCommandsPerCycle) queued commands through
+        /// execute(command), which returns the status to acknowledge. (Audio thread)
+        /// </summary>
+        template <typename Execute>
+        int Drain(uint64_t cycle, int limit, Execute&& execute)
+        {
+            limit = limit < kMaxCommandsPerCycle ? limit : kMaxCommandsPerCycle;
+
+            int executed = 0;
+            while (executed < limit) {
+                const EngineCommand* command = _commands.Peek();
+                if (command == nullptr) break;
+
+                const EngineCommandStatus status = execute(*command);
+                if (!command->unacknowledged) PushCompletion(EngineCompletion{ command->id, status, cycle });
+                _commands.Pop();
+                executed++;
+            }
+
+            return executed;
+        }
+
+        /// <summary>
+        /// Copies up to capacity acknowledgements, oldest first, and returns the number
+        /// copied. Acknowledgements overwritten before they were read are skipped.
+        /// </summary>
+        int ReadCompletions(EngineCompletion* completions, int capacity);
+
+        /// <summary>
+        /// Acknowledgements overwritten unread since the queue was created. One copied in the
+        /// instant it was overwritten may be counted as well, so this never undercounts.
+        /// </summary>
+        uint64_t GetDroppedCompletions() const
+        {
+            return _droppedCompletions.load(std::memory_order_relaxed);
+        }
+
+    private:
+        /// <summary>
+        /// One acknowledgement, written field by field under a sequence number (2 * index + 2
+        /// once complete, odd while being written) so readers detect an overwrite
+        /// </summary>
+        struct CompletionSlot
+        {
+            std::atomic<uint64_t> sequence{ 0 };
+            std::atomic<uint32_t> id{ 0 };
+            std::atomic<int32_t> status{ 0 };
+            std::atomic<uint64_t> cycle{ 0 };
+        };
+
+        uint32_t NextIdLocked();
+
+        // Audio thread only; overwrites the oldest acknowledgement once the ring is full
+        void PushCompletion(const EngineCompletion& completion);
+
+        SpscRing<EngineCommand, kCapacity> _commands;
+        uint32_t _nextId;
+
+        CompletionSlot _completions[kCapacity];
+        std::atomic<uint64_t> _completionWrite;     // Written by the audio thread
+        std::atomic<uint64_t> _completionRead;      // Written by readers under _completionMutex
+        std::atomic<uint64_t> _droppedCompletions;  // Written by the audio thread
+
+        std::mutex _producerMutex;
+        std::mutex _completionMutex;
+    };
+}
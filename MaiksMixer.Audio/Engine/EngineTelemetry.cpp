@@ -0,0 +1,147 @@
+#include "EngineTelemetry.h"
+
+#include <chrono>
+
+namespace emp {
+
+    namespace {
+        // Single-writer update: a plain load and store, no locked read-modify-write
+        void Increment(std::atomic<uint64_t>& counter, uint64_t amount = 1)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+    }
+
+    // Constructor
+    EngineTelemetry::EngineTelemetry()
+        : _mixedChannels(0), _idleChannels(0), _insertChannels(0), _bypassedInserts(0), _droppedCompletions(0), _sampleRate(0), _arenasLocked(false), _resetRequested(false), _xrunCount(0)
+    {
+        ClearCycleCounters();
+    }
+
+    // Set Sample Rate
+    void EngineTelemetry::SetSampleRate(uint32_t sampleRate)
+    {
+        _sampleRate.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    // Set Arenas Locked
+    void EngineTelemetry::SetArenasLocked(bool locked)
+    {
+        _arenasLocked.store(locked, std::memory_order_relaxed);
+    }
+
+    // Record Cycle (real-time thread)
+    void EngineTelemetry::RecordCycle(uint64_t durationNs, uint32_t nframes)
+    {
+        if (_resetRequested.load(std::memory_order_relaxed) && _resetRequested.exchange(false, std::memory_order_acquire)) {
+            ClearCycleCounters();
+        }
+
+        const uint32_t sampleRate = _sampleRate.load(std::memory_order_relaxed);
+        const uint64_t budgetNs = sampleRate > 0 ? static_cast<uint64_t>(nframes) * 1000000000ull / sampleRate : 0;
+
+        Increment(_cycles);
+        Increment(_frames, nframes);
+        Increment(_totalNs, durationNs);
+        Increment(_histogram[BucketFor(durationNs)]);
+        _lastNs.store(durationNs, std::memory_order_relaxed);
+
+        if (durationNs > _worstNs.load(std::memory_order_relaxed)) {
+            _worstNs.store(durationNs, std::memory_order_relaxed);
+            _worstBudgetNs.store(budgetNs, std::memory_order_relaxed);
+        }
+        if (budgetNs > 0 && durationNs > budgetNs) Increment(_overBudgetCycles);
+    }
+
+    // Record Xrun (notification thread)
+    void EngineTelemetry::RecordXrun(float delayedUs)
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const XrunEvent event{
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count()),
+            delayedUs,
+            _cycles.load(std::memory_order_relaxed) };
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _xrunCount.fetch_add(1, std::memory_order_relaxed);
+        _recentXruns.push_back(event);
+        if (_recentXruns.size() > kMaxRecentXruns) _recentXruns.pop_front();
+    }
+
+    // Set Latency Source
+    void EngineTelemetry::SetLatencySource(std::function<void(std::vector<PortLatencyRange>&)> source)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _latencySource = std::move(source);
+    }
+
+    // Get Snapshot
+    void EngineTelemetry::GetSnapshot(TelemetrySnapshot& snapshot)
+    {
+        snapshot.cycles = _cycles.load(std::memory_order_relaxed);
+        snapshot.frames = _frames.load(std::memory_order_relaxed);
+        snapshot.totalNs = _totalNs.load(std::memory_order_relaxed);
+        snapshot.lastNs = _lastNs.load(std::memory_order_relaxed);
+        snapshot.worstNs = _worstNs.load(std::memory_order_relaxed);
+        snapshot.worstBudgetNs = _worstBudgetNs.load(std::memory_order_relaxed);
+        snapshot.overBudgetCycles = _overBudgetCycles.load(std::memory_order_relaxed);
+        for (int i = 0; i < TelemetrySnapshot::kHistogramBuckets; i++) {
+            snapshot.histogram[i] = _histogram[i].load(std::memory_order_relaxed);
+        }
+        snapshot.sampleRate = _sampleRate.load(std::memory_order_relaxed);
+        snapshot.arenasLocked = _arenasLocked.load(std::memory_order_relaxed);
+        snapshot.mixedChannels = _mixedChannels.load(std::memory_order_relaxed);
+        snapshot.idleChannels = _idleChannels.load(std::memory_order_relaxed);
+        snapshot.insertChannels = _insertChannels.load(std::memory_order_relaxed);
+        snapshot.bypassedInserts = _bypassedInserts.load(std::memory_order_relaxed);
+        snapshot.droppedCompletions = _droppedCompletions.load(std::memory_order_relaxed);
+
+        std::function<void(std::vector<PortLatencyRange>&)> source;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            snapshot.xrunCount = _xrunCount.load(std::memory_order_relaxed);
+            snapshot.recentXruns.assign(_recentXruns.begin(), _recentXruns.end());
+            source = _latencySource;
+        }
+
+        snapshot.portLatencies.clear();
+        if (source) source(snapshot.portLatencies);
+    }
+
+    // Reset
+    void EngineTelemetry::Reset()
+    {
+        _resetRequested.store(true, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _xrunCount.store(0, std::memory_order_relaxed);
+        _recentXruns.clear();
+    }
+
+    // Bucket For
+    int EngineTelemetry::BucketFor(uint64_t durationNs)
+    {
+        int bucket = 0;
+        while (durationNs >= 2 && bucket < TelemetrySnapshot::kHistogramBuckets - 1) {
+            durationNs >>= 1;
+            bucket++;
+        }
+
+        return bucket;
+    }
+
+    void EngineTelemetry::ClearCycleCounters()
+    {
+        _cycles.store(0, std::memory_order_relaxed);
+        _frames.store(0, std::memory_order_relaxed);
+        _totalNs.store(0, std::memory_order_relaxed);
+        _lastNs.store(0, std::memory_order_relaxed);
+        _worstNs.store(0, std::memory_order_relaxed);
+        _worstBudgetNs.store(0, std::memory_order_relaxed);
+        _overBudgetCycles.store(0, std::memory_order_relaxed);
+        for (auto& bucket : _histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// One xrun reported by the server
+    /// </summary>
+    struct XrunEvent
+    {
+        uint64_t timestampUs;   // Wall clock, microseconds since the Unix epoch
+        float delayedUs;        // Lateness reported by the server (0 if unknown)
+        uint64_t cycle;         // Engine cycles processed when the xrun was reported
+    };
+
+    /// <summary>
+    /// Latency range of one of the client's ports, in frames
+    /// </summary>
+    struct PortLatencyRange
+    {
+        std::string portName;
+        uint32_t captureMin;
+        uint32_t captureMax;
+        uint32_t playbackMin;
+        uint32_t playbackMax;
+    };
+
+    /// <summary>
+    /// Point-in-time copy of the engine telemetry
+    /// </summary>
+    struct TelemetrySnapshot
+    {
+        // Bucket i counts cycles that took [2^i, 2^(i+1)) ns; the last bucket is open-ended
+        static constexpr int kHistogramBuckets = 32;
+
+        uint64_t cycles = 0;
+        uint64_t frames = 0;
+        uint64_t totalNs = 0;
+        uint64_t lastNs = 0;
+        uint64_t worstNs = 0;
+        uint64_t worstBudgetNs = 0;     // Real-time budget of the worst cycle
+        uint64_t overBudgetCycles = 0;  // Cycles that took longer than their period
+        uint64_t histogram[kHistogramBuckets] = {};
+        uint32_t sampleRate = 0;
+        bool arenasLocked = false;      // Per-cycle arenas locked in RAM (everything after LockMemory(true))
+        uint32_t mixedChannels = 0;     // Channels mixed in the last cycle
+        uint32_t idleChannels = 0;      // Audible channels skipped as silent in the last cycle
+        uint32_t insertChannels = 0;    // Channels whose insert chains ran in the last cycle
+        uint32_t bypassedInserts = 0;   // Channels whose insert chains are bypassed
+        uint64_t droppedCompletions = 0;    // Command acknowledgements overwritten before anyone read them
+
+        uint64_t xrunCount = 0;
+        std::vector<XrunEvent> recentXruns;     // Oldest first
+        std::vector<PortLatencyRange> portLatencies;
+    };
+
+    /// <summary>
+    /// Real-time performance counters of the engine. The process callback records the
+    /// duration of every cycle into a log-bucketed histogram with plain relaxed atomics
+    /// (single writer, no locks or read-modify-write on the audio thread); xruns arrive
+    /// from the server's notification thread and port latencies are queried when a
+    /// snapshot is taken.
+    /// </summary>
+    class EngineTelemetry
+    {
+    public:
+        // Xruns kept with their timestamps; the counter keeps counting past this
+        static constexpr size_t kMaxRecentXruns = 64;
+
+        EngineTelemetry();
+
+        /// <summary>
+        /// Sets the sample rate used to derive each cycle's real-time budget
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Records whether the engine's arenas (or the whole process) could be locked in RAM
+        /// </summary>
+        void SetArenasLocked(bool locked);
+
+        /// <summary>
+        /// Records one process cycle. Real-time safe; audio thread only.
+        /// </summary>
+        void RecordCycle(uint64_t durationNs, uint32_t nframes);
+
+        /// <summary>
+        /// Records how many channels the last cycle mixed and skipped as silent. Real-time
+        /// safe; audio thread only.
+        /// </summary>
+        void RecordChannelActivity(uint32_t mixedChannels, uint32_t idleChannels)
+        {
+            _mixedChannels.store(mixedChannels, std::memory_order_relaxed);
+            _idleChannels.store(idleChannels, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Records how many channels ran their insert chains in the last cycle and how many
+        /// have them bypassed. Real-time safe; audio thread only.
+        /// </summary>
+        void RecordInsertActivity(uint32_t insertChannels, uint32_t bypassedInserts)
+        {
+            _insertChannels.store(insertChannels, std::memory_order_relaxed);
+            _bypassedInserts.store(bypassedInserts, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Records the command acknowledgements lost so far. Real-time safe; audio thread only.
+        /// </summary>
+        void RecordDroppedCompletions(uint64_t droppedCompletions)
+        {
+            _droppedCompletions.store(droppedCompletions, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Records an xrun (server notification thread)
+        /// </summary>
+        void RecordXrun(float delayedUs);
+
+        /// <summary>
+        /// Sets the function that reports the client's port latency ranges; it is called
+        /// by GetSnapshot() outside any lock
+        /// </summary>
+        void SetLatencySource(std::function<void(std::vector<PortLatencyRange>&)> source);
+
+        /// <summary>
+        /// Copies the counters. Cycle counters are read individually, so a snapshot taken
+        /// while the engine runs may mix values from adjacent cycles.
+        /// </summary>
+        void GetSnapshot(TelemetrySnapshot& snapshot);
+
+        /// <summary>
+        /// Clears the cycle statistics and xrun history. The cycle counters are cleared by
+        /// the audio thread at the start of its next recorded cycle.
+        /// </summary>
+        void Reset();
+
+        /// <summary>
+        /// Histogram bucket a cycle duration falls into
+        /// </summary>
+        static int BucketFor(uint64_t durationNs);
+
+    private:
+        void ClearCycleCounters();
+
+        // Written by the audio thread only
+        std::atomic<uint64_t> _cycles;
+        std::atomic<uint64_t> _frames;
+        std::atomic<uint64_t> _totalNs;
+        std::atomic<uint64_t> _lastNs;
+        std::atomic<uint64_t> _worstNs;
+        std::atomic<uint64_t> _worstBudgetNs;
+        std::atomic<uint64_t> _overBudgetCycles;
+        std::atomic<uint64_t> _histogram[TelemetrySnapshot::kHistogramBuckets];
+        std::atomic<uint32_t> _mixedChannels;
+        std::atomic<uint32_t> _idleChannels;
+        std::atomic<uint32_t> _insertChannels;
+        std::atomic<uint32_t> _bypassedInserts;
+        std::atomic<uint64_t> _droppedCompletions;
+
+        std::atomic<uint32_t> _sampleRate;
+        std::atomic<bool> _arenasLocked;
+        std::atomic<bool> _resetRequested;
+
+        std::atomic<uint64_t> _xrunCount;
+        std::deque<XrunEvent> _recentXruns;
+        std::function<void(std::vector<PortLatencyRange>&)> _latencySource;
+
+        // Guards the xrun history and latency source; never taken by the audio thread
+        std::mutex _mutex;
+    };
+}
@@ -0,0 +1,293 @@
+#include "JackEngineClient.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace emp {
+
+    // Constructor
+    JackEngineClient::JackEngineClient(MixEngine& engine)
+        : _engine(engine), _client(nullptr), _active(false), _serverRunning(false), _stopMeters(false)
+    {
+    }
+
+    // Destructor
+    JackEngineClient::~JackEngineClient()
+    {
+        Close();
+    }
+
+    // Open
+    bool JackEngineClient::Open(const std::string& clientName)
+    {
+        if (_client != nullptr) return true;
+
+        jack_status_t status;
+        jack_client_t* client = jack_client_open(clientName.c_str(), JackNoStartServer, &status);
+        if (client == nullptr) return false;
+
+        if (jack_set_process_callback(client, ProcessCallback, this) != 0) {
+            jack_client_close(client);
+            return false;
+        }
+        jack_on_info_shutdown(client, ShutdownCallback, this);
+
+        // JACK only accepts notification callbacks before activation, and the listeners
+        // must live as long as the client
+        auto serverListener = std::make_unique<JackServerListener>(client, _engine);
+        auto graphListener = std::make_unique<JackPortGraphListener>(client, _engine.PortGraph());
+        auto telemetryListener = std::make_unique<JackTelemetryListener>(client, _engine.Telemetry());
+        if (!serverListener->Attach() || !graphListener->Attach() || !telemetryListener->Attach()) {
+            DetachListeners();
+            jack_client_close(client);
+            return false;
+        }
+
+        _client = client;
+        _ports = std::make_unique<JackPortSet>(_client, _engine);
+
+        // MixEngine::ResizePorts() registers and unregisters this client's ports from now on
+        _ports->Attach();
+
+        _serverListener = std::move(serverListener);
+        _graphListener = std::move(graphListener);
+        _telemetryListener = std::move(telemetryListener);
+        _serverRunning.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // Close
+    void JackEngineClient::Close()
+    {
+        if (_client == nullptr) return;
+
+        Deactivate();
+        DetachListeners();
+        jack_client_close(_client);
+
+        _client = nullptr;
+        _ports.reset();
+        _serverListener.reset();
+        _graphListener.reset();
+        _telemetryListener.reset();
+        _serverRunning.store(false, std::memory_order_release);
+    }
+
+    // Create Ports
+    bool JackEngineClient::CreatePorts(int numInputs, int numOutputs)
+    {
+        if (_client == nullptr || _active) return false;
+
+        // Size the engine before the ports exist so the process callback never sees a port
+        // without matching parameter and meter storage; leave headroom for ports added later
+        _engine.ConfigurePorts(numInputs, numOutputs,
+                               std::max(numInputs, MixEngine::kDefaultInputCapacity),
+                               std::max(numOutputs, MixEngine::kDefaultOutputCapacity));
+        return _ports->Resize(numInputs, numOutputs);
+    }
+
+    // Activate
+    bool JackEngineClient::Activate()
+    {
+        if (_client == nullptr) return false;
+        if (_active) return true;
+
+        // Build the per-cycle layout for the server's period and rate before the first cycle
+        _engine.SetSampleRate(jack_get_sample_rate(_client));
+        _engine.Prepare(jack_get_buffer_size(_client));
+
+        if (jack_activate(_client) != 0) return false;
+
+        // Notifications only reach active clients: pick up what changed since Open(),
+        // including this client's own ports
+        _graphListener->Resync();
+
+        _active = true;
+        StartMeterThread();
+        return true;
+    }
+
+    // Deactivate
+    bool JackEngineClient::Deactivate()
+    {
+        if (_client == nullptr) return false;
+        if (!_active) return true;
+
+        if (jack_deactivate(_client) != 0) return false;
+
+        StopMeterThread();
+        _active = false;
+        return true;
+    }
+
+    // Get Sample Rate
+    uint32_t JackEngineClient::GetSampleRate() const
+    {
+        return _client != nullptr ? jack_get_sample_rate(_client) : 0;
+    }
+
+    // Get Buffer Size
+    uint32_t JackEngineClient::GetBufferSize() const
+    {
+        return _client != nullptr ? jack_get_buffer_size(_client) : 0;
+    }
+
+    // Get CPU Load
+    float JackEngineClient::GetCpuLoad() const
+    {
+        return _client != nullptr ? jack_cpu_load(_client) : 0.0f;
+    }
+
+    // Connect Ports
+    bool JackEngineClient::ConnectPorts(const std::string& source, const std::string& destination)
+    {
+        if (_client == nullptr) return false;
+
+        // An existing connection counts as success (EEXIST)
+        const int result = jack_connect(_client, source.c_str(), destination.c_str());
+        return result == 0 || result == EEXIST;
+    }
+
+    // Disconnect Ports
+    bool JackEngineClient::DisconnectPorts(const std::string& source, const std::string& destination)
+    {
+        if (_client == nullptr) return false;
+        return jack_disconnect(_client, source.c_str(), destination.c_str()) == 0;
+    }
+
+    // Get Port List
+    std::vector<std::string> JackEngineClient::GetPortList(const std::string& typePattern, unsigned long flags)
+    {
+        std::vector<std::string> result;
+        if (_client == nullptr) return result;
+
+        const char** names = jack_get_ports(_client, nullptr, typePattern.empty() ? nullptr : typePattern.c_str(), flags);
+        if (names == nullptr) return result;
+
+        for (size_t i = 0; names[i] != nullptr; i++) {
+            result.emplace_back(names[i]);
+        }
+        jack_free(names);
+        return result;
+    }
+
+    // Query Ports
+    std::vector<PortGraphPort> JackEngineClient::QueryPorts()
+    {
+        std::vector<PortGraphPort> ports;
+        if (_client == nullptr) return ports;
+
+        const char** names = jack_get_ports(_client, nullptr, nullptr, 0);
+        if (names == nullptr) return ports;
+
+        for (size_t i = 0; names[i] != nullptr; i++) {
+            jack_port_t* port = jack_port_by_name(_client, names[i]);
+            if (port == nullptr) continue;
+
+            PortGraphPort entry{ names[i], jack_port_type(port), static_cast<uint32_t>(jack_port_flags(port)), {} };
+
+            const char** connections = jack_port_get_all_connections(_client, port);
+            if (connections != nullptr) {
+                for (size_t c = 0; connections[c] != nullptr; c++) {
+                    entry.connections.emplace_back(connections[c]);
+                }
+                jack_free(connections);
+            }
+
+            ports.push_back(std::move(entry));
+        }
+        jack_free(names);
+        return ports;
+    }
+
+    // Set Shutdown Handler
+    void JackEngineClient::SetShutdownHandler(std::function<void()> handler)
+    {
+        std::lock_guard<std::mutex> lock(_handlerMutex);
+        _shutdownHandler = std::move(handler);
+    }
+
+    // Set Meter Handler
+    void JackEngineClient::SetMeterHandler(std::function<void(int channel, const ChannelMeterFrame& meter)> handler)
+    {
+        std::lock_guard<std::mutex> lock(_handlerMutex);
+        _meterHandler = std::move(handler);
+    }
+
+    // The engine outlives the client: drop the hooks that call back into the port set and
+    // the listeners
+    void JackEngineClient::DetachListeners()
+    {
+        _engine.SetPortRegistrar(nullptr);
+        _engine.PortGraph().SetResyncSource(nullptr);
+        _engine.Telemetry().SetLatencySource(nullptr);
+    }
+
+    void JackEngineClient::StartMeterThread()
+    {
+        _stopMeters = false;
+        _meterThread = std::thread(&JackEngineClient::MeterLoop, this);
+    }
+
+    void JackEngineClient::StopMeterThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_meterMutex);
+            _stopMeters = true;
+        }
+        _meterWake.notify_all();
+        if (_meterThread.joinable()) _meterThread.join();
+    }
+
+    // Hands every meter publish to the meter handler (meter thread)
+    void JackEngineClient::MeterLoop()
+    {
+        std::vector<float> values(static_cast<size_t>(_engine.GetInputCapacity()) * MeterBank::kValuesPerChannel);
+        uint64_t lastSequence = 0;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(_meterMutex);
+                if (_meterWake.wait_for(lock, kMeterPollInterval, [this] { return _stopMeters; })) return;
+            }
+
+            std::function<void(int, const ChannelMeterFrame&)> handler;
+            {
+                std::lock_guard<std::mutex> lock(_handlerMutex);
+                handler = _meterHandler;
+            }
+            if (!handler) continue;
+
+            uint64_t sequence = 0;
+            const int count = _engine.Meters().CopyTo(values.data(), static_cast<int>(values.size()), &sequence);
+            if (sequence == lastSequence) continue;
+            lastSequence = sequence;
+
+            for (int i = 0; i < count; i++) {
+                const float* meter = values.data() + static_cast<size_t>(i) * MeterBank::kValuesPerChannel;
+                handler(i, ChannelMeterFrame{ meter[0], meter[1], meter[2], static_cast<uint32_t>(meter[3]) });
+            }
+        }
+    }
+
+    // Process (real-time thread)
+    int JackEngineClient::ProcessCallback(jack_nframes_t nframes, void* arg)
+    {
+        static_cast<JackEngineClient*>(arg)->_ports->Process(nframes);
+        return 0;
+    }
+
+    // Server shutdown (JACK thread); the client handle stays valid until Close()
+    void JackEngineClient::ShutdownCallback(jack_status_t, const char*, void* arg)
+    {
+        auto client = static_cast<JackEngineClient*>(arg);
+        client->_serverRunning.store(false, std::memory_order_release);
+
+        std::function<void()> handler;
+        {
+            std::lock_guard<std::mutex> lock(client->_handlerMutex);
+            handler = client->_shutdownHandler;
+        }
+        if (handler) handler();
+    }
+}
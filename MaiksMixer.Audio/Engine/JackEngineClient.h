@@ -0,0 +1,139 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JackPortGraphListener.h"
+#include "JackPortSet.h"
+#include "JackServerListener.h"
+#include "JackTelemetryListener.h"
+#include "MixEngine.h"
+#include "PortGraphCache.h"
+
+namespace emp {
+
+    /// <summary>
+    /// The mixer's JACK client: opens the client, owns its audio ports (JackPortSet) and
+    /// the listeners that keep the engine's port graph and telemetry current, and renders
+    /// the engine from the process callback. The managed bridge and the flat C
+    /// library both drive the engine through it. The engine must outlive the client.
+    /// </summary>
+    class JackEngineClient
+    {
+    public:
+        // How often the meter thread looks for newly published meters
+        static constexpr std::chrono::milliseconds kMeterPollInterval{ 10 };
+
+        explicit JackEngineClient(MixEngine& engine);
+        ~JackEngineClient();
+
+        JackEngineClient(const JackEngineClient&) = delete;
+        JackEngineClient& operator=(const JackEngineClient&) = delete;
+
+        /// <summary>
+        /// Opens the client (without starting a server), registers the process callback and
+        /// attaches the notification listeners. Returns true if the client is open,
+        /// including when it already was.
+        /// </summary>
+        bool Open(const std::string& clientName);
+
+        /// <summary>
+        /// Deactivates and closes the client; its ports go with it
+        /// </summary>
+        void Close();
+
+        bool IsOpen() const { return _client != nullptr; }
+
+        /// <summary>
+        /// Sizes the engine for the port counts (with headroom for ports added later) and
+        /// registers the ports. Must be called before Activate().
+        /// </summary>
+        bool CreatePorts(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Builds the engine's layout for the server's period and rate and starts the
+        /// process callback
+        /// </summary>
+        bool Activate();
+
+        bool Deactivate();
+
+        bool IsActive() const { return _active; }
+
+        /// <summary>
+        /// False before Open() and once the server has shut the client down
+        /// </summary>
+        bool IsServerRunning() const { return _serverRunning.load(std::memory_order_acquire); }
+
+        uint32_t GetSampleRate() const;
+        uint32_t GetBufferSize() const;
+
+        /// <summary>
+        /// DSP load of the server in percent
+        /// </summary>
+        float GetCpuLoad() const;
+
+        bool ConnectPorts(const std::string& source, const std::string& destination);
+        bool DisconnectPorts(const std::string& source, const std::string& destination);
+
+        /// <summary>
+        /// Names of the ports whose type matches typePattern (a regular expression, empty
+        /// for any) and that have all of flags
+        /// </summary>
+        std::vector<std::string> GetPortList(const std::string& typePattern, unsigned long flags);
+
+        /// <summary>
+        /// Every port of the graph with its connections, queried from the server
+        /// </summary>
+        std::vector<PortGraphPort> QueryPorts();
+
+        /// <summary>
+        /// Sets the function called (on a JACK thread) when the server shuts the client down
+        /// </summary>
+        void SetShutdownHandler(std::function<void()> handler);
+
+        /// <summary>
+        /// Sets the function called with each channel's meters whenever the engine has
+        /// published new ones while the client is active (on the client's meter thread,
+        /// never the process callback)
+        /// </summary>
+        void SetMeterHandler(std::function<void(int channel, const ChannelMeterFrame& meter)> handler);
+
+    private:
+        static int ProcessCallback(jack_nframes_t nframes, void* arg);
+        static void ShutdownCallback(jack_status_t code, const char* reason, void* arg);
+
+        void DetachListeners();
+
+        void StartMeterThread();
+        void StopMeterThread();
+        void MeterLoop();
+
+        MixEngine& _engine;
+        jack_client_t* _client;
+        std::unique_ptr<JackPortSet> _ports;
+        std::unique_ptr<JackServerListener> _serverListener;
+        std::unique_ptr<JackPortGraphListener> _graphListener;
+        std::unique_ptr<JackTelemetryListener> _telemetryListener;
+        bool _active;
+        std::atomic<bool> _serverRunning;
+
+        std::function<void()> _shutdownHandler;
+        std::function<void(int, const ChannelMeterFrame&)> _meterHandler;
+        std::mutex _handlerMutex;
+
+        std::thread _meterThread;
+        std::mutex _meterMutex;
+        std::condition_variable _meterWake;
+        bool _stopMeters;
+    };
+}
@@ -0,0 +1,141 @@
+#include "JackPortGraphListener.h"
+
+#include <vector>
+
+namespace emp {
+
+    // Constructor
+    JackPortGraphListener::JackPortGraphListener(jack_client_t* client, PortGraphCache& cache)
+        : _client(client), _cache(cache)
+    {
+    }
+
+    // Attach
+    bool JackPortGraphListener::Attach()
+    {
+        if (_client == nullptr) return false;
+
+        if (jack_set_port_registration_callback(_client, PortRegistrationCallback, this) != 0) return false;
+        if (jack_set_port_connect_callback(_client, PortConnectCallback, this) != 0) return false;
+        if (jack_set_port_rename_callback(_client, PortRenameCallback, this) != 0) return false;
+
+        _cache.SetResyncSource([this](PortGraphCache&) { Resync(); });
+        Resync();
+        return true;
+    }
+
+    // Resync
+    void JackPortGraphListener::Resync()
+    {
+        std::vector<PortGraphPort> ports;
+
+        const char** names = jack_get_ports(_client, nullptr, nullptr, 0);
+        if (names != nullptr) {
+            for (size_t i = 0; names[i] != nullptr; i++) {
+                jack_port_t* port = jack_port_by_name(_client, names[i]);
+                if (port == nullptr) continue;
+
+                PortGraphPort entry{ names[i], jack_port_type(port), static_cast<uint32_t>(jack_port_flags(port)), {} };
+
+                const char** connections = jack_port_get_all_connections(_client, port);
+                if (connections != nullptr) {
+                    for (size_t c = 0; connections[c] != nullptr; c++) {
+                        entry.connections.emplace_back(connections[c]);
+                    }
+                    jack_free(connections);
+                }
+
+                ports.push_back(std::move(entry));
+            }
+            jack_free(names);
+        }
+
+        _cache.Reset(ports);
+    }
+
+    void JackPortGraphListener::PortRegistrationCallback(jack_port_id_t port, int registered, void* arg)
+    {
+        static_cast<JackPortGraphListener*>(arg)->OnPortRegistration(port, registered != 0);
+    }
+
+    void JackPortGraphListener::PortConnectCallback(jack_port_id_t a, jack_port_id_t b, int connected, void* arg)
+    {
+        static_cast<JackPortGraphListener*>(arg)->OnPortConnect(a, b, connected != 0);
+    }
+
+    int JackPortGraphListener::PortRenameCallback(jack_port_id_t port, const char* oldName, const char* newName, void* arg)
+    {
+        static_cast<JackPortGraphListener*>(arg)->OnPortRename(port, oldName, newName);
+        return 0;
+    }
+
+    // Port registration notification (JACK notification thread)
+    void JackPortGraphListener::OnPortRegistration(jack_port_id_t id, bool registered)
+    {
+        std::string name;
+        if (!ResolveName(id, name)) {
+            _cache.MarkStale();
+            return;
+        }
+
+        if (registered) {
+            jack_port_t* port = jack_port_by_id(_client, id);
+            if (port == nullptr) {
+                _cache.MarkStale();
+                return;
+            }
+
+            _cache.OnPortRegistered(name, jack_port_type(port), static_cast<uint32_t>(jack_port_flags(port)));
+        }
+        else {
+            {
+                std::lock_guard<std::mutex> lock(_namesMutex);
+                _names.erase(id);
+            }
+            _cache.OnPortUnregistered(name);
+        }
+    }
+
+    // Port connect notification (JACK notification thread)
+    void JackPortGraphListener::OnPortConnect(jack_port_id_t a, jack_port_id_t b, bool connected)
+    {
+        std::string source;
+        std::string destination;
+        if (!ResolveName(a, source) || !ResolveName(b, destination)) {
+            _cache.MarkStale();
+            return;
+        }
+
+        _cache.OnPortsConnected(source, destination, connected);
+    }
+
+    // Port rename notification (JACK notification thread)
+    void JackPortGraphListener::OnPortRename(jack_port_id_t id, const char* oldName, const char* newName)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_namesMutex);
+            _names[id] = newName;
+        }
+        _cache.OnPortRenamed(oldName, newName);
+    }
+
+    // Looks up a port name, remembering it for when the id can no longer be resolved
+    bool JackPortGraphListener::ResolveName(jack_port_id_t id, std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+
+        auto it = _names.find(id);
+        if (it != _names.end()) {
+            name = it->second;
+            return true;
+        }
+
+        jack_port_t* port = jack_port_by_id(_client, id);
+        const char* portName = port != nullptr ? jack_port_name(port) : nullptr;
+        if (portName == nullptr) return false;
+
+        name = portName;
+        _names.emplace(id, name);
+        return true;
+    }
+}
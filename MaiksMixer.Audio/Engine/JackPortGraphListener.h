@@ -0,0 +1,56 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "PortGraphCache.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Keeps a PortGraphCache current from JACK's port registration, connect and rename
+    /// notifications. Created by the JACK client owner right after jack_client_open() and
+    /// attached before jack_activate(); JACK offers no way to remove these callbacks, so
+    /// the listener must live as long as the client.
+    /// </summary>
+    class JackPortGraphListener
+    {
+    public:
+        JackPortGraphListener(jack_client_t* client, PortGraphCache& cache);
+
+        JackPortGraphListener(const JackPortGraphListener&) = delete;
+        JackPortGraphListener& operator=(const JackPortGraphListener&) = delete;
+
+        /// <summary>
+        /// Registers the notification callbacks and seeds the cache with the current graph.
+        /// Must be called before the client is activated.
+        /// </summary>
+        bool Attach();
+
+        /// <summary>
+        /// Re-enumerates every port and connection into the cache
+        /// </summary>
+        void Resync();
+
+    private:
+        static void PortRegistrationCallback(jack_port_id_t port, int registered, void* arg);
+        static void PortConnectCallback(jack_port_id_t a, jack_port_id_t b, int connected, void* arg);
+        static int PortRenameCallback(jack_port_id_t port, const char* oldName, const char* newName, void* arg);
+
+        void OnPortRegistration(jack_port_id_t port, bool registered);
+        void OnPortConnect(jack_port_id_t a, jack_port_id_t b, bool connected);
+        void OnPortRename(jack_port_id_t port, const char* oldName, const char* newName);
+
+        bool ResolveName(jack_port_id_t port, std::string& name);
+
+        jack_client_t* _client;
+        PortGraphCache& _cache;
+
+        // Names by port id; an unregistered port can no longer be looked up by id
+        std::map<jack_port_id_t, std::string> _names;
+        std::mutex _namesMutex;
+    };
+}
@@ -0,0 +1,122 @@
+#include "JackPortSet.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace emp {
+
+    // Constructor
+    JackPortSet::JackPortSet(jack_client_t* client, MixEngine& engine)
+        : _client(client), _engine(engine), _frameClock(0)
+    {
+    }
+
+    // Attach
+    void JackPortSet::Attach()
+    {
+        _engine.SetPortRegistrar([this](int numInputs, int numOutputs) { return Resize(numInputs, numOutputs); });
+    }
+
+    // Resize (control thread)
+    bool JackPortSet::Resize(int numInputs, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_client == nullptr) return false;
+
+        numInputs = std::clamp(numInputs, 0, _engine.GetInputCapacity());
+        numOutputs = std::clamp(numOutputs, 0, _engine.GetOutputCapacity());
+
+        const PortTable* current = _table.Get();
+        auto next = std::make_unique<PortTable>();
+        if (current != nullptr) {
+            next->inputs = current->inputs;
+            next->outputs = current->outputs;
+        }
+
+        const size_t previousInputs = next->inputs.size();
+        const size_t previousOutputs = next->outputs.size();
+
+        // Register the added ports first so a failure leaves everything as it was
+        if (!RegisterPorts(next->inputs, numInputs, true)) {
+            UnregisterPorts(next->inputs, previousInputs);
+            return false;
+        }
+        if (!RegisterPorts(next->outputs, numOutputs, false)) {
+            UnregisterPorts(next->inputs, previousInputs);
+            UnregisterPorts(next->outputs, previousOutputs);
+            return false;
+        }
+
+        // Stop the engine using channels that are going away before their ports do
+        const int keptInputs = std::min(numInputs, static_cast<int>(previousInputs));
+        const int keptOutputs = std::min(numOutputs, static_cast<int>(previousOutputs));
+        if (keptInputs < _engine.GetInputCount() || keptOutputs < _engine.GetOutputCount()) {
+            _engine.SetActivePorts(keptInputs, keptOutputs);
+        }
+
+        std::vector<jack_port_t*> removedInputs(next->inputs.begin() + numInputs, next->inputs.end());
+        std::vector<jack_port_t*> removedOutputs(next->outputs.begin() + numOutputs, next->outputs.end());
+        next->inputs.resize(numInputs);
+        next->outputs.resize(numOutputs);
+        next->inputBuffers.resize(next->inputs.size());
+        next->outputBuffers.resize(next->outputs.size());
+
+        // Returns once no cycle can still read the previous table
+        _table.Publish(std::move(next), _rcu);
+
+        UnregisterPorts(removedInputs, 0);
+        UnregisterPorts(removedOutputs, 0);
+
+        _engine.SetActivePorts(numInputs, numOutputs);
+        return true;
+    }
+
+    // Process (real-time thread)
+    void JackPortSet::Process(jack_nframes_t nframes)
+    {
+        RcuDomain::ReadScope cycleScope(_rcu);
+
+        PortTable* table = _table.Load();
+        if (table == nullptr) return;
+
+        for (size_t i = 0; i < table->inputs.size(); i++) {
+            table->inputBuffers[i] = static_cast<const float*>(jack_port_get_buffer(table->inputs[i], nframes));
+        }
+        for (size_t o = 0; o < table->outputs.size(); o++) {
+            table->outputBuffers[o] = static_cast<float*>(jack_port_get_buffer(table->outputs[o], nframes));
+        }
+
+        // jack_nframes_t wraps after about a day at 48 kHz; the engine's clock must not
+        const jack_nframes_t frameTime = jack_last_frame_time(_client);
+        if (frameTime < static_cast<jack_nframes_t>(_frameClock)) _frameClock += 1ull << 32;
+        _frameClock = (_frameClock & ~0xFFFFFFFFull) | frameTime;
+
+        _engine.Process(table->inputBuffers.data(), static_cast<int>(table->inputBuffers.size()),
+                        table->outputBuffers.data(), static_cast<int>(table->outputBuffers.size()), nframes, _frameClock);
+    }
+
+    // Registers ports until the vector holds count of them
+    bool JackPortSet::RegisterPorts(std::vector<jack_port_t*>& ports, int count, bool input)
+    {
+        while (static_cast<int>(ports.size()) < count) {
+            const std::string name = (input ? "input_" : "output_") + std::to_string(ports.size() + 1);
+            jack_port_t* port = jack_port_register(_client, name.c_str(), JACK_DEFAULT_AUDIO_TYPE,
+                                                   input ? JackPortIsInput : JackPortIsOutput, 0);
+            if (port == nullptr) return false;
+
+            ports.push_back(port);
+        }
+
+        return true;
+    }
+
+    // Unregisters the ports from index from onwards and drops them from the vector
+    void JackPortSet::UnregisterPorts(std::vector<jack_port_t*>& ports, size_t from)
+    {
+        for (size_t i = from; i < ports.size(); i++) {
+            jack_port_unregister(_client, ports[i]);
+        }
+        ports.resize(std::min(from, ports.size()));
+    }
+}
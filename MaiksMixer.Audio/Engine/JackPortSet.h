@@ -0,0 +1,74 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include <mutex>
+#include <vector>
+
+#include "MixEngine.h"
+#include "RcuDomain.h"
+
+namespace emp {
+
+    /// <summary>
+    /// The client's audio ports ("input_N" / "output_N"), registered and unregistered while
+    /// the client is active. The port table the process callback reads is rebuilt on the
+    /// control thread and swapped in between cycles; removed ports are unregistered only
+    /// after the last cycle that could touch them has finished. Created by the JACK client
+    /// owner, whose process callback calls Process() instead of filling the engine itself.
+    /// </summary>
+    class JackPortSet
+    {
+    public:
+        JackPortSet(jack_client_t* client, MixEngine& engine);
+
+        JackPortSet(const JackPortSet&) = delete;
+        JackPortSet& operator=(const JackPortSet&) = delete;
+
+        /// <summary>
+        /// Installs this set as the engine's port registrar, so MixEngine::ResizePorts()
+        /// registers and unregisters ports
+        /// </summary>
+        void Attach();
+
+        /// <summary>
+        /// Registers or unregisters ports until the client has numInputs inputs and
+        /// numOutputs outputs (clamped to the engine's capacity), keeping existing ports and
+        /// their connections. Safe while the client is active. Returns false if a port
+        /// could not be registered; the port set is then unchanged.
+        /// </summary>
+        bool Resize(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Fetches the port buffers and renders the engine at the cycle's frame time
+        /// (process callback)
+        /// </summary>
+        void Process(jack_nframes_t nframes);
+
+    private:
+        struct PortTable
+        {
+            std::vector<jack_port_t*> inputs;
+            std::vector<jack_port_t*> outputs;
+
+            // Buffer pointers of the current cycle, sized with the ports
+            std::vector<const float*> inputBuffers;
+            std::vector<float*> outputBuffers;
+        };
+
+        bool RegisterPorts(std::vector<jack_port_t*>& ports, int count, bool input);
+        void UnregisterPorts(std::vector<jack_port_t*>& ports, size_t from);
+
+        jack_client_t* _client;
+        MixEngine& _engine;
+
+        RcuDomain _rcu;
+        RcuPointer<PortTable> _table;
+
+        // Serializes resizes
+        std::mutex _mutex;
+
+        // Server frame time extended to 64 bits across wraps (audio thread)
+        uint64_t _frameClock;
+    };
+}
@@ -0,0 +1,61 @@
+#include "JackServerListener.h"
+
+#include <exception>
+
+#include "RtMemoryLock.h"
+
+namespace emp {
+
+    // Constructor
+    JackServerListener::JackServerListener(jack_client_t* client, MixEngine& engine)
+        : _client(client), _engine(engine)
+    {
+    }
+
+    // Attach
+    bool JackServerListener::Attach()
+    {
+        if (_client == nullptr) return false;
+
+        if (jack_set_buffer_size_callback(_client, BufferSizeCallback, this) != 0) return false;
+        if (jack_set_sample_rate_callback(_client, SampleRateCallback, this) != 0) return false;
+        if (jack_set_thread_init_callback(_client, ThreadInitCallback, this) != 0) return false;
+
+        return true;
+    }
+
+    // Buffer size change (JACK notification thread)
+    int JackServerListener::BufferSizeCallback(jack_nframes_t nframes, void* arg)
+    {
+        auto listener = static_cast<JackServerListener*>(arg);
+
+        // Cycles that arrive before the swap are rendered in chunks of the old size
+        try {
+            listener->_engine.Prepare(nframes);
+        }
+        catch (const std::exception&) {
+            return 1;
+        }
+        return 0;
+    }
+
+    // Sample rate change (JACK notification thread)
+    int JackServerListener::SampleRateCallback(jack_nframes_t sampleRate, void* arg)
+    {
+        auto listener = static_cast<JackServerListener*>(arg);
+
+        try {
+            listener->_engine.SetSampleRate(sampleRate);
+        }
+        catch (const std::exception&) {
+            return 1;
+        }
+        return 0;
+    }
+
+    // Thread init (every thread JACK creates for the client, before it runs callbacks)
+    void JackServerListener::ThreadInitCallback(void*)
+    {
+        RtMemoryLock::PrefaultStack();
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include "MixEngine.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Follows runtime changes of the server's buffer size (-p) and sample rate (-r): the
+    /// engine's per-cycle layout is rebuilt for the new values on the notification thread
+    /// and swapped in between two cycles. Also prefaults the stack of every thread JACK
+    /// creates for the client. Created by the JACK client owner after jack_client_open()
+    /// and attached before jack_activate(); it must live as long as the client.
+    /// </summary>
+    class JackServerListener
+    {
+    public:
+        JackServerListener(jack_client_t* client, MixEngine& engine);
+
+        JackServerListener(const JackServerListener&) = delete;
+        JackServerListener& operator=(const JackServerListener&) = delete;
+
+        /// <summary>
+        /// Registers the buffer size, sample rate and thread init callbacks. Must be called
+        /// before the client is activated.
+        /// </summary>
+        bool Attach();
+
+    private:
+        static int BufferSizeCallback(jack_nframes_t nframes, void* arg);
+        static int SampleRateCallback(jack_nframes_t sampleRate, void* arg);
+        static void ThreadInitCallback(void* arg);
+
+        jack_client_t* _client;
+        MixEngine& _engine;
+    };
+}
@@ -0,0 +1,49 @@
+#include "JackTelemetryListener.h"
+
+namespace emp {
+
+    // Constructor
+    JackTelemetryListener::JackTelemetryListener(jack_client_t* client, EngineTelemetry& telemetry)
+        : _client(client), _telemetry(telemetry)
+    {
+    }
+
+    // Attach
+    bool JackTelemetryListener::Attach()
+    {
+        if (_client == nullptr) return false;
+
+        if (jack_set_xrun_callback(_client, XrunCallback, this) != 0) return false;
+
+        _telemetry.SetLatencySource([this](std::vector<PortLatencyRange>& latencies) { GetPortLatencies(latencies); });
+        return true;
+    }
+
+    // Get Port Latencies
+    void JackTelemetryListener::GetPortLatencies(std::vector<PortLatencyRange>& latencies)
+    {
+        const char** names = jack_get_ports(_client, nullptr, nullptr, 0);
+        if (names == nullptr) return;
+
+        for (size_t i = 0; names[i] != nullptr; i++) {
+            jack_port_t* port = jack_port_by_name(_client, names[i]);
+            if (port == nullptr || !jack_port_is_mine(_client, port)) continue;
+
+            jack_latency_range_t capture;
+            jack_latency_range_t playback;
+            jack_port_get_latency_range(port, JackCaptureLatency, &capture);
+            jack_port_get_latency_range(port, JackPlaybackLatency, &playback);
+
+            latencies.push_back({ names[i], capture.min, capture.max, playback.min, playback.max });
+        }
+        jack_free(names);
+    }
+
+    // Xrun notification (JACK notification thread)
+    int JackTelemetryListener::XrunCallback(void* arg)
+    {
+        auto listener = static_cast<JackTelemetryListener*>(arg);
+        listener->_telemetry.RecordXrun(jack_get_xrun_delayed_usecs(listener->_client));
+        return 0;
+    }
+}
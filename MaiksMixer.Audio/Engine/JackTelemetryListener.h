@@ -0,0 +1,41 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include <vector>
+
+#include "EngineTelemetry.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Feeds JACK's xrun notifications into EngineTelemetry and reports the latency ranges
+    /// of the client's own ports. Created by the JACK client owner after jack_client_open()
+    /// and attached before jack_activate(); it must live as long as the client.
+    /// </summary>
+    class JackTelemetryListener
+    {
+    public:
+        JackTelemetryListener(jack_client_t* client, EngineTelemetry& telemetry);
+
+        JackTelemetryListener(const JackTelemetryListener&) = delete;
+        JackTelemetryListener& operator=(const JackTelemetryListener&) = delete;
+
+        /// <summary>
+        /// Registers the xrun callback and installs the latency source. Must be called
+        /// before the client is activated.
+        /// </summary>
+        bool Attach();
+
+        /// <summary>
+        /// Queries the capture and playback latency range of every port owned by the client
+        /// </summary>
+        void GetPortLatencies(std::vector<PortLatencyRange>& latencies);
+
+    private:
+        static int XrunCallback(void* arg);
+
+        jack_client_t* _client;
+        EngineTelemetry& _telemetry;
+    };
+}
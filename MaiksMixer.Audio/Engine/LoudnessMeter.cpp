@@ -0,0 +1,188 @@
+#include "LoudnessMeter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    namespace {
+        constexpr double kPi = 3.14159265358979323846;
+
+        // Gating histogram: 0.1 LU bins from the absolute gate up to +5 LUFS
+        constexpr int kGateBinsPerLu = 10;
+        constexpr int kGateBins = 75 * kGateBinsPerLu;
+
+        constexpr int kTruePeakLength = LoudnessMeter::kTruePeakTaps / LoudnessMeter::kOversampling;
+
+        // BS.1770 loudness of a mean square
+        float Loudness(double energy)
+        {
+            if (energy <= 0.0) return LoudnessMeter::kFloorDb;
+            return std::max(static_cast<float>(-0.691 + 10.0 * std::log10(energy)), LoudnessMeter::kFloorDb);
+        }
+    }
+
+    // Constructor
+    LoudnessMeter::LoudnessMeter()
+        : _shelf(), _highPass(), _blockEnergy(), _blockIndex(0), _blockCount(0), _blockFrames(1), _blockPosition(0),
+          _blockSum(0.0), _momentary(kFloorDb), _shortTerm(kFloorDb), _history(), _truePeak(0.0f)
+    {
+        _gateEnergy.assign(kGateBins, 0.0);
+        _gateCount.assign(kGateBins, 0);
+
+        // Windowed-sinc interpolator with its cutoff at the input Nyquist frequency; every
+        // phase is normalized to unity gain at DC
+        _truePeakTaps.resize(kTruePeakTaps);
+        const double center = (kTruePeakTaps - 1) / 2.0;
+        for (int n = 0; n < kTruePeakTaps; n++) {
+            const double t = (n - center) / kOversampling;
+            const double sinc = std::sin(kPi * t) / (kPi * t);
+            const double phase = 2.0 * kPi * n / (kTruePeakTaps - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            // Phase-major: phase p, tap k holds h[p + kOversampling * k]
+            const int p = n % kOversampling;
+            const int k = n / kOversampling;
+            _truePeakTaps[p * kTruePeakLength + k] = static_cast<float>(sinc * window);
+        }
+        for (int p = 0; p < kOversampling; p++) {
+            float* taps = _truePeakTaps.data() + p * kTruePeakLength;
+            float sum = 0.0f;
+            for (int k = 0; k < kTruePeakLength; k++) sum += taps[k];
+            for (int k = 0; k < kTruePeakLength; k++) taps[k] /= sum;
+        }
+
+        Reset(48000);
+    }
+
+    // Reset
+    void LoudnessMeter::Reset(uint32_t sampleRate)
+    {
+        const double rate = static_cast<double>(std::max<uint32_t>(sampleRate, 1));
+
+        // K-weighting stage 1: high shelf (+4 dB above ~1.7 kHz), coefficients derived
+        // for any sample rate from the BS.1770 analog prototype
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+            const double k = std::tan(kPi * f0 / rate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+            _shelf = Biquad{ (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                             2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0, 0.0, 0.0 };
+        }
+
+        // Stage 2: RLB high-pass at ~38 Hz
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+            const double k = std::tan(kPi * f0 / rate);
+            const double a0 = 1.0 + k / q + k * k;
+            _highPass = Biquad{ 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0, 0.0, 0.0 };
+        }
+
+        std::fill(std::begin(_blockEnergy), std::end(_blockEnergy), 0.0);
+        _blockIndex = 0;
+        _blockCount = 0;
+        _blockFrames = std::max<uint32_t>(static_cast<uint32_t>(rate / 10.0 + 0.5), 1);
+        _blockPosition = 0;
+        _blockSum = 0.0;
+        _momentary = kFloorDb;
+        _shortTerm = kFloorDb;
+
+        std::fill(_gateEnergy.begin(), _gateEnergy.end(), 0.0);
+        std::fill(_gateCount.begin(), _gateCount.end(), 0);
+
+        std::fill(std::begin(_history), std::end(_history), 0.0f);
+        _truePeak = 0.0f;
+    }
+
+    // Process
+    void LoudnessMeter::Process(const float* samples, size_t count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            const float x = samples[i];
+
+            const double weighted = _highPass.Process(_shelf.Process(x));
+            _blockSum += weighted * weighted;
+            if (++_blockPosition == _blockFrames) CloseBlock();
+
+            // Newest sample first; each phase interpolates one of the points between x and
+            // the sample before it
+            std::copy_backward(_history, _history + kTruePeakLength - 1, _history + kTruePeakLength);
+            _history[0] = x;
+            for (int p = 0; p < kOversampling; p++) {
+                const float* taps = _truePeakTaps.data() + p * kTruePeakLength;
+                float value = 0.0f;
+                for (int k = 0; k < kTruePeakLength; k++) {
+                    value += taps[k] * _history[k];
+                }
+                _truePeak = std::max(_truePeak, std::abs(value));
+            }
+        }
+    }
+
+    // Get Integrated
+    float LoudnessMeter::GetIntegrated() const
+    {
+        double energy = 0.0;
+        uint64_t blocks = 0;
+        for (int bin = 0; bin < kGateBins; bin++) {
+            energy += _gateEnergy[bin];
+            blocks += _gateCount[bin];
+        }
+        if (blocks == 0) return kFloorDb;
+
+        // Relative gate, rounded to the histogram's resolution
+        const double gate = Loudness(energy / static_cast<double>(blocks)) + kRelativeGateLu;
+        const int first = std::clamp(static_cast<int>(std::ceil((gate - kAbsoluteGateLufs) * kGateBinsPerLu)), 0, kGateBins);
+
+        energy = 0.0;
+        blocks = 0;
+        for (int bin = first; bin < kGateBins; bin++) {
+            energy += _gateEnergy[bin];
+            blocks += _gateCount[bin];
+        }
+
+        return blocks > 0 ? Loudness(energy / static_cast<double>(blocks)) : kFloorDb;
+    }
+
+    // Get True Peak Db
+    float LoudnessMeter::GetTruePeakDb() const
+    {
+        return _truePeak > 0.0f ? std::max(20.0f * std::log10(_truePeak), kFloorDb) : kFloorDb;
+    }
+
+    // Close a 100 ms block: update momentary and short-term loudness and feed the gate
+    void LoudnessMeter::CloseBlock()
+    {
+        _blockEnergy[_blockIndex] = _blockSum / static_cast<double>(_blockFrames);
+        _blockIndex = (_blockIndex + 1) % kShortTermBlocks;
+        _blockCount = std::min(_blockCount + 1, kShortTermBlocks);
+        _blockSum = 0.0;
+        _blockPosition = 0;
+
+        // Windows still filling average over the blocks they have
+        double momentary = 0.0;
+        double shortTerm = 0.0;
+        for (int i = 1; i <= _blockCount; i++) {
+            const double energy = _blockEnergy[(_blockIndex - i + kShortTermBlocks) % kShortTermBlocks];
+            if (i <= kMomentaryBlocks) momentary += energy;
+            shortTerm += energy;
+        }
+        momentary /= std::min(_blockCount, kMomentaryBlocks);
+        shortTerm /= _blockCount;
+
+        _momentary = Loudness(momentary);
+        _shortTerm = Loudness(shortTerm);
+
+        // Gating blocks are the 400 ms windows, overlapping by 75%
+        if (_blockCount < kMomentaryBlocks || _momentary < kAbsoluteGateLufs) return;
+
+        const int bin = std::min(static_cast<int>((_momentary - kAbsoluteGateLufs) * kGateBinsPerLu), kGateBins - 1);
+        _gateEnergy[bin] += momentary;
+        _gateCount[bin]++;
+    }
+}
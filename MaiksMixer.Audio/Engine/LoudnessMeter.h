@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// EBU R128 / ITU-R BS.1770-4 loudness of one mono signal: K-weighted momentary
+    /// (400 ms) and short-term (3 s) loudness updated every 100 ms, gated integrated
+    /// loudness since the last reset, and the true peak found by 4x oversampling. Not
+    /// real-time safe; runs on analysis workers.
+    /// </summary>
+    class LoudnessMeter
+    {
+    public:
+        // Level reported before any signal (and for digital silence)
+        static constexpr float kFloorDb = -120.0f;
+
+        // Gating: blocks below kAbsoluteGateLufs never count, then only blocks within
+        // kRelativeGateLu of the ungated mean do
+        static constexpr float kAbsoluteGateLufs = -70.0f;
+        static constexpr float kRelativeGateLu = -10.0f;
+
+        // True-peak interpolator: polyphase FIR of kTruePeakTaps taps
+        static constexpr int kOversampling = 4;
+        static constexpr int kTruePeakTaps = 48;
+
+        LoudnessMeter();
+
+        /// <summary>
+        /// Clears every measurement and derives the filters for a sample rate
+        /// </summary>
+        void Reset(uint32_t sampleRate);
+
+        /// <summary>
+        /// Measures a block of samples
+        /// </summary>
+        void Process(const float* samples, size_t count);
+
+        float GetMomentary() const { return _momentary; }
+        float GetShortTerm() const { return _shortTerm; }
+        float GetIntegrated() const;
+        float GetTruePeakDb() const;
+
+    private:
+        struct Biquad
+        {
+            double b0, b1, b2, a1, a2;
+            double z1, z2;
+
+            double Process(double x)
+            {
+                const double y = b0 * x + z1;
+                z1 = b1 * x - a1 * y + z2;
+                z2 = b2 * x - a2 * y;
+                return y;
+            }
+        };
+
+        void CloseBlock();
+
+        // K-weighting: high shelf, then high-pass
+        Biquad _shelf;
+        Biquad _highPass;
+
+        // Mean squares of the last 30 100 ms blocks (newest at _blockIndex - 1)
+        static constexpr int kShortTermBlocks = 30;
+        static constexpr int kMomentaryBlocks = 4;
+        double _blockEnergy[kShortTermBlocks];
+        int _blockIndex;
+        int _blockCount;
+        uint32_t _blockFrames;
+        uint32_t _blockPosition;
+        double _blockSum;
+
+        float _momentary;
+        float _shortTerm;
+
+        // Gating histogram of 400 ms block loudness in 0.1 LU bins from the absolute gate:
+        // energy sum and block count per bin, so the gated means stay exact
+        std::vector<double> _gateEnergy;
+        std::vector<uint64_t> _gateCount;
+
+        // True peak: interpolation taps by phase and the input history
+        std::vector<float> _truePeakTaps;
+        float _history[kTruePeakTaps / kOversampling];
+        float _truePeak;
+    };
+}
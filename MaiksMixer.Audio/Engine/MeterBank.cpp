@@ -0,0 +1,169 @@
+#include "MeterBank.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    namespace {
+        constexpr float kDefaultRefreshRateHz = 30.0f;
+        constexpr float kDefaultPeakHoldSeconds = 1.5f;
+        constexpr uint32_t kDefaultSampleRate = 48000;
+
+        constexpr float kClipLevel = 1.0f;
+    }
+
+    // Constructor
+    MeterBank::MeterBank()
+        : _windowFrames(0), _sequence(0),
+          _refreshRateHz(kDefaultRefreshRateHz), _peakHoldSeconds(kDefaultPeakHoldSeconds),
+          _sampleRate(kDefaultSampleRate), _intervalFrames(0), _holdFrames(0), _resetClips(false)
+    {
+        UpdateIntervalsLocked();
+    }
+
+    // Reserve
+    void MeterBank::Reserve(int numChannels)
+    {
+        std::lock_guard<std::mutex> lock(_readerMutex);
+
+        numChannels = std::max(numChannels, 0);
+        _windows.assign(numChannels, Window{ 0.0f, 0.0f, 0.0f, 0, 0, 0.0f, 0.0f, false });
+        _windowFrames = 0;
+
+        _frames.ForEach([numChannels](MeterFrame& frame) {
+            frame.channels.assign(numChannels, ChannelMeterFrame{ 0.0f, 0.0f, 0.0f, 0 });
+            frame.channelCount = numChannels;
+            frame.sequence = 0;
+        });
+    }
+
+    // Configure
+    void MeterBank::Configure(float refreshRateHz, float peakHoldSeconds)
+    {
+        std::lock_guard<std::mutex> lock(_readerMutex);
+
+        _refreshRateHz = std::clamp(refreshRateHz, 1.0f, 1000.0f);
+        _peakHoldSeconds = std::max(peakHoldSeconds, 0.0f);
+        UpdateIntervalsLocked();
+    }
+
+    // Set Sample Rate
+    void MeterBank::SetSampleRate(uint32_t sampleRate)
+    {
+        std::lock_guard<std::mutex> lock(_readerMutex);
+        if (sampleRate == 0) return;
+
+        _sampleRate = sampleRate;
+        UpdateIntervalsLocked();
+    }
+
+    void MeterBank::UpdateIntervalsLocked()
+    {
+        _intervalFrames.store(std::max<uint32_t>(static_cast<uint32_t>(_sampleRate / _refreshRateHz), 1),
+                              std::memory_order_relaxed);
+        _holdFrames.store(static_cast<uint32_t>(_sampleRate * _peakHoldSeconds), std::memory_order_relaxed);
+    }
+
+    // Reset Clip Counters
+    void MeterBank::ResetClipCounters()
+    {
+        _resetClips.store(true, std::memory_order_relaxed);
+    }
+
+    // End Cycle (audio thread)
+    void MeterBank::EndCycle(int numChannels, uint32_t nframes)
+    {
+        _windowFrames += nframes;
+        if (_windowFrames < _intervalFrames.load(std::memory_order_relaxed)) return;
+
+        Publish(std::min(numChannels, static_cast<int>(_windows.size())));
+        _windowFrames = 0;
+    }
+
+    // Publish the finished window of every channel and start a new one (audio thread)
+    void MeterBank::Publish(int numChannels)
+    {
+        const bool resetClips = _resetClips.exchange(false, std::memory_order_relaxed);
+        const uint32_t holdFrames = _holdFrames.load(std::memory_order_relaxed);
+
+        MeterFrame& frame = _frames.WriteBuffer();
+
+        for (int i = 0; i < numChannels; i++) {
+            Window& window = _windows[i];
+
+            if (resetClips) window.clipCount = 0;
+
+            float rms;
+            if (window.accumulated) {
+                if (window.peak >= kClipLevel) window.clipCount++;
+                rms = std::sqrt(window.sumSquares / _windowFrames);
+            }
+            else {
+                // Fast decay for channels the engine skipped: no meter kernels ran
+                window.peak = window.lastPeak * kIdleDecay;
+                rms = window.lastRms * kIdleDecay;
+                if (window.peak < kIdleFloor) window.peak = 0.0f;
+                if (rms < kIdleFloor) rms = 0.0f;
+            }
+
+            // Hold the highest peak until the hold time runs out, then follow the meter
+            if (window.peak >= window.peakHold || window.holdRemaining == 0) {
+                window.peakHold = window.peak;
+                window.holdRemaining = holdFrames;
+            }
+            else {
+                window.holdRemaining -= std::min(window.holdRemaining, _windowFrames);
+            }
+
+            frame.channels[i] = ChannelMeterFrame{
+                window.peak,
+                rms,
+                window.peakHold,
+                window.clipCount
+            };
+
+            window.lastPeak = window.peak;
+            window.lastRms = rms;
+            window.peak = 0.0f;
+            window.sumSquares = 0.0f;
+            window.accumulated = false;
+        }
+
+        frame.channelCount = numChannels;
+        frame.sequence = ++_sequence;
+        _frames.Publish();
+    }
+
+    // Copy To
+    int MeterBank::CopyTo(float* destination, int capacity, uint64_t* sequence)
+    {
+        std::lock_guard<std::mutex> lock(_readerMutex);
+
+        const MeterFrame& frame = _frames.Read();
+        const int count = std::min(frame.channelCount, capacity / kValuesPerChannel);
+
+        for (int i = 0; i < count; i++) {
+            const ChannelMeterFrame& meter = frame.channels[i];
+            float* out = destination + static_cast<size_t>(i) * kValuesPerChannel;
+            out[0] = meter.peak;
+            out[1] = meter.rms;
+            out[2] = meter.peakHold;
+            out[3] = static_cast<float>(meter.clipCount);
+        }
+
+        if (sequence != nullptr) *sequence = frame.sequence;
+        return count;
+    }
+
+    // Get Channel
+    ChannelMeterFrame MeterBank::GetChannel(int channel)
+    {
+        std::lock_guard<std::mutex> lock(_readerMutex);
+
+        const MeterFrame& frame = _frames.Read();
+        if (channel < 0 || channel >= frame.channelCount) return ChannelMeterFrame{ 0.0f, 0.0f, 0.0f, 0 };
+
+        return frame.channels[channel];
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Published meter values for one channel
+    /// </summary>
+    struct ChannelMeterFrame
+    {
+        float peak;         // Peak over the last meter window (0.0 - 1.0+)
+        float rms;          // RMS over the last meter window
+        float peakHold;     // Highest peak within the hold time
+        uint32_t clipCount; // Windows whose peak reached full scale since the last reset
+    };
+
+    /// <summary>
+    /// Meter values of every channel, published together
+    /// </summary>
+    struct MeterFrame
+    {
+        std::vector<ChannelMeterFrame> channels;
+        int channelCount = 0;
+        uint64_t sequence = 0;
+    };
+
+    /// <summary>
+    /// Collects per-cycle channel levels on the audio thread and publishes all channels at
+    /// a throttled rate through a triple buffer, so readers fetch every meter with one copy
+    /// instead of one callback per channel. Channels the engine skips (muted, inactive or
+    /// idle on silence) are not accumulated at all; their meters fall off by a fixed
+    /// factor per publish instead.
+    /// </summary>
+    class MeterBank
+    {
+    public:
+        // Values per channel in the flattened layout written by CopyTo()
+        static constexpr int kValuesPerChannel = 4;
+
+        // Factor applied per publish to the meters of channels with no levels in the window
+        // (-12 dB), and the level below which they read zero
+        static constexpr float kIdleDecay = 0.25f;
+        static constexpr float kIdleFloor = 1.0e-6f;
+
+        MeterBank();
+
+        /// <summary>
+        /// Sizes the bank for numChannels and resets all meters. Must not be called while
+        /// the process callback may be running.
+        /// </summary>
+        void Reserve(int numChannels);
+
+        /// <summary>
+        /// Sets how often meters are published and how long peaks are held
+        /// </summary>
+        void Configure(float refreshRateHz, float peakHoldSeconds);
+
+        /// <summary>
+        /// Sets the sample rate the refresh interval and hold time are derived from
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Clears the clip counters on the next publish
+        /// </summary>
+        void ResetClipCounters();
+
+        /// <summary>
+        /// Adds one cycle of levels for a channel (audio thread)
+        /// </summary>
+        void Accumulate(int channel, float peak, float sumSquares)
+        {
+            Window& window = _windows[channel];
+            window.peak = window.peak > peak ? window.peak : peak;
+            window.sumSquares += sumSquares;
+            window.accumulated = true;
+        }
+
+        /// <summary>
+        /// Ends a cycle of nframes frames and publishes if the refresh interval has elapsed
+        /// (audio thread)
+        /// </summary>
+        void EndCycle(int numChannels, uint32_t nframes);
+
+        /// <summary>
+        /// Copies the latest meters as kValuesPerChannel floats per channel (peak, rms,
+        /// peak hold, clip count) and returns the number of channels written
+        /// </summary>
+        int CopyTo(float* destination, int capacity, uint64_t* sequence = nullptr);
+
+        /// <summary>
+        /// Returns the latest meters for one channel
+        /// </summary>
+        ChannelMeterFrame GetChannel(int channel);
+
+    private:
+        struct Window
+        {
+            float peak;
+            float sumSquares;
+            float peakHold;
+            uint32_t holdRemaining;
+            uint32_t clipCount;
+            float lastPeak;     // Published values, the start of the idle decay
+            float lastRms;
+            bool accumulated;   // Levels arrived in this window
+        };
+
+        void Publish(int numChannels);
+        void UpdateIntervalsLocked();
+
+        // Audio thread state
+        std::vector<Window> _windows;
+        uint32_t _windowFrames;
+        uint64_t _sequence;
+
+        // Control side settings, guarded by _readerMutex
+        float _refreshRateHz;
+        float _peakHoldSeconds;
+        uint32_t _sampleRate;
+
+        std::atomic<uint32_t> _intervalFrames;
+        std::atomic<uint32_t> _holdFrames;
+        std::atomic<bool> _resetClips;
+
+        TripleBuffer<MeterFrame> _frames;
+
+        // Serializes readers (the triple buffer has a single reader side) and settings
+        std::mutex _readerMutex;
+    };
+}
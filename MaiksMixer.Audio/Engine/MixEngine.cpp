@@ -0,0 +1,1252 @@
+#include "MixEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "RtAllocationGuard.h"
+#include "RtMemoryLock.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace emp {
+
+    namespace {
+        constexpr int kMaskBits = 64;
+        constexpr float kHalfPi = 1.57079632679f;
+
+        size_t MaskWords(int channels) { return (static_cast<size_t>(channels) + kMaskBits - 1) / kMaskBits; }
+
+        int CountTrailingZeros(uint64_t bits)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, bits);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctzll(bits);
+#endif
+        }
+
+        // Sizes compiled routes for a fully populated matrix, so copies never reallocate
+        void ReserveRoutes(CompiledRoutes& routes, int numInputs, int numOutputs)
+        {
+            routes.rowStart.assign(static_cast<size_t>(numInputs) + 1, 0);
+            routes.entries.assign(static_cast<size_t>(numInputs) * numOutputs, RouteEntry{ 0, 0.0f });
+            routes.numInputs = numInputs;
+            routes.numOutputs = numOutputs;
+            routes.routeCount = 0;
+            routes.enabled = false;
+            routes.version = ~0ull;
+            routes.scene = 0;
+        }
+
+        // Copies compiled routes into storage reserved for the same dimensions (real-time safe)
+        void CopyRoutes(const CompiledRoutes& from, CompiledRoutes& to)
+        {
+            std::copy_n(from.rowStart.begin(), std::min(from.rowStart.size(), to.rowStart.size()), to.rowStart.begin());
+            std::copy_n(from.entries.begin(), std::min<size_t>(from.routeCount, to.entries.size()), to.entries.begin());
+            to.routeCount = from.routeCount;
+            to.enabled = from.enabled;
+            to.version = from.version;
+            to.scene = from.scene;
+        }
+    }
+
+    // Constructor
+    MixEngine::MixEngine()
+        : _numInputs(0), _numOutputs(0), _maxFrames(0), _sampleRate(kDefaultSampleRate), _inputCapacity(0), _outputCapacity(0),
+          _current(nullptr), _liveParams(nullptr), _ramps(nullptr), _syncedParams(nullptr),
+          _activeMask(nullptr), _silentFrames(nullptr), _silenceDetection(true),
+          _silenceThreshold(kDefaultSilenceThreshold),
+          _liveChannelCount(0), _liveAnySolo(false), _liveVersion(0), _cycle(0),
+          _liveInserts(nullptr), _insertState(nullptr), _insertChannels(0), _bypassedInserts(0),
+          _busPlan(nullptr), _busPlanVersion(~0ull),
+          _sceneCounter(0), _liveScene(0), _fadeParams(nullptr), _fadeMask(nullptr), _fadeFrames(0), _fadePosition(0),
+          _scheduled(nullptr), _scheduledCount(0), _nextFrameTime(0), _frameTime(0),
+          _smoothingShape(static_cast<int32_t>(RampShape::Linear)), _smoothingMs(kDefaultSmoothingMs),
+          _block(), _kernels(&GetActiveMixKernels())
+    {
+    }
+
+    // Destructor
+    MixEngine::~MixEngine() = default;
+
+    // Configure Ports
+    void MixEngine::ConfigurePorts(int numInputs, int numOutputs, int inputCapacity, int outputCapacity)
+    {
+        std::lock_guard<std::mutex> lock(_layoutMutex);
+
+        numInputs = std::max(numInputs, 0);
+        numOutputs = std::max(numOutputs, 0);
+        _inputCapacity = std::max(numInputs, inputCapacity);
+        _outputCapacity = std::max(numOutputs, outputCapacity);
+
+        _parameters.Reserve(_inputCapacity);
+        _parameters.SetChannelCount(numInputs);
+        _routing.Reserve(_inputCapacity, _outputCapacity);
+        _inserts.Reserve(_inputCapacity);
+        _buses.Reserve(_inputCapacity, _outputCapacity);
+        _meterBank.Reserve(_inputCapacity);
+        _analysis.Reserve(_inputCapacity, _outputCapacity);
+        _recorder.Reserve(_inputCapacity, _outputCapacity);
+        _virtualSources.Reserve(_inputCapacity);
+
+        const size_t capacity = static_cast<size_t>(_inputCapacity);
+        const size_t insertGroups = (capacity + kInsertLanes - 1) / kInsertLanes;
+        _channelArena.Reserve(
+            EngineArena::SizeFor<ChannelParams>(capacity) * 3 +
+            EngineArena::SizeFor<ChannelRamps>(capacity) +
+            EngineArena::SizeFor<uint64_t>(MaskWords(_inputCapacity)) * 2 +
+            EngineArena::SizeFor<uint32_t>(capacity) +
+            EngineArena::SizeFor<TimedParameterChange>(kMaxScheduledChanges) +
+            EngineArena::SizeFor<InsertGroupState>(insertGroups));
+        _liveParams = _channelArena.Allocate<ChannelParams>(capacity);
+        _syncedParams = _channelArena.Allocate<ChannelParams>(capacity);
+        _ramps = _channelArena.Allocate<ChannelRamps>(capacity);
+        _activeMask = _channelArena.Allocate<uint64_t>(MaskWords(_inputCapacity));
+        _silentFrames = _channelArena.Allocate<uint32_t>(capacity);
+        _scheduled = _channelArena.Allocate<TimedParameterChange>(kMaxScheduledChanges);
+        _fadeParams = _channelArena.Allocate<ChannelParams>(capacity);
+        _fadeMask = _channelArena.Allocate<uint64_t>(MaskWords(_inputCapacity));
+        _insertState = _channelArena.Allocate<InsertGroupState>(insertGroups);
+        for (size_t g = 0; g < insertGroups; g++) {
+            _insertState[g].Reset();
+        }
+        std::uninitialized_fill(_liveParams, _liveParams + capacity, ChannelParams());
+        std::uninitialized_fill(_syncedParams, _syncedParams + capacity, ChannelParams());
+        std::uninitialized_fill(_fadeParams, _fadeParams + capacity, ChannelParams());
+        std::uninitialized_fill(_ramps, _ramps + capacity, ChannelRamps());
+        _liveChannelCount = 0;
+        _liveAnySolo = false;
+        _scheduledCount = 0;
+
+        ReserveRoutes(_liveRoutes, _inputCapacity, _outputCapacity);
+        ReserveRoutes(_fadeRoutes, _inputCapacity, _outputCapacity);
+        _liveScene = 0;
+        _fadeFrames = 0;
+        _busPlanVersion = ~0ull;
+
+        // Forces the next cycle to take the published snapshot
+        _liveVersion = ~0ull;
+
+        const uint32_t maxFrames = GetMaxFrames();
+        PublishLayoutLocked(numInputs, numOutputs, maxFrames > 0 ? maxFrames : kDefaultMaxFrames, GetSampleRate());
+    }
+
+    // Prepare
+    void MixEngine::Prepare(uint32_t maxFrames)
+    {
+        std::lock_guard<std::mutex> lock(_layoutMutex);
+        PublishLayoutLocked(GetInputCount(), GetOutputCount(), std::max<uint32_t>(maxFrames, 1), GetSampleRate());
+    }
+
+    // Set Sample Rate
+    void MixEngine::SetSampleRate(uint32_t sampleRate)
+    {
+        if (sampleRate == 0) return;
+
+        std::lock_guard<std::mutex> lock(_layoutMutex);
+        _meterBank.SetSampleRate(sampleRate);
+        _telemetry.SetSampleRate(sampleRate);
+        _analysis.SetSampleRate(sampleRate);
+        _recorder.SetSampleRate(sampleRate);
+        _virtualSources.SetSampleRate(sampleRate);
+        _inserts.SetSampleRate(sampleRate);
+
+        // Nothing to rebuild before the ports are configured
+        const uint32_t maxFrames = GetMaxFrames();
+        if (maxFrames == 0) {
+            _sampleRate.store(sampleRate, std::memory_order_relaxed);
+            return;
+        }
+        PublishLayoutLocked(GetInputCount(), GetOutputCount(), maxFrames, sampleRate);
+    }
+
+    // Set Smoothing
+    void MixEngine::SetSmoothing(RampShape shape, float milliseconds)
+    {
+        _smoothingShape.store(static_cast<int32_t>(shape), std::memory_order_relaxed);
+        _smoothingMs.store(std::max(milliseconds, 0.0f), std::memory_order_relaxed);
+    }
+
+    // Lock Memory
+    bool MixEngine::LockMemory(bool lockProcess)
+    {
+        bool locked;
+        if (lockProcess) {
+            locked = RtMemoryLock::LockProcess();
+        }
+        else {
+            std::lock_guard<std::mutex> lock(_layoutMutex);
+            const Layout* layout = _layout.Load();
+            locked = _channelArena.IsLocked() && (layout == nullptr || layout->arena.IsLocked());
+        }
+        _telemetry.SetArenasLocked(locked);
+        return locked;
+    }
+
+    // Set Active Ports
+    void MixEngine::SetActivePorts(int numInputs, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_layoutMutex);
+
+        numInputs = std::clamp(numInputs, 0, _inputCapacity);
+        numOutputs = std::clamp(numOutputs, 0, _outputCapacity);
+        const int previousInputs = GetInputCount();
+        const int previousOutputs = GetOutputCount();
+
+        // Removed channels start from defaults and without routes if they come back
+        if (numInputs < previousInputs || numOutputs < previousOutputs) {
+            _routing.Apply([&](std::vector<float>& gains, int capacityInputs, int capacityOutputs) {
+                for (int i = 0; i < capacityInputs; i++) {
+                    for (int o = 0; o < capacityOutputs; o++) {
+                        if (i >= numInputs || o >= numOutputs) gains[static_cast<size_t>(i) * capacityOutputs + o] = 0.0f;
+                    }
+                }
+            });
+        }
+        if (numInputs < previousInputs) {
+            _inserts.ResetFrom(numInputs);
+            _buses.ResetChannelsFrom(numInputs);
+        }
+        _parameters.SetChannelCount(numInputs);
+
+        PublishLayoutLocked(numInputs, numOutputs, GetMaxFrames(), GetSampleRate());
+    }
+
+    // Set Port Registrar
+    void MixEngine::SetPortRegistrar(std::function<bool(int numInputs, int numOutputs)> registrar)
+    {
+        std::lock_guard<std::mutex> lock(_layoutMutex);
+        _portRegistrar = std::move(registrar);
+    }
+
+    // Resize Ports
+    bool MixEngine::ResizePorts(int numInputs, int numOutputs)
+    {
+        std::function<bool(int, int)> registrar;
+        {
+            std::lock_guard<std::mutex> lock(_layoutMutex);
+            registrar = _portRegistrar;
+        }
+
+        if (registrar) return registrar(numInputs, numOutputs);
+
+        SetActivePorts(numInputs, numOutputs);
+        return true;
+    }
+
+    // Build the per-cycle structures for a port count and block size (control thread)
+    std::unique_ptr<MixEngine::Layout> MixEngine::BuildLayout(int numInputs, int numOutputs, uint32_t maxFrames, uint32_t sampleRate) const
+    {
+        auto layout = std::make_unique<Layout>();
+        layout->numInputs = numInputs;
+        layout->numOutputs = numOutputs;
+        layout->maxFrames = maxFrames;
+        layout->sampleRate = sampleRate;
+        layout->silenceHoldFrames = static_cast<uint32_t>(static_cast<uint64_t>(sampleRate) * kSilenceHoldMs / 1000);
+
+        const size_t inputs = static_cast<size_t>(numInputs);
+        const size_t outputs = static_cast<size_t>(numOutputs);
+
+        // Strip tasks exist only for graphs large enough to be split
+        layout->maxStripTasks = numInputs >= kParallelMinChannels
+            ? std::min(kMaxStripTasks, (numInputs + kChannelsPerStripTask - 1) / kChannelsPerStripTask)
+            : 0;
+        const size_t stripTasks = static_cast<size_t>(layout->maxStripTasks);
+        const size_t insertGroups = (inputs + kInsertLanes - 1) / kInsertLanes;
+
+        EngineArena& arena = layout->arena;
+        arena.Reserve(
+            EngineArena::SizeFor<const float*>(inputs) * 2 +
+            EngineArena::SizeFor<float*>(outputs) +
+            EngineArena::SizeFor<float>(outputs * maxFrames) +
+            EngineArena::SizeFor<uint8_t>(outputs) +
+            EngineArena::SizeFor<float>(stripTasks * outputs * maxFrames) +
+            EngineArena::SizeFor<uint8_t>(stripTasks * outputs) +
+            EngineArena::SizeFor<float>(inputs) * 2 +
+            EngineArena::SizeFor<float>(insertGroups * kInsertLanes * maxFrames) +
+            EngineArena::SizeFor<float>(inputs * maxFrames) +
+            EngineArena::SizeFor<uint32_t>(insertGroups) +
+            EngineArena::SizeFor<float>(static_cast<size_t>(BusGraph::kMaxLanes) * maxFrames) +
+            EngineArena::SizeFor<SendLevels>(inputs));
+
+        layout->inputTable = arena.Allocate<const float*>(inputs);
+        layout->channelTable = arena.Allocate<const float*>(inputs);
+        layout->outputTable = arena.Allocate<float*>(outputs);
+        layout->mixBuses = arena.Allocate<float>(outputs * maxFrames);
+        layout->busTouched = arena.Allocate<uint8_t>(outputs);
+        layout->stripBuses = arena.Allocate<float>(stripTasks * outputs * maxFrames);
+        layout->stripTouched = arena.Allocate<uint8_t>(stripTasks * outputs);
+        layout->peakAccum = arena.Allocate<float>(inputs);
+        layout->sumSquaresAccum = arena.Allocate<float>(inputs);
+        layout->insertLanes = arena.Allocate<float>(insertGroups * kInsertLanes * maxFrames);
+        layout->insertOutputs = arena.Allocate<float>(inputs * maxFrames);
+        layout->insertMasks = arena.Allocate<uint32_t>(insertGroups);
+        layout->busLanes = arena.Allocate<float>(static_cast<size_t>(BusGraph::kMaxLanes) * maxFrames);
+        layout->sendLevels = arena.Allocate<SendLevels>(inputs);
+
+        return layout;
+    }
+
+    // Swap in a new layout and free the old one once no cycle uses it
+    void MixEngine::PublishLayoutLocked(int numInputs, int numOutputs, uint32_t maxFrames, uint32_t sampleRate)
+    {
+        _layout.Publish(BuildLayout(numInputs, numOutputs, maxFrames, sampleRate), _rcu);
+
+        _numInputs.store(numInputs, std::memory_order_relaxed);
+        _numOutputs.store(numOutputs, std::memory_order_relaxed);
+        _maxFrames.store(maxFrames, std::memory_order_relaxed);
+        _sampleRate.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    // Post Parameter Change
+    uint32_t MixEngine::PostParameterChange(const ParameterChange& change)
+    {
+        EngineCommand command{};
+        command.type = EngineCommandType::SetParameter;
+        command.parameter = change;
+
+        // Staging first means every later snapshot agrees with the command
+        return _commands.Post(command, [this, &change] { return _parameters.Stage(change); });
+    }
+
+    // Schedule Parameter Change
+    uint32_t MixEngine::ScheduleParameterChange(const TimedParameterChange& change, bool acknowledge)
+    {
+        if (!IsValidTimedChange(change)) return 0;
+
+        EngineCommand command{};
+        command.type = EngineCommandType::ScheduleParameter;
+        command.timed = change;
+        command.unacknowledged = !acknowledge;
+        return _commands.Post(command);
+    }
+
+    // Is Valid Timed Change
+    bool MixEngine::IsValidTimedChange(const TimedParameterChange& change)
+    {
+        ChannelParams probe;
+        return change.change.channel >= 0 && ApplyParameterChange(probe, change.change.parameter, change.change.value);
+    }
+
+    // Capture Scene
+    SceneSnapshot MixEngine::CaptureScene()
+    {
+        SceneSnapshot snapshot;
+        _parameters.GetChannels(snapshot.channels);
+        _routing.GetMatrix(snapshot.routes, snapshot.routeInputs, snapshot.routeOutputs);
+        snapshot.routingEnabled = _routing.IsEnabled();
+        return snapshot;
+    }
+
+    // Compile Scene
+    std::shared_ptr<const CompiledScene> MixEngine::CompileScene(const SceneSnapshot& snapshot)
+    {
+        auto scene = std::make_shared<CompiledScene>();
+        {
+            std::lock_guard<std::mutex> lock(_layoutMutex);
+            scene->inputCapacity = _inputCapacity;
+            scene->outputCapacity = _outputCapacity;
+        }
+        const int inputCapacity = scene->inputCapacity;
+        const int outputCapacity = scene->outputCapacity;
+
+        scene->channels.assign(static_cast<size_t>(inputCapacity), ChannelParams());
+        const size_t channels = std::min(snapshot.channels.size(), scene->channels.size());
+        for (size_t i = 0; i < channels; i++) {
+            ChannelParams& params = scene->channels[i];
+            params = snapshot.channels[i];
+            params.volume = std::clamp(params.volume, 0.0f, 1.0f);
+            params.pan = std::clamp(params.pan, 0.0f, 1.0f);
+            params.gain = std::max(params.gain, 0.0f);
+        }
+
+        // Routes beyond the capacity are dropped, missing ones are left unrouted
+        scene->gains.assign(static_cast<size_t>(inputCapacity) * outputCapacity, 0.0f);
+        const int rows = snapshot.routeOutputs > 0
+            ? static_cast<int>(std::min<size_t>(static_cast<size_t>(std::max(snapshot.routeInputs, 0)),
+                                                snapshot.routes.size() / static_cast<size_t>(snapshot.routeOutputs)))
+            : 0;
+        const int inputs = std::min(rows, inputCapacity);
+        const int outputs = std::clamp(snapshot.routeOutputs, 0, outputCapacity);
+        for (int i = 0; i < inputs; i++) {
+            for (int o = 0; o < outputs; o++) {
+                const float gain = snapshot.routes[static_cast<size_t>(i) * snapshot.routeOutputs + o];
+                scene->gains[static_cast<size_t>(i) * outputCapacity + o] = std::max(gain, 0.0f);
+            }
+        }
+
+        ReserveRoutes(scene->routes, inputCapacity, outputCapacity);
+        CompileRoutes(scene->gains.data(), inputCapacity, outputCapacity, scene->routes);
+        scene->routes.enabled = snapshot.routingEnabled;
+        scene->routes.version = 0;
+        return scene;
+    }
+
+    // Recall Scene
+    uint32_t MixEngine::RecallScene(std::shared_ptr<const CompiledScene> scene, float crossfadeMs)
+    {
+        if (!scene) return 0;
+
+        std::lock_guard<std::mutex> lock(_sceneMutex);
+        if (scene->inputCapacity != _inputCapacity || scene->outputCapacity != _outputCapacity) return 0;
+
+        const uint64_t id = _sceneCounter + 1;
+        EngineCommand command{};
+        command.type = EngineCommandType::RecallScene;
+        command.recall.scene = id;
+        command.recall.fadeFrames = static_cast<uint32_t>(std::max(crossfadeMs, 0.0f) * 0.001f * static_cast<float>(GetSampleRate()) + 0.5f);
+
+        // Published only once the command is sure of its queue slot, just before the push:
+        // the audio thread finds it when the command runs, and a recall that could not be
+        // queued never replaces the scene an earlier queued recall is waiting for
+        const uint32_t commandId = _commands.Post(command, [&] {
+            _sceneCounter = id;
+            _scene.Publish(std::unique_ptr<SceneSlot>(new SceneSlot{ id, std::move(scene) }), _rcu);
+            return true;
+        });
+        if (commandId == 0) return 0;
+
+        // The stores take the scene under its recall id; the audio thread ignores what
+        // they publish until it has run the command, which is now certain to come
+        const CompiledScene& compiled = *_scene.Get()->scene;
+        _parameters.Restore(compiled.channels, id);
+        _routing.Restore(compiled.gains, compiled.routes.enabled, id);
+        return commandId;
+    }
+
+    // Process (real-time thread)
+    void MixEngine::Process(const float* const* inputs, int numInputs, float* const* outputs, int numOutputs, uint32_t nframes,
+                            uint64_t frameTime)
+    {
+        RtAllocationGuard::Scope rtScope;
+        const auto cycleStart = std::chrono::steady_clock::now();
+
+        // The layout stays valid until the scope closes at the end of the cycle
+        RcuDomain::ReadScope cycleScope(_rcu);
+        Layout* layout = _layout.Load();
+        if (layout == nullptr) {
+            for (int o = 0; o < numOutputs; o++) {
+                std::memset(outputs[o], 0, sizeof(float) * nframes);
+            }
+            return;
+        }
+        _current = layout;
+
+        const uint64_t firstFrame = frameTime != kNoFrameTime ? frameTime : _nextFrameTime;
+        _nextFrameTime = firstFrame + nframes;
+        _frameTime.store(firstFrame, std::memory_order_relaxed);
+
+        // Bind the caller's buffers; outputs the engine does not drive are silenced
+        const int boundInputs = std::min(numInputs, layout->numInputs);
+        std::copy(inputs, inputs + boundInputs, layout->inputTable);
+        _virtualSources.Render(*_kernels, layout->inputTable, boundInputs, nframes, firstFrame);
+        for (int o = 0; o < layout->numOutputs; o++) {
+            layout->outputTable[o] = o < numOutputs ? outputs[o] : nullptr;
+        }
+        for (int o = layout->numOutputs; o < numOutputs; o++) {
+            std::memset(outputs[o], 0, sizeof(float) * nframes);
+        }
+
+        // Count the commands before taking the snapshot: a snapshot published before one of
+        // them was queued is then picked up no later than the command, never after it
+        const int pendingCommands = _commands.GetPendingCount();
+        SyncLiveParameters(_parameters.AcquireSnapshot());
+        _commands.Drain(_cycle, pendingCommands, [this](const EngineCommand& command) { return ExecuteCommand(command); });
+
+        SyncLiveRoutes(_routing.AcquireRoutes());
+        const CompiledRoutes& routes = _liveRoutes;
+        _liveInserts = &_inserts.AcquireInserts();
+        _busPlan = &_buses.AcquirePlan();
+        _insertChannels = 0;
+        _bypassedInserts = 0;
+        const int numChannels = std::min(_liveChannelCount, boundInputs);
+
+        std::fill(layout->peakAccum, layout->peakAccum + numChannels, -1.0f);
+        std::fill(layout->sumSquaresAccum, layout->sumSquaresAccum + numChannels, 0.0f);
+
+        // Blocks longer than the prepared size are rendered in layout-sized chunks, which
+        // are split again wherever a timed change lands
+        for (uint32_t offset = 0; offset < nframes;) {
+            ApplyDueChanges(firstFrame + offset);
+
+            uint32_t end = std::min(nframes, offset + layout->maxFrames);
+            if (_scheduledCount > 0 && _scheduled[0].frameTime < firstFrame + end) {
+                end = static_cast<uint32_t>(_scheduled[0].frameTime - firstFrame);
+            }
+
+            MixBlock(routes, numChannels, offset, end - offset);
+
+            if (_fadeFrames > 0) {
+                _fadePosition += end - offset;
+                if (_fadePosition >= _fadeFrames) _fadeFrames = 0;
+            }
+            offset = end;
+        }
+
+        // Channels that were skipped all cycle leave their meters to the idle decay
+        uint32_t mixedChannels = 0;
+        uint32_t idleChannels = 0;
+        for (int i = 0; i < numChannels; i++) {
+            if (layout->peakAccum[i] >= 0.0f) {
+                _meterBank.Accumulate(i, layout->peakAccum[i], layout->sumSquaresAccum[i]);
+                mixedChannels++;
+            }
+            else if (_activeMask[i / kMaskBits] & (1ull << (i % kMaskBits))) {
+                idleChannels++;
+            }
+        }
+        _telemetry.RecordChannelActivity(mixedChannels, idleChannels);
+        _telemetry.RecordInsertActivity(_insertChannels, _bypassedInserts);
+        _telemetry.RecordDroppedCompletions(_commands.GetDroppedCompletions());
+        _meterBank.EndCycle(numChannels, nframes);
+        _analysis.Capture(layout->inputTable, boundInputs, outputs, std::min(numOutputs, layout->numOutputs), nframes);
+        _recorder.Capture(layout->inputTable, boundInputs, outputs, std::min(numOutputs, layout->numOutputs), nframes);
+        _cycle++;
+
+        const auto cycleTime = std::chrono::steady_clock::now() - cycleStart;
+        _telemetry.RecordCycle(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(cycleTime).count()), nframes);
+    }
+
+    // Process with one buffer per active port
+    void MixEngine::Process(const float* const* inputs, float* const* outputs, uint32_t nframes)
+    {
+        Process(inputs, GetInputCount(), outputs, GetOutputCount(), nframes);
+    }
+
+    // Take the changes in a newly published snapshot into the live parameters (audio thread)
+    void MixEngine::SyncLiveParameters(const ParameterSnapshot& snapshot)
+    {
+        // Held back while a recalled scene's command has not run yet
+        if (snapshot.scene != _liveScene || snapshot.version == _liveVersion) return;
+
+        // Only values that changed since the previous snapshot are taken, so a snapshot
+        // never undoes a timed change; channels that just became active start as published
+        const bool initial = _liveVersion == ~0ull;
+        const int count = std::min(_inputCapacity, snapshot.channelCount);
+        const RampShape shape = static_cast<RampShape>(_smoothingShape.load(std::memory_order_relaxed));
+        const uint32_t rampFrames = GetSmoothingFrames();
+
+        for (int i = 0; i < count; i++) {
+            const ChannelParams& next = snapshot.channels[i];
+            ChannelParams& live = _liveParams[i];
+            ChannelParams& synced = _syncedParams[i];
+
+            if (initial || i >= _liveChannelCount) {
+                live = next;
+                _ramps[i].Reset(next);
+                _silentFrames[i] = 0;
+            }
+            else {
+                if (next.volume != synced.volume) {
+                    live.volume = next.volume;
+                    _ramps[i].volume.Start(live.volume, shape, rampFrames);
+                }
+                if (next.pan != synced.pan) {
+                    live.pan = next.pan;
+                    _ramps[i].pan.Start(live.pan, shape, rampFrames);
+                }
+                if (next.gain != synced.gain) {
+                    live.gain = next.gain;
+                    _ramps[i].gain.Start(live.gain, shape, rampFrames);
+                }
+                if (next.mute != synced.mute) live.mute = next.mute;
+                if (next.solo != synced.solo) live.solo = next.solo;
+            }
+            synced = next;
+        }
+
+        _liveChannelCount = count;
+        _liveVersion = snapshot.version;
+        UpdateActiveMask();
+    }
+
+    // Take a newly published routing matrix into the live copy (audio thread)
+    void MixEngine::SyncLiveRoutes(const CompiledRoutes& routes)
+    {
+        if (routes.scene != _liveScene || routes.version == _liveRoutes.version) return;
+        CopyRoutes(routes, _liveRoutes);
+    }
+
+    // Swap in a recalled scene, keeping what was playing for the crossfade (audio thread)
+    bool MixEngine::ApplyScene(const SceneRecall& recall)
+    {
+        // A later recall has replaced this one; its own command follows
+        const SceneSlot* slot = _scene.Load();
+        if (slot == nullptr || slot->id != recall.scene) return false;
+        const CompiledScene& scene = *slot->scene;
+
+        _fadeFrames = 0;
+        if (recall.fadeFrames > 0) {
+            for (int i = 0; i < _liveChannelCount; i++) {
+                ChannelParams& from = _fadeParams[i];
+                from = _liveParams[i];
+                from.volume = _ramps[i].volume.GetValue();
+                from.pan = _ramps[i].pan.GetValue();
+                from.gain = _ramps[i].gain.GetValue();
+            }
+            std::copy(_activeMask, _activeMask + MaskWords(_inputCapacity), _fadeMask);
+            std::swap(_liveRoutes, _fadeRoutes);
+            _fadeFrames = recall.fadeFrames;
+            _fadePosition = 0;
+        }
+
+        CopyRoutes(scene.routes, _liveRoutes);
+        for (int i = 0; i < _liveChannelCount; i++) {
+            _liveParams[i] = scene.channels[i];
+            _syncedParams[i] = scene.channels[i];
+            _ramps[i].Reset(scene.channels[i]);
+            _silentFrames[i] = 0;
+        }
+
+        _liveScene = recall.scene;
+        UpdateActiveMask();
+        return true;
+    }
+
+    // Execute one queued command (audio thread)
+    EngineCommandStatus MixEngine::ExecuteCommand(const EngineCommand& command)
+    {
+        switch (command.type) {
+        case EngineCommandType::SetParameter: {
+            const RampShape shape = static_cast<RampShape>(_smoothingShape.load(std::memory_order_relaxed));
+            return ApplyLiveChange(command.parameter, shape, GetSmoothingFrames())
+                ? EngineCommandStatus::Applied
+                : EngineCommandStatus::Rejected;
+        }
+        case EngineCommandType::ScheduleParameter:
+            return InsertScheduled(command.timed) ? EngineCommandStatus::Applied : EngineCommandStatus::Rejected;
+        case EngineCommandType::RecallScene:
+            return ApplyScene(command.recall) ? EngineCommandStatus::Applied : EngineCommandStatus::Rejected;
+        case EngineCommandType::Barrier:
+            return EngineCommandStatus::Applied;
+        }
+
+        return EngineCommandStatus::Rejected;
+    }
+
+    // Apply a change to the live parameters, ramping continuous ones (audio thread)
+    bool MixEngine::ApplyLiveChange(const ParameterChange& change, RampShape shape, uint32_t rampFrames)
+    {
+        if (change.channel < 0 || change.channel >= _liveChannelCount) return false;
+
+        ChannelParams& live = _liveParams[change.channel];
+        if (!ApplyParameterChange(live, change.parameter, change.value)) return false;
+
+        // Channels that are not mixed have nothing to smooth
+        const bool active = (_activeMask[change.channel / kMaskBits] & (1ull << (change.channel % kMaskBits))) != 0;
+        if (!active) rampFrames = 0;
+
+        ChannelRamps& ramps = _ramps[change.channel];
+        switch (change.parameter) {
+        case ParameterId::Volume:
+            ramps.volume.Start(live.volume, shape, rampFrames);
+            break;
+        case ParameterId::Pan:
+            ramps.pan.Start(live.pan, shape, rampFrames);
+            break;
+        case ParameterId::GainDb:
+            ramps.gain.Start(live.gain, shape, rampFrames);
+            break;
+        case ParameterId::Mute:
+        case ParameterId::Solo:
+            UpdateActiveMask();
+            break;
+        }
+
+        return true;
+    }
+
+    // Rebuild the audible-channel mask from the live mute and solo states (audio thread)
+    void MixEngine::UpdateActiveMask()
+    {
+        _liveAnySolo = std::any_of(_liveParams, _liveParams + _liveChannelCount,
+                                   [](const ChannelParams& params) { return params.solo; });
+
+        std::fill(_activeMask, _activeMask + MaskWords(_inputCapacity), 0ull);
+        for (int i = 0; i < _liveChannelCount; i++) {
+            const ChannelParams& params = _liveParams[i];
+
+            // Solo-in-place: when any channel is soloed only soloed channels are audible
+            if (!params.mute && (!_liveAnySolo || params.solo)) {
+                _activeMask[i / kMaskBits] |= 1ull << (i % kMaskBits);
+            }
+            else {
+                // Skipped channels are not advanced, so their ramps finish now
+                _ramps[i].Reset(params);
+            }
+        }
+    }
+
+    // Add a timed change behind those due at the same or an earlier frame (audio thread)
+    bool MixEngine::InsertScheduled(const TimedParameterChange& change)
+    {
+        if (_scheduledCount == kMaxScheduledChanges) return false;
+
+        int position = _scheduledCount;
+        while (position > 0 && _scheduled[position - 1].frameTime > change.frameTime) {
+            _scheduled[position] = _scheduled[position - 1];
+            position--;
+        }
+        _scheduled[position] = change;
+        _scheduledCount++;
+        return true;
+    }
+
+    // Apply every timed change due at or before frameTime (audio thread)
+    void MixEngine::ApplyDueChanges(uint64_t frameTime)
+    {
+        int due = 0;
+        while (due < _scheduledCount && _scheduled[due].frameTime <= frameTime) {
+            const TimedParameterChange& timed = _scheduled[due];
+            ApplyLiveChange(timed.change, timed.shape, timed.rampFrames);
+            due++;
+        }
+
+        if (due == 0) return;
+        std::copy(_scheduled + due, _scheduled + _scheduledCount, _scheduled);
+        _scheduledCount -= due;
+    }
+
+    // Ramp length for untimed changes at the current sample rate
+    uint32_t MixEngine::GetSmoothingFrames() const
+    {
+        if (static_cast<RampShape>(_smoothingShape.load(std::memory_order_relaxed)) == RampShape::Step) return 0;
+
+        const float frames = _smoothingMs.load(std::memory_order_relaxed) * 0.001f * static_cast<float>(GetSampleRate());
+        return static_cast<uint32_t>(frames + 0.5f);
+    }
+
+    // Mix one chunk of the cycle into the output buffers
+    void MixEngine::MixBlock(const CompiledRoutes& routes, int numChannels, uint32_t offset, uint32_t nframes)
+    {
+        _block.routes = &routes;
+        _block.offset = offset;
+        _block.nframes = nframes;
+        _block.numChannels = numChannels;
+
+        const Layout& layout = *_current;
+        ProcessInserts(numChannels);
+        CaptureSendLevels(numChannels);
+
+        // Small graphs: every strip on this thread into the scratch buses
+        if (numChannels < kParallelMinChannels || layout.maxStripTasks == 0) {
+            std::memset(layout.busTouched, 0, layout.numOutputs);
+            MixChannels(0, numChannels, layout.mixBuses, layout.busTouched);
+
+            for (int o = 0; o < layout.numOutputs; o++) {
+                float* out = layout.outputTable[o];
+                if (out == nullptr) continue;
+
+                if (layout.busTouched[o]) {
+                    std::memcpy(out + offset, layout.mixBuses + static_cast<size_t>(o) * layout.maxFrames, sizeof(float) * nframes);
+                }
+                else {
+                    std::memset(out + offset, 0, sizeof(float) * nframes);
+                }
+            }
+            RenderBuses(numChannels);
+            return;
+        }
+
+        // The partition depends on the channel count only, never on the worker count or
+        // on which thread runs a task, so the reduced output is deterministic
+        const int tasks = std::min(layout.maxStripTasks, (numChannels + kChannelsPerStripTask - 1) / kChannelsPerStripTask);
+        _block.channelsPerTask = (numChannels + tasks - 1) / tasks;
+        _block.taskCount = (numChannels + _block.channelsPerTask - 1) / _block.channelsPerTask;
+        std::memset(layout.stripTouched, 0, static_cast<size_t>(_block.taskCount) * layout.numOutputs);
+
+        _workers.Run(_block.taskCount, MixStripTask, this);
+        _workers.Run(layout.numOutputs, ReduceOutputTask, this);
+        RenderBuses(numChannels);
+    }
+
+    // Mix the audible channels of [begin, end) into a set of buses, one per output
+    void MixEngine::MixChannels(int begin, int end, float* buses, uint8_t* touched)
+    {
+        const bool detectSilence = _silenceDetection.load(std::memory_order_relaxed);
+        const float silenceThreshold = _silenceThreshold.load(std::memory_order_relaxed);
+
+        for (int word = begin / kMaskBits; word * kMaskBits < end; word++) {
+            // While a scene crossfades, channels audible in either scene are mixed
+            uint64_t bits = _activeMask[word];
+            if (_fadeFrames > 0) bits |= _fadeMask[word];
+
+            // Clip the word to [begin, end)
+            const int first = word * kMaskBits;
+            if (begin > first) bits &= ~0ull << (begin - first);
+            if (end - first < kMaskBits) bits &= (1ull << (end - first)) - 1;
+
+            while (bits != 0) {
+                MixChannel(first + CountTrailingZeros(bits), buses, touched, detectSilence, silenceThreshold);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Mix one audible channel unless it has been silent for the hold time
+    void MixEngine::MixChannel(int channel, float* buses, uint8_t* touched, bool detectSilence, float silenceThreshold)
+    {
+        const Layout& layout = *_current;
+        const CompiledRoutes& routes = *_block.routes;
+        const uint32_t numOutputs = static_cast<uint32_t>(layout.numOutputs);
+        const uint32_t nframes = _block.nframes;
+        const ChannelParams& params = _liveParams[channel];
+        const float* in = layout.channelTable[channel];
+
+        if (_fadeFrames > 0) {
+            MixFadingChannel(channel, in, buses, touched);
+            return;
+        }
+
+        if (_ramps[channel].IsActive()) {
+            _silentFrames[channel] = 0;
+            MixRampedChannel(channel, in, buses, touched);
+            return;
+        }
+
+        // Level is non-negative, so the post-fader peak is the input's scaled. It doubles
+        // as the silence check: a channel that stays below the threshold for the hold time
+        // is idle and costs one peak pass per block until it is heard again.
+        const float level = params.gain * params.volume;
+        const float peak = level * _kernels->peak(in, nframes);
+        if (detectSilence) {
+            if (peak > silenceThreshold) {
+                _silentFrames[channel] = 0;
+            }
+            else {
+                _silentFrames[channel] = std::min(_silentFrames[channel] + std::min(nframes, layout.silenceHoldFrames),
+                                                  layout.silenceHoldFrames);
+                if (_silentFrames[channel] == layout.silenceHoldFrames) return;
+            }
+        }
+
+        layout.peakAccum[channel] = std::max(layout.peakAccum[channel], peak);
+        layout.sumSquaresAccum[channel] += level * level * _kernels->sumSquares(in, nframes);
+
+        if (routes.enabled) {
+            // Matrix routing: visit only the non-zero crosspoints of this input (the
+            // matrix spans the port capacity, so skip outputs that are not active)
+            const RouteEntry* route = routes.entries.data() + routes.rowStart[channel];
+            const RouteEntry* routeEnd = routes.entries.data() + routes.rowStart[channel + 1];
+            for (; route != routeEnd; ++route) {
+                if (route->output >= numOutputs) continue;
+                _kernels->gainAccumulate(in, level * route->gain, TouchBus(buses, touched, route->output), nframes);
+            }
+        }
+        else if (numOutputs >= 2) {
+            // Default stereo mix: simple linear pan
+            _kernels->gainPanAccumulate(in, level * (1.0f - params.pan), level * params.pan,
+                                        TouchBus(buses, touched, 0), TouchBus(buses, touched, 1), nframes);
+        }
+        else if (numOutputs == 1) {
+            _kernels->gainAccumulate(in, level, TouchBus(buses, touched, 0), nframes);
+        }
+    }
+
+    // Mix one channel whose volume, pan or gain is ramping: the gains are evaluated at
+    // segment boundaries and interpolated across each segment by the ramp kernels
+    void MixEngine::MixRampedChannel(int channel, const float* in, float* buses, uint8_t* touched)
+    {
+        const Layout& layout = *_current;
+        ChannelRamps& ramps = _ramps[channel];
+
+        float level = ramps.gain.GetValue() * ramps.volume.GetValue();
+        float pan = ramps.pan.GetValue();
+
+        for (uint32_t done = 0; done < _block.nframes;) {
+            // Segments end where a ramp does, so every ramp reaches its target on time
+            uint32_t count = std::min(kRampSegmentFrames, _block.nframes - done);
+            const uint32_t nextEnd = ramps.GetNextEnd();
+            if (nextEnd > 0) count = std::min(count, nextEnd);
+            ramps.Advance(count);
+
+            const float nextLevel = ramps.gain.GetValue() * ramps.volume.GetValue();
+            const float nextPan = ramps.pan.GetValue();
+            const float* segment = in + done;
+
+            // Meters take the louder end for peaks and the mean power for RMS
+            layout.peakAccum[channel] = std::max(layout.peakAccum[channel], std::max(level, nextLevel) * _kernels->peak(segment, count));
+            layout.sumSquaresAccum[channel] += 0.5f * (level * level + nextLevel * nextLevel) * _kernels->sumSquares(segment, count);
+
+            AccumulateSegment(*_block.routes, channel, segment, done, count, level, nextLevel, pan, nextPan, buses, touched);
+
+            level = nextLevel;
+            pan = nextPan;
+            done += count;
+        }
+    }
+
+    // Mix one channel while a scene crossfades: the old scene's contribution follows the
+    // cosine, the new one's (ramps included) the sine, both interpolated per segment
+    void MixEngine::MixFadingChannel(int channel, const float* in, float* buses, uint8_t* touched)
+    {
+        const Layout& layout = *_current;
+        const uint64_t bit = 1ull << (channel % kMaskBits);
+        const bool audible = (_activeMask[channel / kMaskBits] & bit) != 0;
+        const bool wasAudible = (_fadeMask[channel / kMaskBits] & bit) != 0;
+        const ChannelParams& from = _fadeParams[channel];
+        const float fromLevel = from.gain * from.volume;
+        ChannelRamps& ramps = _ramps[channel];
+        _silentFrames[channel] = 0;
+
+        float level = ramps.gain.GetValue() * ramps.volume.GetValue();
+        float pan = ramps.pan.GetValue();
+        float fadeIn;
+        float fadeOut;
+        GetFadeGains(_fadePosition, fadeIn, fadeOut);
+
+        for (uint32_t done = 0; done < _block.nframes;) {
+            // Segments also end where the crossfade does
+            const uint32_t position = _fadePosition + done;
+            uint32_t count = std::min(kRampSegmentFrames, _block.nframes - done);
+            const uint32_t nextEnd = ramps.GetNextEnd();
+            if (nextEnd > 0) count = std::min(count, nextEnd);
+            if (position < _fadeFrames) count = std::min(count, _fadeFrames - position);
+            ramps.Advance(count);
+
+            const float nextLevel = ramps.gain.GetValue() * ramps.volume.GetValue();
+            const float nextPan = ramps.pan.GetValue();
+            float nextFadeIn;
+            float nextFadeOut;
+            GetFadeGains(position + count, nextFadeIn, nextFadeOut);
+            const float* segment = in + done;
+
+            // Meters follow the new scene only
+            if (audible) {
+                layout.peakAccum[channel] = std::max(layout.peakAccum[channel], std::max(level, nextLevel) * _kernels->peak(segment, count));
+                layout.sumSquaresAccum[channel] += 0.5f * (level * level + nextLevel * nextLevel) * _kernels->sumSquares(segment, count);
+
+                AccumulateSegment(*_block.routes, channel, segment, done, count, level * fadeIn, nextLevel * nextFadeIn,
+                                  pan, nextPan, buses, touched);
+            }
+            if (wasAudible && fadeOut > 0.0f) {
+                AccumulateSegment(_fadeRoutes, channel, segment, done, count, fromLevel * fadeOut, fromLevel * nextFadeOut,
+                                  from.pan, from.pan, buses, touched);
+            }
+
+            level = nextLevel;
+            pan = nextPan;
+            fadeIn = nextFadeIn;
+            fadeOut = nextFadeOut;
+            done += count;
+        }
+    }
+
+    // Add one segment of a channel through a set of routes, its level and pan
+    // interpolated linearly from the segment's start to its end
+    void MixEngine::AccumulateSegment(const CompiledRoutes& routes, int channel, const float* segment, uint32_t offset, uint32_t count,
+                                      float level, float nextLevel, float pan, float nextPan, float* buses, uint8_t* touched)
+    {
+        const uint32_t numOutputs = static_cast<uint32_t>(_current->numOutputs);
+        const float levelStep = (nextLevel - level) / static_cast<float>(count);
+
+        if (routes.enabled) {
+            const RouteEntry* route = routes.entries.data() + routes.rowStart[channel];
+            const RouteEntry* routeEnd = routes.entries.data() + routes.rowStart[channel + 1];
+            for (; route != routeEnd; ++route) {
+                if (route->output >= numOutputs) continue;
+                _kernels->rampAccumulate(segment, level * route->gain, levelStep * route->gain,
+                                         TouchBus(buses, touched, route->output) + offset, count);
+            }
+        }
+        else if (numOutputs >= 2) {
+            const float left = level * (1.0f - pan);
+            const float right = level * pan;
+            const float nextLeft = nextLevel * (1.0f - nextPan);
+            const float nextRight = nextLevel * nextPan;
+            _kernels->rampPanAccumulate(segment, left, (nextLeft - left) / static_cast<float>(count),
+                                        right, (nextRight - right) / static_cast<float>(count),
+                                        TouchBus(buses, touched, 0) + offset, TouchBus(buses, touched, 1) + offset, count);
+        }
+        else if (numOutputs == 1) {
+            _kernels->rampAccumulate(segment, level, levelStep, TouchBus(buses, touched, 0) + offset, count);
+        }
+    }
+
+    // Equal-power crossfade gains at a position in the crossfade
+    void MixEngine::GetFadeGains(uint32_t position, float& fadeIn, float& fadeOut) const
+    {
+        if (position >= _fadeFrames) {
+            fadeIn = 1.0f;
+            fadeOut = 0.0f;
+            return;
+        }
+
+        const float angle = kHalfPi * static_cast<float>(position) / static_cast<float>(_fadeFrames);
+        fadeIn = std::sin(angle);
+        fadeOut = std::cos(angle);
+    }
+
+    // Point every channel at its input for this chunk, then run the insert chains of the
+    // audible channels that have them and point those at the processed block instead
+    void MixEngine::ProcessInserts(int numChannels)
+    {
+        const Layout& layout = *_current;
+        for (int i = 0; i < numChannels; i++) {
+            layout.channelTable[i] = layout.inputTable[i] + _block.offset;
+        }
+
+        const CompiledInserts& inserts = *_liveInserts;
+        if (inserts.enabledCount == 0 && inserts.bypassedCount == 0) return;
+
+        // Chains of muted channels are not run (nor counted); while a scene crossfades,
+        // channels audible in either scene are
+        const int groups = (numChannels + static_cast<int>(kInsertLanes) - 1) / static_cast<int>(kInsertLanes);
+        uint32_t running = 0;
+        uint32_t bypassed = 0;
+        for (int g = 0; g < groups; g++) {
+            uint32_t mask = 0;
+            const int first = g * static_cast<int>(kInsertLanes);
+            const int last = std::min(first + static_cast<int>(kInsertLanes), numChannels);
+            for (int channel = first; channel < last; channel++) {
+                if (inserts.bypassed[channel]) bypassed++;
+                if (!inserts.enabled[channel]) continue;
+
+                uint64_t bits = _activeMask[channel / kMaskBits];
+                if (_fadeFrames > 0) bits |= _fadeMask[channel / kMaskBits];
+                if ((bits & (1ull << (channel % kMaskBits))) == 0) continue;
+
+                mask |= 1u << (channel - first);
+                running++;
+            }
+            layout.insertMasks[g] = mask;
+        }
+        _insertChannels = running;
+        _bypassedInserts = bypassed;
+        if (running == 0) return;
+
+        // Groups are independent, so large graphs share them with the workers
+        if (numChannels >= kParallelMinChannels && layout.maxStripTasks > 0) {
+            _workers.Run(groups, InsertGroupTask, this);
+            return;
+        }
+        for (int g = 0; g < groups; g++) {
+            RunInsertGroup(g);
+        }
+    }
+
+    // Run one group's chains: interleave its running channels into the lanes (the
+    // others get silence), process the lanes and de-interleave the results
+    void MixEngine::RunInsertGroup(int group)
+    {
+        const Layout& layout = *_current;
+        const uint32_t mask = layout.insertMasks[group];
+        if (mask == 0) return;
+
+        const uint32_t nframes = _block.nframes;
+        const int first = group * static_cast<int>(kInsertLanes);
+        float* lanes = layout.insertLanes + static_cast<size_t>(group) * kInsertLanes * layout.maxFrames;
+
+        for (uint32_t l = 0; l < kInsertLanes; l++) {
+            if (mask & (1u << l)) {
+                const float* in = layout.channelTable[first + l];
+                for (uint32_t i = 0; i < nframes; i++) {
+                    lanes[static_cast<size_t>(i) * kInsertLanes + l] = in[i];
+                }
+            }
+            else {
+                for (uint32_t i = 0; i < nframes; i++) {
+                    lanes[static_cast<size_t>(i) * kInsertLanes + l] = 0.0f;
+                }
+            }
+        }
+
+        ProcessInsertGroup(*_kernels, _liveInserts->groups[group], _insertState[group], lanes, nframes);
+
+        for (uint32_t l = 0; l < kInsertLanes; l++) {
+            if ((mask & (1u << l)) == 0) continue;
+
+            float* out = layout.insertOutputs + static_cast<size_t>(first + l) * layout.maxFrames;
+            for (uint32_t i = 0; i < nframes; i++) {
+                out[i] = lanes[static_cast<size_t>(i) * kInsertLanes + l];
+            }
+            layout.channelTable[first + l] = out;
+        }
+    }
+
+    // Sum the strip tasks' buses for one output in task order
+    void MixEngine::ReduceOutput(int output)
+    {
+        const Layout& layout = *_current;
+        if (layout.outputTable[output] == nullptr) return;
+
+        float* out = layout.outputTable[output] + _block.offset;
+        bool first = true;
+
+        for (int t = 0; t < _block.taskCount; t++) {
+            const size_t bus = static_cast<size_t>(t) * layout.numOutputs + output;
+            if (!layout.stripTouched[bus]) continue;
+
+            const float* partial = layout.stripBuses + bus * layout.maxFrames;
+            if (first) {
+                std::memcpy(out, partial, sizeof(float) * _block.nframes);
+                first = false;
+            }
+            else {
+                _kernels->gainAccumulate(partial, 1.0f, out, _block.nframes);
+            }
+        }
+
+        if (first) std::memset(out, 0, sizeof(float) * _block.nframes);
+    }
+
+    // Returns a bus, clearing it on its first use in the block
+    float* MixEngine::TouchBus(float* buses, uint8_t* touched, uint32_t output)
+    {
+        float* bus = buses + static_cast<size_t>(output) * _current->maxFrames;
+        if (!touched[output]) {
+            std::memset(bus, 0, sizeof(float) * _block.nframes);
+            touched[output] = 1;
+        }
+
+        return bus;
+    }
+
+    // Record the fader levels of channels with sends before the chunk advances their ramps
+    void MixEngine::CaptureSendLevels(int numChannels)
+    {
+        const Layout& layout = *_current;
+        const CompiledBusPlan& plan = *_busPlan;
+
+        for (uint32_t s = 0; s < plan.channelSendCount; s++) {
+            const int channel = plan.steps[s].source;
+            if (channel >= numChannels) continue;
+
+            const ChannelRamps& ramps = _ramps[channel];
+            SendLevels& levels = layout.sendLevels[channel];
+            levels.preFader = ramps.gain.GetValue();
+            levels.postFader = levels.preFader * ramps.volume.GetValue();
+            levels.pan = ramps.pan.GetValue();
+        }
+    }
+
+    // Run the bus plan over the chunk: clear the lanes, add the channel sends, then sum
+    // each bus into the buses and outputs it feeds, in plan order
+    void MixEngine::RenderBuses(int numChannels)
+    {
+        const CompiledBusPlan& plan = *_busPlan;
+        if (plan.steps.empty()) return;
+
+        const Layout& layout = *_current;
+        const uint32_t nframes = _block.nframes;
+
+        // A plan's first chunk ramps from the gains of the plan before it
+        const bool rampPlan = plan.version != _busPlanVersion;
+        _busPlanVersion = plan.version;
+
+        for (uint32_t lane = 0; lane < plan.laneCount; lane++) {
+            std::memset(layout.busLanes + static_cast<size_t>(lane) * layout.maxFrames, 0, sizeof(float) * nframes);
+        }
+
+        for (uint32_t s = 0; s < plan.channelSendCount; s++) {
+            const BusStep& step = plan.steps[s];
+            if (step.source >= numChannels) continue;
+            if ((_activeMask[step.source / kMaskBits] & (1ull << (step.source % kMaskBits))) == 0) continue;
+
+            RenderChannelSend(step, rampPlan);
+        }
+
+        for (size_t s = plan.channelSendCount; s < plan.steps.size(); s++) {
+            const BusStep& step = plan.steps[s];
+            const float start = rampPlan ? step.startGain[0] : step.gain[0];
+            if (start == 0.0f && step.gain[0] == 0.0f) continue;
+
+            float* out;
+            if (step.type == BusStepType::LaneSend) {
+                out = layout.busLanes + static_cast<size_t>(step.destination) * layout.maxFrames;
+            }
+            else {
+                // Outputs the caller has no buffer for (or beyond the active ports) are skipped
+                if (step.destination >= layout.numOutputs || layout.outputTable[step.destination] == nullptr) continue;
+                out = layout.outputTable[step.destination] + _block.offset;
+            }
+
+            const float* in = layout.busLanes + static_cast<size_t>(step.source) * layout.maxFrames;
+            if (start == step.gain[0]) {
+                _kernels->gainAccumulate(in, start, out, nframes);
+            }
+            else {
+                _kernels->rampAccumulate(in, start, (step.gain[0] - start) / static_cast<float>(nframes), out, nframes);
+            }
+        }
+    }
+
+    // Add one channel send, scaled by the channel's pre- or post-fader level: ramped from
+    // the levels at the start of the chunk (and a new plan's previous gains) to the end
+    void MixEngine::RenderChannelSend(const BusStep& step, bool rampPlan)
+    {
+        const Layout& layout = *_current;
+        const uint32_t nframes = _block.nframes;
+        const float* in = layout.channelTable[step.source];
+        float* lane = layout.busLanes + static_cast<size_t>(step.destination) * layout.maxFrames;
+        const SendLevels& from = layout.sendLevels[step.source];
+        const ChannelRamps& ramps = _ramps[step.source];
+        const float* startGain = rampPlan ? step.startGain : step.gain;
+
+        const float gain = ramps.gain.GetValue();
+        const float fromLevel = step.postFader ? from.postFader : from.preFader;
+        const float toLevel = step.postFader ? gain * ramps.volume.GetValue() : gain;
+
+        if (step.lanes == 1) {
+            const float start = startGain[0] * fromLevel;
+            const float end = step.gain[0] * toLevel;
+            if (start == end) {
+                if (end != 0.0f) _kernels->gainAccumulate(in, end, lane, nframes);
+            }
+            else {
+                _kernels->rampAccumulate(in, start, (end - start) / static_cast<float>(nframes), lane, nframes);
+            }
+            return;
+        }
+
+        // Post-fader sends into stereo buses follow the channel's pan
+        float startLeft = startGain[0] * fromLevel;
+        float startRight = startGain[1] * fromLevel;
+        float endLeft = step.gain[0] * toLevel;
+        float endRight = step.gain[1] * toLevel;
+        if (step.postFader) {
+            const float pan = ramps.pan.GetValue();
+            startLeft *= 1.0f - from.pan;
+            startRight *= from.pan;
+            endLeft *= 1.0f - pan;
+            endRight *= pan;
+        }
+
+        float* right = lane + layout.maxFrames;
+        if (startLeft == endLeft && startRight == endRight) {
+            _kernels->gainPanAccumulate(in, endLeft, endRight, lane, right, nframes);
+        }
+        else {
+            _kernels->rampPanAccumulate(in, startLeft, (endLeft - startLeft) / static_cast<float>(nframes),
+                                        startRight, (endRight - startRight) / static_cast<float>(nframes), lane, right, nframes);
+        }
+    }
+
+    void MixEngine::MixStripTask(void* context, int task)
+    {
+        auto engine = static_cast<MixEngine*>(context);
+        const Layout& layout = *engine->_current;
+        const size_t buses = static_cast<size_t>(task) * layout.numOutputs;
+        const int begin = task * engine->_block.channelsPerTask;
+        const int end = std::min(begin + engine->_block.channelsPerTask, engine->_block.numChannels);
+
+        engine->MixChannels(begin, end, layout.stripBuses + buses * layout.maxFrames, layout.stripTouched + buses);
+    }
+
+    void MixEngine::ReduceOutputTask(void* context, int output)
+    {
+        static_cast<MixEngine*>(context)->ReduceOutput(output);
+    }
+
+    void MixEngine::InsertGroupTask(void* context, int group)
+    {
+        static_cast<MixEngine*>(context)->RunInsertGroup(group);
+    }
+}
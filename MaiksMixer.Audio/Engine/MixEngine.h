@@ -0,0 +1,522 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "AnalysisTaps.h"
+#include "BusGraph.h"
+#include "ChannelInserts.h"
+#include "DiskRecorder.h"
+#include "EngineArena.h"
+#include "EngineCommandQueue.h"
+#include "EngineTelemetry.h"
+#include "MeterBank.h"
+#include "MixKernels.h"
+#include "MixScene.h"
+#include "ParameterRamp.h"
+#include "ParameterState.h"
+#include "PortGraphCache.h"
+#include "PortHandleTable.h"
+#include "RcuDomain.h"
+#include "RoutingMatrix.h"
+#include "RtWorkerPool.h"
+#include "VirtualSources.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Mix engine rendered by the JACK client's process callback. Parameters are edited
+    /// from control threads through Parameters(); Process() only ever reads the snapshot
+    /// published for the current cycle. Volume, pan and gain changes are smoothed with
+    /// per-channel ramps, and timed changes split the cycle so they land on their frame.
+    /// Channels with insert chains (EQ, gate, compressor) are processed before their
+    /// faders, kInsertLanes channels at a time.
+    ///
+    /// Every per-cycle structure (port buffer tables, mix buses, meter accumulators) lives
+    /// in the arena of a layout built for the active port counts and block size, so
+    /// Process() never allocates. Layouts are rebuilt on a control thread and swapped in
+    /// between cycles (RCU), so ports can be added and removed while audio is running.
+    ///
+    /// Scenes (full parameter and routing state) are compiled on control threads and
+    /// recalled in one cycle, optionally crossfading from the mix that was playing.
+    ///
+    /// Aux, subgroup and master buses run after the main mix of each chunk: channel sends
+    /// fill the bus lanes, and the compiled bus plan's steps sum the buses into each other
+    /// and onto their output ports in one pass.
+    /// </summary>
+    class MixEngine
+    {
+    public:
+        // Block size and sample rate assumed until the server's are known
+        static constexpr uint32_t kDefaultMaxFrames = 1024;
+        static constexpr uint32_t kDefaultSampleRate = 48000;
+
+        // Port capacity reserved by clients that create ports at runtime
+        static constexpr int kDefaultInputCapacity = 64;
+        static constexpr int kDefaultOutputCapacity = 32;
+
+        // Channel counts from which strips are mixed in parallel tasks (smaller graphs
+        // take the single-threaded path)
+        static constexpr int kParallelMinChannels = 32;
+
+        // Channel strips per parallel task, and the task limit beyond which strips per
+        // task grow instead
+        static constexpr int kChannelsPerStripTask = 8;
+        static constexpr int kMaxStripTasks = 64;
+
+        // Timed parameter changes waiting for their frame
+        static constexpr int kMaxScheduledChanges = 256;
+
+        // While a channel ramps, its gains are recomputed every this many frames and
+        // interpolated linearly in between
+        static constexpr uint32_t kRampSegmentFrames = 32;
+
+        // Smoothing of untimed volume, pan and gain changes
+        static constexpr float kDefaultSmoothingMs = 10.0f;
+
+        // Post-fader peak at or below which a block counts as silent (exact digital silence
+        // by default, so skipping never changes the mix), and how long a channel must stay
+        // silent before it is skipped
+        static constexpr float kDefaultSilenceThreshold = 0.0f;
+        static constexpr uint32_t kSilenceHoldMs = 100;
+
+        // Process() frame time argument that continues the engine's own frame clock
+        static constexpr uint64_t kNoFrameTime = ~0ull;
+
+        MixEngine();
+        ~MixEngine();
+
+        MixEngine(const MixEngine&) = delete;
+        MixEngine& operator=(const MixEngine&) = delete;
+
+        /// <summary>
+        /// Sizes the engine for the given port counts, reserving parameter, routing and
+        /// meter storage for up to inputCapacity/outputCapacity ports (at least the port
+        /// counts) so SetActivePorts() can add ports later. Must be called before the client
+        /// is activated (never while Process() may be running).
+        /// </summary>
+        void ConfigurePorts(int numInputs, int numOutputs, int inputCapacity = 0, int outputCapacity = 0);
+
+        /// <summary>
+        /// Builds the per-cycle layout for blocks of up to maxFrames frames and swaps it in
+        /// at a cycle boundary; longer blocks are rendered in chunks. Control threads only.
+        /// </summary>
+        void Prepare(uint32_t maxFrames);
+
+        /// <summary>
+        /// Sets the sample rate of the meters, telemetry and every rate-dependent per-cycle
+        /// structure, rebuilding the layout and swapping it in at a cycle boundary like
+        /// Prepare(). Control threads only.
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Keeps the engine's real-time memory in RAM (best effort). The per-channel and
+        /// per-cycle arenas, including those rebuilt after a buffer size or sample rate
+        /// change, lock their own pages and the audio and worker threads lock their stacks,
+        /// so by default this only reports whether the current arenas are locked. The rest
+        /// is ordinary heap that can still fault: the MixEngine object with its command
+        /// rings, the parameter and routing snapshots, the meter frames and the analysis,
+        /// recorder and virtual-source rings. lockProcess locks every current and future
+        /// page of the process (mlockall), those and the host's heap included; it is an
+        /// explicit opt-in for machines dedicated to the mixer. Returns true if the
+        /// requested memory is locked.
+        /// </summary>
+        bool LockMemory(bool lockProcess = false);
+
+        /// <summary>
+        /// Changes the number of active ports (clamped to the reserved capacity) while the
+        /// engine may be running: the new layout is built on the calling thread, published
+        /// between two cycles and the old one freed once no cycle can still use it. Removed
+        /// channels are reset to defaults and lose their routes. Control threads only.
+        /// </summary>
+        void SetActivePorts(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Sets the function that registers or unregisters the client's ports for a new
+        /// port count and then calls SetActivePorts() (installed by the JACK client owner)
+        /// </summary>
+        void SetPortRegistrar(std::function<bool(int numInputs, int numOutputs)> registrar);
+
+        /// <summary>
+        /// Changes the port counts at runtime through the port registrar, or directly with
+        /// SetActivePorts() if none is installed. Returns false if registration failed.
+        /// </summary>
+        bool ResizePorts(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Sets the ramp applied to volume, pan and gain changes made through Parameters()
+        /// or PostParameterChange() (Step or 0 ms for hard steps)
+        /// </summary>
+        void SetSmoothing(RampShape shape, float milliseconds);
+
+        /// <summary>
+        /// Enables skipping of channels that have been silent for kSilenceHoldMs (on by
+        /// default). A skipped channel is still checked every block and rejoins the mix
+        /// on the first block above the silence threshold.
+        /// </summary>
+        void SetSilenceDetection(bool enabled) { _silenceDetection.store(enabled, std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Sets the post-fader peak (linear, 0 by default) at or below which a block counts
+        /// as silent. Anything above 0 drops channels whose level stays under it, such as
+        /// the end of a reverb tail, in exchange for skipping them sooner.
+        /// </summary>
+        void SetSilenceThreshold(float threshold)
+        {
+            _silenceThreshold.store(std::max(threshold, 0.0f), std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Queues a parameter change for the frame it is stamped with, ramping from there
+        /// with its own shape and length. Changes stamped with a frame the engine has
+        /// already rendered apply at the start of the next cycle. Returns the command id,
+        /// acknowledged once the audio thread has scheduled (or rejected) the change, or 0
+        /// if the change is invalid or the queue is full. Callers that never read
+        /// acknowledgements pass acknowledge = false so they do not crowd out anyone else's.
+        /// Unlike untimed changes these are not reflected in Parameters().
+        /// </summary>
+        uint32_t ScheduleParameterChange(const TimedParameterChange& change, bool acknowledge = true);
+
+        /// <summary>
+        /// Whether ScheduleParameterChange() accepts the change when the queue has room
+        /// </summary>
+        static bool IsValidTimedChange(const TimedParameterChange& change);
+
+        /// <summary>
+        /// Captures the staged channel parameters and routing matrix (control threads)
+        /// </summary>
+        SceneSnapshot CaptureScene();
+
+        /// <summary>
+        /// Compiles a scene for the engine's current port capacity: parameters are clamped
+        /// and the matrix is fitted to the capacity and compiled to sparse rows. Control
+        /// threads; may run while Process() is running.
+        /// </summary>
+        std::shared_ptr<const CompiledScene> CompileScene(const SceneSnapshot& snapshot);
+
+        /// <summary>
+        /// Recalls a compiled scene: the audio thread swaps every channel's parameters and
+        /// the whole routing matrix in at the start of one cycle, after every command
+        /// queued before it. With a crossfade the mix that was playing fades out on a
+        /// cosine while the scene fades in on a sine (equal power); a recall during a
+        /// crossfade fades from the scene that was fading in. Parameters() and Routing()
+        /// take the scene's state too. Channels the scene does not cover are reset to
+        /// defaults; the port counts are unchanged. Returns the command id, or 0 if the
+        /// scene was compiled for another capacity or the queue is full. Control threads.
+        /// </summary>
+        uint32_t RecallScene(std::shared_ptr<const CompiledScene> scene, float crossfadeMs);
+
+        /// <summary>
+        /// Frame time of the first frame of the most recent cycle
+        /// </summary>
+        uint64_t GetFrameTime() const { return _frameTime.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Kernel table used by Process()
+        /// </summary>
+        const MixKernels& GetKernels() const { return *_kernels; }
+
+        /// <summary>
+        /// Replaces the kernel table (benchmarks and tests). Must not be called while
+        /// Process() may be running.
+        /// </summary>
+        void SetKernels(const MixKernels& kernels) { _kernels = &kernels; }
+
+        /// <summary>
+        /// Channel parameter store (control threads)
+        /// </summary>
+        ParameterState& Parameters() { return _parameters; }
+
+        /// <summary>
+        /// Input x output routing matrix (control threads)
+        /// </summary>
+        RoutingMatrix& Routing() { return _routing; }
+
+        /// <summary>
+        /// Per-channel insert chains (control threads)
+        /// </summary>
+        InsertBank& Inserts() { return _inserts; }
+
+        /// <summary>
+        /// Aux, subgroup and master buses and the sends feeding them (control threads)
+        /// </summary>
+        BusGraph& Buses() { return _buses; }
+
+        /// <summary>
+        /// Channel meters, published at a throttled rate (control threads)
+        /// </summary>
+        MeterBank& Meters() { return _meterBank; }
+
+        /// <summary>
+        /// Cached JACK port graph, kept current by the client's port notifications
+        /// </summary>
+        PortGraphCache& PortGraph() { return _portGraph; }
+
+        /// <summary>
+        /// Interned port name handles (control threads)
+        /// </summary>
+        PortHandleTable& PortHandles() { return _portHandles; }
+
+        /// <summary>
+        /// Command queue drained by Process() (control/IPC threads post, the audio thread
+        /// executes and acknowledges)
+        /// </summary>
+        EngineCommandQueue& Commands() { return _commands; }
+
+        /// <summary>
+        /// Cycle timing histogram, xrun and latency counters (any thread)
+        /// </summary>
+        EngineTelemetry& Telemetry() { return _telemetry; }
+
+        /// <summary>
+        /// Spectrum and loudness taps on channels and outputs, reserved to the port
+        /// capacity and fed at the end of every cycle (control threads)
+        /// </summary>
+        AnalysisTaps& Analysis() { return _analysis; }
+
+        /// <summary>
+        /// Multitrack recorder of channels and outputs, fed at the end of every cycle
+        /// (control threads)
+        /// </summary>
+        DiskRecorder& Recorder() { return _recorder; }
+
+        /// <summary>
+        /// Devices on independent clocks resampled into channels at the start of every
+        /// cycle (control threads and device writers)
+        /// </summary>
+        VirtualSourceBank& VirtualSources() { return _virtualSources; }
+
+        /// <summary>
+        /// Worker threads that share the channel strips of large graphs with the process
+        /// callback. Start and stop them only while Process() is not running. Strips are
+        /// grouped into tasks by channel count alone and the group sums are reduced in task
+        /// order, so the output is identical with any number of workers (including none).
+        /// </summary>
+        RtWorkerPool& Workers() { return _workers; }
+
+        /// <summary>
+        /// Stages a parameter change and queues it for the process callback, which applies
+        /// it at the start of its next cycle. Returns the command id, or 0 if the change is
+        /// invalid or the queue is full.
+        /// </summary>
+        uint32_t PostParameterChange(const ParameterChange& change);
+
+        int GetInputCount() const { return _numInputs.load(std::memory_order_relaxed); }
+        int GetOutputCount() const { return _numOutputs.load(std::memory_order_relaxed); }
+        int GetInputCapacity() const { return _inputCapacity; }
+        int GetOutputCapacity() const { return _outputCapacity; }
+        uint32_t GetMaxFrames() const { return _maxFrames.load(std::memory_order_relaxed); }
+        uint32_t GetSampleRate() const { return _sampleRate.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Renders one cycle: applies gain and volume to every audible input and sums it
+        /// into the outputs, either through the routing matrix or, while it is disabled,
+        /// panned across outputs 1/2. The caller's port counts may briefly differ from the
+        /// engine's while ports are added or removed: channels without an input buffer are
+        /// skipped and outputs the engine does not drive are silenced. frameTime is the
+        /// server frame time of the cycle's first frame (kNoFrameTime continues from the
+        /// previous cycle); timed changes are placed relative to it. The cycle's duration
+        /// is recorded in Telemetry(). Real-time safe.
+        /// </summary>
+        void Process(const float* const* inputs, int numInputs, float* const* outputs, int numOutputs, uint32_t nframes,
+                     uint64_t frameTime = kNoFrameTime);
+
+        /// <summary>
+        /// Renders one cycle with one buffer per active input and output port
+        /// </summary>
+        void Process(const float* const* inputs, float* const* outputs, uint32_t nframes);
+
+        /// <summary>
+        /// Returns the latest published meters for a channel
+        /// </summary>
+        ChannelMeterFrame GetChannelMeter(int channel) { return _meterBank.GetChannel(channel); }
+
+    private:
+        /// <summary>
+        /// Levels a channel's sends are scaled by, captured before its ramps advance
+        /// </summary>
+        struct SendLevels
+        {
+            float preFader;     // Gain
+            float postFader;    // Gain x volume
+            float pan;
+        };
+
+        /// <summary>
+        /// Per-cycle structures for one set of port counts and block size
+        /// </summary>
+        struct Layout
+        {
+            int numInputs = 0;
+            int numOutputs = 0;
+            uint32_t maxFrames = 0;
+            uint32_t sampleRate = 0;
+            uint32_t silenceHoldFrames = 0;
+            int maxStripTasks = 0;
+
+            EngineArena arena;
+            const float** inputTable = nullptr;
+            const float** channelTable = nullptr;   // Per channel: the chunk being mixed (insert output where chains run)
+            float** outputTable = nullptr;      // nullptr for outputs the caller has no buffer for
+            float* mixBuses = nullptr;          // numOutputs buses of maxFrames samples
+            uint8_t* busTouched = nullptr;      // Per bus: written this block (untouched buses are not cleared)
+            float* stripBuses = nullptr;        // Per strip task: numOutputs buses of maxFrames samples
+            uint8_t* stripTouched = nullptr;    // Per strip task and bus
+            float* peakAccum = nullptr;         // Per channel, across chunks of one cycle; negative if not metered
+            float* sumSquaresAccum = nullptr;   // Per channel, across chunks of one cycle
+            float* insertLanes = nullptr;       // Per insert group: maxFrames x kInsertLanes interleaved samples
+            float* insertOutputs = nullptr;     // Per channel: maxFrames samples of insert output
+            uint32_t* insertMasks = nullptr;    // Per insert group: lanes whose chains run this chunk
+            float* busLanes = nullptr;          // BusGraph::kMaxLanes lanes of maxFrames samples
+            SendLevels* sendLevels = nullptr;   // Per channel: fader levels at the start of the chunk
+        };
+
+        std::unique_ptr<Layout> BuildLayout(int numInputs, int numOutputs, uint32_t maxFrames, uint32_t sampleRate) const;
+        void PublishLayoutLocked(int numInputs, int numOutputs, uint32_t maxFrames, uint32_t sampleRate);
+        void SyncLiveParameters(const ParameterSnapshot& snapshot);
+        void SyncLiveRoutes(const CompiledRoutes& routes);
+        bool ApplyScene(const SceneRecall& recall);
+        EngineCommandStatus ExecuteCommand(const EngineCommand& command);
+        bool ApplyLiveChange(const ParameterChange& change, RampShape shape, uint32_t rampFrames);
+        bool InsertScheduled(const TimedParameterChange& change);
+        void ApplyDueChanges(uint64_t frameTime);
+        uint32_t GetSmoothingFrames() const;
+        void UpdateActiveMask();
+        void MixChannel(int channel, float* buses, uint8_t* touched, bool detectSilence, float silenceThreshold);
+        void MixRampedChannel(int channel, const float* in, float* buses, uint8_t* touched);
+        void MixFadingChannel(int channel, const float* in, float* buses, uint8_t* touched);
+        void AccumulateSegment(const CompiledRoutes& routes, int channel, const float* segment, uint32_t offset, uint32_t count,
+                               float level, float nextLevel, float pan, float nextPan, float* buses, uint8_t* touched);
+        void GetFadeGains(uint32_t position, float& fadeIn, float& fadeOut) const;
+        void MixBlock(const CompiledRoutes& routes, int numChannels, uint32_t offset, uint32_t nframes);
+        void ProcessInserts(int numChannels);
+        void RunInsertGroup(int group);
+        void MixChannels(int begin, int end, float* buses, uint8_t* touched);
+        void ReduceOutput(int output);
+        float* TouchBus(float* buses, uint8_t* touched, uint32_t output);
+        void CaptureSendLevels(int numChannels);
+        void RenderBuses(int numChannels);
+        void RenderChannelSend(const BusStep& step, bool rampPlan);
+        static void MixStripTask(void* context, int task);
+        static void ReduceOutputTask(void* context, int output);
+        static void InsertGroupTask(void* context, int group);
+
+        ParameterState _parameters;
+        RoutingMatrix _routing;
+        InsertBank _inserts;
+        BusGraph _buses;
+        MeterBank _meterBank;
+        PortGraphCache _portGraph;
+        PortHandleTable _portHandles;
+        EngineCommandQueue _commands;
+        EngineTelemetry _telemetry;
+        AnalysisTaps _analysis;
+        DiskRecorder _recorder;
+        VirtualSourceBank _virtualSources;
+
+        // Active port counts, block size and sample rate of the latest layout (read by any thread)
+        std::atomic<int> _numInputs;
+        std::atomic<int> _numOutputs;
+        std::atomic<uint32_t> _maxFrames;
+        std::atomic<uint32_t> _sampleRate;
+        int _inputCapacity;
+        int _outputCapacity;
+
+        // Layout swapped in by control threads; _current is the one the running cycle uses
+        RcuDomain _rcu;
+        RcuPointer<Layout> _layout;
+        Layout* _current;
+        std::mutex _layoutMutex;
+        std::function<bool(int, int)> _portRegistrar;
+
+        // Parameters the audio thread renders with: the latest snapshot plus the commands
+        // executed since it was published, with the ramps currently smoothing them and the
+        // snapshot values they were last synced from. Sized to the input capacity.
+        EngineArena _channelArena;
+        ChannelParams* _liveParams;
+        ChannelRamps* _ramps;
+        ChannelParams* _syncedParams;
+
+        // Audible channels (not muted, and soloed while any channel is), one bit each,
+        // rebuilt whenever mute, solo or the channel count change; and the frames each
+        // channel has been silent for, up to the hold time
+        uint64_t* _activeMask;
+        uint32_t* _silentFrames;
+        std::atomic<bool> _silenceDetection;
+        std::atomic<float> _silenceThreshold;
+        int _liveChannelCount;
+        bool _liveAnySolo;
+        uint64_t _liveVersion;
+        uint64_t _cycle;
+
+        // Insert chains of the current cycle, the filter and dynamics state of each group
+        // of kInsertLanes channels (sized to the input capacity), and the channels whose
+        // chains ran or were bypassed in the last chunk
+        const CompiledInserts* _liveInserts;
+        InsertGroupState* _insertState;
+        uint32_t _insertChannels;
+        uint32_t _bypassedInserts;
+
+        // Bus plan of the current cycle, and the version of the last plan rendered (a new
+        // plan ramps its gains over its first block)
+        const CompiledBusPlan* _busPlan;
+        uint64_t _busPlanVersion;
+
+        // Routing matrix the audio thread renders with, copied from the latest published
+        // matrix (or a recalled scene's) into storage sized to the port capacity
+        CompiledRoutes _liveRoutes;
+
+        // Scene being recalled. The audio thread holds back parameter snapshots and
+        // matrices that do not descend from the last scene it applied, so a recall never
+        // reaches it half-published.
+        struct SceneSlot
+        {
+            uint64_t id;
+            std::shared_ptr<const CompiledScene> scene;
+        };
+        RcuPointer<SceneSlot> _scene;
+        std::mutex _sceneMutex;
+        uint64_t _sceneCounter;
+        uint64_t _liveScene;
+
+        // Crossfade from the state that was playing when a scene was recalled: its
+        // parameters (ramps settled where they were), audible channels and matrix
+        ChannelParams* _fadeParams;
+        uint64_t* _fadeMask;
+        CompiledRoutes _fadeRoutes;
+        uint32_t _fadeFrames;       // 0 while no crossfade runs
+        uint32_t _fadePosition;
+
+        // Timed changes ordered by frame (audio thread)
+        TimedParameterChange* _scheduled;
+        int _scheduledCount;
+        uint64_t _nextFrameTime;
+        std::atomic<uint64_t> _frameTime;
+
+        std::atomic<int32_t> _smoothingShape;
+        std::atomic<float> _smoothingMs;
+
+        // Block being mixed by the strip tasks
+        struct StripBlock
+        {
+            const CompiledRoutes* routes;
+            uint32_t offset;
+            uint32_t nframes;
+            int numChannels;
+            int channelsPerTask;
+            int taskCount;
+        };
+        StripBlock _block;
+
+        // Kernel table chosen for this CPU at construction
+        const MixKernels* _kernels;
+
+        // Declared last so the workers stop before anything they touch is destroyed
+        RtWorkerPool _workers;
+    };
+}
@@ -0,0 +1,241 @@
+#include "MixKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if EMP_KERNELS_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace emp {
+
+    namespace {
+
+        void ScalarGainAccumulate(const float* in, float gain, float* out, uint32_t nframes)
+        {
+            for (uint32_t i = 0; i < nframes; i++) {
+                out[i] += in[i] * gain;
+            }
+        }
+
+        void ScalarGainPanAccumulate(const float* in, float gainLeft, float gainRight,
+                                     float* outLeft, float* outRight, uint32_t nframes)
+        {
+            for (uint32_t i = 0; i < nframes; i++) {
+                outLeft[i] += in[i] * gainLeft;
+                outRight[i] += in[i] * gainRight;
+            }
+        }
+
+        void ScalarRampAccumulate(const float* in, float gain, float gainStep, float* out, uint32_t nframes)
+        {
+            for (uint32_t i = 0; i < nframes; i++) {
+                out[i] += in[i] * (gain + gainStep * static_cast<float>(i));
+            }
+        }
+
+        void ScalarRampPanAccumulate(const float* in, float gainLeft, float stepLeft, float gainRight, float stepRight,
+                                     float* outLeft, float* outRight, uint32_t nframes)
+        {
+            for (uint32_t i = 0; i < nframes; i++) {
+                const float index = static_cast<float>(i);
+                outLeft[i] += in[i] * (gainLeft + stepLeft * index);
+                outRight[i] += in[i] * (gainRight + stepRight * index);
+            }
+        }
+
+        float ScalarPeak(const float* in, uint32_t nframes)
+        {
+            float peak = 0.0f;
+            for (uint32_t i = 0; i < nframes; i++) {
+                peak = std::max(peak, std::abs(in[i]));
+            }
+            return peak;
+        }
+
+        // Same partial sums and folds as the dot product, so every table meters alike; the
+        // frames past the last whole group are added one by one
+        float ScalarSumSquares(const float* in, uint32_t nframes)
+        {
+            float sums[kDotLanes] = {};
+            uint32_t i = 0;
+            for (; i + kDotLanes <= nframes; i += kDotLanes) {
+                for (uint32_t l = 0; l < kDotLanes; l++) {
+                    sums[l] += in[i + l] * in[i + l];
+                }
+            }
+            for (uint32_t width = kDotLanes / 2; width > 0; width /= 2) {
+                for (uint32_t l = 0; l < width; l++) {
+                    sums[l] += sums[l + width];
+                }
+            }
+            float sum = sums[0];
+            for (; i < nframes; i++) {
+                sum += in[i] * in[i];
+            }
+            return sum;
+        }
+
+        void ScalarBiquadLanes(float* lanes, uint32_t nframes, const float* coefficients, float* state)
+        {
+            const float* b0 = coefficients;
+            const float* b1 = coefficients + kInsertLanes;
+            const float* b2 = coefficients + kInsertLanes * 2;
+            const float* a1 = coefficients + kInsertLanes * 3;
+            const float* a2 = coefficients + kInsertLanes * 4;
+            float* z1 = state;
+            float* z2 = state + kInsertLanes;
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                for (uint32_t l = 0; l < kInsertLanes; l++) {
+                    const float x = frame[l];
+                    const float y = b0[l] * x + z1[l];
+                    z1[l] = b1[l] * x - a1[l] * y + z2[l];
+                    z2[l] = b2[l] * x - a2[l] * y;
+                    frame[l] = y;
+                }
+            }
+        }
+
+        void ScalarDynamicsLanes(float* lanes, uint32_t nframes, uint32_t position, const float* decay,
+                                 const float* gain, const float* gainStep, float* envelope)
+        {
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                const float index = static_cast<float>(position + i);
+                for (uint32_t l = 0; l < kInsertLanes; l++) {
+                    const float x = frame[l];
+                    envelope[l] = std::max(std::abs(x), envelope[l] * decay[l]);
+                    frame[l] = x * (gain[l] + gainStep[l] * index);
+                }
+            }
+        }
+
+        void ScalarInterpolateTaps(const float* base, const float* delta, float fraction, float* out, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = base[i] + delta[i] * fraction;
+            }
+        }
+
+        float ScalarDotProduct(const float* a, const float* b, uint32_t count)
+        {
+            float sums[kDotLanes] = {};
+            for (uint32_t i = 0; i < count; i += kDotLanes) {
+                for (uint32_t l = 0; l < kDotLanes; l++) {
+                    sums[l] += a[i + l] * b[i + l];
+                }
+            }
+            for (uint32_t width = kDotLanes / 2; width > 0; width /= 2) {
+                for (uint32_t l = 0; l < width; l++) {
+                    sums[l] += sums[l + width];
+                }
+            }
+            return sums[0];
+        }
+
+#if EMP_KERNELS_X86
+        void CpuId(int leaf, int subLeaf, unsigned int regs[4])
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, leaf, subLeaf);
+            for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+            __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        }
+
+        // Register state the OS saves on context switch (XCR0)
+        unsigned long long ReadXcr0()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned int eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+        }
+#endif
+    }
+
+    const MixKernels kScalarMixKernels = {
+        KernelIsa::Scalar,
+        "scalar",
+        ScalarGainAccumulate,
+        ScalarGainPanAccumulate,
+        ScalarRampAccumulate,
+        ScalarRampPanAccumulate,
+        ScalarPeak,
+        ScalarSumSquares,
+        ScalarBiquadLanes,
+        ScalarDynamicsLanes,
+        ScalarInterpolateTaps,
+        ScalarDotProduct
+    };
+
+    // Detect Kernel ISA
+    KernelIsa DetectKernelIsa()
+    {
+#if EMP_KERNELS_X86
+        unsigned int regs[4];
+        CpuId(0, 0, regs);
+        const unsigned int maxLeaf = regs[0];
+
+        CpuId(1, 0, regs);
+        const bool sse2 = (regs[3] & (1u << 26)) != 0;
+        const bool osxsave = (regs[2] & (1u << 27)) != 0;
+        const bool avx = (regs[2] & (1u << 28)) != 0;
+        if (!sse2) return KernelIsa::Scalar;
+        if (!osxsave || !avx || maxLeaf < 7) return KernelIsa::Sse2;
+
+        const unsigned long long xcr0 = ReadXcr0();
+        const bool ymmState = (xcr0 & 0x6) == 0x6;
+        const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+        CpuId(7, 0, regs);
+        const bool avx2 = (regs[1] & (1u << 5)) != 0;
+        const bool avx512f = (regs[1] & (1u << 16)) != 0;
+
+        if (avx512f && zmmState) return KernelIsa::Avx512;
+        if (avx2 && ymmState) return KernelIsa::Avx2;
+        return KernelIsa::Sse2;
+#else
+        return KernelIsa::Scalar;
+#endif
+    }
+
+    // Get Mix Kernels
+    const MixKernels* GetMixKernels(KernelIsa isa)
+    {
+        if (isa > DetectKernelIsa()) return nullptr;
+
+        switch (isa) {
+        case KernelIsa::Scalar:
+            return &kScalarMixKernels;
+#if EMP_KERNELS_X86
+        case KernelIsa::Sse2:
+            return &kSse2MixKernels;
+        case KernelIsa::Avx2:
+            return &kAvx2MixKernels;
+        case KernelIsa::Avx512:
+            return &kAvx512MixKernels;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    // Get Active Mix Kernels
+    const MixKernels& GetActiveMixKernels()
+    {
+        static const MixKernels* active = GetMixKernels(DetectKernelIsa());
+        return *active;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+namespace emp {
+
+    /// <summary>
+    /// Instruction set a kernel table is implemented with
+    /// </summary>
+    enum class KernelIsa
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+        Avx512
+    };
+
+    // Channels the insert kernels process side by side (structure of arrays): sample i of
+    // lane l is at lanes[i * kInsertLanes + l], and every per-lane coefficient or state is
+    // an array of kInsertLanes values. One AVX-512 vector holds a whole group, AVX2 two
+    // and SSE2 four vectors.
+    constexpr uint32_t kInsertLanes = 16;
+
+    // Dot products and sums of squares run over groups of this many values: element i adds
+    // to partial sum i % kDotLanes, and the partial sums are folded in halves (8, 4, 2, 1),
+    // so every table adds in the same order whatever its vector width
+    constexpr uint32_t kDotLanes = 16;
+
+    /// <summary>
+    /// Table of mixing, metering, insert and resampler kernels for one instruction set. Kernels
+    /// accept unaligned buffers and any frame count. Every table performs the same float
+    /// operations per sample in the same order, so all of them produce bit-identical mixes and
+    /// meters.
+    /// </summary>
+    struct MixKernels
+    {
+        KernelIsa isa;
+        const char* name;
+
+        // out[i] += in[i] * gain
+        void (*gainAccumulate)(const float* in, float gain, float* out, uint32_t nframes);
+
+        // outLeft[i] += in[i] * gainLeft; outRight[i] += in[i] * gainRight
+        void (*gainPanAccumulate)(const float* in, float gainLeft, float gainRight,
+                                  float* outLeft, float* outRight, uint32_t nframes);
+
+        // out[i] += in[i] * (gain + gainStep * i)
+        void (*rampAccumulate)(const float* in, float gain, float gainStep, float* out, uint32_t nframes);
+
+        // outLeft[i] += in[i] * (gainLeft + stepLeft * i); outRight likewise
+        void (*rampPanAccumulate)(const float* in, float gainLeft, float stepLeft, float gainRight, float stepRight,
+                                  float* outLeft, float* outRight, uint32_t nframes);
+
+        // max(|in[i]|)
+        float (*peak)(const float* in, uint32_t nframes);
+
+        // sum(in[i] * in[i]), reduced in the same kDotLanes partial sums as dotProduct
+        float (*sumSquares)(const float* in, uint32_t nframes);
+
+        // One transposed direct form II biquad per lane, in place. coefficients holds b0,
+        // b1, b2, a1 and a2 of every lane (5 x kInsertLanes), state z1 and z2 (2 x kInsertLanes).
+        void (*biquadLanes)(float* lanes, uint32_t nframes, const float* coefficients, float* state);
+
+        // Per lane: envelope = max(|x|, envelope * decay), then x *= gain + gainStep * (position + i)
+        void (*dynamicsLanes)(float* lanes, uint32_t nframes, uint32_t position, const float* decay,
+                              const float* gain, const float* gainStep, float* envelope);
+
+        // out[i] = base[i] + delta[i] * fraction
+        void (*interpolateTaps)(const float* base, const float* delta, float fraction, float* out, uint32_t count);
+
+        // sum(a[i] * b[i]) in kDotLanes partial sums; count is a multiple of kDotLanes
+        float (*dotProduct)(const float* a, const float* b, uint32_t count);
+    };
+
+    /// <summary>
+    /// Returns the best instruction set supported by this CPU and operating system
+    /// </summary>
+    KernelIsa DetectKernelIsa();
+
+    /// <summary>
+    /// Returns the kernel table for an instruction set, or nullptr if it is not compiled
+    /// in or not supported by this CPU
+    /// </summary>
+    const MixKernels* GetMixKernels(KernelIsa isa);
+
+    /// <summary>
+    /// Returns the kernel table chosen at startup for this CPU. The first call performs the
+    /// CPUID probe, so call it once outside the process callback.
+    /// </summary>
+    const MixKernels& GetActiveMixKernels();
+
+    // Per-ISA tables, defined in MixKernels*.cpp
+    extern const MixKernels kScalarMixKernels;
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define EMP_KERNELS_X86 1
+    extern const MixKernels kSse2MixKernels;
+    extern const MixKernels kAvx2MixKernels;
+    extern const MixKernels kAvx512MixKernels;
+#else
+#define EMP_KERNELS_X86 0
+#endif
+}
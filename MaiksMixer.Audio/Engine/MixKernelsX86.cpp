@@ -0,0 +1,679 @@
+#include "MixKernels.h"
+
+#if EMP_KERNELS_X86
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+// GCC and Clang need per-function targets to emit AVX code from a baseline build;
+// MSVC accepts the intrinsics without an /arch switch. Build this file with
+// -ffp-contract=off on GCC/Clang: the avx512f target implies FMA, and contracting the
+// multiply-adds would make those kernels round differently from the other tables.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define EMP_TARGET(isa)
+#else
+#define EMP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace emp {
+
+    namespace {
+
+        // ---------------------------------------------------------------- SSE2
+
+        EMP_TARGET("sse2") float HorizontalMax128(__m128 v)
+        {
+            v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+            v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+            return _mm_cvtss_f32(v);
+        }
+
+        EMP_TARGET("sse2") float HorizontalSum128(__m128 v)
+        {
+            v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+            return _mm_cvtss_f32(v);
+        }
+
+        EMP_TARGET("sse2") void Sse2GainAccumulate(const float* in, float gain, float* out, uint32_t nframes)
+        {
+            const __m128 g = _mm_set1_ps(gain);
+            uint32_t i = 0;
+            for (; i + 4 <= nframes; i += 4) {
+                __m128 x = _mm_loadu_ps(in + i);
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(x, g)));
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * gain;
+            }
+        }
+
+        EMP_TARGET("sse2") void Sse2GainPanAccumulate(const float* in, float gainLeft, float gainRight,
+                                                      float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m128 gl = _mm_set1_ps(gainLeft);
+            const __m128 gr = _mm_set1_ps(gainRight);
+            uint32_t i = 0;
+            for (; i + 4 <= nframes; i += 4) {
+                __m128 x = _mm_loadu_ps(in + i);
+                _mm_storeu_ps(outLeft + i, _mm_add_ps(_mm_loadu_ps(outLeft + i), _mm_mul_ps(x, gl)));
+                _mm_storeu_ps(outRight + i, _mm_add_ps(_mm_loadu_ps(outRight + i), _mm_mul_ps(x, gr)));
+            }
+            for (; i < nframes; i++) {
+                outLeft[i] += in[i] * gainLeft;
+                outRight[i] += in[i] * gainRight;
+            }
+        }
+
+        EMP_TARGET("sse2") void Sse2RampAccumulate(const float* in, float gain, float gainStep, float* out, uint32_t nframes)
+        {
+            const __m128 g = _mm_set1_ps(gain);
+            const __m128 step = _mm_set1_ps(gainStep);
+            const __m128 advance = _mm_set1_ps(4.0f);
+            __m128 index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            uint32_t i = 0;
+            for (; i + 4 <= nframes; i += 4) {
+                __m128 x = _mm_loadu_ps(in + i);
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(x, _mm_add_ps(g, _mm_mul_ps(step, index)))));
+                index = _mm_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * (gain + gainStep * static_cast<float>(i));
+            }
+        }
+
+        EMP_TARGET("sse2") void Sse2RampPanAccumulate(const float* in, float gainLeft, float stepLeft, float gainRight, float stepRight,
+                                                      float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m128 gl = _mm_set1_ps(gainLeft);
+            const __m128 sl = _mm_set1_ps(stepLeft);
+            const __m128 gr = _mm_set1_ps(gainRight);
+            const __m128 sr = _mm_set1_ps(stepRight);
+            const __m128 advance = _mm_set1_ps(4.0f);
+            __m128 index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            uint32_t i = 0;
+            for (; i + 4 <= nframes; i += 4) {
+                __m128 x = _mm_loadu_ps(in + i);
+                _mm_storeu_ps(outLeft + i, _mm_add_ps(_mm_loadu_ps(outLeft + i), _mm_mul_ps(x, _mm_add_ps(gl, _mm_mul_ps(sl, index)))));
+                _mm_storeu_ps(outRight + i, _mm_add_ps(_mm_loadu_ps(outRight + i), _mm_mul_ps(x, _mm_add_ps(gr, _mm_mul_ps(sr, index)))));
+                index = _mm_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                const float idx = static_cast<float>(i);
+                outLeft[i] += in[i] * (gainLeft + stepLeft * idx);
+                outRight[i] += in[i] * (gainRight + stepRight * idx);
+            }
+        }
+
+        EMP_TARGET("sse2") float Sse2Peak(const float* in, uint32_t nframes)
+        {
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            __m128 acc = _mm_setzero_ps();
+            uint32_t i = 0;
+            for (; i + 4 <= nframes; i += 4) {
+                acc = _mm_max_ps(acc, _mm_and_ps(_mm_loadu_ps(in + i), absMask));
+            }
+            float peak = HorizontalMax128(acc);
+            for (; i < nframes; i++) {
+                peak = std::max(peak, std::abs(in[i]));
+            }
+            return peak;
+        }
+
+        EMP_TARGET("sse2") float Sse2SumSquares(const float* in, uint32_t nframes)
+        {
+            __m128 s[kDotLanes / 4];
+            for (uint32_t v = 0; v < kDotLanes / 4; v++) s[v] = _mm_setzero_ps();
+
+            uint32_t i = 0;
+            for (; i + kDotLanes <= nframes; i += kDotLanes) {
+                for (uint32_t v = 0; v < kDotLanes / 4; v++) {
+                    const __m128 x = _mm_loadu_ps(in + i + v * 4);
+                    s[v] = _mm_add_ps(s[v], _mm_mul_ps(x, x));
+                }
+            }
+
+            float sum = HorizontalSum128(_mm_add_ps(_mm_add_ps(s[0], s[2]), _mm_add_ps(s[1], s[3])));
+            for (; i < nframes; i++) {
+                sum += in[i] * in[i];
+            }
+            return sum;
+        }
+
+        // The insert kernels keep a group's coefficients and state in registers for the
+        // whole block
+        constexpr uint32_t kSse2Vectors = kInsertLanes / 4;
+
+        EMP_TARGET("sse2") void Sse2BiquadLanes(float* lanes, uint32_t nframes, const float* coefficients, float* state)
+        {
+            __m128 b0[kSse2Vectors], b1[kSse2Vectors], b2[kSse2Vectors], a1[kSse2Vectors], a2[kSse2Vectors];
+            __m128 z1[kSse2Vectors], z2[kSse2Vectors];
+            for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                b0[v] = _mm_loadu_ps(coefficients + v * 4);
+                b1[v] = _mm_loadu_ps(coefficients + kInsertLanes + v * 4);
+                b2[v] = _mm_loadu_ps(coefficients + kInsertLanes * 2 + v * 4);
+                a1[v] = _mm_loadu_ps(coefficients + kInsertLanes * 3 + v * 4);
+                a2[v] = _mm_loadu_ps(coefficients + kInsertLanes * 4 + v * 4);
+                z1[v] = _mm_loadu_ps(state + v * 4);
+                z2[v] = _mm_loadu_ps(state + kInsertLanes + v * 4);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                    const __m128 x = _mm_loadu_ps(frame + v * 4);
+                    const __m128 y = _mm_add_ps(_mm_mul_ps(b0[v], x), z1[v]);
+                    z1[v] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1[v], x), _mm_mul_ps(a1[v], y)), z2[v]);
+                    z2[v] = _mm_sub_ps(_mm_mul_ps(b2[v], x), _mm_mul_ps(a2[v], y));
+                    _mm_storeu_ps(frame + v * 4, y);
+                }
+            }
+
+            for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                _mm_storeu_ps(state + v * 4, z1[v]);
+                _mm_storeu_ps(state + kInsertLanes + v * 4, z2[v]);
+            }
+        }
+
+        EMP_TARGET("sse2") void Sse2DynamicsLanes(float* lanes, uint32_t nframes, uint32_t position, const float* decay,
+                                                  const float* gain, const float* gainStep, float* envelope)
+        {
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            __m128 d[kSse2Vectors], g[kSse2Vectors], step[kSse2Vectors], env[kSse2Vectors];
+            for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                d[v] = _mm_loadu_ps(decay + v * 4);
+                g[v] = _mm_loadu_ps(gain + v * 4);
+                step[v] = _mm_loadu_ps(gainStep + v * 4);
+                env[v] = _mm_loadu_ps(envelope + v * 4);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                const __m128 index = _mm_set1_ps(static_cast<float>(position + i));
+                for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                    const __m128 x = _mm_loadu_ps(frame + v * 4);
+                    env[v] = _mm_max_ps(_mm_and_ps(x, absMask), _mm_mul_ps(env[v], d[v]));
+                    _mm_storeu_ps(frame + v * 4, _mm_mul_ps(x, _mm_add_ps(g[v], _mm_mul_ps(step[v], index))));
+                }
+            }
+
+            for (uint32_t v = 0; v < kSse2Vectors; v++) {
+                _mm_storeu_ps(envelope + v * 4, env[v]);
+            }
+        }
+
+        EMP_TARGET("sse2") void Sse2InterpolateTaps(const float* base, const float* delta, float fraction, float* out, uint32_t count)
+        {
+            const __m128 f = _mm_set1_ps(fraction);
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(base + i), _mm_mul_ps(_mm_loadu_ps(delta + i), f)));
+            }
+            for (; i < count; i++) {
+                out[i] = base[i] + delta[i] * fraction;
+            }
+        }
+
+        // Partial sums l, l + 4, l + 8 and l + 12 sit in lane l of s[0..3]; the folds match
+        // the scalar kernel's (8, 4, 2, 1)
+        EMP_TARGET("sse2") float Sse2DotProduct(const float* a, const float* b, uint32_t count)
+        {
+            __m128 s[kDotLanes / 4];
+            for (uint32_t v = 0; v < kDotLanes / 4; v++) s[v] = _mm_setzero_ps();
+
+            for (uint32_t i = 0; i < count; i += kDotLanes) {
+                for (uint32_t v = 0; v < kDotLanes / 4; v++) {
+                    s[v] = _mm_add_ps(s[v], _mm_mul_ps(_mm_loadu_ps(a + i + v * 4), _mm_loadu_ps(b + i + v * 4)));
+                }
+            }
+
+            __m128 sum = _mm_add_ps(_mm_add_ps(s[0], s[2]), _mm_add_ps(s[1], s[3]));
+            return HorizontalSum128(sum);
+        }
+
+        // ---------------------------------------------------------------- AVX2
+
+        EMP_TARGET("avx2") void Avx2GainAccumulate(const float* in, float gain, float* out, uint32_t nframes)
+        {
+            const __m256 g = _mm256_set1_ps(gain);
+            uint32_t i = 0;
+            for (; i + 8 <= nframes; i += 8) {
+                __m256 x = _mm256_loadu_ps(in + i);
+                _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(x, g)));
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * gain;
+            }
+        }
+
+        EMP_TARGET("avx2") void Avx2GainPanAccumulate(const float* in, float gainLeft, float gainRight,
+                                                      float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m256 gl = _mm256_set1_ps(gainLeft);
+            const __m256 gr = _mm256_set1_ps(gainRight);
+            uint32_t i = 0;
+            for (; i + 8 <= nframes; i += 8) {
+                __m256 x = _mm256_loadu_ps(in + i);
+                _mm256_storeu_ps(outLeft + i, _mm256_add_ps(_mm256_loadu_ps(outLeft + i), _mm256_mul_ps(x, gl)));
+                _mm256_storeu_ps(outRight + i, _mm256_add_ps(_mm256_loadu_ps(outRight + i), _mm256_mul_ps(x, gr)));
+            }
+            for (; i < nframes; i++) {
+                outLeft[i] += in[i] * gainLeft;
+                outRight[i] += in[i] * gainRight;
+            }
+        }
+
+        EMP_TARGET("avx2") void Avx2RampAccumulate(const float* in, float gain, float gainStep, float* out, uint32_t nframes)
+        {
+            const __m256 g = _mm256_set1_ps(gain);
+            const __m256 step = _mm256_set1_ps(gainStep);
+            const __m256 advance = _mm256_set1_ps(8.0f);
+            __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+            uint32_t i = 0;
+            for (; i + 8 <= nframes; i += 8) {
+                __m256 x = _mm256_loadu_ps(in + i);
+                _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(x, _mm256_add_ps(g, _mm256_mul_ps(step, index)))));
+                index = _mm256_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * (gain + gainStep * static_cast<float>(i));
+            }
+        }
+
+        EMP_TARGET("avx2") void Avx2RampPanAccumulate(const float* in, float gainLeft, float stepLeft, float gainRight, float stepRight,
+                                                      float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m256 gl = _mm256_set1_ps(gainLeft);
+            const __m256 sl = _mm256_set1_ps(stepLeft);
+            const __m256 gr = _mm256_set1_ps(gainRight);
+            const __m256 sr = _mm256_set1_ps(stepRight);
+            const __m256 advance = _mm256_set1_ps(8.0f);
+            __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+            uint32_t i = 0;
+            for (; i + 8 <= nframes; i += 8) {
+                __m256 x = _mm256_loadu_ps(in + i);
+                _mm256_storeu_ps(outLeft + i, _mm256_add_ps(_mm256_loadu_ps(outLeft + i), _mm256_mul_ps(x, _mm256_add_ps(gl, _mm256_mul_ps(sl, index)))));
+                _mm256_storeu_ps(outRight + i, _mm256_add_ps(_mm256_loadu_ps(outRight + i), _mm256_mul_ps(x, _mm256_add_ps(gr, _mm256_mul_ps(sr, index)))));
+                index = _mm256_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                const float idx = static_cast<float>(i);
+                outLeft[i] += in[i] * (gainLeft + stepLeft * idx);
+                outRight[i] += in[i] * (gainRight + stepRight * idx);
+            }
+        }
+
+        EMP_TARGET("avx2") float Avx2Peak(const float* in, uint32_t nframes)
+        {
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            __m256 acc = _mm256_setzero_ps();
+            uint32_t i = 0;
+            for (; i + 8 <= nframes; i += 8) {
+                acc = _mm256_max_ps(acc, _mm256_and_ps(_mm256_loadu_ps(in + i), absMask));
+            }
+            __m128 half = _mm_max_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+            half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+            float peak = _mm_cvtss_f32(half);
+            for (; i < nframes; i++) {
+                peak = std::max(peak, std::abs(in[i]));
+            }
+            return peak;
+        }
+
+        EMP_TARGET("avx2") float Avx2SumSquares(const float* in, uint32_t nframes)
+        {
+            __m256 low = _mm256_setzero_ps();
+            __m256 high = _mm256_setzero_ps();
+            uint32_t i = 0;
+            for (; i + kDotLanes <= nframes; i += kDotLanes) {
+                const __m256 x = _mm256_loadu_ps(in + i);
+                const __m256 y = _mm256_loadu_ps(in + i + 8);
+                low = _mm256_add_ps(low, _mm256_mul_ps(x, x));
+                high = _mm256_add_ps(high, _mm256_mul_ps(y, y));
+            }
+
+            const __m256 both = _mm256_add_ps(low, high);
+            float sum = HorizontalSum128(_mm_add_ps(_mm256_castps256_ps128(both), _mm256_extractf128_ps(both, 1)));
+            for (; i < nframes; i++) {
+                sum += in[i] * in[i];
+            }
+            return sum;
+        }
+
+        constexpr uint32_t kAvx2Vectors = kInsertLanes / 8;
+
+        EMP_TARGET("avx2") void Avx2BiquadLanes(float* lanes, uint32_t nframes, const float* coefficients, float* state)
+        {
+            __m256 b0[kAvx2Vectors], b1[kAvx2Vectors], b2[kAvx2Vectors], a1[kAvx2Vectors], a2[kAvx2Vectors];
+            __m256 z1[kAvx2Vectors], z2[kAvx2Vectors];
+            for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                b0[v] = _mm256_loadu_ps(coefficients + v * 8);
+                b1[v] = _mm256_loadu_ps(coefficients + kInsertLanes + v * 8);
+                b2[v] = _mm256_loadu_ps(coefficients + kInsertLanes * 2 + v * 8);
+                a1[v] = _mm256_loadu_ps(coefficients + kInsertLanes * 3 + v * 8);
+                a2[v] = _mm256_loadu_ps(coefficients + kInsertLanes * 4 + v * 8);
+                z1[v] = _mm256_loadu_ps(state + v * 8);
+                z2[v] = _mm256_loadu_ps(state + kInsertLanes + v * 8);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                    const __m256 x = _mm256_loadu_ps(frame + v * 8);
+                    const __m256 y = _mm256_add_ps(_mm256_mul_ps(b0[v], x), z1[v]);
+                    z1[v] = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(b1[v], x), _mm256_mul_ps(a1[v], y)), z2[v]);
+                    z2[v] = _mm256_sub_ps(_mm256_mul_ps(b2[v], x), _mm256_mul_ps(a2[v], y));
+                    _mm256_storeu_ps(frame + v * 8, y);
+                }
+            }
+
+            for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                _mm256_storeu_ps(state + v * 8, z1[v]);
+                _mm256_storeu_ps(state + kInsertLanes + v * 8, z2[v]);
+            }
+        }
+
+        EMP_TARGET("avx2") void Avx2DynamicsLanes(float* lanes, uint32_t nframes, uint32_t position, const float* decay,
+                                                  const float* gain, const float* gainStep, float* envelope)
+        {
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            __m256 d[kAvx2Vectors], g[kAvx2Vectors], step[kAvx2Vectors], env[kAvx2Vectors];
+            for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                d[v] = _mm256_loadu_ps(decay + v * 8);
+                g[v] = _mm256_loadu_ps(gain + v * 8);
+                step[v] = _mm256_loadu_ps(gainStep + v * 8);
+                env[v] = _mm256_loadu_ps(envelope + v * 8);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                const __m256 index = _mm256_set1_ps(static_cast<float>(position + i));
+                for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                    const __m256 x = _mm256_loadu_ps(frame + v * 8);
+                    env[v] = _mm256_max_ps(_mm256_and_ps(x, absMask), _mm256_mul_ps(env[v], d[v]));
+                    _mm256_storeu_ps(frame + v * 8, _mm256_mul_ps(x, _mm256_add_ps(g[v], _mm256_mul_ps(step[v], index))));
+                }
+            }
+
+            for (uint32_t v = 0; v < kAvx2Vectors; v++) {
+                _mm256_storeu_ps(envelope + v * 8, env[v]);
+            }
+        }
+
+        EMP_TARGET("avx2") void Avx2InterpolateTaps(const float* base, const float* delta, float fraction, float* out, uint32_t count)
+        {
+            const __m256 f = _mm256_set1_ps(fraction);
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(base + i), _mm256_mul_ps(_mm256_loadu_ps(delta + i), f)));
+            }
+            for (; i < count; i++) {
+                out[i] = base[i] + delta[i] * fraction;
+            }
+        }
+
+        EMP_TARGET("avx2") float Avx2DotProduct(const float* a, const float* b, uint32_t count)
+        {
+            __m256 low = _mm256_setzero_ps();
+            __m256 high = _mm256_setzero_ps();
+            for (uint32_t i = 0; i < count; i += kDotLanes) {
+                low = _mm256_add_ps(low, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+                high = _mm256_add_ps(high, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+            }
+
+            const __m256 sum = _mm256_add_ps(low, high);
+            return HorizontalSum128(_mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1)));
+        }
+
+        // ---------------------------------------------------------------- AVX-512
+
+        // GCC's AVX-512 intrinsic headers trip its own uninitialized-value warnings
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+        EMP_TARGET("avx512f") void Avx512GainAccumulate(const float* in, float gain, float* out, uint32_t nframes)
+        {
+            const __m512 g = _mm512_set1_ps(gain);
+            uint32_t i = 0;
+            for (; i + 16 <= nframes; i += 16) {
+                __m512 x = _mm512_loadu_ps(in + i);
+                _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(x, g)));
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * gain;
+            }
+        }
+
+        EMP_TARGET("avx512f") void Avx512GainPanAccumulate(const float* in, float gainLeft, float gainRight,
+                                                           float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m512 gl = _mm512_set1_ps(gainLeft);
+            const __m512 gr = _mm512_set1_ps(gainRight);
+            uint32_t i = 0;
+            for (; i + 16 <= nframes; i += 16) {
+                __m512 x = _mm512_loadu_ps(in + i);
+                _mm512_storeu_ps(outLeft + i, _mm512_add_ps(_mm512_loadu_ps(outLeft + i), _mm512_mul_ps(x, gl)));
+                _mm512_storeu_ps(outRight + i, _mm512_add_ps(_mm512_loadu_ps(outRight + i), _mm512_mul_ps(x, gr)));
+            }
+            for (; i < nframes; i++) {
+                outLeft[i] += in[i] * gainLeft;
+                outRight[i] += in[i] * gainRight;
+            }
+        }
+
+        EMP_TARGET("avx512f") void Avx512RampAccumulate(const float* in, float gain, float gainStep, float* out, uint32_t nframes)
+        {
+            const __m512 g = _mm512_set1_ps(gain);
+            const __m512 step = _mm512_set1_ps(gainStep);
+            const __m512 advance = _mm512_set1_ps(16.0f);
+            __m512 index = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+                                           8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+            uint32_t i = 0;
+            for (; i + 16 <= nframes; i += 16) {
+                __m512 x = _mm512_loadu_ps(in + i);
+                _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(x, _mm512_add_ps(g, _mm512_mul_ps(step, index)))));
+                index = _mm512_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                out[i] += in[i] * (gain + gainStep * static_cast<float>(i));
+            }
+        }
+
+        EMP_TARGET("avx512f") void Avx512RampPanAccumulate(const float* in, float gainLeft, float stepLeft, float gainRight, float stepRight,
+                                                           float* outLeft, float* outRight, uint32_t nframes)
+        {
+            const __m512 gl = _mm512_set1_ps(gainLeft);
+            const __m512 sl = _mm512_set1_ps(stepLeft);
+            const __m512 gr = _mm512_set1_ps(gainRight);
+            const __m512 sr = _mm512_set1_ps(stepRight);
+            const __m512 advance = _mm512_set1_ps(16.0f);
+            __m512 index = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+                                           8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+            uint32_t i = 0;
+            for (; i + 16 <= nframes; i += 16) {
+                __m512 x = _mm512_loadu_ps(in + i);
+                _mm512_storeu_ps(outLeft + i, _mm512_add_ps(_mm512_loadu_ps(outLeft + i), _mm512_mul_ps(x, _mm512_add_ps(gl, _mm512_mul_ps(sl, index)))));
+                _mm512_storeu_ps(outRight + i, _mm512_add_ps(_mm512_loadu_ps(outRight + i), _mm512_mul_ps(x, _mm512_add_ps(gr, _mm512_mul_ps(sr, index)))));
+                index = _mm512_add_ps(index, advance);
+            }
+            for (; i < nframes; i++) {
+                const float idx = static_cast<float>(i);
+                outLeft[i] += in[i] * (gainLeft + stepLeft * idx);
+                outRight[i] += in[i] * (gainRight + stepRight * idx);
+            }
+        }
+
+        EMP_TARGET("avx512f") float Avx512Peak(const float* in, uint32_t nframes)
+        {
+            __m512 acc = _mm512_setzero_ps();
+            uint32_t i = 0;
+            for (; i + 16 <= nframes; i += 16) {
+                acc = _mm512_max_ps(acc, _mm512_abs_ps(_mm512_loadu_ps(in + i)));
+            }
+            float peak = _mm512_reduce_max_ps(acc);
+            for (; i < nframes; i++) {
+                peak = std::max(peak, std::abs(in[i]));
+            }
+            return peak;
+        }
+
+        EMP_TARGET("avx512f") float Avx512SumSquares(const float* in, uint32_t nframes)
+        {
+            __m512 sums = _mm512_setzero_ps();
+            uint32_t i = 0;
+            for (; i + kDotLanes <= nframes; i += kDotLanes) {
+                const __m512 x = _mm512_loadu_ps(in + i);
+                sums = _mm512_add_ps(sums, _mm512_mul_ps(x, x));
+            }
+
+            const __m256 half = _mm256_add_ps(_mm512_castps512_ps256(sums),
+                                              _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(sums), 1)));
+            float sum = HorizontalSum128(_mm_add_ps(_mm256_castps256_ps128(half), _mm256_extractf128_ps(half, 1)));
+            for (; i < nframes; i++) {
+                sum += in[i] * in[i];
+            }
+            return sum;
+        }
+
+        constexpr uint32_t kAvx512Vectors = kInsertLanes / 16;
+
+        EMP_TARGET("avx512f") void Avx512BiquadLanes(float* lanes, uint32_t nframes, const float* coefficients, float* state)
+        {
+            __m512 b0[kAvx512Vectors], b1[kAvx512Vectors], b2[kAvx512Vectors], a1[kAvx512Vectors], a2[kAvx512Vectors];
+            __m512 z1[kAvx512Vectors], z2[kAvx512Vectors];
+            for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                b0[v] = _mm512_loadu_ps(coefficients + v * 16);
+                b1[v] = _mm512_loadu_ps(coefficients + kInsertLanes + v * 16);
+                b2[v] = _mm512_loadu_ps(coefficients + kInsertLanes * 2 + v * 16);
+                a1[v] = _mm512_loadu_ps(coefficients + kInsertLanes * 3 + v * 16);
+                a2[v] = _mm512_loadu_ps(coefficients + kInsertLanes * 4 + v * 16);
+                z1[v] = _mm512_loadu_ps(state + v * 16);
+                z2[v] = _mm512_loadu_ps(state + kInsertLanes + v * 16);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                    const __m512 x = _mm512_loadu_ps(frame + v * 16);
+                    const __m512 y = _mm512_add_ps(_mm512_mul_ps(b0[v], x), z1[v]);
+                    z1[v] = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(b1[v], x), _mm512_mul_ps(a1[v], y)), z2[v]);
+                    z2[v] = _mm512_sub_ps(_mm512_mul_ps(b2[v], x), _mm512_mul_ps(a2[v], y));
+                    _mm512_storeu_ps(frame + v * 16, y);
+                }
+            }
+
+            for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                _mm512_storeu_ps(state + v * 16, z1[v]);
+                _mm512_storeu_ps(state + kInsertLanes + v * 16, z2[v]);
+            }
+        }
+
+        EMP_TARGET("avx512f") void Avx512DynamicsLanes(float* lanes, uint32_t nframes, uint32_t position, const float* decay,
+                                                       const float* gain, const float* gainStep, float* envelope)
+        {
+            __m512 d[kAvx512Vectors], g[kAvx512Vectors], step[kAvx512Vectors], env[kAvx512Vectors];
+            for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                d[v] = _mm512_loadu_ps(decay + v * 16);
+                g[v] = _mm512_loadu_ps(gain + v * 16);
+                step[v] = _mm512_loadu_ps(gainStep + v * 16);
+                env[v] = _mm512_loadu_ps(envelope + v * 16);
+            }
+
+            for (uint32_t i = 0; i < nframes; i++) {
+                float* frame = lanes + static_cast<size_t>(i) * kInsertLanes;
+                const __m512 index = _mm512_set1_ps(static_cast<float>(position + i));
+                for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                    const __m512 x = _mm512_loadu_ps(frame + v * 16);
+                    env[v] = _mm512_max_ps(_mm512_abs_ps(x), _mm512_mul_ps(env[v], d[v]));
+                    _mm512_storeu_ps(frame + v * 16, _mm512_mul_ps(x, _mm512_add_ps(g[v], _mm512_mul_ps(step[v], index))));
+                }
+            }
+
+            for (uint32_t v = 0; v < kAvx512Vectors; v++) {
+                _mm512_storeu_ps(envelope + v * 16, env[v]);
+            }
+        }
+
+        EMP_TARGET("avx512f") void Avx512InterpolateTaps(const float* base, const float* delta, float fraction, float* out, uint32_t count)
+        {
+            const __m512 f = _mm512_set1_ps(fraction);
+            uint32_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(base + i), _mm512_mul_ps(_mm512_loadu_ps(delta + i), f)));
+            }
+            for (; i < count; i++) {
+                out[i] = base[i] + delta[i] * fraction;
+            }
+        }
+
+        EMP_TARGET("avx512f") float Avx512DotProduct(const float* a, const float* b, uint32_t count)
+        {
+            __m512 sums = _mm512_setzero_ps();
+            for (uint32_t i = 0; i < count; i += kDotLanes) {
+                sums = _mm512_add_ps(sums, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+            }
+
+            // Not _mm512_reduce_add_ps, whose folding order is unspecified
+            const __m256 half = _mm256_add_ps(_mm512_castps512_ps256(sums),
+                                              _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(sums), 1)));
+            return HorizontalSum128(_mm_add_ps(_mm256_castps256_ps128(half), _mm256_extractf128_ps(half, 1)));
+        }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    }
+
+    const MixKernels kSse2MixKernels = {
+        KernelIsa::Sse2,
+        "sse2",
+        Sse2GainAccumulate,
+        Sse2GainPanAccumulate,
+        Sse2RampAccumulate,
+        Sse2RampPanAccumulate,
+        Sse2Peak,
+        Sse2SumSquares,
+        Sse2BiquadLanes,
+        Sse2DynamicsLanes,
+        Sse2InterpolateTaps,
+        Sse2DotProduct
+    };
+
+    const MixKernels kAvx2MixKernels = {
+        KernelIsa::Avx2,
+        "avx2",
+        Avx2GainAccumulate,
+        Avx2GainPanAccumulate,
+        Avx2RampAccumulate,
+        Avx2RampPanAccumulate,
+        Avx2Peak,
+        Avx2SumSquares,
+        Avx2BiquadLanes,
+        Avx2DynamicsLanes,
+        Avx2InterpolateTaps,
+        Avx2DotProduct
+    };
+
+    const MixKernels kAvx512MixKernels = {
+        KernelIsa::Avx512,
+        "avx512",
+        Avx512GainAccumulate,
+        Avx512GainPanAccumulate,
+        Avx512RampAccumulate,
+        Avx512RampPanAccumulate,
+        Avx512Peak,
+        Avx512SumSquares,
+        Avx512BiquadLanes,
+        Avx512DynamicsLanes,
+        Avx512InterpolateTaps,
+        Avx512DotProduct
+    };
+}
+
+#endif
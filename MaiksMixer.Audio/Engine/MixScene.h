@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ParameterState.h"
+#include "RoutingMatrix.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Complete mixer state as edited by control threads: every channel's parameters and
+    /// the dense routing matrix. Any dimensions are accepted; CompileScene() fits them to
+    /// the engine.
+    /// </summary>
+    struct SceneSnapshot
+    {
+        std::vector<ChannelParams> channels;
+        std::vector<float> routes;      // Input-major, routeInputs x routeOutputs
+        int routeInputs = 0;
+        int routeOutputs = 0;
+        bool routingEnabled = false;
+    };
+
+    /// <summary>
+    /// Scene in the form the process callback applies: parameters and routes sized to the
+    /// engine's port capacity, the routes already compiled to sparse rows, so a recall
+    /// only copies preallocated arrays. Immutable once compiled; one compiled scene can be
+    /// recalled any number of times.
+    /// </summary>
+    struct CompiledScene
+    {
+        int inputCapacity = 0;
+        int outputCapacity = 0;
+        std::vector<ChannelParams> channels;    // inputCapacity entries, defaults beyond the snapshot
+        std::vector<float> gains;               // Dense matrix restored into the RoutingMatrix
+        CompiledRoutes routes;
+    };
+
+    /// <summary>
+    /// Scene recall queued for the process callback
+    /// </summary>
+    struct SceneRecall
+    {
+        uint64_t scene;         // Recall id, matched against the engine's published scene
+        uint32_t fadeFrames;    // Equal-power crossfade length, 0 for a hard swap
+    };
+}
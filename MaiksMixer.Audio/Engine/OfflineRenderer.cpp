@@ -0,0 +1,84 @@
+#include "OfflineRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    // Constructor
+    OfflineRenderer::OfflineRenderer(int numInputs, int numOutputs, uint32_t blockSize, uint32_t sampleRate)
+        : _numInputs(std::max(numInputs, 0)), _numOutputs(std::max(numOutputs, 0)),
+          _blockSize(std::max<uint32_t>(blockSize, 1)), _sampleRate(sampleRate)
+    {
+        _engine.ConfigurePorts(_numInputs, _numOutputs);
+        _engine.SetSampleRate(_sampleRate);
+        _engine.Prepare(_blockSize);
+
+        _sources.assign(_numInputs, std::vector<float>(_blockSize, 0.0f));
+        _positions.assign(_numInputs, 0);
+        _inputBlocks.assign(_numInputs, std::vector<float>(_blockSize, 0.0f));
+        _outputs.assign(_numOutputs, std::vector<float>(_blockSize, 0.0f));
+
+        for (auto& block : _inputBlocks) _inputPointers.push_back(block.data());
+        for (auto& block : _outputs) _outputPointers.push_back(block.data());
+    }
+
+    // Set Input
+    void OfflineRenderer::SetInput(int channel, const std::vector<float>& samples)
+    {
+        if (channel < 0 || channel >= _numInputs || samples.empty()) return;
+
+        _sources[channel] = samples;
+        _positions[channel] = 0;
+    }
+
+    // Generate Test Signals
+    void OfflineRenderer::GenerateTestSignals(uint32_t seed, uint32_t frames)
+    {
+        frames = std::max<uint32_t>(frames, 1);
+        uint32_t state = seed != 0 ? seed : 1;
+
+        for (int channel = 0; channel < _numInputs; channel++) {
+            std::vector<float> samples(frames);
+
+            // Parabolic sine approximation plus LCG noise: plain IEEE arithmetic only, so the
+            // signal is identical on every platform and libm
+            const double increment = 55.0 * (1.0 + channel * 0.37) / std::max<uint32_t>(_sampleRate, 1);
+            double phase = 0.0;
+
+            for (uint32_t i = 0; i < frames; i++) {
+                const double x = 2.0 * phase - 1.0;
+                const double tone = 4.0 * x * (1.0 - std::fabs(x));
+                phase += increment;
+                if (phase >= 1.0) phase -= 1.0;
+
+                state = state * 1664525u + 1013904223u;
+                const double noise = static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+                samples[i] = static_cast<float>(0.6 * tone + 0.1 * noise);
+            }
+
+            SetInput(channel, samples);
+        }
+    }
+
+    // Render Block
+    void OfflineRenderer::RenderBlock()
+    {
+        for (int channel = 0; channel < _numInputs; channel++) {
+            const std::vector<float>& source = _sources[channel];
+            float* block = _inputBlocks[channel].data();
+            size_t position = _positions[channel];
+
+            for (uint32_t copied = 0; copied < _blockSize;) {
+                const uint32_t count = static_cast<uint32_t>(std::min<size_t>(_blockSize - copied, source.size() - position));
+                std::copy(source.begin() + position, source.begin() + position + count, block + copied);
+                copied += count;
+                position = (position + count) % source.size();
+            }
+
+            _positions[channel] = position;
+        }
+
+        _engine.Process(_inputPointers.data(), _numInputs, _outputPointers.data(), _numOutputs, _blockSize);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MixEngine.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Drives a MixEngine from in-memory input buffers, with no JACK server, so the mix,
+    /// meter and routing path can be benchmarked and regression-tested reproducibly.
+    /// Inputs loop over their buffers; every block is rendered exactly like a process
+    /// callback of blockSize frames.
+    /// </summary>
+    class OfflineRenderer
+    {
+    public:
+        OfflineRenderer(int numInputs, int numOutputs, uint32_t blockSize, uint32_t sampleRate);
+
+        OfflineRenderer(const OfflineRenderer&) = delete;
+        OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+        MixEngine& Engine() { return _engine; }
+
+        int GetInputCount() const { return _numInputs; }
+        int GetOutputCount() const { return _numOutputs; }
+        uint32_t GetBlockSize() const { return _blockSize; }
+        uint32_t GetSampleRate() const { return _sampleRate; }
+
+        /// <summary>
+        /// Sets the samples an input loops over
+        /// </summary>
+        void SetInput(int channel, const std::vector<float>& samples);
+
+        /// <summary>
+        /// Fills every input with a deterministic test signal of the given length: a
+        /// per-channel sine plus pseudo-random noise derived from seed
+        /// </summary>
+        void GenerateTestSignals(uint32_t seed, uint32_t frames);
+
+        /// <summary>
+        /// Renders one block; the results are available through GetOutput()
+        /// </summary>
+        void RenderBlock();
+
+        /// <summary>
+        /// Output buffer of the last rendered block
+        /// </summary>
+        const float* GetOutput(int output) const { return _outputs[output].data(); }
+
+        /// <summary>
+        /// Renders blocks until at least totalFrames frames have been processed, calling
+        /// sink(renderer) after each block. Returns the number of blocks rendered.
+        /// </summary>
+        template <typename Sink>
+        uint64_t Render(uint64_t totalFrames, Sink&& sink)
+        {
+            uint64_t blocks = 0;
+            for (uint64_t frames = 0; frames < totalFrames; frames += _blockSize) {
+                RenderBlock();
+                sink(*this);
+                blocks++;
+            }
+
+            return blocks;
+        }
+
+    private:
+        MixEngine _engine;
+        int _numInputs;
+        int _numOutputs;
+        uint32_t _blockSize;
+        uint32_t _sampleRate;
+
+        std::vector<std::vector<float>> _sources;
+        std::vector<size_t> _positions;
+
+        // Contiguous per-block views handed to the engine
+        std::vector<std::vector<float>> _inputBlocks;
+        std::vector<std::vector<float>> _outputs;
+        std::vector<const float*> _inputPointers;
+        std::vector<float*> _outputPointers;
+    };
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+
+#include "ParameterState.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Curve a parameter follows from its current value to a new one (matches the managed
+    /// RampShape)
+    /// </summary>
+    enum class RampShape : int32_t
+    {
+        Step = 0,           // Jumps to the new value
+        Linear = 1,         // Constant rate, reaching the value after the ramp time
+        Exponential = 2     // One-pole approach, within -60 dB of the distance at the end
+    };
+
+    /// <summary>
+    /// Parameter change that lands on a given frame. Layout matches the managed
+    /// TimedParameterChange value struct.
+    /// </summary>
+    struct TimedParameterChange
+    {
+        uint64_t frameTime;         // Server frame time of the first frame using the new value
+        ParameterChange change;
+        RampShape shape;            // Volume, pan and gain only; mute and solo always step
+        uint32_t rampFrames;        // Ramp length, 0 for a step
+    };
+
+    /// <summary>
+    /// Smoothed value of one parameter, advanced by the audio thread in frame steps
+    /// </summary>
+    class ParameterRamp
+    {
+    public:
+        // Fraction of the distance left when an exponential ramp ends (and snaps)
+        static constexpr float kExponentialFloor = 0.001f;
+
+        /// <summary>
+        /// Jumps to a value and ends any ramp
+        /// </summary>
+        void Reset(float value)
+        {
+            _value = value;
+            _target = value;
+            _remaining = 0;
+        }
+
+        /// <summary>
+        /// Ramps from the current value to target over frames frames. A ramp already
+        /// heading for target keeps its course.
+        /// </summary>
+        void Start(float target, RampShape shape, uint32_t frames)
+        {
+            if (IsActive() && target == _target) return;
+            if (shape == RampShape::Step || frames == 0 || target == _value) {
+                Reset(target);
+                return;
+            }
+
+            _target = target;
+            _shape = shape;
+            _remaining = frames;
+            _rate = shape == RampShape::Linear
+                ? (target - _value) / static_cast<float>(frames)
+                : std::exp(std::log(kExponentialFloor) / static_cast<float>(frames));
+        }
+
+        bool IsActive() const { return _remaining > 0; }
+        uint32_t GetRemaining() const { return _remaining; }
+        float GetValue() const { return _value; }
+        float GetTarget() const { return _target; }
+
+        /// <summary>
+        /// Moves the ramp forward by frames frames and returns the new value
+        /// </summary>
+        float Advance(uint32_t frames)
+        {
+            if (_remaining == 0) return _value;
+
+            if (frames >= _remaining) {
+                Reset(_target);
+            }
+            else if (_shape == RampShape::Linear) {
+                _value += _rate * static_cast<float>(frames);
+                _remaining -= frames;
+            }
+            else {
+                _value = _target + (_value - _target) * std::pow(_rate, static_cast<float>(frames));
+                _remaining -= frames;
+            }
+
+            return _value;
+        }
+
+    private:
+        float _value = 0.0f;
+        float _target = 0.0f;
+        float _rate = 0.0f;         // Linear: increment per frame; exponential: decay per frame
+        uint32_t _remaining = 0;
+        RampShape _shape = RampShape::Step;
+    };
+
+    /// <summary>
+    /// Smoothed continuous parameters of one channel
+    /// </summary>
+    struct ChannelRamps
+    {
+        ParameterRamp volume;
+        ParameterRamp pan;
+        ParameterRamp gain;
+
+        bool IsActive() const { return volume.IsActive() || pan.IsActive() || gain.IsActive(); }
+
+        /// <summary>
+        /// Frames until the next ramp ends (0 if none is active)
+        /// </summary>
+        uint32_t GetNextEnd() const
+        {
+            uint32_t next = 0;
+            for (const ParameterRamp* ramp : { &volume, &pan, &gain }) {
+                if (ramp->IsActive() && (next == 0 || ramp->GetRemaining() < next)) next = ramp->GetRemaining();
+            }
+            return next;
+        }
+
+        void Reset(const ChannelParams& params)
+        {
+            volume.Reset(params.volume);
+            pan.Reset(params.pan);
+            gain.Reset(params.gain);
+        }
+
+        void Advance(uint32_t frames)
+        {
+            volume.Advance(frames);
+            pan.Advance(frames);
+            gain.Advance(frames);
+        }
+    };
+}
@@ -0,0 +1,188 @@
+#include "ParameterState.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    // Apply Parameter Change
+    bool ApplyParameterChange(ChannelParams& params, ParameterId parameter, float value)
+    {
+        switch (parameter) {
+        case ParameterId::Volume:
+            params.volume = std::clamp(value, 0.0f, 1.0f);
+            return true;
+        case ParameterId::Pan:
+            params.pan = std::clamp(value, 0.0f, 1.0f);
+            return true;
+        case ParameterId::GainDb:
+            params.gain = std::pow(10.0f, value / 20.0f);
+            return true;
+        case ParameterId::Mute:
+            params.mute = value != 0.0f;
+            return true;
+        case ParameterId::Solo:
+            params.solo = value != 0.0f;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Constructor
+    ParameterState::ParameterState()
+    {
+    }
+
+    // Reserve
+    void ParameterState::Reserve(int capacity)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        capacity = std::max(capacity, 0);
+        _staging.channels.assign(capacity, ChannelParams());
+        _staging.channelCount = capacity;
+        _staging.anySolo = false;
+        _staging.scene = 0;
+
+        _snapshots.ForEach([this](ParameterSnapshot& snapshot) { snapshot = _staging; });
+    }
+
+    // Set Channel Count
+    void ParameterState::SetChannelCount(int count)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        count = std::clamp(count, 0, static_cast<int>(_staging.channels.size()));
+
+        // Channels that are removed come back with default parameters
+        if (count < _staging.channelCount) {
+            std::fill(_staging.channels.begin() + count, _staging.channels.begin() + _staging.channelCount, ChannelParams());
+        }
+
+        _staging.channelCount = count;
+        PublishLocked();
+    }
+
+    // Set Volume
+    void ParameterState::SetVolume(int channel, float volume)
+    {
+        SetParameter(channel, ParameterId::Volume, volume);
+    }
+
+    // Set Pan
+    void ParameterState::SetPan(int channel, float pan)
+    {
+        SetParameter(channel, ParameterId::Pan, pan);
+    }
+
+    // Set Gain
+    void ParameterState::SetGainDb(int channel, float gainDB)
+    {
+        SetParameter(channel, ParameterId::GainDb, gainDB);
+    }
+
+    // Set Mute
+    void ParameterState::SetMute(int channel, bool mute)
+    {
+        SetParameter(channel, ParameterId::Mute, mute ? 1.0f : 0.0f);
+    }
+
+    // Set Solo
+    void ParameterState::SetSolo(int channel, bool solo)
+    {
+        SetParameter(channel, ParameterId::Solo, solo ? 1.0f : 0.0f);
+    }
+
+    // Apply Batch
+    int ParameterState::ApplyBatch(const ParameterChange* changes, int count)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        int applied = 0;
+        for (int i = 0; i < count; i++) {
+            if (ApplyChangeLocked(changes[i])) applied++;
+        }
+
+        if (applied > 0) PublishLocked();
+        return applied;
+    }
+
+    void ParameterState::SetParameter(int channel, ParameterId parameter, float value)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (ApplyChangeLocked(ParameterChange{ channel, parameter, value })) PublishLocked();
+    }
+
+    // Stage
+    bool ParameterState::Stage(const ParameterChange& change)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        return ApplyChangeLocked(change);
+    }
+
+    // Apply one change to the staging copy; returns false if it addresses nothing
+    bool ParameterState::ApplyChangeLocked(const ParameterChange& change)
+    {
+        if (!IsValidChannel(change.channel)) return false;
+
+        return ApplyParameterChange(_staging.channels[change.channel], change.parameter, change.value);
+    }
+
+    // Get Channel
+    ChannelParams ParameterState::GetChannel(int channel)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (!IsValidChannel(channel)) return ChannelParams();
+
+        return _staging.channels[channel];
+    }
+
+    // Get Channels
+    void ParameterState::GetChannels(std::vector<ChannelParams>& channels)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        channels.assign(_staging.channels.begin(), _staging.channels.begin() + _staging.channelCount);
+    }
+
+    // Restore
+    void ParameterState::Restore(const std::vector<ChannelParams>& channels, uint64_t scene)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const size_t count = std::min(channels.size(), static_cast<size_t>(_staging.channelCount));
+        std::copy(channels.begin(), channels.begin() + count, _staging.channels.begin());
+        _staging.scene = scene;
+        PublishLocked();
+    }
+
+    // Acquire Snapshot (process thread)
+    const ParameterSnapshot& ParameterState::AcquireSnapshot()
+    {
+        return _snapshots.Read();
+    }
+
+    // Copy the staging parameters into the back buffer and swap it in as the latest snapshot
+    void ParameterState::PublishLocked()
+    {
+        _staging.anySolo = std::any_of(
+            _staging.channels.begin(), _staging.channels.begin() + _staging.channelCount,
+            [](const ChannelParams& params) { return params.solo; });
+        _staging.version++;
+
+        // All buffers share the staging capacity, so this copy never reallocates
+        auto& back = _snapshots.WriteBuffer();
+        std::copy(_staging.channels.begin(), _staging.channels.end(), back.channels.begin());
+        back.channelCount = _staging.channelCount;
+        back.anySolo = _staging.anySolo;
+        back.version = _staging.version;
+        back.scene = _staging.scene;
+
+        _snapshots.Publish();
+    }
+
+    bool ParameterState::IsValidChannel(int channel) const
+    {
+        return channel >= 0 && channel < _staging.channelCount;
+    }
+}
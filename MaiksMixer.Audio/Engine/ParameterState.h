@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Mixing parameters for a single input channel
+    /// </summary>
+    struct ChannelParams
+    {
+        float volume = 1.0f;    // Fader position (0.0 - 1.0)
+        float pan = 0.5f;       // 0.0 left, 0.5 center, 1.0 right
+        float gain = 1.0f;      // Linear input gain
+        bool mute = false;
+        bool solo = false;
+    };
+
+    /// <summary>
+    /// Channel parameter addressed by a ParameterChange (matches the managed ChannelParameter)
+    /// </summary>
+    enum class ParameterId : int32_t
+    {
+        Volume = 0,
+        Pan = 1,
+        GainDb = 2,
+        Mute = 3,       // Non-zero value mutes
+        Solo = 4        // Non-zero value solos
+    };
+
+    /// <summary>
+    /// One parameter edit. Layout matches the managed ParameterChange value struct so
+    /// arrays can be passed without conversion.
+    /// </summary>
+    struct ParameterChange
+    {
+        int32_t channel;
+        ParameterId parameter;
+        float value;
+    };
+
+    /// <summary>
+    /// Applies one change to a channel's parameters (clamping and dB conversion included).
+    /// Real-time safe. Returns false for an unknown parameter.
+    /// </summary>
+    bool ApplyParameterChange(ChannelParams& params, ParameterId parameter, float value);
+
+    /// <summary>
+    /// Complete, immutable set of channel parameters for one process cycle
+    /// </summary>
+    struct ParameterSnapshot
+    {
+        // Sized to the reserved capacity; only the first channelCount entries are valid
+        std::vector<ChannelParams> channels;
+        int channelCount = 0;
+        bool anySolo = false;
+        uint64_t version = 0;
+        uint64_t scene = 0;     // Scene recall the snapshot descends from (0 before any)
+    };
+
+    /// <summary>
+    /// Channel parameter store shared between control threads and the process callback.
+    /// Control threads edit a staging copy and publish it through a triple buffer; the
+    /// process callback picks up the latest complete snapshot with a single atomic exchange,
+    /// so it never locks, allocates or observes a half-applied edit.
+    /// </summary>
+    class ParameterState
+    {
+    public:
+        ParameterState();
+
+        /// <summary>
+        /// Allocates storage for up to capacity channels and resets them to defaults.
+        /// Must not be called while the process callback may be running.
+        /// </summary>
+        void Reserve(int capacity);
+
+        /// <summary>
+        /// Sets the number of active channels (clamped to the reserved capacity). Channels
+        /// beyond the new count are reset to defaults.
+        /// </summary>
+        void SetChannelCount(int count);
+
+        void SetVolume(int channel, float volume);
+        void SetPan(int channel, float pan);
+        void SetGainDb(int channel, float gainDB);
+        void SetMute(int channel, bool mute);
+        void SetSolo(int channel, bool solo);
+
+        /// <summary>
+        /// Applies a block of parameter changes in order and publishes them as one
+        /// snapshot, so the process callback sees all of them in the same cycle.
+        /// Returns the number of changes that addressed a valid channel and parameter.
+        /// </summary>
+        int ApplyBatch(const ParameterChange* changes, int count);
+
+        /// <summary>
+        /// Applies a change to the staging copy without publishing it, for changes that
+        /// reach the process callback as commands; later snapshots then carry it too.
+        /// Returns false if the change addresses no valid channel and parameter.
+        /// </summary>
+        bool Stage(const ParameterChange& change);
+
+        /// <summary>
+        /// Applies several edits to the staging copy and publishes them as one snapshot.
+        /// The editor is called with the staging channel vector and the active channel count.
+        /// </summary>
+        template <typename Editor>
+        void Apply(Editor&& edit)
+        {
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            edit(_staging.channels, _staging.channelCount);
+            PublishLocked();
+        }
+
+        /// <summary>
+        /// Returns a copy of the staged parameters for a channel (control threads only)
+        /// </summary>
+        ChannelParams GetChannel(int channel);
+
+        /// <summary>
+        /// Copies the staged parameters of the active channels (control threads only)
+        /// </summary>
+        void GetChannels(std::vector<ChannelParams>& channels);
+
+        /// <summary>
+        /// Replaces the parameters of the active channels with a recalled scene's and
+        /// publishes them tagged with the recall id; later snapshots keep the tag. The
+        /// active channel count is left alone.
+        /// </summary>
+        void Restore(const std::vector<ChannelParams>& channels, uint64_t scene);
+
+        /// <summary>
+        /// Returns the most recently published snapshot. Real-time safe; call once at the
+        /// start of each process cycle and use the returned reference for the whole cycle.
+        /// </summary>
+        const ParameterSnapshot& AcquireSnapshot();
+
+    private:
+        void SetParameter(int channel, ParameterId parameter, float value);
+        bool ApplyChangeLocked(const ParameterChange& change);
+        void PublishLocked();
+        bool IsValidChannel(int channel) const;
+
+        TripleBuffer<ParameterSnapshot> _snapshots;
+        ParameterSnapshot _staging;
+
+        // Serializes control threads; the process callback never takes it
+        std::mutex _writerMutex;
+    };
+}
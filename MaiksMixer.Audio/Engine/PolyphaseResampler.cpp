@@ -0,0 +1,179 @@
+#include "PolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace emp {
+
+    namespace {
+
+        constexpr uint32_t kPhaseBits = 8;
+        static_assert((1u << kPhaseBits) == PolyphaseResampler::kPhases, "kPhases must be 2^kPhaseBits");
+
+        // Fractional bits below the branch index, interpolated between two branches
+        constexpr uint32_t kFractionBits = 32 - kPhaseBits;
+
+        constexpr double kPi = 3.14159265358979323846;
+
+        struct QualityDesign
+        {
+            uint32_t taps;
+            double passband;    // Cutoff as a fraction of the lower Nyquist frequency
+            double beta;        // Kaiser window shape
+        };
+
+        QualityDesign GetDesign(ResamplerQuality quality)
+        {
+            switch (quality) {
+            case ResamplerQuality::Low: return { 16, 0.80, 6.0 };
+            case ResamplerQuality::High: return { 64, 0.94, 10.0 };
+            default: return { 32, 0.90, 8.0 };
+            }
+        }
+
+        // Modified Bessel function of the first kind, order 0
+        double BesselI0(double x)
+        {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 64 && term > sum * 1e-15; k++) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        }
+    }
+
+    // Constructor
+    PolyphaseResampler::PolyphaseResampler()
+        : _channels(0), _taps(0), _stride(0), _filled(0), _position(0)
+    {
+    }
+
+    // Configure
+    void PolyphaseResampler::Configure(int channels, uint32_t inputRate, uint32_t outputRate, ResamplerQuality quality,
+                                       uint32_t maxInputFrames)
+    {
+        const QualityDesign design = GetDesign(quality);
+        _channels = std::max(channels, 1);
+        _taps = design.taps;
+
+        // Cutoff in cycles per input frame, below the lower of the two Nyquist frequencies
+        const double cutoff = 0.5 * design.passband * std::min(1.0, static_cast<double>(outputRate) / std::max(inputRate, 1u));
+        const double center = _taps / 2 - 1.0;
+        const double halfLength = _taps / 2.0;
+        const double windowScale = 1.0 / BesselI0(design.beta);
+
+        std::vector<double> branch(_taps);
+        _branches.assign(static_cast<size_t>(kPhases + 1) * _taps, 0.0f);
+        for (uint32_t p = 0; p <= kPhases; p++) {
+            const double fraction = static_cast<double>(p) / kPhases;
+
+            double sum = 0.0;
+            for (uint32_t t = 0; t < _taps; t++) {
+                const double u = t - center - fraction;
+                const double x = 2.0 * cutoff * u;
+                const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+                const double r = u / halfLength;
+                const double window = std::abs(r) >= 1.0 ? 0.0 : BesselI0(design.beta * std::sqrt(1.0 - r * r)) * windowScale;
+                branch[t] = 2.0 * cutoff * sinc * window;
+                sum += branch[t];
+            }
+
+            // Unity gain at DC for every fractional position
+            for (uint32_t t = 0; t < _taps; t++) {
+                _branches[static_cast<size_t>(p) * _taps + t] = static_cast<float>(branch[t] / sum);
+            }
+        }
+
+        _deltas.assign(static_cast<size_t>(kPhases) * _taps, 0.0f);
+        for (size_t i = 0; i < _deltas.size(); i++) {
+            _deltas[i] = _branches[i + _taps] - _branches[i];
+        }
+
+        _coefficients.assign(_taps, 0.0f);
+        _stride = _taps + maxInputFrames;
+        _history.assign(static_cast<size_t>(_stride) * _channels, 0.0f);
+        Reset();
+    }
+
+    // Reset
+    void PolyphaseResampler::Reset()
+    {
+        std::fill(_history.begin(), _history.end(), 0.0f);
+
+        // Silence up to the first window's center, so the first input frame is heard
+        // right away rather than after a whole window
+        _filled = _taps / 2;
+        _position = 0;
+    }
+
+    // Get Input Frames
+    uint32_t PolyphaseResampler::GetInputFrames(uint32_t outputFrames, double ratio) const
+    {
+        if (outputFrames == 0) return 0;
+
+        const uint64_t last = _position + static_cast<uint64_t>(outputFrames - 1) * ToStep(ratio);
+        const uint64_t needed = (last >> 32) + _taps;
+        return needed > _filled ? static_cast<uint32_t>(needed - _filled) : 0;
+    }
+
+    // Get Buffered Frames
+    double PolyphaseResampler::GetBufferedFrames() const
+    {
+        return _filled - _position / 4294967296.0 - (_taps / 2 - 1.0);
+    }
+
+    // Process (real-time thread)
+    void PolyphaseResampler::Process(const MixKernels& kernels, const float* input, uint32_t inputFrames,
+                                     float* const* outputs, uint32_t outputFrames, double ratio)
+    {
+        inputFrames = std::min(inputFrames, _stride - _filled);
+        for (int c = 0; c < _channels; c++) {
+            float* history = _history.data() + static_cast<size_t>(c) * _stride + _filled;
+            for (uint32_t i = 0; i < inputFrames; i++) {
+                history[i] = input[static_cast<size_t>(i) * _channels + c];
+            }
+        }
+        _filled += inputFrames;
+
+        const uint64_t step = ToStep(ratio);
+        for (uint32_t i = 0; i < outputFrames; i++) {
+            const uint32_t start = static_cast<uint32_t>(_position >> 32);
+            const uint32_t fraction = static_cast<uint32_t>(_position);
+
+            // A short input (never with GetInputFrames() frames) renders silence
+            if (start + _taps > _filled) {
+                for (int c = 0; c < _channels; c++) outputs[c][i] = 0.0f;
+                continue;
+            }
+
+            const size_t branch = static_cast<size_t>(fraction >> kFractionBits) * _taps;
+            const float weight = static_cast<float>(fraction & ((1u << kFractionBits) - 1)) * (1.0f / (1u << kFractionBits));
+            kernels.interpolateTaps(_branches.data() + branch, _deltas.data() + branch, weight, _coefficients.data(), _taps);
+
+            for (int c = 0; c < _channels; c++) {
+                outputs[c][i] = kernels.dotProduct(_history.data() + static_cast<size_t>(c) * _stride + start,
+                                                   _coefficients.data(), _taps);
+            }
+            _position += step;
+        }
+
+        // Drop the frames the window has moved past
+        const uint32_t consumed = std::min(static_cast<uint32_t>(_position >> 32), _filled);
+        if (consumed > 0) {
+            for (int c = 0; c < _channels; c++) {
+                float* history = _history.data() + static_cast<size_t>(c) * _stride;
+                std::memmove(history, history + consumed, sizeof(float) * (_filled - consumed));
+            }
+            _filled -= consumed;
+            _position -= static_cast<uint64_t>(consumed) << 32;
+        }
+    }
+
+    uint64_t PolyphaseResampler::ToStep(double ratio)
+    {
+        return static_cast<uint64_t>(std::llround(ratio * 4294967296.0));
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MixKernels.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Filter length of a resampler, trading stopband rejection for CPU time (matches the
+    /// managed ResamplerQuality)
+    /// </summary>
+    enum class ResamplerQuality : int32_t
+    {
+        Low = 0,        // 16 taps
+        Medium = 1,     // 32 taps
+        High = 2        // 64 taps
+    };
+
+    /// <summary>
+    /// Band-limited resampler for a fixed set of channels whose conversion ratio may change
+    /// every call, as needed to follow a drifting clock. A Kaiser-windowed sinc is stored as
+    /// kPhases + 1 polyphase branches; each output frame interpolates the two branches
+    /// around its fractional position once and then takes one dot product per channel.
+    /// The read position is 32.32 fixed point, so the frames a call consumes are known
+    /// exactly beforehand. Configure() allocates; everything else is real-time safe.
+    /// </summary>
+    class PolyphaseResampler
+    {
+    public:
+        static constexpr uint32_t kPhases = 256;
+
+        PolyphaseResampler();
+
+        /// <summary>
+        /// Designs the filter for a nominal conversion from inputRate to outputRate and
+        /// sizes the history for calls of up to maxInputFrames input frames. Clears the
+        /// history.
+        /// </summary>
+        void Configure(int channels, uint32_t inputRate, uint32_t outputRate, ResamplerQuality quality,
+                       uint32_t maxInputFrames);
+
+        /// <summary>
+        /// Clears the history and the fractional position
+        /// </summary>
+        void Reset();
+
+        int GetChannels() const { return _channels; }
+        uint32_t GetTaps() const { return _taps; }
+
+        /// <summary>
+        /// Input frames a Process() call of outputFrames frames at this ratio consumes
+        /// (input frames per output frame)
+        /// </summary>
+        uint32_t GetInputFrames(uint32_t outputFrames, double ratio) const;
+
+        /// <summary>
+        /// Input frames held in the history that have not been passed yet, fraction included
+        /// </summary>
+        double GetBufferedFrames() const;
+
+        /// <summary>
+        /// Appends inputFrames interleaved frames (exactly GetInputFrames(outputFrames, ratio))
+        /// and renders outputFrames frames into one buffer per channel
+        /// </summary>
+        void Process(const MixKernels& kernels, const float* input, uint32_t inputFrames, float* const* outputs,
+                     uint32_t outputFrames, double ratio);
+
+    private:
+        static uint64_t ToStep(double ratio);
+
+        int _channels;
+        uint32_t _taps;
+
+        // Branch p holds the taps for a position p / kPhases of a frame past the window
+        // start; _deltas[p] = branch p + 1 - branch p
+        std::vector<float> _branches;
+        std::vector<float> _deltas;
+        std::vector<float> _coefficients;
+
+        // Per channel: _stride samples, the first _filled of them valid
+        std::vector<float> _history;
+        uint32_t _stride;
+        uint32_t _filled;
+        uint64_t _position;     // Window start in 32.32 frames from the history start
+    };
+}
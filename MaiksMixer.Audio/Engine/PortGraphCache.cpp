@@ -0,0 +1,274 @@
+#include "PortGraphCache.h"
+
+namespace emp {
+
+    namespace {
+        // JackPortIsOutput
+        constexpr uint32_t kPortIsOutput = 0x2;
+    }
+
+    // Constructor
+    PortGraphCache::PortGraphCache()
+        : _version(0), _seeded(false), _stale(false)
+    {
+    }
+
+    // Reset
+    void PortGraphCache::Reset(const std::vector<PortGraphPort>& ports)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::map<std::string, const PortGraphPort*> incoming;
+        for (const auto& port : ports) {
+            incoming[port.name] = &port;
+        }
+
+        // Ports that disappeared (or changed type/flags, which JACK only does by re-registering)
+        std::vector<std::string> removed;
+        for (const auto& entry : _ports) {
+            auto it = incoming.find(entry.first);
+            if (it == incoming.end() || it->second->type != entry.second.type || it->second->flags != entry.second.flags) {
+                removed.push_back(entry.first);
+            }
+        }
+        for (const auto& name : removed) {
+            RemovePortLocked(name);
+        }
+
+        for (const auto& port : ports) {
+            if (_ports.find(port.name) == _ports.end()) {
+                AddPortLocked(port.name, port.type, port.flags);
+            }
+        }
+
+        // Connection differences, seen from the output side of each connection
+        for (const auto& port : ports) {
+            if ((port.flags & kPortIsOutput) == 0) continue;
+
+            std::set<std::string> wanted(port.connections.begin(), port.connections.end());
+            std::set<std::string> current = _ports[port.name].connections;
+
+            for (const auto& other : current) {
+                if (wanted.count(other) == 0) ConnectLocked(port.name, other, false);
+            }
+            for (const auto& other : wanted) {
+                if (current.count(other) == 0 && _ports.count(other) != 0) ConnectLocked(port.name, other, true);
+            }
+        }
+
+        _seeded = true;
+        _stale = false;
+    }
+
+    // On Port Registered
+    void PortGraphCache::OnPortRegistered(const std::string& name, const std::string& type, uint32_t flags)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_ports.count(name) != 0) RemovePortLocked(name);
+        AddPortLocked(name, type, flags);
+    }
+
+    // On Port Unregistered
+    void PortGraphCache::OnPortUnregistered(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_ports.count(name) != 0) RemovePortLocked(name);
+    }
+
+    // On Port Renamed
+    void PortGraphCache::OnPortRenamed(const std::string& oldName, const std::string& newName)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _ports.find(oldName);
+        if (it == _ports.end() || _ports.count(newName) != 0) {
+            _stale = true;
+            return;
+        }
+
+        PortEntry entry = std::move(it->second);
+        _ports.erase(it);
+
+        for (const auto& other : entry.connections) {
+            auto& otherConnections = _ports[other].connections;
+            otherConnections.erase(oldName);
+            otherConnections.insert(newName);
+        }
+
+        _ports.emplace(newName, std::move(entry));
+        LogLocked(PortGraphChangeKind::PortRenamed, newName, oldName);
+    }
+
+    // On Ports Connected
+    void PortGraphCache::OnPortsConnected(const std::string& source, const std::string& destination, bool connected)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_ports.count(source) == 0 || _ports.count(destination) == 0) {
+            // A disconnect that follows the removal of one of its ports is already reflected
+            if (connected) _stale = true;
+            return;
+        }
+
+        ConnectLocked(source, destination, connected);
+    }
+
+    // Mark Stale
+    void PortGraphCache::MarkStale()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stale = true;
+    }
+
+    // Set Resync Source
+    void PortGraphCache::SetResyncSource(std::function<void(PortGraphCache&)> source)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _resyncSource = std::move(source);
+    }
+
+    // Is Seeded
+    bool PortGraphCache::IsSeeded()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _seeded;
+    }
+
+    // Get Version
+    uint64_t PortGraphCache::GetVersion()
+    {
+        ResyncIfStale();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _version;
+    }
+
+    // Get Changes
+    uint64_t PortGraphCache::GetChanges(uint64_t sinceVersion, std::vector<PortGraphChange>& changes, bool& fullSnapshot)
+    {
+        ResyncIfStale();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        changes.clear();
+        fullSnapshot = false;
+
+        // Nothing happened since the caller's version
+        if (sinceVersion == _version) return _version;
+
+        const uint64_t oldestLogged = _log.empty() ? _version + 1 : _log.front().version;
+        if (sinceVersion > _version || sinceVersion + 1 < oldestLogged) {
+            fullSnapshot = true;
+
+            for (const auto& entry : _ports) {
+                changes.push_back({ _version, PortGraphChangeKind::PortAdded, entry.first, std::string(),
+                                    entry.second.type, entry.second.flags });
+            }
+            for (const auto& entry : _ports) {
+                if ((entry.second.flags & kPortIsOutput) == 0) continue;
+                for (const auto& other : entry.second.connections) {
+                    changes.push_back({ _version, PortGraphChangeKind::Connected, entry.first, other, std::string(), 0 });
+                }
+            }
+
+            return _version;
+        }
+
+        // The log is ordered by version; skip to the first entry the caller hasn't seen
+        auto it = _log.begin() + static_cast<std::ptrdiff_t>(sinceVersion + 1 - oldestLogged);
+        changes.assign(it, _log.end());
+        return _version;
+    }
+
+    // Get Ports
+    std::vector<PortGraphPort> PortGraphCache::GetPorts()
+    {
+        ResyncIfStale();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::vector<PortGraphPort> ports;
+        ports.reserve(_ports.size());
+        for (const auto& entry : _ports) {
+            ports.push_back({ entry.first, entry.second.type, entry.second.flags,
+                              std::vector<std::string>(entry.second.connections.begin(), entry.second.connections.end()) });
+        }
+
+        return ports;
+    }
+
+    // Try Get Connected
+    bool PortGraphCache::TryGetConnected(const std::string& source, const std::string& destination, bool& connected)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_seeded || _stale) return false;
+
+        auto it = _ports.find(source);
+        if (it == _ports.end() || _ports.count(destination) == 0) return false;
+
+        connected = it->second.connections.count(destination) != 0;
+        return true;
+    }
+
+    // Re-enumerate the graph outside the lock if a notification could not be applied
+    void PortGraphCache::ResyncIfStale()
+    {
+        std::function<void(PortGraphCache&)> source;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_stale || !_resyncSource) return;
+            source = _resyncSource;
+        }
+
+        source(*this);
+    }
+
+    void PortGraphCache::AddPortLocked(const std::string& name, const std::string& type, uint32_t flags)
+    {
+        _ports[name] = PortEntry{ type, flags, {} };
+        LogLocked(PortGraphChangeKind::PortAdded, name, std::string(), type, flags);
+    }
+
+    void PortGraphCache::RemovePortLocked(const std::string& name)
+    {
+        auto it = _ports.find(name);
+        if (it == _ports.end()) return;
+
+        // Report the port's connections as dropped before the port itself
+        std::set<std::string> connections = it->second.connections;
+        const bool isOutput = (it->second.flags & kPortIsOutput) != 0;
+        for (const auto& other : connections) {
+            if (isOutput) ConnectLocked(name, other, false);
+            else ConnectLocked(other, name, false);
+        }
+
+        _ports.erase(name);
+        LogLocked(PortGraphChangeKind::PortRemoved, name);
+    }
+
+    void PortGraphCache::ConnectLocked(const std::string& source, const std::string& destination, bool connected)
+    {
+        auto& sourceConnections = _ports[source].connections;
+        auto& destinationConnections = _ports[destination].connections;
+
+        if (connected) {
+            if (!sourceConnections.insert(destination).second) return;
+            destinationConnections.insert(source);
+        }
+        else {
+            if (sourceConnections.erase(destination) == 0) return;
+            destinationConnections.erase(source);
+        }
+
+        LogLocked(connected ? PortGraphChangeKind::Connected : PortGraphChangeKind::Disconnected, source, destination);
+    }
+
+    void PortGraphCache::LogLocked(PortGraphChangeKind kind, const std::string& portName,
+                                   const std::string& otherPortName, const std::string& type, uint32_t flags)
+    {
+        _log.push_back({ ++_version, kind, portName, otherPortName, type, flags });
+        if (_log.size() > kMaxLogEntries) _log.pop_front();
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// Kind of change recorded in the port graph log
+    /// </summary>
+    enum class PortGraphChangeKind
+    {
+        PortAdded,
+        PortRemoved,
+        PortRenamed,
+        Connected,
+        Disconnected
+    };
+
+    /// <summary>
+    /// One change to the port graph
+    /// </summary>
+    struct PortGraphChange
+    {
+        uint64_t version;
+        PortGraphChangeKind kind;
+        std::string portName;
+        std::string otherPortName;  // Connected port, or the previous name for renames
+        std::string type;           // PortAdded only
+        uint32_t flags;             // PortAdded only
+    };
+
+    /// <summary>
+    /// A port and its connections as held by the cache
+    /// </summary>
+    struct PortGraphPort
+    {
+        std::string name;
+        std::string type;
+        uint32_t flags;
+        std::vector<std::string> connections;
+    };
+
+    /// <summary>
+    /// In-memory copy of the JACK port graph, kept current from JACK's registration,
+    /// connect and rename notifications instead of being re-queried on every read. Every
+    /// change bumps the graph version and is logged, so readers can fetch only what
+    /// changed since the version they last saw.
+    /// </summary>
+    class PortGraphCache
+    {
+    public:
+        // Number of changes retained for incremental reads
+        static constexpr size_t kMaxLogEntries = 4096;
+
+        PortGraphCache();
+
+        /// <summary>
+        /// Replaces the whole graph (initial enumeration or resynchronization). Changes
+        /// against the previous contents are logged like individual notifications.
+        /// </summary>
+        void Reset(const std::vector<PortGraphPort>& ports);
+
+        void OnPortRegistered(const std::string& name, const std::string& type, uint32_t flags);
+        void OnPortUnregistered(const std::string& name);
+        void OnPortRenamed(const std::string& oldName, const std::string& newName);
+        void OnPortsConnected(const std::string& source, const std::string& destination, bool connected);
+
+        /// <summary>
+        /// Marks the cache as out of sync (e.g. a notification could not be resolved);
+        /// the next read resynchronizes through the source set with SetResyncSource()
+        /// </summary>
+        void MarkStale();
+
+        /// <summary>
+        /// Sets the function that re-enumerates the graph and calls Reset()
+        /// </summary>
+        void SetResyncSource(std::function<void(PortGraphCache&)> source);
+
+        /// <summary>
+        /// Returns true once the graph has been populated
+        /// </summary>
+        bool IsSeeded();
+
+        /// <summary>
+        /// Returns the current graph version
+        /// </summary>
+        uint64_t GetVersion();
+
+        /// <summary>
+        /// Returns the changes after sinceVersion and the current version. If the log no
+        /// longer reaches back that far, the whole graph is returned as PortAdded and
+        /// Connected changes and fullSnapshot is set.
+        /// </summary>
+        uint64_t GetChanges(uint64_t sinceVersion, std::vector<PortGraphChange>& changes, bool& fullSnapshot);
+
+        /// <summary>
+        /// Returns every port with its connections
+        /// </summary>
+        std::vector<PortGraphPort> GetPorts();
+
+        /// <summary>
+        /// Looks up whether two ports are connected. Returns false if the cache has not
+        /// been seeded or does not know one of the ports.
+        /// </summary>
+        bool TryGetConnected(const std::string& source, const std::string& destination, bool& connected);
+
+    private:
+        struct PortEntry
+        {
+            std::string type;
+            uint32_t flags;
+            std::set<std::string> connections;
+        };
+
+        void ResyncIfStale();
+        void AddPortLocked(const std::string& name, const std::string& type, uint32_t flags);
+        void RemovePortLocked(const std::string& name);
+        void ConnectLocked(const std::string& source, const std::string& destination, bool connected);
+        void LogLocked(PortGraphChangeKind kind, const std::string& portName,
+                       const std::string& otherPortName = std::string(),
+                       const std::string& type = std::string(), uint32_t flags = 0);
+
+        std::map<std::string, PortEntry> _ports;
+        std::deque<PortGraphChange> _log;
+        uint64_t _version;
+        bool _seeded;
+        bool _stale;
+
+        std::function<void(PortGraphCache&)> _resyncSource;
+
+        // Notifications arrive on JACK's notification thread, reads on control threads
+        std::mutex _mutex;
+    };
+}
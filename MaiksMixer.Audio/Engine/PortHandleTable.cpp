@@ -0,0 +1,37 @@
+#include "PortHandleTable.h"
+
+namespace emp {
+
+    // Intern
+    int32_t PortHandleTable::Intern(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _handles.find(name);
+        if (it != _handles.end()) return it->second;
+
+        const int32_t handle = static_cast<int32_t>(_names.size());
+        _names.push_back(name);
+        _handles.emplace(name, handle);
+        return handle;
+    }
+
+    // Find
+    int32_t PortHandleTable::Find(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _handles.find(name);
+        return it != _handles.end() ? it->second : kInvalidHandle;
+    }
+
+    // Get Name
+    bool PortHandleTable::GetName(int32_t handle, std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (handle < 0 || static_cast<size_t>(handle) >= _names.size()) return false;
+
+        name = _names[handle];
+        return true;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PortGraphCache.h"
+
+namespace emp {
+
+    /// <summary>
+    /// Requested change of one connection. Layout matches the managed
+    /// PortConnectionChange value struct so arrays can be passed without conversion.
+    /// </summary>
+    struct PortConnectionChange
+    {
+        int32_t source;         // Port handle
+        int32_t destination;    // Port handle
+        int32_t connect;        // Non-zero to connect, zero to disconnect
+    };
+
+    /// <summary>
+    /// Outcome of one PortConnectionChange (matches the managed PortConnectionResult)
+    /// </summary>
+    enum class PortConnectionResult : int32_t
+    {
+        Applied = 0,
+        Unchanged = 1,          // Already in the requested state
+        InvalidHandle = -1,
+        Failed = -2
+    };
+
+    /// <summary>
+    /// Interns port names as small integer handles so callers resolve a name once and
+    /// then refer to the port by handle. Handles stay valid for the lifetime of the
+    /// table and always map to the same name, whether or not the port currently exists.
+    /// </summary>
+    class PortHandleTable
+    {
+    public:
+        static constexpr int32_t kInvalidHandle = -1;
+
+        /// <summary>
+        /// Returns the handle for a port name, creating it on first use
+        /// </summary>
+        int32_t Intern(const std::string& name);
+
+        /// <summary>
+        /// Returns the handle for a port name, or kInvalidHandle if it was never interned
+        /// </summary>
+        int32_t Find(const std::string& name);
+
+        /// <summary>
+        /// Gets the name behind a handle; returns false for unknown handles
+        /// </summary>
+        bool GetName(int32_t handle, std::string& name);
+
+        /// <summary>
+        /// Applies a batch of connection changes in order, calling
+        /// setConnected(sourceName, destinationName, connect) for each change that is not
+        /// already in effect according to graph. Writes one result per change.
+        /// </summary>
+        template <typename SetConnected>
+        void ApplyConnectionChanges(const PortConnectionChange* changes, int count, PortConnectionResult* results,
+                                    PortGraphCache& graph, SetConnected&& setConnected)
+        {
+            std::string source;
+            std::string destination;
+
+            for (int i = 0; i < count; i++) {
+                const PortConnectionChange& change = changes[i];
+                if (!GetName(change.source, source) || !GetName(change.destination, destination)) {
+                    results[i] = PortConnectionResult::InvalidHandle;
+                    continue;
+                }
+
+                const bool connect = change.connect != 0;
+                bool connected = false;
+                if (graph.TryGetConnected(source, destination, connected) && connected == connect) {
+                    results[i] = PortConnectionResult::Unchanged;
+                    continue;
+                }
+
+                results[i] = setConnected(source, destination, connect)
+                    ? PortConnectionResult::Applied
+                    : PortConnectionResult::Failed;
+            }
+        }
+
+    private:
+        std::vector<std::string> _names;
+        std::unordered_map<std::string, int32_t> _handles;
+        std::mutex _mutex;
+    };
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace emp {
+
+    /// <summary>
+    /// Read-copy-update for structures the process callback reads once per cycle. The
+    /// audio thread brackets each cycle with a ReadScope (two atomic increments); a control
+    /// thread publishes a replacement with RcuPointer::Publish() and then Synchronize()s,
+    /// which returns once every cycle that could still see the old version has ended.
+    /// The old version can then be freed. The audio thread never blocks or waits.
+    /// </summary>
+    class RcuDomain
+    {
+    public:
+        // Poll interval while waiting for a cycle to end
+        static constexpr int kPollIntervalUs = 100;
+
+        class ReadScope
+        {
+        public:
+            explicit ReadScope(RcuDomain& domain) : _domain(domain)
+            {
+                _domain._epoch.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~ReadScope()
+            {
+                _domain._epoch.fetch_add(1, std::memory_order_release);
+            }
+
+            ReadScope(const ReadScope&) = delete;
+            ReadScope& operator=(const ReadScope&) = delete;
+
+        private:
+            RcuDomain& _domain;
+        };
+
+        RcuDomain() : _epoch(0) {}
+
+        /// <summary>
+        /// Waits until no cycle that began before this call is still running (control
+        /// threads only; returns immediately while no cycle is running)
+        /// </summary>
+        void Synchronize()
+        {
+            const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+            if ((epoch & 1) == 0) return;
+
+            while (_epoch.load(std::memory_order_acquire) == epoch) {
+                std::this_thread::sleep_for(std::chrono::microseconds(kPollIntervalUs));
+            }
+        }
+
+    private:
+        // Odd while a cycle is running
+        std::atomic<uint64_t> _epoch;
+    };
+
+    /// <summary>
+    /// Pointer to an RCU-managed object: the audio thread loads it inside a ReadScope, a
+    /// control thread replaces it and reclaims the old object after a grace period
+    /// </summary>
+    template <typename T>
+    class RcuPointer
+    {
+    public:
+        RcuPointer() : _current(nullptr) {}
+
+        /// <summary>
+        /// Current object (audio thread, inside a ReadScope); nullptr before the first Publish()
+        /// </summary>
+        T* Load() const { return _current.load(std::memory_order_seq_cst); }
+
+        /// <summary>
+        /// Swaps in a new object, waits for the grace period and destroys the old one.
+        /// Control threads only; callers must serialize Publish() among themselves.
+        /// </summary>
+        void Publish(std::unique_ptr<T> next, RcuDomain& domain)
+        {
+            _current.store(next.get(), std::memory_order_seq_cst);
+            std::unique_ptr<T> previous = std::move(_owned);
+            _owned = std::move(next);
+
+            domain.Synchronize();
+            previous.reset();
+        }
+
+        /// <summary>
+        /// Current object for control threads that serialize with Publish()
+        /// </summary>
+        T* Get() const { return _owned.get(); }
+
+    private:
+        std::atomic<T*> _current;
+        std::unique_ptr<T> _owned;
+    };
+}
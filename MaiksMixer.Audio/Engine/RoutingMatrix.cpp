@@ -0,0 +1,133 @@
+#include "RoutingMatrix.h"
+
+#include <algorithm>
+
+namespace emp {
+
+    // Compile Routes
+    void CompileRoutes(const float* gains, int numInputs, int numOutputs, CompiledRoutes& routes)
+    {
+        uint32_t count = 0;
+        for (int i = 0; i < numInputs; i++) {
+            routes.rowStart[i] = count;
+
+            const float* row = gains + static_cast<size_t>(i) * numOutputs;
+            for (int o = 0; o < numOutputs; o++) {
+                if (row[o] > 0.0f) {
+                    routes.entries[count++] = RouteEntry{ static_cast<uint32_t>(o), row[o] };
+                }
+            }
+        }
+        routes.rowStart[numInputs] = count;
+        routes.routeCount = count;
+    }
+
+    // Constructor
+    RoutingMatrix::RoutingMatrix()
+        : _numInputs(0), _numOutputs(0), _enabled(false), _version(0), _scene(0)
+    {
+    }
+
+    // Reserve
+    void RoutingMatrix::Reserve(int numInputs, int numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        _numInputs = std::max(numInputs, 0);
+        _numOutputs = std::max(numOutputs, 0);
+        _gains.assign(static_cast<size_t>(_numInputs) * _numOutputs, 0.0f);
+        _scene = 0;
+
+        // Every buffer can hold a fully populated matrix, so compiling never reallocates
+        _compiled.ForEach([this](CompiledRoutes& routes) {
+            routes.rowStart.assign(_numInputs + 1, 0);
+            routes.entries.assign(_gains.size(), RouteEntry{ 0, 0.0f });
+            routes.numInputs = _numInputs;
+            routes.numOutputs = _numOutputs;
+            routes.routeCount = 0;
+            routes.enabled = _enabled;
+            routes.version = _version;
+            routes.scene = _scene;
+        });
+    }
+
+    // Set Enabled
+    void RoutingMatrix::SetEnabled(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        _enabled = enabled;
+        PublishLocked();
+    }
+
+    // Is Enabled
+    bool RoutingMatrix::IsEnabled()
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        return _enabled;
+    }
+
+    // Set Route
+    bool RoutingMatrix::SetRoute(int input, int output, float gain)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (input < 0 || input >= _numInputs || output < 0 || output >= _numOutputs) return false;
+
+        _gains[static_cast<size_t>(input) * _numOutputs + output] = std::max(gain, 0.0f);
+        PublishLocked();
+        return true;
+    }
+
+    // Get Route
+    float RoutingMatrix::GetRoute(int input, int output)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        if (input < 0 || input >= _numInputs || output < 0 || output >= _numOutputs) return 0.0f;
+
+        return _gains[static_cast<size_t>(input) * _numOutputs + output];
+    }
+
+    // Clear
+    void RoutingMatrix::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        std::fill(_gains.begin(), _gains.end(), 0.0f);
+        PublishLocked();
+    }
+
+    // Restore
+    void RoutingMatrix::Restore(const std::vector<float>& gains, bool enabled, uint64_t scene)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        const size_t count = std::min(gains.size(), _gains.size());
+        std::copy(gains.begin(), gains.begin() + count, _gains.begin());
+        std::fill(_gains.begin() + count, _gains.end(), 0.0f);
+        _enabled = enabled;
+        _scene = scene;
+        PublishLocked();
+    }
+
+    // Get Matrix
+    void RoutingMatrix::GetMatrix(std::vector<float>& gains, int& numInputs, int& numOutputs)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+
+        gains = _gains;
+        numInputs = _numInputs;
+        numOutputs = _numOutputs;
+    }
+
+    // Compile the dense staging matrix into sparse rows and publish it
+    void RoutingMatrix::PublishLocked()
+    {
+        CompiledRoutes& routes = _compiled.WriteBuffer();
+        CompileRoutes(_gains.data(), _numInputs, _numOutputs, routes);
+        routes.enabled = _enabled;
+        routes.version = ++_version;
+        routes.scene = _scene;
+
+        _compiled.Publish();
+    }
+}
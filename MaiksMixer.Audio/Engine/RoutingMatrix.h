@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "TripleBuffer.h"
+
+namespace emp {
+
+    /// <summary>
+    /// One non-zero crosspoint of the routing matrix
+    /// </summary>
+    struct RouteEntry
+    {
+        uint32_t output;
+        float gain;
+    };
+
+    /// <summary>
+    /// Routing matrix compiled for the process callback: the non-zero crosspoints of each
+    /// input stored contiguously (compressed sparse rows), so a cycle only visits routes
+    /// that exist.
+    /// </summary>
+    struct CompiledRoutes
+    {
+        // Routes of input i are entries[rowStart[i] .. rowStart[i + 1])
+        std::vector<uint32_t> rowStart;
+        std::vector<RouteEntry> entries;
+        int numInputs = 0;
+        int numOutputs = 0;
+        uint32_t routeCount = 0;
+        bool enabled = false;
+        uint64_t version = 0;
+        uint64_t scene = 0;     // Scene recall the matrix descends from (0 before any)
+    };
+
+    /// <summary>
+    /// Compiles a dense input-major matrix into the sparse rows of routes, whose rowStart
+    /// and entries must already hold numInputs + 1 and numInputs x numOutputs elements
+    /// (never reallocates). Sets routeCount; the other fields are the caller's.
+    /// </summary>
+    void CompileRoutes(const float* gains, int numInputs, int numOutputs, CompiledRoutes& routes);
+
+    /// <summary>
+    /// Input channel x output port gain matrix. Control threads edit a dense staging copy;
+    /// each edit is compiled to sparse rows off the audio thread and published atomically,
+    /// so the process callback switches matrices only between cycles.
+    ///
+    /// While the matrix is disabled the engine keeps its default stereo pan mix.
+    /// </summary>
+    class RoutingMatrix
+    {
+    public:
+        RoutingMatrix();
+
+        /// <summary>
+        /// Sizes the matrix and clears every route. Must not be called while the process
+        /// callback may be running.
+        /// </summary>
+        void Reserve(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Enables or disables matrix routing
+        /// </summary>
+        void SetEnabled(bool enabled);
+        bool IsEnabled();
+
+        /// <summary>
+        /// Sets the gain of a crosspoint; a gain of 0 removes the route
+        /// </summary>
+        bool SetRoute(int input, int output, float gain);
+
+        /// <summary>
+        /// Returns the gain of a crosspoint (0 if not routed)
+        /// </summary>
+        float GetRoute(int input, int output);
+
+        /// <summary>
+        /// Removes every route
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// Copies the dense matrix (input-major, numInputs x numOutputs) into gains
+        /// </summary>
+        void GetMatrix(std::vector<float>& gains, int& numInputs, int& numOutputs);
+
+        /// <summary>
+        /// Replaces the matrix with a recalled scene's (same dimensions as Reserve()) and
+        /// publishes it tagged with the recall id; later matrices keep the tag
+        /// </summary>
+        void Restore(const std::vector<float>& gains, bool enabled, uint64_t scene);
+
+        /// <summary>
+        /// Applies several crosspoint edits to the staging matrix and publishes them as one
+        /// compiled matrix. The editor is called with the dense gains and the dimensions.
+        /// </summary>
+        template <typename Editor>
+        void Apply(Editor&& edit)
+        {
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            edit(_gains, _numInputs, _numOutputs);
+            PublishLocked();
+        }
+
+        /// <summary>
+        /// Returns the matrix to render this cycle. Real-time safe.
+        /// </summary>
+        const CompiledRoutes& AcquireRoutes() { return _compiled.Read(); }
+
+    private:
+        void PublishLocked();
+
+        // Dense staging matrix, input-major
+        std::vector<float> _gains;
+        int _numInputs;
+        int _numOutputs;
+        bool _enabled;
+        uint64_t _version;
+        uint64_t _scene;
+
+        TripleBuffer<CompiledRoutes> _compiled;
+
+        // Serializes control threads; the process callback never takes it
+        std::mutex _writerMutex;
+    };
+}
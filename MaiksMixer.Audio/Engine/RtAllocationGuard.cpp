@@ -0,0 +1,148 @@
+#include "RtAllocationGuard.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+#if EMP_RT_ALLOC_GUARD && defined(_MSC_VER)
+#include <crtdbg.h>
+#endif
+
+namespace emp {
+
+    namespace {
+        thread_local bool t_inRealtimeScope = false;
+    }
+
+    // Scope constructor
+    RtAllocationGuard::Scope::Scope()
+        : _previous(t_inRealtimeScope)
+    {
+        t_inRealtimeScope = true;
+    }
+
+    // Scope destructor
+    RtAllocationGuard::Scope::~Scope()
+    {
+        t_inRealtimeScope = _previous;
+    }
+
+    // Is Realtime Thread
+    bool RtAllocationGuard::IsRealtimeThread()
+    {
+        return t_inRealtimeScope;
+    }
+
+    // Report Violation
+    void RtAllocationGuard::ReportViolation(const char* function)
+    {
+        // Leave the scope first so the diagnostic itself may allocate
+        t_inRealtimeScope = false;
+
+        std::fprintf(stderr, "MaiksMixer: %s called on the real-time audio thread\n", function);
+        assert(!"heap allocation on the real-time audio thread");
+        std::abort();
+    }
+}
+
+#if EMP_RT_ALLOC_GUARD
+
+#if defined(_MSC_VER)
+
+// The debug CRT routes malloc, realloc and operator new through the allocation hook
+namespace {
+    _CRT_ALLOC_HOOK g_previousAllocHook = nullptr;
+
+    int __cdecl RtAllocHook(int allocType, void* userData, size_t size, int blockType,
+                            long requestNumber, const unsigned char* fileName, int lineNumber)
+    {
+        if ((allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) &&
+            emp::RtAllocationGuard::IsRealtimeThread()) {
+            emp::RtAllocationGuard::ReportViolation(allocType == _HOOK_ALLOC ? "malloc" : "realloc");
+        }
+
+        return g_previousAllocHook != nullptr
+            ? g_previousAllocHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber)
+            : TRUE;
+    }
+
+    struct RtAllocHookInstaller
+    {
+        RtAllocHookInstaller() { g_previousAllocHook = _CrtSetAllocHook(RtAllocHook); }
+    } g_rtAllocHookInstaller;
+}
+
+#elif defined(__GLIBC__)
+
+#include <cerrno>
+
+// Interpose the C allocator, every entry point including the aligned ones; operator new is
+// implemented on top of malloc and aligned_alloc
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void* __libc_valloc(size_t size);
+    void* __libc_pvalloc(size_t size);
+
+    void* malloc(size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("realloc");
+        return __libc_realloc(ptr, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("posix_memalign");
+
+        // Same checks as glibc: a power of two that is a multiple of sizeof(void*)
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0) return EINVAL;
+
+        void* memory = __libc_memalign(alignment, size);
+        if (memory == nullptr) return ENOMEM;
+
+        *result = memory;
+        return 0;
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* valloc(size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("valloc");
+        return __libc_valloc(size);
+    }
+
+    void* pvalloc(size_t size)
+    {
+        if (emp::RtAllocationGuard::IsRealtimeThread()) emp::RtAllocationGuard::ReportViolation("pvalloc");
+        return __libc_pvalloc(size);
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+// Debug guard that asserts when the heap is used on the real-time thread. Enabled by
+// default in debug builds; define EMP_RT_ALLOC_GUARD=0/1 to override.
+#if !defined(EMP_RT_ALLOC_GUARD)
+#if defined(NDEBUG)
+#define EMP_RT_ALLOC_GUARD 0
+#else
+#define EMP_RT_ALLOC_GUARD 1
+#endif
+#endif
+
+namespace emp {
+
+    /// <summary>
+    /// Marks the calling thread as real-time for the lifetime of a scope. While a scope is
+    /// open, any malloc/new on that thread aborts with a diagnostic (when the guard is
+    /// compiled in). Scopes nest.
+    /// </summary>
+    class RtAllocationGuard
+    {
+    public:
+        class Scope
+        {
+        public:
+            Scope();
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            bool _previous;
+        };
+
+        /// <summary>
+        /// Returns true if the calling thread is inside a real-time scope
+        /// </summary>
+        static bool IsRealtimeThread();
+
+        /// <summary>
+        /// Called by the allocation hooks when the heap is used inside a real-time scope
+        /// </summary>
+        static void ReportViolation(const char* function);
+    };
+}
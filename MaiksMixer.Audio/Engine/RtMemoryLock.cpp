@@ -0,0 +1,90 @@
+#include "RtMemoryLock.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace emp {
+
+    // Lock Process
+    bool RtMemoryLock::LockProcess()
+    {
+#ifdef _WIN32
+        return false;
+#else
+        return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+    }
+
+    // Unlock Process
+    void RtMemoryLock::UnlockProcess()
+    {
+#ifndef _WIN32
+        munlockall();
+#endif
+    }
+
+    // Get Page Size
+    size_t RtMemoryLock::GetPageSize()
+    {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        return pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+#endif
+    }
+
+    // Lock Pages
+    bool RtMemoryLock::LockPages(const void* address, size_t bytes)
+    {
+        if (address == nullptr || bytes == 0) return false;
+
+#ifdef _WIN32
+        return VirtualLock(const_cast<void*>(address), bytes) != 0;
+#else
+        return mlock(address, bytes) == 0;
+#endif
+    }
+
+    // Unlock Pages
+    void RtMemoryLock::UnlockPages(const void* address, size_t bytes)
+    {
+        if (address == nullptr || bytes == 0) return;
+
+#ifdef _WIN32
+        VirtualUnlock(const_cast<void*>(address), bytes);
+#else
+        munlock(address, bytes);
+#endif
+    }
+
+    // Prefault Stack
+    void RtMemoryLock::PrefaultStack()
+    {
+        // volatile keeps the compiler from dropping the writes and the read-back
+        volatile unsigned char stack[kPrefaultStackBytes];
+        const size_t pageSize = GetPageSize();
+        for (size_t i = 0; i < kPrefaultStackBytes; i += pageSize) {
+            stack[i] = 0;
+        }
+
+        unsigned char touched = 0;
+        for (size_t i = 0; i < kPrefaultStackBytes; i += pageSize) {
+            touched |= stack[i];
+        }
+        static_cast<void>(touched);
+
+        // Only the stack is locked, not the process: the pages stay resident for the
+        // frames that use them later
+        LockPages(const_cast<const unsigned char*>(stack), kPrefaultStackBytes);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+namespace emp {
+
+    /// <summary>
+    /// Keeps engine memory resident so the process callback never takes a page fault.
+    /// Every call is best effort: locking needs privileges (RLIMIT_MEMLOCK on Linux, the
+    /// working set quota on Windows) and the engine runs unlocked when they are missing.
+    /// </summary>
+    class RtMemoryLock
+    {
+    public:
+        // Stack touched by PrefaultStack(), enough for the deepest process call chain
+        static constexpr size_t kPrefaultStackBytes = 256 * 1024;
+
+        /// <summary>
+        /// Locks every current and future page of the process (mlockall; a no-op that
+        /// returns false on Windows). This pins the whole heap, a managed host's included,
+        /// so the engine only does it when asked to (MixEngine::LockMemory(true)).
+        /// </summary>
+        static bool LockProcess();
+
+        /// <summary>
+        /// Undoes LockProcess()
+        /// </summary>
+        static void UnlockProcess();
+
+        /// <summary>
+        /// Size of a memory page, the unit pages are locked and unlocked in
+        /// </summary>
+        static size_t GetPageSize();
+
+        /// <summary>
+        /// Locks a range of pages (mlock / VirtualLock). The pages must already be committed.
+        /// Page locks do not nest, so the range should cover whole pages that no other
+        /// locked block shares.
+        /// </summary>
+        static bool LockPages(const void* address, size_t bytes);
+
+        /// <summary>
+        /// Unlocks a range locked with LockPages() before its memory is freed
+        /// </summary>
+        static void UnlockPages(const void* address, size_t bytes);
+
+        /// <summary>
+        /// Touches kPrefaultStackBytes of the calling thread's stack and locks those pages
+        /// (best effort) before the thread does real-time work. The lock ends with the thread.
+        /// </summary>
+        static void PrefaultStack();
+    };
+}
@@ -0,0 +1,282 @@
+#include "RtWorkerPool.h"
+
+#include <algorithm>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EMP_SPIN_PAUSE() _mm_pause()
+#else
+#define EMP_SPIN_PAUSE() std::this_thread::yield()
+#endif
+
+#include "RtAllocationGuard.h"
+#include "RtMemoryLock.h"
+
+namespace emp {
+
+    namespace {
+        void* CreateWakeSemaphore()
+        {
+#ifdef _WIN32
+            return CreateSemaphoreA(nullptr, 0, LONG_MAX, nullptr);
+#else
+            auto semaphore = new sem_t;
+            if (sem_init(semaphore, 0, 0) != 0) {
+                delete semaphore;
+                return nullptr;
+            }
+            return semaphore;
+#endif
+        }
+
+        void DestroyWakeSemaphore(void* semaphore)
+        {
+            if (semaphore == nullptr) return;
+#ifdef _WIN32
+            CloseHandle(static_cast<HANDLE>(semaphore));
+#else
+            sem_destroy(static_cast<sem_t*>(semaphore));
+            delete static_cast<sem_t*>(semaphore);
+#endif
+        }
+
+        void PostWakeSemaphore(void* semaphore, int count)
+        {
+#ifdef _WIN32
+            ReleaseSemaphore(static_cast<HANDLE>(semaphore), count, nullptr);
+#else
+            for (int i = 0; i < count; i++) {
+                sem_post(static_cast<sem_t*>(semaphore));
+            }
+#endif
+        }
+
+        void WaitWakeSemaphore(void* semaphore)
+        {
+#ifdef _WIN32
+            WaitForSingleObject(static_cast<HANDLE>(semaphore), INFINITE);
+#else
+            while (sem_wait(static_cast<sem_t*>(semaphore)) != 0) {
+                // Interrupted by a signal
+            }
+#endif
+        }
+
+        // Applies the scheduling settings to the calling thread; returns true if it runs
+        // with the requested real-time priority
+        bool ConfigureWorkerThread(int participant, const WorkerPoolConfig& config)
+        {
+            const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+            const unsigned core = static_cast<unsigned>(participant + 1) % cores;
+            bool realtime = false;
+
+#ifdef _WIN32
+            if (config.pinThreads && core < 64) SetThreadAffinityMask(GetCurrentThread(), 1ull << core);
+            if (config.realtimePriority > 0) {
+                realtime = SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+            }
+#else
+#ifdef __linux__
+            if (config.pinThreads) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(core, &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+#endif
+            if (config.realtimePriority > 0) {
+                sched_param param{};
+                param.sched_priority = config.realtimePriority;
+                realtime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+            }
+#endif
+
+            return realtime;
+        }
+    }
+
+    // Constructor
+    RtWorkerPool::RtWorkerPool()
+        : _participants(1), _wakeSemaphore(nullptr), _task(nullptr), _context(nullptr),
+          _remaining(0), _stopping(false), _realtimeWorkers(0), _stolenTasks(0)
+    {
+        _ranges.reset(new TaskRange[1]);
+    }
+
+    // Destructor
+    RtWorkerPool::~RtWorkerPool()
+    {
+        Stop();
+    }
+
+    // Start
+    bool RtWorkerPool::Start(const WorkerPoolConfig& config)
+    {
+        Stop();
+
+        const int workerCount = std::clamp(config.workerCount, 0, kMaxWorkers);
+        if (workerCount == 0) return true;
+
+        _wakeSemaphore = CreateWakeSemaphore();
+        if (_wakeSemaphore == nullptr) return false;
+
+        _participants = workerCount + 1;
+        _ranges.reset(new TaskRange[_participants]);
+        _stopping.store(false, std::memory_order_relaxed);
+        _realtimeWorkers.store(0, std::memory_order_relaxed);
+
+        try {
+            for (int i = 0; i < workerCount; i++) {
+                _workers.emplace_back(&RtWorkerPool::WorkerMain, this, i, config);
+            }
+        }
+        catch (const std::system_error&) {
+            Stop();
+            return false;
+        }
+
+        return true;
+    }
+
+    // Stop
+    void RtWorkerPool::Stop()
+    {
+        if (!_workers.empty()) {
+            _stopping.store(true, std::memory_order_release);
+            PostWakeSemaphore(_wakeSemaphore, static_cast<int>(_workers.size()));
+
+            for (auto& worker : _workers) {
+                worker.join();
+            }
+            _workers.clear();
+        }
+
+        DestroyWakeSemaphore(_wakeSemaphore);
+        _wakeSemaphore = nullptr;
+        _participants = 1;
+        _ranges.reset(new TaskRange[1]);
+    }
+
+    // Run (real-time thread)
+    void RtWorkerPool::Run(int taskCount, TaskFunction task, void* context)
+    {
+        if (taskCount <= 0) return;
+
+        // Inline when there is nobody to share with
+        if (_workers.empty() || taskCount == 1) {
+            for (int i = 0; i < taskCount; i++) {
+                task(context, i);
+            }
+            return;
+        }
+
+        _task = task;
+        _context = context;
+        _remaining.store(taskCount, std::memory_order_relaxed);
+
+        // Contiguous share per participant; the release stores publish the task function
+        for (int p = 0; p < _participants; p++) {
+            const uint32_t begin = static_cast<uint32_t>(static_cast<int64_t>(taskCount) * p / _participants);
+            const uint32_t end = static_cast<uint32_t>(static_cast<int64_t>(taskCount) * (p + 1) / _participants);
+            _ranges[p].bounds.store(Pack(begin, end), std::memory_order_release);
+        }
+
+        PostWakeSemaphore(_wakeSemaphore, std::min(static_cast<int>(_workers.size()), taskCount - 1));
+
+        Participate(_participants - 1);
+
+        // Wait for tasks still running on workers; yield eventually in case a worker
+        // shares this core
+        for (int spins = 0; _remaining.load(std::memory_order_acquire) > 0; spins++) {
+            if (spins < kSpinsBeforeYield) EMP_SPIN_PAUSE();
+            else std::this_thread::yield();
+        }
+    }
+
+    void RtWorkerPool::WorkerMain(int participant, const WorkerPoolConfig& config)
+    {
+        if (ConfigureWorkerThread(participant, config)) _realtimeWorkers.fetch_add(1, std::memory_order_relaxed);
+        RtMemoryLock::PrefaultStack();
+
+        // The worker is a real-time thread from here on, waiting included: nothing in the
+        // loop may touch the heap
+        RtAllocationGuard::Scope rtScope;
+
+        for (;;) {
+            WaitWakeSemaphore(_wakeSemaphore);
+            if (_stopping.load(std::memory_order_acquire)) break;
+
+            Participate(participant);
+        }
+    }
+
+    // Run own tasks, then steal until no task is left unclaimed
+    void RtWorkerPool::Participate(int participant)
+    {
+        int task;
+        for (;;) {
+            if (TakeOwn(participant, task)) {
+                _task(_context, task);
+            }
+            else if (Steal(participant, task)) {
+                _task(_context, task);
+                _stolenTasks.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                return;
+            }
+
+            _remaining.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    bool RtWorkerPool::TakeOwn(int participant, int& task)
+    {
+        std::atomic<uint64_t>& bounds = _ranges[participant].bounds;
+        uint64_t current = bounds.load(std::memory_order_acquire);
+
+        for (;;) {
+            const uint32_t begin = static_cast<uint32_t>(current);
+            const uint32_t end = static_cast<uint32_t>(current >> 32);
+            if (begin >= end) return false;
+
+            if (bounds.compare_exchange_weak(current, Pack(begin + 1, end), std::memory_order_acquire)) {
+                task = static_cast<int>(begin);
+                return true;
+            }
+        }
+    }
+
+    bool RtWorkerPool::Steal(int participant, int& task)
+    {
+        for (int offset = 1; offset < _participants; offset++) {
+            std::atomic<uint64_t>& bounds = _ranges[(participant + offset) % _participants].bounds;
+            uint64_t current = bounds.load(std::memory_order_acquire);
+
+            for (;;) {
+                const uint32_t begin = static_cast<uint32_t>(current);
+                const uint32_t end = static_cast<uint32_t>(current >> 32);
+                if (begin >= end) break;
+
+                if (bounds.compare_exchange_weak(current, Pack(begin, end - 1), std::memory_order_acquire)) {
+                    task = static_cast<int>(end - 1);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// Worker pool settings
+    /// </summary>
+    struct WorkerPoolConfig
+    {
+        int workerCount = 0;        // Threads besides the caller of Run(); 0 runs everything inline
+        int realtimePriority = 0;   // SCHED_FIFO priority (Windows: time-critical); 0 leaves the default
+        bool pinThreads = false;    // Pin worker i to core i + 1 (core 0 is left to the caller)
+    };
+
+    /// <summary>
+    /// Fixed set of worker threads that help the process callback with one parallel loop
+    /// per call to Run(). Tasks are split into one contiguous range per participant;
+    /// a participant takes tasks from the front of its own range and, once it runs dry,
+    /// steals from the back of the others'. The calling thread participates and Run()
+    /// returns only after every task has finished, so the pool is synchronized to the
+    /// audio cycle without any locks on the audio thread.
+    /// </summary>
+    class RtWorkerPool
+    {
+    public:
+        static constexpr int kMaxWorkers = 63;
+
+        // Busy-wait iterations for running tasks before the caller starts yielding
+        static constexpr int kSpinsBeforeYield = 4096;
+
+        using TaskFunction = void (*)(void* context, int task);
+
+        RtWorkerPool();
+        ~RtWorkerPool();
+
+        RtWorkerPool(const RtWorkerPool&) = delete;
+        RtWorkerPool& operator=(const RtWorkerPool&) = delete;
+
+        /// <summary>
+        /// Starts the workers (stopping any running ones first). Must not be called while
+        /// Run() may be executing. Returns false if a thread could not be created.
+        /// </summary>
+        bool Start(const WorkerPoolConfig& config);
+
+        /// <summary>
+        /// Stops and joins the workers. Must not be called while Run() may be executing.
+        /// </summary>
+        void Stop();
+
+        int GetWorkerCount() const { return static_cast<int>(_workers.size()); }
+
+        /// <summary>
+        /// Workers that obtained the requested real-time priority
+        /// </summary>
+        int GetRealtimeWorkerCount() const { return _realtimeWorkers.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Tasks executed by a participant other than the one they were assigned to
+        /// </summary>
+        uint64_t GetStolenTaskCount() const { return _stolenTasks.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Calls task(context, i) for every i in [0, taskCount) across the workers and the
+        /// calling thread and waits for all of them. Real-time safe; one caller at a time.
+        /// </summary>
+        void Run(int taskCount, TaskFunction task, void* context);
+
+    private:
+        // Task range [begin, end) packed into one word so owner and thieves claim with one CAS
+        struct alignas(64) TaskRange
+        {
+            std::atomic<uint64_t> bounds{ 0 };
+        };
+
+        static uint64_t Pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(end) << 32) | begin; }
+
+        void WorkerMain(int participant, const WorkerPoolConfig& config);
+        void Participate(int participant);
+        bool TakeOwn(int participant, int& task);
+        bool Steal(int participant, int& task);
+
+        std::vector<std::thread> _workers;
+        std::unique_ptr<TaskRange[]> _ranges;   // One per participant; the caller is the last
+        int _participants;
+        void* _wakeSemaphore;
+
+        TaskFunction _task;
+        void* _context;
+        alignas(64) std::atomic<int> _remaining;
+        std::atomic<bool> _stopping;
+        std::atomic<int> _realtimeWorkers;
+        std::atomic<uint64_t> _stolenTasks;
+    };
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// Wait-free single-producer/single-consumer ring of samples, written and read in
+    /// blocks. Storage is allocated once by Reserve(); a block that does not fit is
+    /// rejected whole instead of being split, so the consumer only ever sees complete
+    /// blocks.
+    /// </summary>
+    class SampleRing
+    {
+    public:
+        SampleRing()
+            : _mask(0), _head(0), _tail(0)
+        {
+        }
+
+        SampleRing(const SampleRing&) = delete;
+        SampleRing& operator=(const SampleRing&) = delete;
+
+        /// <summary>
+        /// Allocates room for at least capacity samples (rounded up to a power of two) and
+        /// empties the ring. Neither side may be active.
+        /// </summary>
+        void Reserve(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity) size *= 2;
+
+            _buffer.assign(size, 0.0f);
+            _mask = size - 1;
+            _head.store(0, std::memory_order_relaxed);
+            _tail.store(0, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Appends a block (producer side). Returns false, writing nothing, if it does not fit.
+        /// </summary>
+        bool TryWrite(const float* samples, size_t count)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            if (_buffer.size() - (tail - _head.load(std::memory_order_acquire)) < count) return false;
+
+            const size_t start = tail & _mask;
+            const size_t first = std::min(count, _buffer.size() - start);
+            std::copy(samples, samples + first, _buffer.data() + start);
+            std::copy(samples + first, samples + count, _buffer.data());
+
+            _tail.store(tail + count, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// Appends count zero samples (producer side). Returns false, writing nothing, if they
+        /// do not fit.
+        /// </summary>
+        bool TryWriteSilence(size_t count)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            if (_buffer.size() - (tail - _head.load(std::memory_order_acquire)) < count) return false;
+
+            const size_t start = tail & _mask;
+            const size_t first = std::min(count, _buffer.size() - start);
+            std::fill(_buffer.data() + start, _buffer.data() + start + first, 0.0f);
+            std::fill(_buffer.data(), _buffer.data() + (count - first), 0.0f);
+
+            _tail.store(tail + count, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// Removes up to capacity of the oldest samples (consumer side) and returns how many
+        /// were read
+        /// </summary>
+        size_t Read(float* destination, size_t capacity)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            const size_t count = std::min(capacity, _tail.load(std::memory_order_acquire) - head);
+            if (count == 0) return 0;
+
+            const size_t start = head & _mask;
+            const size_t first = std::min(count, _buffer.size() - start);
+            std::copy(_buffer.data() + start, _buffer.data() + start + first, destination);
+            std::copy(_buffer.data(), _buffer.data() + (count - first), destination + first);
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /// <summary>
+        /// Drops up to count of the oldest samples (consumer side) and returns how many were dropped
+        /// </summary>
+        size_t Skip(size_t count)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            count = std::min(count, _tail.load(std::memory_order_acquire) - head);
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /// <summary>
+        /// Drops every pending sample (consumer side)
+        /// </summary>
+        void Discard()
+        {
+            _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        /// <summary>
+        /// Samples available to the consumer
+        /// </summary>
+        size_t GetPendingCount() const
+        {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Samples the producer can still write; only grows until the producer writes again
+        /// </summary>
+        size_t GetFreeCount() const
+        {
+            return _buffer.size() - (_tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire));
+        }
+
+        size_t GetCapacity() const { return _buffer.size(); }
+
+    private:
+        std::vector<float> _buffer;
+        size_t _mask;
+
+        // Consumer and producer indices on separate cache lines
+        alignas(64) std::atomic<size_t> _head;
+        alignas(64) std::atomic<size_t> _tail;
+    };
+}
@@ -0,0 +1,227 @@
+#include "SharedMemoryRing.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace emp {
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared ring indices must be lock-free");
+    static_assert(sizeof(SharedRingHeader) <= SharedMemoryRing::kSlotOffset, "Ring header overlaps the slots");
+    static_assert(sizeof(SharedFrameHeader) == 16, "Frame header layout is shared with managed code");
+
+    // Constructor
+    SharedMemoryRing::SharedMemoryRing()
+        : _header(nullptr), _base(nullptr), _size(0), _slotCount(0), _slotSize(0), _owner(false), _handle(nullptr)
+    {
+    }
+
+    // Destructor
+    SharedMemoryRing::~SharedMemoryRing()
+    {
+        Close();
+    }
+
+    // Create
+    bool SharedMemoryRing::Create(const std::string& name, uint32_t slotCount, uint32_t slotSize)
+    {
+        Close();
+
+        if (slotCount < 2 || (slotCount & (slotCount - 1)) != 0) return false;
+        if (slotSize <= sizeof(SharedFrameHeader)) return false;
+
+        // Keep every slot 8-byte aligned
+        slotSize = (slotSize + 7) & ~7u;
+
+        const size_t size = kSlotOffset + static_cast<size_t>(slotCount) * slotSize;
+        if (!Map(name, size, true)) return false;
+        _owner = true;
+        _slotCount = slotCount;
+        _slotSize = slotSize;
+
+        _header->magic.store(0, std::memory_order_relaxed);
+        _header->slotCount = slotCount;
+        _header->slotSize = slotSize;
+        _header->layoutVersion = kLayoutVersion;
+        _header->writeIndex.store(0, std::memory_order_relaxed);
+        _header->readIndex.store(0, std::memory_order_relaxed);
+        _header->droppedFrames.store(0, std::memory_order_relaxed);
+
+        // Openers check the magic first
+        _header->magic.store(kMagic, std::memory_order_release);
+        return true;
+    }
+
+    // Open
+    bool SharedMemoryRing::Open(const std::string& name)
+    {
+        Close();
+
+        if (!Map(name, 0, false)) return false;
+
+        // The geometry is read once and validated against the mapping: the peer can write
+        // the header at any time, so nothing later trusts it again
+        const bool initialized = _header->magic.load(std::memory_order_acquire) == kMagic;
+        const uint32_t slotCount = _header->slotCount;
+        const uint32_t slotSize = _header->slotSize;
+        const bool valid = initialized && _header->layoutVersion == kLayoutVersion &&
+                           slotCount >= 2 && (slotCount & (slotCount - 1)) == 0 &&
+                           slotSize > sizeof(SharedFrameHeader) &&
+                           static_cast<uint64_t>(slotCount) * slotSize <= _size - kSlotOffset;
+        if (!valid) {
+            Close();
+            return false;
+        }
+
+        _slotCount = slotCount;
+        _slotSize = slotSize;
+        return true;
+    }
+
+    // Close
+    void SharedMemoryRing::Close()
+    {
+        if (_base == nullptr) return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(_base);
+        CloseHandle(static_cast<HANDLE>(_handle));
+#else
+        munmap(_base, _size);
+        if (_owner) shm_unlink(_name.c_str());
+#endif
+
+        _header = nullptr;
+        _base = nullptr;
+        _size = 0;
+        _slotCount = 0;
+        _slotSize = 0;
+        _owner = false;
+        _handle = nullptr;
+        _name.clear();
+    }
+
+    // Get Max Payload
+    uint32_t SharedMemoryRing::GetMaxPayload() const
+    {
+        return _header != nullptr ? _slotSize - static_cast<uint32_t>(sizeof(SharedFrameHeader)) : 0;
+    }
+
+    // Try Write (producer)
+    bool SharedMemoryRing::TryWrite(uint32_t type, const void* payload, uint32_t length)
+    {
+        if (_header == nullptr || length > GetMaxPayload()) return false;
+
+        const uint64_t write = _header->writeIndex.load(std::memory_order_relaxed);
+        if (write - _header->readIndex.load(std::memory_order_acquire) >= _slotCount) {
+            _header->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        unsigned char* slot = SlotAt(write);
+        const SharedFrameHeader frame{ write + 1, type, length };
+        std::memcpy(slot, &frame, sizeof(frame));
+        if (length > 0) std::memcpy(slot + sizeof(frame), payload, length);
+
+        _header->writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Try Read (consumer)
+    int SharedMemoryRing::TryRead(uint32_t& type, void* payload, uint32_t capacity, uint64_t* sequence)
+    {
+        if (_header == nullptr) return 0;
+
+        const uint64_t read = _header->readIndex.load(std::memory_order_relaxed);
+        if (read == _header->writeIndex.load(std::memory_order_acquire)) return 0;
+
+        const unsigned char* slot = SlotAt(read);
+        SharedFrameHeader frame;
+        std::memcpy(&frame, slot, sizeof(frame));
+
+        int result = -1;
+        if (frame.length <= capacity && frame.length <= GetMaxPayload()) {
+            if (frame.length > 0) std::memcpy(payload, slot + sizeof(frame), frame.length);
+            type = frame.type;
+            if (sequence != nullptr) *sequence = frame.sequence;
+            result = static_cast<int>(frame.length);
+        }
+
+        _header->readIndex.store(read + 1, std::memory_order_release);
+        return result;
+    }
+
+    // Get Dropped Count
+    uint64_t SharedMemoryRing::GetDroppedCount() const
+    {
+        return _header != nullptr ? _header->droppedFrames.load(std::memory_order_relaxed) : 0;
+    }
+
+    bool SharedMemoryRing::Map(const std::string& name, size_t size, bool create)
+    {
+#ifdef _WIN32
+        HANDLE mapping = create
+            ? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                 static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFFu), name.c_str())
+            : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+        if (mapping == nullptr) return false;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, create ? size : 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        if (!create) {
+            MEMORY_BASIC_INFORMATION info;
+            if (VirtualQuery(view, &info, sizeof(info)) == 0) {
+                UnmapViewOfFile(view);
+                CloseHandle(mapping);
+                return false;
+            }
+            size = info.RegionSize;
+        }
+
+        _handle = mapping;
+        _name = name;
+#else
+        const std::string shmName = "/" + name;
+        const int fd = shm_open(shmName.c_str(), create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (create ? ftruncate(fd, static_cast<off_t>(size)) != 0 : fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        if (!create) size = static_cast<size_t>(info.st_size);
+
+        void* view = size >= kSlotOffset ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (view == MAP_FAILED) return false;
+
+        _name = shmName;
+#endif
+
+        _base = static_cast<unsigned char*>(view);
+        _header = reinterpret_cast<SharedRingHeader*>(_base);
+        _size = size;
+        return true;
+    }
+
+    unsigned char* SharedMemoryRing::SlotAt(uint64_t index) const
+    {
+        return _base + kSlotOffset + static_cast<size_t>(index & (_slotCount - 1)) * _slotSize;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace emp {
+
+    /// <summary>
+    /// Frame types carried by the engine's shared-memory rings
+    /// </summary>
+    enum class SharedFrameType : uint32_t
+    {
+        Meters = 1,                 // uint32 channel count, uint32 values per channel, float values
+        ParameterChanges = 2,       // Array of ParameterChange records
+        TimedParameterChanges = 3   // Array of TimedParameterChange records
+    };
+
+    /// <summary>
+    /// Control block at the start of a ring mapping. The layout is shared with the
+    /// managed SharedMemoryRing and must not change without bumping kLayoutVersion.
+    /// </summary>
+    struct SharedRingHeader
+    {
+        std::atomic<uint32_t> magic;                // Written last by the creator
+        uint32_t layoutVersion;
+        uint32_t slotCount;
+        uint32_t slotSize;                          // Bytes per slot, frame header included
+        alignas(64) std::atomic<uint64_t> writeIndex;   // Frames written (producer)
+        alignas(64) std::atomic<uint64_t> readIndex;    // Frames consumed (consumer)
+        alignas(64) std::atomic<uint64_t> droppedFrames;
+    };
+
+    /// <summary>
+    /// Header in front of every frame
+    /// </summary>
+    struct SharedFrameHeader
+    {
+        uint64_t sequence;      // 1-based frame number, equal to writeIndex + 1 when written
+        uint32_t type;
+        uint32_t length;        // Payload bytes
+    };
+
+    /// <summary>
+    /// Lock-free single-producer/single-consumer ring of length-prefixed binary frames in a
+    /// named shared-memory mapping, for passing meters and parameter changes between
+    /// processes without serialization or a kernel mutex per message. Each slot holds one
+    /// frame; a full ring rejects (and counts) the frame instead of blocking the producer.
+    /// </summary>
+    class SharedMemoryRing
+    {
+    public:
+        static constexpr uint32_t kMagic = 0x524D5045;    // "EPMR"
+        static constexpr uint32_t kLayoutVersion = 1;
+        static constexpr size_t kSlotOffset = 256;        // Slots start after the header
+
+        SharedMemoryRing();
+        ~SharedMemoryRing();
+
+        SharedMemoryRing(const SharedMemoryRing&) = delete;
+        SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+        /// <summary>
+        /// Creates (or re-initializes) the named mapping with slotCount slots of slotSize
+        /// bytes. slotCount must be a power of two.
+        /// </summary>
+        bool Create(const std::string& name, uint32_t slotCount, uint32_t slotSize);
+
+        /// <summary>
+        /// Opens a mapping created by another process
+        /// </summary>
+        bool Open(const std::string& name);
+
+        /// <summary>
+        /// Unmaps the ring (and removes the name if this side created it)
+        /// </summary>
+        void Close();
+
+        bool IsOpen() const { return _header != nullptr; }
+
+        /// <summary>
+        /// Largest payload a frame can carry
+        /// </summary>
+        uint32_t GetMaxPayload() const;
+
+        /// <summary>
+        /// Appends a frame (producer side). Returns false if the ring is full or the
+        /// payload does not fit in a slot.
+        /// </summary>
+        bool TryWrite(uint32_t type, const void* payload, uint32_t length);
+
+        /// <summary>
+        /// Removes the oldest frame (consumer side), copying up to capacity payload bytes.
+        /// Returns the payload length, 0 if the ring is empty, or -1 if the frame was
+        /// larger than capacity (it is skipped).
+        /// </summary>
+        int TryRead(uint32_t& type, void* payload, uint32_t capacity, uint64_t* sequence = nullptr);
+
+        /// <summary>
+        /// Frames rejected because the ring was full
+        /// </summary>
+        uint64_t GetDroppedCount() const;
+
+    private:
+        bool Map(const std::string& name, size_t size, bool create);
+        unsigned char* SlotAt(uint64_t index) const;
+
+        SharedRingHeader* _header;
+        unsigned char* _base;
+        size_t _size;
+        uint32_t _slotCount;    // Validated copies of the header geometry
+        uint32_t _slotSize;
+        bool _owner;
+        std::string _name;
+        void* _handle;          // Mapping handle (Windows)
+    };
+}
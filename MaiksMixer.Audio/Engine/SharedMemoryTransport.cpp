@@ -0,0 +1,118 @@
+#include "SharedMemoryTransport.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "MixEngine.h"
+
+namespace emp {
+
+    namespace {
+        // Meters frame prefix: channel count, values per channel
+        constexpr size_t kMetersPrefix = sizeof(uint32_t) * 2;
+    }
+
+    // Constructor
+    SharedMemoryTransport::SharedMemoryTransport(MixEngine& engine)
+        : _engine(engine), _running(false), _framesSent(0), _framesReceived(0), _meterSequence(0)
+    {
+    }
+
+    // Destructor
+    SharedMemoryTransport::~SharedMemoryTransport()
+    {
+        Stop();
+    }
+
+    // Start
+    bool SharedMemoryTransport::Start(const std::string& name, uint32_t slotCount, uint32_t slotSize)
+    {
+        Stop();
+
+        if (!_toUi.Create(name + "_EngineToUi", slotCount, slotSize) ||
+            !_toEngine.Create(name + "_UiToEngine", slotCount, slotSize)) {
+            _toUi.Close();
+            _toEngine.Close();
+            return false;
+        }
+
+        _frameBuffer.assign(_toUi.GetMaxPayload(), 0);
+        _meterSequence = 0;
+        _framesSent.store(0, std::memory_order_relaxed);
+        _framesReceived.store(0, std::memory_order_relaxed);
+
+        _running.store(true, std::memory_order_relaxed);
+        _worker = std::thread(&SharedMemoryTransport::Run, this);
+        return true;
+    }
+
+    // Stop
+    void SharedMemoryTransport::Stop()
+    {
+        _running.store(false, std::memory_order_relaxed);
+        if (_worker.joinable()) _worker.join();
+
+        _toUi.Close();
+        _toEngine.Close();
+    }
+
+    void SharedMemoryTransport::Run()
+    {
+        while (_running.load(std::memory_order_relaxed)) {
+            PublishMeters();
+            ReceiveFrames();
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        }
+    }
+
+    // Send the latest meter frame if the engine has published a new one
+    void SharedMemoryTransport::PublishMeters()
+    {
+        const int capacity = static_cast<int>((_frameBuffer.size() - kMetersPrefix) / sizeof(float));
+
+        uint64_t sequence = 0;
+        float* values = reinterpret_cast<float*>(_frameBuffer.data() + kMetersPrefix);
+        const uint32_t channels = static_cast<uint32_t>(_engine.Meters().CopyTo(values, capacity, &sequence));
+        if (sequence == _meterSequence) return;
+
+        const uint32_t valuesPerChannel = MeterBank::kValuesPerChannel;
+        std::memcpy(_frameBuffer.data(), &channels, sizeof(channels));
+        std::memcpy(_frameBuffer.data() + sizeof(channels), &valuesPerChannel, sizeof(valuesPerChannel));
+
+        const uint32_t length = static_cast<uint32_t>(kMetersPrefix + channels * valuesPerChannel * sizeof(float));
+        if (_toUi.TryWrite(static_cast<uint32_t>(SharedFrameType::Meters), _frameBuffer.data(), length)) {
+            _framesSent.fetch_add(1, std::memory_order_relaxed);
+        }
+        _meterSequence = sequence;
+    }
+
+    // Apply every frame the UI has written since the last poll
+    void SharedMemoryTransport::ReceiveFrames()
+    {
+        uint32_t type = 0;
+        int length;
+        while ((length = _toEngine.TryRead(type, _frameBuffer.data(), static_cast<uint32_t>(_frameBuffer.size()))) != 0) {
+            if (length < 0) continue;
+            _framesReceived.fetch_add(1, std::memory_order_relaxed);
+
+            if (type == static_cast<uint32_t>(SharedFrameType::ParameterChanges)) {
+                const int count = length / static_cast<int>(sizeof(ParameterChange));
+                _engine.Parameters().ApplyBatch(reinterpret_cast<const ParameterChange*>(_frameBuffer.data()), count);
+            }
+            else if (type == static_cast<uint32_t>(SharedFrameType::TimedParameterChanges)) {
+                const int count = length / static_cast<int>(sizeof(TimedParameterChange));
+                const auto changes = reinterpret_cast<const TimedParameterChange*>(_frameBuffer.data());
+                for (int i = 0; i < count; i++) {
+                    if (!MixEngine::IsValidTimedChange(changes[i])) continue;
+
+                    // Nobody reads the acknowledgements here; a full queue is waited out
+                    // rather than dropping the change, the engine drains it every cycle
+                    while (_engine.ScheduleParameterChange(changes[i], false) == 0) {
+                        if (!_running.load(std::memory_order_relaxed)) return;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SharedMemoryRing.h"
+
+namespace emp {
+
+    class MixEngine;
+
+    /// <summary>
+    /// Engine side of the shared-memory transport. Owns two rings named
+    /// "&lt;name&gt;_EngineToUi" and "&lt;name&gt;_UiToEngine" and a worker thread that
+    /// publishes every new meter frame as a binary Meters frame, applies incoming
+    /// ParameterChanges frames as one parameter batch each and schedules the changes of
+    /// TimedParameterChanges frames on their frames, waiting for room in the command
+    /// queue while the engine works through a burst.
+    /// </summary>
+    class SharedMemoryTransport
+    {
+    public:
+        static constexpr uint32_t kDefaultSlotCount = 64;
+        static constexpr uint32_t kDefaultSlotSize = 8192;
+
+        // Worker poll interval
+        static constexpr int kPollIntervalMs = 2;
+
+        explicit SharedMemoryTransport(MixEngine& engine);
+        ~SharedMemoryTransport();
+
+        SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+        SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+        /// <summary>
+        /// Creates the rings and starts the worker. Returns false if a mapping could not
+        /// be created.
+        /// </summary>
+        bool Start(const std::string& name, uint32_t slotCount = kDefaultSlotCount,
+                   uint32_t slotSize = kDefaultSlotSize);
+
+        /// <summary>
+        /// Stops the worker and removes the rings
+        /// </summary>
+        void Stop();
+
+        bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+
+        uint64_t GetFramesSent() const { return _framesSent.load(std::memory_order_relaxed); }
+        uint64_t GetFramesReceived() const { return _framesReceived.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Outgoing frames dropped because the UI did not keep up
+        /// </summary>
+        uint64_t GetFramesDropped() const { return _toUi.GetDroppedCount(); }
+
+    private:
+        void Run();
+        void PublishMeters();
+        void ReceiveFrames();
+
+        MixEngine& _engine;
+        SharedMemoryRing _toUi;
+        SharedMemoryRing _toEngine;
+
+        std::thread _worker;
+        std::atomic<bool> _running;
+        std::atomic<uint64_t> _framesSent;
+        std::atomic<uint64_t> _framesReceived;
+
+        // Worker state, sized in Start()
+        std::vector<unsigned char> _frameBuffer;
+        uint64_t _meterSequence;
+    };
+}
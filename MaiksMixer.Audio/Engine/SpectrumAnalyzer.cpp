@@ -0,0 +1,153 @@
+#include "SpectrumAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace emp {
+
+    namespace {
+        constexpr double kPi = 3.14159265358979323846;
+
+        // Complex FFT length the real input is packed into
+        constexpr size_t kHalfSize = SpectrumAnalyzer::kFftSize / 2;
+    }
+
+    // Constructor
+    SpectrumAnalyzer::SpectrumAnalyzer()
+        : _filled(0), _scale(0.0f)
+    {
+        // Periodic Hann window; a full-scale sine reads 0 dBFS in its bin
+        _window.resize(kFftSize);
+        double windowSum = 0.0;
+        for (size_t n = 0; n < kFftSize; n++) {
+            const double value = 0.5 - 0.5 * std::cos(2.0 * kPi * static_cast<double>(n) / kFftSize);
+            _window[n] = static_cast<float>(value);
+            windowSum += value;
+        }
+        _scale = static_cast<float>(2.0 / windowSum);
+
+        int bits = 0;
+        while ((size_t(1) << bits) < kHalfSize) bits++;
+        _bitReverse.resize(kHalfSize);
+        for (size_t i = 0; i < kHalfSize; i++) {
+            uint32_t reversed = 0;
+            for (int b = 0; b < bits; b++) {
+                if (i & (size_t(1) << b)) reversed |= 1u << (bits - 1 - b);
+            }
+            _bitReverse[i] = reversed;
+        }
+
+        for (size_t size = 2; size <= kHalfSize; size *= 2) {
+            for (size_t j = 0; j < size / 2; j++) {
+                const double angle = -2.0 * kPi * static_cast<double>(j) / static_cast<double>(size);
+                _stageCos.push_back(static_cast<float>(std::cos(angle)));
+                _stageSin.push_back(static_cast<float>(std::sin(angle)));
+            }
+        }
+
+        _unpackCos.resize(kHalfSize + 1);
+        _unpackSin.resize(kHalfSize + 1);
+        for (size_t k = 0; k <= kHalfSize; k++) {
+            const double angle = -2.0 * kPi * static_cast<double>(k) / kFftSize;
+            _unpackCos[k] = static_cast<float>(std::cos(angle));
+            _unpackSin[k] = static_cast<float>(std::sin(angle));
+        }
+
+        _real.resize(kHalfSize);
+        _imag.resize(kHalfSize);
+        _history.resize(kFftSize);
+        _spectrum.resize(kBins);
+        Reset();
+    }
+
+    // Reset
+    void SpectrumAnalyzer::Reset()
+    {
+        // Start from silence so the first spectrum appears after one hop
+        std::fill(_history.begin(), _history.end(), 0.0f);
+        _filled = kFftSize - kHopSize;
+        std::fill(_spectrum.begin(), _spectrum.end(), kFloorDb);
+    }
+
+    // Process
+    bool SpectrumAnalyzer::Process(const float* samples, size_t count)
+    {
+        bool transformed = false;
+        while (count > 0) {
+            const size_t take = std::min(count, kFftSize - _filled);
+            std::copy(samples, samples + take, _history.begin() + _filled);
+            _filled += take;
+            samples += take;
+            count -= take;
+
+            if (_filled == kFftSize) {
+                Transform();
+                std::copy(_history.begin() + kHopSize, _history.end(), _history.begin());
+                _filled = kFftSize - kHopSize;
+                transformed = true;
+            }
+        }
+
+        return transformed;
+    }
+
+    // Transform the full history into the spectrum
+    void SpectrumAnalyzer::Transform()
+    {
+        // Windowed input packed as even samples real, odd samples imaginary, in
+        // bit-reversed order
+        for (size_t i = 0; i < kHalfSize; i++) {
+            const uint32_t j = _bitReverse[i];
+            _real[j] = _history[2 * i] * _window[2 * i];
+            _imag[j] = _history[2 * i + 1] * _window[2 * i + 1];
+        }
+
+        // Radix-2 butterflies, one stage per doubling of the sub-transform size
+        const float* stageCos = _stageCos.data();
+        const float* stageSin = _stageSin.data();
+        for (size_t size = 2; size <= kHalfSize; size *= 2) {
+            const size_t half = size / 2;
+            for (size_t start = 0; start < kHalfSize; start += size) {
+                float* aReal = _real.data() + start;
+                float* aImag = _imag.data() + start;
+                float* bReal = aReal + half;
+                float* bImag = aImag + half;
+
+                for (size_t j = 0; j < half; j++) {
+                    const float tReal = bReal[j] * stageCos[j] - bImag[j] * stageSin[j];
+                    const float tImag = bReal[j] * stageSin[j] + bImag[j] * stageCos[j];
+                    bReal[j] = aReal[j] - tReal;
+                    bImag[j] = aImag[j] - tImag;
+                    aReal[j] += tReal;
+                    aImag[j] += tImag;
+                }
+            }
+            stageCos += half;
+            stageSin += half;
+        }
+
+        // Unpack the spectrum of the real input: X[k] = E[k] + W^k O[k], where E and O are
+        // the transforms of the even and odd samples recovered from Z[k] and Z[M - k]
+        for (size_t k = 0; k <= kHalfSize; k++) {
+            const size_t index = k % kHalfSize;
+            const size_t mirror = (kHalfSize - k) % kHalfSize;
+            const float a = _real[index];
+            const float b = _imag[index];
+            const float c = _real[mirror];
+            const float d = _imag[mirror];
+
+            const float evenReal = 0.5f * (a + c);
+            const float evenImag = 0.5f * (b - d);
+            const float oddReal = 0.5f * (b + d);
+            const float oddImag = -0.5f * (a - c);
+
+            const float real = evenReal + _unpackCos[k] * oddReal - _unpackSin[k] * oddImag;
+            const float imag = evenImag + _unpackCos[k] * oddImag + _unpackSin[k] * oddReal;
+
+            // DC and Nyquist have no mirrored half
+            const float scale = (k == 0 || k == kHalfSize) ? 0.5f * _scale : _scale;
+            const float magnitude = scale * std::sqrt(real * real + imag * imag);
+            _spectrum[k] = magnitude > 0.0f ? std::max(20.0f * std::log10(magnitude), kFloorDb) : kFloorDb;
+        }
+    }
+}
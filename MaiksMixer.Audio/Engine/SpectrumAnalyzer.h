@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace emp {
+
+    /// <summary>
+    /// Magnitude spectrum of one signal for display: Hann-windowed FFTs of kFftSize
+    /// samples every kHopSize samples (50% overlap), in dBFS per bin. The real input is
+    /// packed into a half-length complex FFT whose stages read their twiddles from
+    /// contiguous tables, so every butterfly loop runs over unit-stride arrays the
+    /// compiler vectorizes. Not real-time safe; runs on analysis workers.
+    /// </summary>
+    class SpectrumAnalyzer
+    {
+    public:
+        static constexpr size_t kFftSize = 2048;
+        static constexpr size_t kHopSize = kFftSize / 2;
+        static constexpr size_t kBins = kFftSize / 2 + 1;
+
+        // Level reported for empty bins
+        static constexpr float kFloorDb = -120.0f;
+
+        SpectrumAnalyzer();
+
+        /// <summary>
+        /// Clears the input history and the spectrum
+        /// </summary>
+        void Reset();
+
+        /// <summary>
+        /// Feeds samples; returns true if at least one new spectrum was computed
+        /// </summary>
+        bool Process(const float* samples, size_t count);
+
+        /// <summary>
+        /// Latest spectrum, kBins values in dBFS; bin k is at k * sampleRate / kFftSize Hz
+        /// </summary>
+        const float* GetSpectrum() const { return _spectrum.data(); }
+
+    private:
+        void Transform();
+
+        // Input history, oldest first; the next transform runs once it is full
+        std::vector<float> _history;
+        size_t _filled;
+
+        std::vector<float> _window;
+        float _scale;
+
+        // Half-length complex FFT: split real/imaginary work arrays, bit-reversal order,
+        // twiddles of every stage stored back to back, and the twiddles that unpack the
+        // real spectrum
+        std::vector<float> _real;
+        std::vector<float> _imag;
+        std::vector<uint32_t> _bitReverse;
+        std::vector<float> _stageCos;
+        std::vector<float> _stageSin;
+        std::vector<float> _unpackCos;
+        std::vector<float> _unpackSin;
+
+        std::vector<float> _spectrum;
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace emp {
+
+    /// <summary>
+    /// Bounded, wait-free single-producer/single-consumer ring of fixed-size records.
+    /// Storage is inline, so neither side allocates; a full ring rejects the push instead
+    /// of blocking. Capacity must be a power of two.
+    /// </summary>
+    template <typename T, size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        SpscRing()
+            : _head(0), _tail(0)
+        {
+        }
+
+        /// <summary>
+        /// Appends a record (producer side). Returns false if the ring is full.
+        /// </summary>
+        bool TryPush(const T& value)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) == Capacity) return false;
+
+            _slots[tail & kMask] = value;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// Removes the oldest record (consumer side). Returns false if the ring is empty.
+        /// </summary>
+        bool TryPop(T& value)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire)) return false;
+
+            value = _slots[head & kMask];
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// Returns the oldest record without removing it, or nullptr (consumer side)
+        /// </summary>
+        const T* Peek() const
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire)) return nullptr;
+
+            return &_slots[head & kMask];
+        }
+
+        /// <summary>
+        /// Drops the record returned by Peek() (consumer side)
+        /// </summary>
+        void Pop()
+        {
+            _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /// <summary>
+        /// Free slots as seen by the producer
+        /// </summary>
+        size_t GetFreeCount() const
+        {
+            return Capacity - (_tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire));
+        }
+
+        /// <summary>
+        /// Records available to the consumer
+        /// </summary>
+        size_t GetPendingCount() const
+        {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_relaxed);
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        std::array<T, Capacity> _slots;
+
+        // Consumer and producer indices on separate cache lines
+        alignas(64) std::atomic<size_t> _head;
+        alignas(64) std::atomic<size_t> _tail;
+    };
+}
@@ -0,0 +1,207 @@
+// Checks the analysis path against reference signals: a sine lands in the FFT bin of its
+// frequency, EBU Tech 3341 test signals read their nominal loudness within the
+// specification's +/-0.1 LU, and the same holds end to end through an AnalysisTaps tap
+// fed from capture blocks and analyzed on a worker thread.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../AnalysisTaps.h"
+#include "../LoudnessMeter.h"
+#include "../SpectrumAnalyzer.h"
+
+namespace {
+
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr uint32_t kSampleRate = 48000;
+
+    // EBU Tech 3341 tolerance for momentary, short-term and integrated loudness
+    constexpr float kLoudnessToleranceLu = 0.1f;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    void CheckNear(float value, float expected, float tolerance, const char* what)
+    {
+        if (std::abs(value - expected) <= tolerance) {
+            std::printf("ok   %s (%.3f)\n", what, value);
+            return;
+        }
+        std::printf("FAIL %s (got %.3f, expected %.3f +/- %.3f)\n", what, value, expected, tolerance);
+        g_failures++;
+    }
+
+    // Appends seconds of a sine at a peak amplitude, continuing its phase
+    void AppendSine(std::vector<float>& signal, double frequency, double amplitude, double seconds)
+    {
+        const size_t start = signal.size();
+        const size_t frames = static_cast<size_t>(seconds * kSampleRate);
+        for (size_t i = start; i < start + frames; i++) {
+            signal.push_back(static_cast<float>(amplitude * std::sin(2.0 * kPi * frequency * i / kSampleRate)));
+        }
+    }
+
+    // Tech 3341 signals are stereo with the same sine in both channels at the given
+    // level; a mono meter reads the same loudness for one sine carrying both channels'
+    // power, 3 dB higher
+    double ReferenceAmplitude(double dbfsPerChannel)
+    {
+        return std::sqrt(2.0) * std::pow(10.0, dbfsPerChannel / 20.0);
+    }
+
+    int PeakBin(const float* spectrum)
+    {
+        return static_cast<int>(std::max_element(spectrum, spectrum + emp::SpectrumAnalyzer::kBins) - spectrum);
+    }
+
+    // 997 Hz (bin 42.54 at 48 kHz) peaks in the nearest bin; a bin-centred sine reads its
+    // level exactly and the Hann window confines it to the neighbouring bins
+    void TestSpectrumBins()
+    {
+        const double amplitude = std::pow(10.0, -6.0 / 20.0);
+        const double binHz = static_cast<double>(kSampleRate) / emp::SpectrumAnalyzer::kFftSize;
+
+        std::vector<float> signal;
+        AppendSine(signal, 997.0, amplitude, 0.5);
+        emp::SpectrumAnalyzer analyzer;
+        Check(analyzer.Process(signal.data(), signal.size()), "spectrum: transforms once a window is full");
+
+        const float* spectrum = analyzer.GetSpectrum();
+        const int peak = PeakBin(spectrum);
+        Check(peak == static_cast<int>(std::lround(997.0 / binHz)), "spectrum: 997 Hz peaks in bin 43");
+        CheckNear(spectrum[peak], -6.0f, 1.5f, "spectrum: 997 Hz level within the Hann scalloping loss");
+        Check(spectrum[42] > spectrum[41] && spectrum[43] > spectrum[44], "spectrum: 997 Hz falls between bins 42 and 43");
+
+        signal.clear();
+        AppendSine(signal, 44 * binHz, amplitude, 0.5);
+        analyzer.Reset();
+        analyzer.Process(signal.data(), signal.size());
+        spectrum = analyzer.GetSpectrum();
+
+        Check(PeakBin(spectrum) == 44, "spectrum: bin-centred sine peaks in its bin");
+        CheckNear(spectrum[44], -6.0f, 0.01f, "spectrum: bin-centred sine reads its level");
+        CheckNear(spectrum[43], -12.0f, 0.05f, "spectrum: Hann main lobe, lower neighbour at -6 dB");
+        CheckNear(spectrum[45], -12.0f, 0.05f, "spectrum: Hann main lobe, upper neighbour at -6 dB");
+
+        float leakage = emp::SpectrumAnalyzer::kFloorDb;
+        for (size_t k = 0; k < emp::SpectrumAnalyzer::kBins; k++) {
+            if (k + 2 <= 44 || k >= 46) leakage = std::max(leakage, spectrum[k]);
+        }
+        Check(leakage < -96.0f, "spectrum: nothing outside the main lobe");
+
+        std::vector<float> silence(emp::SpectrumAnalyzer::kFftSize, 0.0f);
+        analyzer.Reset();
+        analyzer.Process(silence.data(), silence.size());
+        Check(analyzer.GetSpectrum()[PeakBin(analyzer.GetSpectrum())] == emp::SpectrumAnalyzer::kFloorDb,
+              "spectrum: silence reads the floor");
+    }
+
+    // Tech 3341 cases 1 and 2: a stereo 1 kHz sine at -23 and -33 dBFS reads -23 and
+    // -33 LUFS in every window
+    void TestLoudnessReference()
+    {
+        for (double level : { -23.0, -33.0 }) {
+            std::vector<float> signal;
+            AppendSine(signal, 1000.0, ReferenceAmplitude(level), 20.0);
+
+            emp::LoudnessMeter meter;
+            meter.Reset(kSampleRate);
+            meter.Process(signal.data(), signal.size());
+
+            const bool reference = level == -23.0;
+            const float expected = static_cast<float>(level);
+            CheckNear(meter.GetMomentary(), expected, kLoudnessToleranceLu,
+                      reference ? "loudness: -23 dBFS reference, momentary" : "loudness: -33 dBFS, momentary");
+            CheckNear(meter.GetShortTerm(), expected, kLoudnessToleranceLu,
+                      reference ? "loudness: -23 dBFS reference, short-term" : "loudness: -33 dBFS, short-term");
+            CheckNear(meter.GetIntegrated(), expected, kLoudnessToleranceLu,
+                      reference ? "loudness: -23 dBFS reference, integrated" : "loudness: -33 dBFS, integrated");
+        }
+
+        // The sine's peak, not interpolated overs: 20 log10(sqrt(2) * 10^(-23/20))
+        std::vector<float> signal;
+        AppendSine(signal, 1000.0, ReferenceAmplitude(-23.0), 1.0);
+        emp::LoudnessMeter meter;
+        meter.Reset(kSampleRate);
+        meter.Process(signal.data(), signal.size());
+        CheckNear(meter.GetTruePeakDb(), -19.99f, 0.05f, "true peak: sine peak");
+    }
+
+    // Tech 3341 case 3: 10 s at -36, 60 s at -23 and 10 s at -36 dBFS integrate to
+    // -23 LUFS, the quiet parts removed by the relative gate
+    void TestLoudnessGating()
+    {
+        std::vector<float> signal;
+        AppendSine(signal, 1000.0, ReferenceAmplitude(-36.0), 10.0);
+        AppendSine(signal, 1000.0, ReferenceAmplitude(-23.0), 60.0);
+        AppendSine(signal, 1000.0, ReferenceAmplitude(-36.0), 10.0);
+
+        emp::LoudnessMeter meter;
+        meter.Reset(kSampleRate);
+        meter.Process(signal.data(), signal.size());
+        CheckNear(meter.GetIntegrated(), -23.0f, kLoudnessToleranceLu, "loudness: relative gate (Tech 3341 case 3)");
+        CheckNear(meter.GetMomentary(), -36.0f, kLoudnessToleranceLu, "loudness: momentary follows the quiet tail");
+
+        std::vector<float> silence(kSampleRate, 0.0f);
+        meter.Reset(kSampleRate);
+        meter.Process(silence.data(), silence.size());
+        Check(meter.GetIntegrated() == emp::LoudnessMeter::kFloorDb, "loudness: silence stays below the absolute gate");
+    }
+
+    // The same reference through a channel tap: capture blocks in, worker results out
+    void TestAnalysisTap()
+    {
+        constexpr uint32_t kBlockFrames = 4096;
+        constexpr int kBlocks = 36;
+
+        std::vector<float> signal;
+        AppendSine(signal, 997.0, ReferenceAmplitude(-23.0), static_cast<double>(kBlockFrames) * kBlocks / kSampleRate);
+
+        emp::AnalysisTaps taps;
+        taps.Reserve(1, 0);
+        taps.SetSampleRate(kSampleRate);
+        Check(taps.SetEnabled(emp::TapSource::Channel, 0, true), "tap: enabled");
+        taps.Start(1);
+
+        // Roughly real time at 20 ms per block, well inside the ring
+        for (int block = 0; block < kBlocks; block++) {
+            const float* channels[] = { signal.data() + static_cast<size_t>(block) * kBlockFrames };
+            taps.Capture(channels, 1, nullptr, 0, kBlockFrames);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 * emp::AnalysisTaps::kPollIntervalMs));
+        taps.Stop();
+
+        emp::AnalysisFrame frame;
+        Check(taps.GetFrame(emp::TapSource::Channel, 0, frame) && frame.sequence > 0, "tap: results published");
+        Check(frame.droppedBlocks == 0 && frame.sampleRate == kSampleRate, "tap: every block analyzed at the tap's rate");
+        Check(frame.spectrum.size() == emp::SpectrumAnalyzer::kBins && PeakBin(frame.spectrum.data()) == 43,
+              "tap: 997 Hz peaks in bin 43");
+        CheckNear(frame.momentaryLufs, -23.0f, kLoudnessToleranceLu, "tap: reference reads -23 LUFS momentary");
+        CheckNear(frame.integratedLufs, -23.0f, kLoudnessToleranceLu, "tap: reference reads -23 LUFS integrated");
+    }
+}
+
+int main()
+{
+    TestSpectrumBins();
+    TestLoudnessReference();
+    TestLoudnessGating();
+    TestAnalysisTap();
+
+    if (g_failures > 0) std::printf("%d analysis check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+// Exercises SpscRing and EngineCommandQueue with their producer and consumer on separate
+// threads: every record arrives once, untorn and in order across many wraparounds, and a
+// full ring rejects pushes instead of overwriting. Command acknowledgements are the
+// exception: they overwrite the oldest so execution never waits for a reader. Build with EMP_SANITIZE_THREAD=ON to
+// run the same checks under ThreadSanitizer.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../EngineCommandQueue.h"
+#include "../SpscRing.h"
+
+namespace {
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    // Record whose halves must always agree; a torn read breaks the pairing
+    struct Record
+    {
+        uint64_t sequence;
+        uint64_t check;
+    };
+
+    uint64_t CheckOf(uint64_t sequence)
+    {
+        return sequence * 0x9E3779B97F4A7C15ull;
+    }
+
+    // Fill, reject, drain and wrap on one thread
+    void TestRingSingleThread()
+    {
+        emp::SpscRing<Record, 8> ring;
+        Record record{};
+
+        Check(!ring.TryPop(record) && ring.Peek() == nullptr, "ring: empty pop fails");
+
+        bool pushed = true;
+        for (uint64_t i = 0; i < 8; i++) pushed = pushed && ring.TryPush({ i, CheckOf(i) });
+        Check(pushed && ring.GetFreeCount() == 0 && ring.GetPendingCount() == 8, "ring: fills to capacity");
+        Check(!ring.TryPush({ 99, CheckOf(99) }), "ring: full ring rejects the push");
+
+        Check(ring.Peek() != nullptr && ring.Peek()->sequence == 0, "ring: peek returns the oldest record");
+        ring.Pop();
+        Check(ring.TryPush({ 8, CheckOf(8) }) && !ring.TryPush({ 9, CheckOf(9) }), "ring: one pop frees one slot");
+
+        // Keep the ring half full while the indices run round it many times
+        uint64_t next = 9;
+        uint64_t expected = 1;
+        bool ordered = true;
+        while (ring.GetPendingCount() > 4) ordered = ordered && ring.TryPop(record) && record.sequence == expected++;
+        for (int round = 0; round < 1000; round++) {
+            ordered = ordered && ring.TryPush({ next, CheckOf(next) });
+            next++;
+            ordered = ordered && ring.TryPop(record) && record.sequence == expected++ && record.check == CheckOf(record.sequence);
+        }
+        Check(ordered, "ring: order kept across wraparound");
+    }
+
+    // Producer and consumer on their own threads through a small ring, so both the full
+    // and the empty case are hit constantly
+    void TestRingTwoThreads()
+    {
+        constexpr uint64_t kRecords = 1000000;
+        emp::SpscRing<Record, 64> ring;
+
+        std::atomic<uint64_t> rejected{ 0 };
+        std::thread producer([&] {
+            uint64_t rejections = 0;
+            for (uint64_t i = 0; i < kRecords; i++) {
+                while (!ring.TryPush({ i, CheckOf(i) })) {
+                    rejections++;
+                    std::this_thread::yield();
+                }
+            }
+            rejected.store(rejections, std::memory_order_relaxed);
+        });
+
+        uint64_t expected = 0;
+        bool intact = true;
+        while (expected < kRecords) {
+            Record record;
+            if (!ring.TryPop(record)) {
+                std::this_thread::yield();
+                continue;
+            }
+            intact = intact && record.sequence == expected && record.check == CheckOf(record.sequence);
+            expected++;
+
+            // Stall now and then so the producer runs into a full ring
+            if (expected % 4096 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        producer.join();
+
+        Check(intact, "ring threads: every record once, in order and untorn");
+        Check(ring.GetPendingCount() == 0, "ring threads: nothing left behind");
+        Check(rejected.load(std::memory_order_relaxed) > 0, "ring threads: producer saw the ring full");
+    }
+
+    // With no process callback draining, the queue fills and Post() reports it; with no
+    // completion reader, Drain() keeps executing and the oldest acknowledgements are lost
+    void TestCommandQueueFull()
+    {
+        emp::EngineCommandQueue queue;
+        emp::EngineCommand command{};
+        command.type = emp::EngineCommandType::Barrier;
+
+        uint32_t lastId = 0;
+        bool accepted = true;
+        for (size_t i = 0; i < emp::EngineCommandQueue::kCapacity; i++) {
+            const uint32_t id = queue.Post(command);
+            accepted = accepted && id == lastId + 1;
+            lastId = id;
+        }
+        Check(accepted, "queue: accepts its capacity with consecutive ids");
+        Check(queue.Post(command) == 0, "queue: full queue rejects the post");
+
+        bool prepared = false;
+        Check(queue.Post(command, [&] { prepared = true; return true; }) == 0 && !prepared,
+              "queue: prepare not run while full");
+
+        auto execute = [](const emp::EngineCommand&) { return emp::EngineCommandStatus::Applied; };
+        int executed = 0;
+        for (uint64_t cycle = 0; cycle < 100; cycle++) {
+            executed += queue.Drain(cycle, emp::EngineCommandQueue::kMaxCommandsPerCycle, execute);
+        }
+        Check(executed == static_cast<int>(emp::EngineCommandQueue::kCapacity), "queue: drains in bounded cycles");
+
+        Check(queue.GetDroppedCompletions() == 0, "queue: a full completion ring has lost nothing yet");
+
+        // Nobody reads acknowledgements: another few queues' worth must still run
+        uint64_t cycle = 100;
+        bool keptRunning = true;
+        for (int round = 0; round < 3; round++) {
+            for (size_t i = 0; i < emp::EngineCommandQueue::kCapacity; i++) {
+                lastId = queue.Post(command);
+                keptRunning = keptRunning && lastId != 0;
+            }
+            executed = 0;
+            while (queue.GetPendingCount() > 0) {
+                executed += queue.Drain(cycle++, emp::EngineCommandQueue::kMaxCommandsPerCycle, execute);
+            }
+            keptRunning = keptRunning && executed == static_cast<int>(emp::EngineCommandQueue::kCapacity);
+        }
+        Check(keptRunning, "queue: commands keep executing while nobody reads completions");
+        Check(queue.GetDroppedCompletions() == 3 * emp::EngineCommandQueue::kCapacity,
+              "queue: overwritten acknowledgements counted");
+
+        std::vector<emp::EngineCompletion> completions(2 * emp::EngineCommandQueue::kCapacity);
+        const int read = queue.ReadCompletions(completions.data(), static_cast<int>(completions.size()));
+        bool newest = read == static_cast<int>(emp::EngineCommandQueue::kCapacity);
+        for (int i = 0; newest && i < read; i++) {
+            newest = completions[i].id == lastId - static_cast<uint32_t>(read - 1 - i);
+        }
+        Check(newest, "queue: the newest acknowledgements kept, oldest first");
+        Check(queue.ReadCompletions(completions.data(), 1) == 0, "queue: read acknowledgements are consumed");
+
+        bool cancelled = queue.Post(command, [] { return false; }) == 0;
+        Check(cancelled && queue.GetPendingCount() == 0, "queue: cancelled post leaves nothing queued");
+    }
+
+    // Two control threads post, a process thread drains per cycle and a reader collects
+    // the acknowledgements, all concurrently
+    void TestCommandQueueThreads()
+    {
+        constexpr int kProducers = 2;
+        constexpr int kCommandsPerProducer = 50000;
+        constexpr int kTotal = kProducers * kCommandsPerProducer;
+
+        emp::EngineCommandQueue queue;
+
+        // Written by the process thread only; read after it has been joined
+        std::vector<int> lastValue(kProducers, -1);
+        std::vector<uint32_t> executedIds;
+        std::vector<emp::EngineCommandStatus> executedStatus;
+        executedIds.reserve(kTotal);
+        executedStatus.reserve(kTotal);
+        bool fifo = true;
+
+        std::atomic<bool> stop{ false };
+        std::atomic<bool> processed{ false };
+        std::thread process([&] {
+            uint64_t cycle = 0;
+            while (!stop.load(std::memory_order_acquire) || queue.GetPendingCount() > 0) {
+                queue.Drain(cycle++, emp::EngineCommandQueue::kMaxCommandsPerCycle, [&](const emp::EngineCommand& command) {
+                    const int producer = command.parameter.channel;
+                    const int value = static_cast<int>(command.parameter.value);
+                    fifo = fifo && value == lastValue[producer] + 1;
+                    lastValue[producer] = value;
+                    executedIds.push_back(command.id);
+                    executedStatus.push_back(value % 7 == 0 ? emp::EngineCommandStatus::Rejected : emp::EngineCommandStatus::Applied);
+                    return executedStatus.back();
+                });
+                std::this_thread::yield();
+            }
+            processed.store(true, std::memory_order_release);
+        });
+
+        std::vector<emp::EngineCompletion> acknowledged;
+        acknowledged.reserve(kTotal);
+        std::thread reader([&] {
+            emp::EngineCompletion batch[128];
+            for (;;) {
+                const bool finished = processed.load(std::memory_order_acquire);
+                const int count = queue.ReadCompletions(batch, 128);
+                acknowledged.insert(acknowledged.end(), batch, batch + count);
+                if (count == 0) {
+                    if (finished) break;
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::atomic<int> fullRejections{ 0 };
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; p++) {
+            producers.emplace_back([&, p] {
+                emp::EngineCommand command{};
+                command.type = emp::EngineCommandType::SetParameter;
+                command.parameter = { p, emp::ParameterId::Volume, 0.0f };
+                for (int i = 0; i < kCommandsPerProducer; i++) {
+                    command.parameter.value = static_cast<float>(i);
+                    while (queue.Post(command) == 0) {
+                        fullRejections.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (std::thread& producer : producers) producer.join();
+        stop.store(true, std::memory_order_release);
+        process.join();
+        reader.join();
+
+        Check(fifo, "queue threads: each producer's commands run in order");
+        Check(lastValue[0] == kCommandsPerProducer - 1 && lastValue[1] == kCommandsPerProducer - 1,
+              "queue threads: every command executed");
+
+        bool idsAscend = executedIds.size() == static_cast<size_t>(kTotal);
+        for (size_t i = 1; idsAscend && i < executedIds.size(); i++) idsAscend = executedIds[i] == executedIds[i - 1] + 1;
+        Check(idsAscend, "queue threads: ids assigned in queue order");
+
+        // Acknowledgements the reader fell too far behind for are lost, never reordered or torn
+        const uint64_t dropped = queue.GetDroppedCompletions();
+        bool matched = idsAscend && acknowledged.size() <= executedIds.size() && acknowledged.size() + dropped >= executedIds.size();
+        for (size_t i = 0; matched && i < acknowledged.size(); i++) {
+            const uint32_t index = acknowledged[i].id - executedIds[0];
+            matched = (i == 0 || (acknowledged[i].id > acknowledged[i - 1].id && acknowledged[i].cycle >= acknowledged[i - 1].cycle)) &&
+                      index < executedStatus.size() && acknowledged[i].status == executedStatus[index];
+        }
+        Check(matched, "queue threads: acknowledgements in execution order with their statuses");
+        std::printf("     (%d posts found the queue full, %llu acknowledgements lost)\n", fullRejections.load(),
+                    static_cast<unsigned long long>(dropped));
+    }
+}
+
+int main()
+{
+    TestRingSingleThread();
+    TestRingTwoThreads();
+    TestCommandQueueFull();
+    TestCommandQueueThreads();
+
+    if (g_failures > 0) std::printf("%d command queue check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,303 @@
+// Records known signals through DiskRecorder as WAV and Wave64, one file per track and
+// polyphonic, then parses the files back: the container sizes must describe the file,
+// the format and fact chunks the recording, and the data chunk must start at the
+// aligned offset and hold exactly the captured samples.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../DiskRecorder.h"
+
+namespace {
+
+    constexpr uint32_t kSampleRate = 48000;
+
+    // An odd frame count spanning a few writer chunks, so the last chunk is partial and
+    // mono Wave64 data needs its 8-byte padding
+    constexpr uint32_t kBlockFrames = 251;
+    constexpr int kBlocks = 161;
+    constexpr uint32_t kFrames = kBlockFrames * kBlocks;
+
+    // Wave64 chunk ids: the four-character code followed by the Wave64 GUID suffix
+    constexpr uint8_t kW64RiffSuffix[12] = { 0x2E, 0x91, 0xCF, 0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00 };
+    constexpr uint8_t kW64ChunkSuffix[12] = { 0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A };
+
+    // KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+    constexpr uint8_t kFloatSubFormat[16] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    uint16_t Read16(const std::vector<uint8_t>& bytes, size_t offset)
+    {
+        return static_cast<uint16_t>(bytes[offset] | bytes[offset + 1] << 8);
+    }
+
+    uint32_t Read32(const std::vector<uint8_t>& bytes, size_t offset)
+    {
+        return static_cast<uint32_t>(Read16(bytes, offset)) | static_cast<uint32_t>(Read16(bytes, offset + 2)) << 16;
+    }
+
+    uint64_t Read64(const std::vector<uint8_t>& bytes, size_t offset)
+    {
+        return static_cast<uint64_t>(Read32(bytes, offset)) | static_cast<uint64_t>(Read32(bytes, offset + 4)) << 32;
+    }
+
+    bool HasTag(const std::vector<uint8_t>& bytes, size_t offset, const char* tag)
+    {
+        return offset + 4 <= bytes.size() && std::memcmp(bytes.data() + offset, tag, 4) == 0;
+    }
+
+    bool HasGuid(const std::vector<uint8_t>& bytes, size_t offset, const char* tag, const uint8_t* suffix)
+    {
+        return offset + 16 <= bytes.size() && HasTag(bytes, offset, tag) && std::memcmp(bytes.data() + offset + 4, suffix, 12) == 0;
+    }
+
+    std::vector<uint8_t> ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    // What a parsed file says about itself
+    struct ParsedFile
+    {
+        bool valid = false;             // Container and chunk sizes add up to the file size
+        uint16_t formatTag = 0;
+        uint16_t channels = 0;
+        uint32_t sampleRate = 0;
+        uint32_t byteRate = 0;
+        uint16_t blockAlign = 0;
+        uint16_t bitsPerSample = 0;
+        bool floatSubFormat = false;    // WAVE_FORMAT_EXTENSIBLE carrying IEEE float
+        int64_t factFrames = -1;        // -1 without a fact chunk
+        size_t dataOffset = 0;
+        uint64_t dataBytes = 0;
+    };
+
+    void ParseFormat(const std::vector<uint8_t>& bytes, size_t offset, uint64_t size, ParsedFile& parsed)
+    {
+        parsed.formatTag = Read16(bytes, offset);
+        parsed.channels = Read16(bytes, offset + 2);
+        parsed.sampleRate = Read32(bytes, offset + 4);
+        parsed.byteRate = Read32(bytes, offset + 8);
+        parsed.blockAlign = Read16(bytes, offset + 12);
+        parsed.bitsPerSample = Read16(bytes, offset + 14);
+        parsed.floatSubFormat = size >= 40 && std::memcmp(bytes.data() + offset + 24, kFloatSubFormat, 16) == 0;
+    }
+
+    // RIFF: 4-byte tags and 32-bit sizes that exclude the 8-byte chunk header, chunks
+    // padded to even sizes
+    ParsedFile ParseWav(const std::vector<uint8_t>& bytes)
+    {
+        ParsedFile parsed;
+        if (bytes.size() < 12 || !HasTag(bytes, 0, "RIFF") || !HasTag(bytes, 8, "WAVE")) return parsed;
+        if (Read32(bytes, 4) != bytes.size() - 8) return parsed;
+
+        size_t offset = 12;
+        while (offset + 8 <= bytes.size()) {
+            const uint64_t size = Read32(bytes, offset + 4);
+            const size_t body = offset + 8;
+            if (body + size > bytes.size()) return parsed;
+
+            if (HasTag(bytes, offset, "fmt ")) ParseFormat(bytes, body, size, parsed);
+            else if (HasTag(bytes, offset, "fact")) parsed.factFrames = Read32(bytes, body);
+            else if (HasTag(bytes, offset, "data")) {
+                parsed.dataOffset = body;
+                parsed.dataBytes = size;
+            }
+            offset = body + size + size % 2;
+        }
+
+        parsed.valid = offset == bytes.size() && parsed.dataOffset != 0;
+        return parsed;
+    }
+
+    // Wave64: 16-byte GUIDs and 64-bit sizes that include the 24-byte chunk header,
+    // chunks padded to 8-byte boundaries
+    ParsedFile ParseW64(const std::vector<uint8_t>& bytes)
+    {
+        ParsedFile parsed;
+        if (bytes.size() < 40 || !HasGuid(bytes, 0, "riff", kW64RiffSuffix) || !HasGuid(bytes, 24, "wave", kW64ChunkSuffix)) {
+            return parsed;
+        }
+        if (Read64(bytes, 16) != bytes.size()) return parsed;
+
+        size_t offset = 40;
+        while (offset + 24 <= bytes.size()) {
+            const uint64_t size = Read64(bytes, offset + 16);
+            const size_t body = offset + 24;
+            if (size < 24 || offset + size > bytes.size()) return parsed;
+
+            if (HasGuid(bytes, offset, "fmt ", kW64ChunkSuffix)) ParseFormat(bytes, body, size - 24, parsed);
+            else if (HasGuid(bytes, offset, "data", kW64ChunkSuffix)) {
+                parsed.dataOffset = body;
+                parsed.dataBytes = size - 24;
+            }
+            else if (!HasGuid(bytes, offset, "junk", kW64ChunkSuffix)) {
+                return parsed;
+            }
+            offset += (size + 7) / 8 * 8;
+        }
+
+        parsed.valid = offset == bytes.size() && parsed.dataOffset != 0;
+        return parsed;
+    }
+
+    // Distinct, exactly representable samples per signal and frame
+    float Sample(int signal, uint32_t frame)
+    {
+        return static_cast<float>(signal + 1) * 0.125f - static_cast<float>(frame % 4096) / 8192.0f;
+    }
+
+    // Feeds kFrames of two channels and two outputs; output 1 is unbound in every other
+    // block, which the recorder fills with silence
+    float Expected(emp::TapSource source, int index, uint32_t frame)
+    {
+        const int signal = source == emp::TapSource::Channel ? index : 2 + index;
+        if (source == emp::TapSource::Output && index == 1 && (frame / kBlockFrames) % 2 == 1) return 0.0f;
+        return Sample(signal, frame);
+    }
+
+    emp::RecorderStatus Record(emp::DiskRecorder& recorder, const emp::RecordOptions& options)
+    {
+        std::vector<std::vector<float>> signals(4, std::vector<float>(kBlockFrames));
+        Check(recorder.Start(options), "recorder: started");
+        Check(recorder.IsRecording(), "recorder: recording");
+
+        for (int block = 0; block < kBlocks; block++) {
+            for (int signal = 0; signal < 4; signal++) {
+                for (uint32_t i = 0; i < kBlockFrames; i++) signals[signal][i] = Sample(signal, block * kBlockFrames + i);
+            }
+            const float* channels[] = { signals[0].data(), signals[1].data() };
+            const float* outputs[] = { signals[2].data(), signals[3].data() };
+            recorder.Capture(channels, 2, outputs, block % 2 == 1 ? 1 : 2, kBlockFrames);
+        }
+
+        Check(recorder.Stop() && !recorder.IsRecording(), "recorder: stopped");
+        emp::RecorderStatus status;
+        recorder.GetStatus(status);
+        return status;
+    }
+
+    bool PayloadMatches(const std::vector<uint8_t>& bytes, const ParsedFile& parsed, const std::vector<emp::RecordTrack>& tracks)
+    {
+        const size_t channels = tracks.size();
+        if (parsed.dataBytes != static_cast<uint64_t>(kFrames) * channels * sizeof(float)) return false;
+
+        for (uint32_t frame = 0; frame < kFrames; frame++) {
+            for (size_t c = 0; c < channels; c++) {
+                float value;
+                std::memcpy(&value, bytes.data() + parsed.dataOffset + (frame * channels + c) * sizeof(float), sizeof(float));
+                if (value != Expected(tracks[c].source, tracks[c].index, frame)) return false;
+            }
+        }
+        return true;
+    }
+
+    bool FormatMatches(const ParsedFile& parsed, uint16_t channels)
+    {
+        const bool tagMatches = channels > 2 ? parsed.formatTag == 0xFFFE && parsed.floatSubFormat : parsed.formatTag == 3;
+        return tagMatches && parsed.channels == channels && parsed.sampleRate == kSampleRate &&
+               parsed.blockAlign == channels * sizeof(float) && parsed.byteRate == kSampleRate * channels * sizeof(float) &&
+               parsed.bitsPerSample == 32;
+    }
+
+    void TestRecording(const std::filesystem::path& directory, emp::RecordFormat format, bool polyphonic)
+    {
+        const bool wav = format == emp::RecordFormat::Wav;
+        const std::string label = std::string(wav ? "wav" : "w64") + (polyphonic ? " polyphonic" : " per track");
+        const std::vector<emp::RecordTrack> tracks = {
+            { emp::TapSource::Channel, 0 }, { emp::TapSource::Output, 1 }, { emp::TapSource::Channel, 1 }
+        };
+
+        emp::DiskRecorder recorder;
+        recorder.Reserve(2, 2);
+        recorder.SetSampleRate(kSampleRate);
+
+        emp::RecordOptions options;
+        options.path = (directory / (polyphonic ? "mix" : "take")).string();
+        options.format = format;
+        options.polyphonic = polyphonic;
+        options.tracks = tracks;
+        const emp::RecorderStatus status = Record(recorder, options);
+
+        Check(status.capturedFrames == kFrames && status.writtenFrames == kFrames && status.droppedBlocks == 0 &&
+              !status.writeFailed && !status.limitReached, (label + ": every frame written").c_str());
+        Check(status.bytesWritten == static_cast<uint64_t>(kFrames) * tracks.size() * sizeof(float),
+              (label + ": byte count").c_str());
+
+        std::vector<std::string> names;
+        const char* extension = wav ? ".wav" : ".w64";
+        if (polyphonic) names.push_back(options.path + extension);
+        else names = { options.path + "-in01" + extension, options.path + "-out02" + extension, options.path + "-in02" + extension };
+
+        for (size_t f = 0; f < names.size(); f++) {
+            const std::vector<uint8_t> bytes = ReadFile(names[f]);
+            const ParsedFile parsed = wav ? ParseWav(bytes) : ParseW64(bytes);
+            const std::vector<emp::RecordTrack> fileTracks = polyphonic ? tracks : std::vector<emp::RecordTrack>{ tracks[f] };
+            const uint16_t channels = static_cast<uint16_t>(fileTracks.size());
+            const std::string file = label + " " + std::filesystem::path(names[f]).filename().string();
+
+            Check(parsed.valid, (file + ": container and chunk sizes match the file").c_str());
+            Check(FormatMatches(parsed, channels), (file + ": 32-bit float format").c_str());
+            Check(parsed.dataOffset == emp::DiskRecorder::kDataAlignment, (file + ": data at the aligned offset").c_str());
+            if (wav) Check(parsed.factFrames == kFrames, (file + ": fact chunk frame count").c_str());
+            else Check(parsed.factFrames == -1, (file + ": no fact chunk").c_str());
+            Check(PayloadMatches(bytes, parsed, fileTracks), (file + ": payload").c_str());
+        }
+    }
+
+    // Tracks must refer to reserved sources, and only one recording runs at a time
+    void TestRejectedStarts(const std::filesystem::path& directory)
+    {
+        emp::DiskRecorder recorder;
+        recorder.Reserve(2, 1);
+
+        emp::RecordOptions options;
+        options.path = (directory / "rejected").string();
+        Check(!recorder.Start(options), "start: no tracks rejected");
+
+        options.tracks = { { emp::TapSource::Output, 1 } };
+        Check(!recorder.Start(options), "start: track out of range rejected");
+
+        options.tracks = { { emp::TapSource::Channel, 1 } };
+        Check(recorder.Start(options) && !recorder.Start(options), "start: second recording rejected");
+        Check(recorder.Stop() && !recorder.Stop(), "stop: only once");
+    }
+}
+
+int main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() /
+        ("emp_recorder_tests_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    for (emp::RecordFormat format : { emp::RecordFormat::Wav, emp::RecordFormat::Wave64 }) {
+        TestRecording(directory, format, false);
+        TestRecording(directory, format, true);
+    }
+    TestRejectedStarts(directory);
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+
+    if (g_failures > 0) std::printf("%d disk recorder check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,1043 @@
+// Bit-exact regression tests for the offline mix path. Each scenario renders a fixed
+// input through the engine with every kernel set this CPU supports and compares a hash of
+// the output samples against a recorded value, so kernel, chunking or threading changes
+// cannot alter the audio unnoticed.
+//
+// Multi-threaded scenarios share the single-threaded golden value: the worker count must
+// never change the output.
+//
+// A hash only says the audio is unchanged, not that it was right, so every feature also
+// has expectations worked out by hand: constant or pure-tone inputs through a known
+// setting, compared with the value the mix must produce at chosen frames.
+//
+// Run with --print to show the hashes produced by the current code (after an intentional
+// change to the audio path, update kScenarios with them).
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "../OfflineRenderer.h"
+
+namespace {
+
+    constexpr uint32_t kSampleRate = 48000;
+
+    // FNV-1a over the bit patterns of the output samples
+    class OutputHash
+    {
+    public:
+        void Add(const float* samples, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t bits;
+                std::memcpy(&bits, &samples[i], sizeof(bits));
+                for (int b = 0; b < 4; b++) {
+                    _hash ^= (bits >> (b * 8)) & 0xFF;
+                    _hash *= 0x100000001B3ull;
+                }
+            }
+        }
+
+        void Add(const emp::OfflineRenderer& renderer)
+        {
+            for (int o = 0; o < renderer.GetOutputCount(); o++) {
+                Add(renderer.GetOutput(o), renderer.GetBlockSize());
+            }
+        }
+
+        uint64_t Get() const { return _hash; }
+
+    private:
+        uint64_t _hash = 0xCBF29CE484222325ull;
+    };
+
+    uint64_t RenderAndHash(emp::OfflineRenderer& renderer, uint64_t frames)
+    {
+        OutputHash hash;
+        renderer.Render(frames, [&hash](emp::OfflineRenderer& r) { hash.Add(r); });
+        return hash.Get();
+    }
+
+    // Eight channels panned across a stereo pair with assorted gain, volume and a mute
+    uint64_t StereoPanMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(8, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(7, 3000);
+
+        emp::ParameterState& parameters = renderer.Engine().Parameters();
+        for (int i = 0; i < 8; i++) {
+            parameters.SetVolume(i, 0.3f + 0.08f * i);
+            parameters.SetPan(i, i / 7.0f);
+            parameters.SetGainDb(i, -6.0f + 1.5f * i);
+        }
+        parameters.SetMute(5, true);
+
+        return RenderAndHash(renderer, 48000);
+    }
+
+    // Solo-in-place: only the soloed channels reach the mix
+    uint64_t SoloMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(6, 2, 128, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(11, 1777);
+
+        emp::ParameterState& parameters = renderer.Engine().Parameters();
+        parameters.SetSolo(1, true);
+        parameters.SetSolo(4, true);
+        parameters.SetPan(4, 0.2f);
+
+        return RenderAndHash(renderer, 24000);
+    }
+
+    // Sparse routing matrix: 16 inputs into 8 outputs at roughly 25% density
+    uint64_t MatrixMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(16, 8, 64, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(3, 2500);
+
+        emp::RoutingMatrix& routing = renderer.Engine().Routing();
+        for (int i = 0; i < 16; i++) {
+            routing.SetRoute(i, i % 8, 0.75f);
+            routing.SetRoute(i, (i * 3 + 1) % 8, 0.25f + 0.03f * i);
+        }
+        routing.SetEnabled(true);
+        renderer.Engine().Parameters().SetVolume(2, 0.5f);
+
+        return RenderAndHash(renderer, 16000);
+    }
+
+    // Odd block size rendered in chunks smaller than the block
+    uint64_t ChunkedMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(4, 2, 300, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.Engine().Prepare(128);
+        renderer.GenerateTestSignals(5, 1000);
+        renderer.Engine().Parameters().SetPan(0, 0.1f);
+        renderer.Engine().Parameters().SetGainDb(3, 4.0f);
+
+        return RenderAndHash(renderer, 15000);
+    }
+
+    // Same as ChunkedMix without chunking; must produce identical audio
+    uint64_t UnchunkedMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(4, 2, 300, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(5, 1000);
+        renderer.Engine().Parameters().SetPan(0, 0.1f);
+        renderer.Engine().Parameters().SetGainDb(3, 4.0f);
+
+        return RenderAndHash(renderer, 15000);
+    }
+
+    // 96 channels into a dense 12-output matrix: strips are mixed in parallel tasks
+    uint64_t WideMatrixMix(const emp::MixKernels& kernels, int workers)
+    {
+        emp::OfflineRenderer renderer(96, 12, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(13, 2048);
+
+        emp::WorkerPoolConfig config;
+        config.workerCount = workers;
+        renderer.Engine().Workers().Start(config);
+
+        renderer.Engine().Routing().Apply([](std::vector<float>& gains, int numInputs, int numOutputs) {
+            for (int i = 0; i < numInputs; i++) {
+                for (int o = 0; o < numOutputs; o++) {
+                    if ((i + o) % 3 != 0) gains[static_cast<size_t>(i) * numOutputs + o] = 0.1f + 0.01f * ((i * 7 + o) % 13);
+                }
+            }
+        });
+        renderer.Engine().Routing().SetEnabled(true);
+        renderer.Engine().Parameters().SetMute(17, true);
+
+        return RenderAndHash(renderer, 12000);
+    }
+
+    uint64_t WideMatrixMixSingleThread(const emp::MixKernels& kernels) { return WideMatrixMix(kernels, 0); }
+    uint64_t WideMatrixMixThreeWorkers(const emp::MixKernels& kernels) { return WideMatrixMix(kernels, 3); }
+
+    // Channels added and removed between blocks while rendering
+    uint64_t HotResizeMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(12, 4, 128, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(17, 1500);
+
+        emp::MixEngine& engine = renderer.Engine();
+        engine.SetActivePorts(6, 2);
+        for (int i = 0; i < 6; i++) {
+            engine.Parameters().SetPan(i, i / 5.0f);
+        }
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(4000, sink);
+
+        // A guest channel joins; it starts from default parameters
+        engine.SetActivePorts(10, 4);
+        engine.Parameters().SetGainDb(8, -3.0f);
+        renderer.Render(4000, sink);
+
+        engine.SetActivePorts(3, 2);
+        renderer.Render(4000, sink);
+
+        return hash.Get();
+    }
+
+    // ChunkedMix with the block size and sample rate changing under it (layouts rebuilt
+    // between blocks); must produce identical audio
+    uint64_t ReconfigureMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(4, 2, 300, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(5, 1000);
+        renderer.Engine().Parameters().SetPan(0, 0.1f);
+        renderer.Engine().Parameters().SetGainDb(3, 4.0f);
+
+        emp::MixEngine& engine = renderer.Engine();
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+
+        engine.Prepare(128);
+        renderer.Render(4800, sink);
+        engine.SetSampleRate(44100);
+        renderer.Render(4800, sink);
+        engine.Prepare(64);
+        renderer.Render(2700, sink);
+        engine.SetSampleRate(kSampleRate);
+        engine.Prepare(512);
+        renderer.Render(2700, sink);
+
+        return hash.Get();
+    }
+
+    // Timed changes landing mid-block with step, linear and exponential ramps, plus
+    // untimed edits smoothed by the default ramp
+    uint64_t AutomationMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(6, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(23, 1200);
+
+        emp::MixEngine& engine = renderer.Engine();
+        auto schedule = [&engine](uint64_t frame, int channel, emp::ParameterId parameter, float value,
+                                  emp::RampShape shape, uint32_t rampFrames) {
+            engine.ScheduleParameterChange({ frame, { channel, parameter, value }, shape, rampFrames });
+        };
+
+        schedule(777, 0, emp::ParameterId::Volume, 0.25f, emp::RampShape::Step, 0);
+        schedule(1000, 1, emp::ParameterId::Pan, 0.0f, emp::RampShape::Linear, 4800);
+        schedule(1301, 2, emp::ParameterId::GainDb, -12.0f, emp::RampShape::Exponential, 2400);
+        schedule(1301, 3, emp::ParameterId::Mute, 1.0f, emp::RampShape::Step, 0);
+        schedule(9000, 3, emp::ParameterId::Mute, 0.0f, emp::RampShape::Step, 0);
+        schedule(9000, 3, emp::ParameterId::Volume, 0.5f, emp::RampShape::Linear, 100);
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(4096, sink);
+
+        engine.Parameters().SetVolume(4, 0.1f);
+        engine.SetSmoothing(emp::RampShape::Exponential, 25.0f);
+        engine.Parameters().SetPan(5, 1.0f);
+        renderer.Render(12288, sink);
+
+        return hash.Get();
+    }
+
+    // Scene recalls: a hard swap, equal-power crossfades between the stereo mix and the
+    // matrix, a recall during a crossfade and edits made while one runs
+    uint64_t SceneRecallMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(8, 4, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(31, 3000);
+
+        emp::MixEngine& engine = renderer.Engine();
+        for (int i = 0; i < 8; i++) {
+            engine.Parameters().SetPan(i, i / 7.0f);
+        }
+        engine.Parameters().SetMute(6, true);
+        auto stereo = engine.CompileScene(engine.CaptureScene());
+
+        engine.Parameters().Apply([](std::vector<emp::ChannelParams>& channels, int count) {
+            for (int i = 0; i < count; i++) {
+                channels[i].volume = 0.2f + 0.1f * i;
+                channels[i].mute = i == 2;
+            }
+        });
+        engine.Routing().Apply([](std::vector<float>& gains, int numInputs, int numOutputs) {
+            for (int i = 0; i < numInputs; i++) {
+                gains[static_cast<size_t>(i) * numOutputs + (i % numOutputs)] = 0.9f;
+                gains[static_cast<size_t>(i) * numOutputs + ((i + 2) % numOutputs)] = 0.3f;
+            }
+        });
+        engine.Routing().SetEnabled(true);
+        auto matrix = engine.CompileScene(engine.CaptureScene());
+
+        emp::SceneSnapshot solo = engine.CaptureScene();
+        solo.channels[5].solo = true;
+        solo.routes.assign(solo.routes.size(), 0.0f);
+        solo.routes[5 * solo.routeOutputs + 3] = 1.0f;
+        auto soloScene = engine.CompileScene(solo);
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(2048, sink);
+
+        engine.RecallScene(stereo, 0.0f);
+        renderer.Render(2048, sink);
+
+        engine.RecallScene(matrix, 50.0f);
+        renderer.Render(1024, sink);
+        engine.Parameters().SetVolume(1, 1.0f);
+        renderer.Render(4096, sink);
+
+        engine.RecallScene(soloScene, 20.0f);
+        renderer.Render(512, sink);
+        engine.RecallScene(stereo, 30.0f);
+        renderer.Render(4096, sink);
+
+        return hash.Get();
+    }
+
+    // Live, silent and intermittent channels with mute and solo: idle channels are
+    // skipped, which must not change the mix of exact digital silence
+    uint64_t SilentChannelsMix(const emp::MixKernels& kernels, bool detectSilence)
+    {
+        emp::OfflineRenderer renderer(16, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.Engine().SetSilenceDetection(detectSilence);
+        renderer.GenerateTestSignals(29, 12000);
+
+        // Channels 4-7 silent, 8-11 heard for 2000 of every 12000 frames
+        for (int channel = 4; channel < 8; channel++) {
+            renderer.SetInput(channel, std::vector<float>(12000, 0.0f));
+        }
+        for (int channel = 8; channel < 12; channel++) {
+            std::vector<float> burst(12000, 0.0f);
+            for (int i = 0; i < 2000; i++) {
+                burst[i] = 0.3f * static_cast<float>((i * (channel + 3)) % 97 - 48) / 48.0f;
+            }
+            renderer.SetInput(channel, burst);
+        }
+
+        emp::MixEngine& engine = renderer.Engine();
+        engine.Parameters().SetMute(12, true);
+        for (int i = 0; i < 16; i++) {
+            engine.Parameters().SetPan(i, i / 15.0f);
+        }
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(30000, sink);
+
+        engine.Parameters().SetSolo(9, true);
+        renderer.Render(15000, sink);
+
+        engine.Parameters().SetSolo(9, false);
+        engine.Parameters().SetMute(12, false);
+        renderer.Render(15000, sink);
+
+        return hash.Get();
+    }
+
+    uint64_t SilentChannelsDetected(const emp::MixKernels& kernels) { return SilentChannelsMix(kernels, true); }
+    uint64_t SilentChannelsUndetected(const emp::MixKernels& kernels) { return SilentChannelsMix(kernels, false); }
+
+    // 40 channels (three insert groups, the last partial) with assorted EQ, gate and
+    // compressor chains, one bypassed and one muted; bypass is toggled mid-render
+    uint64_t InsertsMix(const emp::MixKernels& kernels, int workers)
+    {
+        emp::OfflineRenderer renderer(40, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(31, 4096);
+
+        emp::WorkerPoolConfig config;
+        config.workerCount = workers;
+        renderer.Engine().Workers().Start(config);
+
+        emp::MixEngine& engine = renderer.Engine();
+        for (int i = 0; i < 40; i++) {
+            emp::ChannelInsertParams inserts;
+            if (i % 3 == 0) {
+                emp::EqBandParams& band = inserts.eq[i % emp::ChannelInsertParams::kEqBands];
+                band.enabled = true;
+                band.type = static_cast<emp::EqBandType>(i % 5);
+                band.frequency = 80.0f + 190.0f * i;
+                band.gainDb = static_cast<float>(i % 13) - 6.0f;
+                band.q = 0.5f + 0.1f * (i % 7);
+            }
+            if (i % 4 == 1) {
+                inserts.compressor.enabled = true;
+                inserts.compressor.thresholdDb = -30.0f + i % 10;
+                inserts.compressor.ratio = 2.0f + i % 5;
+                inserts.compressor.makeupDb = 3.0f;
+            }
+            if (i % 5 == 2) {
+                inserts.gate.enabled = true;
+                inserts.gate.thresholdDb = -20.0f;
+            }
+            engine.Inserts().SetChannel(i, inserts);
+            engine.Parameters().SetPan(i, (i % 9) / 8.0f);
+        }
+        engine.Inserts().SetBypass(7, true);
+        engine.Parameters().SetMute(9, true);
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(12000, sink);
+
+        engine.Inserts().SetBypass(7, false);
+        engine.Inserts().SetBypass(0, true);
+        renderer.Render(6000, sink);
+
+        return hash.Get();
+    }
+
+    uint64_t InsertsMixSingleThread(const emp::MixKernels& kernels) { return InsertsMix(kernels, 0); }
+    uint64_t InsertsMixThreeWorkers(const emp::MixKernels& kernels) { return InsertsMix(kernels, 3); }
+
+    // A stereo device at 44.1 kHz running 200 ppm fast and a mono one at 96 kHz running
+    // 300 ppm slow, both delivering stamped packets, replace four channels' inputs; the
+    // stereo source is removed mid-render and its channels fall back to their ports
+    uint64_t VirtualSourceMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(8, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(37, 4096);
+
+        emp::MixEngine& engine = renderer.Engine();
+        for (int i = 0; i < 8; i++) {
+            engine.Parameters().SetPan(i, i / 7.0f);
+        }
+
+        struct Device
+        {
+            int id;
+            int channels;
+            uint32_t packetFrames;
+            double rate;
+            uint64_t produced;
+        };
+
+        emp::VirtualSourceConfig stereo;
+        stereo.firstChannel = 2;
+        stereo.channels = 2;
+        stereo.sampleRate = 44100;
+        emp::VirtualSourceConfig mono;
+        mono.firstChannel = 5;
+        mono.channels = 1;
+        mono.sampleRate = 96000;
+        mono.quality = emp::ResamplerQuality::Low;
+
+        Device devices[] = {
+            { engine.VirtualSources().Create(stereo), 2, 441, 44100 * 1.0002, 0 },
+            { engine.VirtualSources().Create(mono), 1, 960, 96000 * 0.9997, 0 },
+        };
+
+        // Queues every packet completed before the next cycle, stamped in graph frames
+        std::vector<float> packet;
+        uint64_t rendered = 0;
+        OutputHash hash;
+        auto sink = [&](emp::OfflineRenderer& r) {
+            hash.Add(r);
+            rendered += r.GetBlockSize();
+            for (Device& device : devices) {
+                for (;;) {
+                    const double completed = (device.produced + device.packetFrames) / device.rate * kSampleRate;
+                    if (completed > rendered) break;
+
+                    packet.resize(static_cast<size_t>(device.packetFrames) * device.channels);
+                    for (size_t i = 0; i < packet.size(); i++) {
+                        const uint64_t n = device.produced * device.channels + i;
+                        packet[i] = 0.4f * static_cast<float>(static_cast<int>((n * 7 + device.channels) % 113) - 56) / 56.0f;
+                    }
+                    engine.VirtualSources().Write(device.id, packet.data(), device.packetFrames, completed);
+                    device.produced += device.packetFrames;
+                }
+            }
+        };
+        renderer.Render(96000, sink);
+
+        engine.VirtualSources().Remove(devices[0].id);
+        renderer.Render(12000, sink);
+
+        return hash.Get();
+    }
+
+    // Eight channels over the stereo pan mix, plus a subgroup and a stereo aux summed into
+    // a master on outputs 3/4 and a mono pre-fader aux on output 5, rendered in chunks
+    // while faders move and the graph is edited; a send closing a cycle and a pre-fader
+    // subgroup send must be rejected
+    uint64_t BusMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(8, 5, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.Engine().Prepare(96);
+        renderer.GenerateTestSignals(41, 2222);
+
+        emp::MixEngine& engine = renderer.Engine();
+        emp::BusGraph& buses = engine.Buses();
+        for (int i = 0; i < 8; i++) {
+            engine.Parameters().SetPan(i, i / 7.0f);
+            engine.Parameters().SetVolume(i, 0.4f + 0.05f * i);
+        }
+
+        emp::BusConfig config;
+        config.type = emp::BusType::Master;
+        config.firstOutput = 2;
+        const int master = buses.CreateBus(config);
+        config.type = emp::BusType::Subgroup;
+        config.firstOutput = -1;
+        const int subgroup = buses.CreateBus(config);
+        config.type = emp::BusType::Aux;
+        const int effects = buses.CreateBus(config);
+        config.channels = 1;
+        config.firstOutput = 4;
+        config.volume = 0.8f;
+        const int monitor = buses.CreateBus(config);
+
+        auto send = [&buses](emp::SendSource type, int source, int destination, emp::SendTap tap, float level, float pan) {
+            return buses.SetSend({ type, source, destination, tap, level, pan });
+        };
+        for (int i = 0; i < 4; i++) {
+            send(emp::SendSource::Channel, i, subgroup, emp::SendTap::PostFader, 1.0f, 0.5f);
+        }
+        for (int i = 4; i < 8; i++) {
+            send(emp::SendSource::Channel, i, monitor, emp::SendTap::PreFader, 0.2f * (i - 3), 0.5f);
+        }
+        send(emp::SendSource::Channel, 1, effects, emp::SendTap::PreFader, 0.7f, 0.2f);
+        send(emp::SendSource::Channel, 6, effects, emp::SendTap::PostFader, 0.5f, 0.5f);
+        send(emp::SendSource::Bus, subgroup, master, emp::SendTap::PostFader, 0.9f, 0.5f);
+        send(emp::SendSource::Bus, effects, master, emp::SendTap::PostFader, 0.6f, 0.5f);
+        send(emp::SendSource::Bus, subgroup, effects, emp::SendTap::PreFader, 0.3f, 0.5f);
+
+        if (send(emp::SendSource::Bus, effects, subgroup, emp::SendTap::PostFader, 1.0f, 0.5f) != emp::BusGraphStatus::Cycle) return 0;
+        if (send(emp::SendSource::Channel, 0, master, emp::SendTap::PreFader, 1.0f, 0.5f) != emp::BusGraphStatus::Invalid) return 0;
+
+        OutputHash hash;
+        auto sink = [&hash](emp::OfflineRenderer& r) { hash.Add(r); };
+        renderer.Render(9600, sink);
+
+        // Faders ramp under post-fader sends; bus edits ramp over the new plan's first chunk
+        engine.Parameters().SetVolume(2, 0.1f);
+        engine.Parameters().SetPan(3, 1.0f);
+        config.type = emp::BusType::Subgroup;
+        config.channels = 2;
+        config.firstOutput = -1;
+        config.volume = 0.5f;
+        buses.SetBus(subgroup, config);
+        renderer.Render(4800, sink);
+
+        engine.Parameters().SetMute(5, true);
+        buses.RemoveSend(emp::SendSource::Channel, 6, effects);
+        send(emp::SendSource::Channel, 7, monitor, emp::SendTap::PostFader, 1.0f, 0.5f);
+        renderer.Render(4800, sink);
+
+        return hash.Get();
+    }
+
+    // The stereo pan mix at a period that leaves a partial group of frames, hashing the
+    // published meters rather than the audio: the level kernels must agree across tables too
+    uint64_t MeterMix(const emp::MixKernels& kernels)
+    {
+        emp::OfflineRenderer renderer(8, 2, 250, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        renderer.GenerateTestSignals(7, 3000);
+
+        emp::MixEngine& engine = renderer.Engine();
+        for (int i = 0; i < 8; i++) {
+            engine.Parameters().SetVolume(i, 0.3f + 0.08f * i);
+            engine.Parameters().SetPan(i, i / 7.0f);
+        }
+        engine.Parameters().SetMute(5, true);
+
+        std::vector<float> meters(8 * emp::MeterBank::kValuesPerChannel);
+        OutputHash hash;
+        renderer.Render(48000, [&](emp::OfflineRenderer&) {
+            const int count = engine.Meters().CopyTo(meters.data(), static_cast<int>(meters.size()));
+            hash.Add(meters.data(), static_cast<uint32_t>(count * emp::MeterBank::kValuesPerChannel));
+        });
+        return hash.Get();
+    }
+
+    // ---------------------------------------------------------------- Expectations
+
+    // Sample of an output at a frame, recorded while rendering
+    class Probe
+    {
+    public:
+        explicit Probe(emp::OfflineRenderer& renderer)
+            : _renderer(renderer), _rendered(0)
+        {
+        }
+
+        // Renders until frame (counted from the first render) has been produced and
+        // returns output's sample there; NaN if the frame was in an earlier block
+        float At(uint64_t frame, int output)
+        {
+            Skip(frame + 1);
+
+            const uint64_t blockStart = _rendered - _renderer.GetBlockSize();
+            if (frame < blockStart) return std::nanf("");
+            return _renderer.GetOutput(output)[frame - blockStart];
+        }
+
+        // Renders until at least frames have been produced
+        void Skip(uint64_t frames)
+        {
+            while (_rendered < frames) {
+                _renderer.RenderBlock();
+                _rendered += _renderer.GetBlockSize();
+            }
+        }
+
+        uint64_t GetRendered() const { return _rendered; }
+
+    private:
+        emp::OfflineRenderer& _renderer;
+        uint64_t _rendered;
+    };
+
+    // Compares a measured value and prints the difference on a mismatch
+    class Expect
+    {
+    public:
+        void Near(float actual, float expected, float tolerance, const char* what)
+        {
+            if (std::fabs(actual - expected) <= tolerance) return;
+            std::printf("     %s: got %.9g, expected %.9g\n", what, actual, expected);
+            _passed = false;
+        }
+
+        void True(bool condition, const char* what)
+        {
+            if (condition) return;
+            std::printf("     %s\n", what);
+            _passed = false;
+        }
+
+        bool Passed() const { return _passed; }
+
+    private:
+        bool _passed = true;
+    };
+
+    void SetConstantInputs(emp::OfflineRenderer& renderer, std::initializer_list<float> levels)
+    {
+        int channel = 0;
+        for (float level : levels) {
+            renderer.SetInput(channel++, std::vector<float>(renderer.GetBlockSize(), level));
+        }
+    }
+
+    // The parameter smoothing of the first edits has settled after this many frames
+    constexpr uint64_t kSettled = 4800;
+
+    // Linear pan law: (1 - pan, pan), so a centred channel reaches each side at half
+    // level (-6 dB); the fader and the gain in dB multiply
+    bool PanLawExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(3, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 1.0f, 0.0f, 0.0f });
+
+        Probe probe(renderer);
+        expect.Near(probe.At(kSettled, 0), 0.5f, 0.0f, "centre pan, left");
+        expect.Near(probe.At(kSettled, 1), 0.5f, 0.0f, "centre pan, right");
+
+        emp::ParameterState& parameters = renderer.Engine().Parameters();
+        parameters.SetPan(0, 0.25f);
+        parameters.SetVolume(0, 0.5f);
+        parameters.SetGainDb(0, 20.0f * std::log10(2.0f));
+        expect.Near(probe.At(2 * kSettled, 0), 0.75f, 1.0e-6f, "pan 0.25 at unity level, left");
+        expect.Near(probe.At(2 * kSettled, 1), 0.25f, 1.0e-6f, "pan 0.25 at unity level, right");
+
+        parameters.SetPan(0, 1.0f);
+        expect.Near(probe.At(3 * kSettled, 0), 0.0f, 0.0f, "hard right, left");
+        return expect.Passed();
+    }
+
+    // Soloed channels alone reach the mix; a muted channel never does
+    bool SoloMuteExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(3, 2, 128, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 0.125f, 0.25f, 0.5f });
+
+        Probe probe(renderer);
+        expect.Near(probe.At(kSettled, 0), 0.4375f, 0.0f, "all channels, centred");
+
+        emp::ParameterState& parameters = renderer.Engine().Parameters();
+        parameters.SetSolo(1, true);
+        expect.Near(probe.At(2 * kSettled, 0), 0.125f, 0.0f, "channel 1 soloed");
+
+        parameters.SetSolo(2, true);
+        parameters.SetMute(2, true);
+        expect.Near(probe.At(3 * kSettled, 0), 0.125f, 0.0f, "muted solo stays silent");
+
+        parameters.SetSolo(1, false);
+        parameters.SetSolo(2, false);
+        expect.Near(probe.At(4 * kSettled, 0), 0.1875f, 0.0f, "solo released, channel 2 still muted");
+        return expect.Passed();
+    }
+
+    // Matrix routing sums input x crosspoint gain x level per output and drops pan
+    bool MatrixExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(2, 3, 64, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 1.0f, 0.5f });
+
+        emp::RoutingMatrix& routing = renderer.Engine().Routing();
+        routing.SetRoute(0, 1, 0.75f);
+        routing.SetRoute(1, 1, 0.25f);
+        routing.SetRoute(1, 2, 1.0f);
+        routing.SetEnabled(true);
+        renderer.Engine().Parameters().SetVolume(1, 0.5f);
+
+        Probe probe(renderer);
+        expect.Near(probe.At(kSettled, 0), 0.0f, 0.0f, "unrouted output silent");
+        expect.Near(probe.At(kSettled, 1), 0.8125f, 1.0e-7f, "two crosspoints summed");
+        expect.Near(probe.At(kSettled, 2), 0.25f, 0.0f, "crosspoint follows the fader");
+        return expect.Passed();
+    }
+
+    // A timed linear volume ramp starts on its frame and ends exactly on its target,
+    // passing the midpoint halfway; a step lands on its frame, even inside a block or a
+    // chunk, and the block size does not matter
+    bool RampExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        for (uint32_t chunk : { 0u, 96u }) {
+            emp::OfflineRenderer renderer(2, 2, 300, kSampleRate);
+            renderer.Engine().SetKernels(kernels);
+            if (chunk != 0) renderer.Engine().Prepare(chunk);
+            SetConstantInputs(renderer, { 1.0f, 1.0f });
+
+            emp::MixEngine& engine = renderer.Engine();
+            engine.ScheduleParameterChange({ 1000, { 0, emp::ParameterId::Volume, 0.25f }, emp::RampShape::Linear, 4800 });
+            engine.ScheduleParameterChange({ 777, { 1, emp::ParameterId::Mute, 1.0f }, emp::RampShape::Step, 0 });
+
+            Probe probe(renderer);
+            expect.Near(probe.At(776, 0), 1.0f, 0.0f, "step: frame before it");
+            expect.Near(probe.At(777, 0), 0.5f, 0.0f, "step: lands on its frame");
+            expect.Near(probe.At(1000, 0), 0.5f, 1.0e-6f, "linear ramp: starts from the old value");
+            expect.Near(probe.At(3400, 0), 0.3125f, 1.0e-5f, "linear ramp: midpoint");
+            expect.Near(probe.At(5800, 0), 0.125f, 0.0f, "linear ramp: ends on its target");
+            expect.Near(probe.At(9000, 0), 0.125f, 0.0f, "linear ramp: holds the target");
+        }
+        return expect.Passed();
+    }
+
+    // An equal-power crossfade passes cos/sin(pi/4) of the two scenes halfway and lands
+    // on the new scene; a hard recall switches on the next cycle
+    bool SceneExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(1, 2, 64, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 1.0f });
+
+        emp::MixEngine& engine = renderer.Engine();
+        auto loud = engine.CompileScene(engine.CaptureScene());
+        emp::SceneSnapshot quietSnapshot = engine.CaptureScene();
+        quietSnapshot.channels[0].volume = 0.5f;
+        auto quiet = engine.CompileScene(quietSnapshot);
+
+        Probe probe(renderer);
+        probe.Skip(kSettled);
+
+        // 20 ms at 48 kHz: 960 frames from the start of the next cycle
+        const uint64_t start = probe.GetRendered();
+        engine.RecallScene(quiet, 20.0f);
+        const float half = std::sqrt(0.5f);
+        expect.Near(probe.At(start, 0), 0.5f, 1.0e-6f, "crossfade: starts on the old scene");
+        expect.Near(probe.At(start + 480, 0), half * 0.5f + half * 0.25f, 1.0e-6f, "crossfade: equal power halfway");
+        expect.Near(probe.At(start + 960, 0), 0.25f, 0.0f, "crossfade: ends on the new scene");
+
+        const uint64_t hard = probe.GetRendered();
+        engine.RecallScene(loud, 0.0f);
+        expect.Near(probe.At(hard, 0), 0.5f, 0.0f, "hard recall: next cycle");
+
+        // A recall that finds the queue full is refused without disturbing the one queued
+        // before it, and the faders keep working once the queue drains
+        expect.True(engine.RecallScene(quiet, 0.0f) != 0, "queued recall accepted");
+        while (engine.PostParameterChange({ 0, emp::ParameterId::Mute, 0.0f }) != 0) {}
+        expect.True(engine.RecallScene(loud, 0.0f) == 0, "recall refused while the queue is full");
+        const uint64_t refused = probe.GetRendered() + kSettled;
+        expect.Near(probe.At(refused, 0), 0.25f, 0.0f, "queued recall still applied");
+        engine.Parameters().SetVolume(0, 0.25f);
+        expect.Near(probe.At(refused + kSettled, 0), 0.125f, 0.0f, "faders follow after a refused recall");
+        return expect.Passed();
+    }
+
+    // Silence detection skips exact digital silence without touching the live mix or
+    // quiet tails
+    bool SilenceExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        for (bool detect : { true, false }) {
+            emp::OfflineRenderer renderer(3, 2, 256, kSampleRate);
+            renderer.Engine().SetKernels(kernels);
+            renderer.Engine().SetSilenceDetection(detect);
+            SetConstantInputs(renderer, { 0.0f, 0.25f, 0.0f });
+
+            Probe probe(renderer);
+            expect.Near(probe.At(kSettled, 0), 0.125f, 0.0f, "live channel through silent ones");
+        }
+
+        // A tail at -120 dBFS stays in the mix long after the hold time; only a raised
+        // threshold drops it
+        for (bool raised : { false, true }) {
+            emp::OfflineRenderer renderer(1, 2, 256, kSampleRate);
+            renderer.Engine().SetKernels(kernels);
+            if (raised) renderer.Engine().SetSilenceThreshold(1.0e-5f);
+            SetConstantInputs(renderer, { 1.0e-6f });
+
+            Probe probe(renderer);
+            expect.Near(probe.At(4 * kSettled, 0), raised ? 0.0f : 0.5e-6f, 0.0f,
+                        raised ? "tail below a raised threshold skipped" : "low-level tail kept by default");
+        }
+        return expect.Passed();
+    }
+
+    // A peaking band of +6.02 dB doubles a tone at its centre frequency; a bypassed
+    // chain passes it unchanged
+    bool InsertExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(1, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+
+        // 1 kHz at 48 kHz: 48 samples per period, a crest every period at frame 12
+        std::vector<float> tone(4800);
+        for (size_t i = 0; i < tone.size(); i++) {
+            tone[i] = 0.25f * static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * 1000.0 * i / kSampleRate));
+        }
+        renderer.SetInput(0, tone);
+
+        emp::ChannelInsertParams inserts;
+        inserts.eq[0].enabled = true;
+        inserts.eq[0].type = emp::EqBandType::Peak;
+        inserts.eq[0].frequency = 1000.0f;
+        inserts.eq[0].gainDb = 20.0f * std::log10(2.0f);
+        inserts.eq[0].q = 1.0f;
+        renderer.Engine().Inserts().SetChannel(0, inserts);
+
+        Probe probe(renderer);
+        expect.Near(probe.At(48000 + 12, 0), 0.25f, 1.0e-3f, "peaking band: doubles its centre frequency");
+
+        renderer.Engine().Inserts().SetBypass(0, true);
+        expect.Near(probe.At(96000 + 12, 0), 0.125f, 1.0e-6f, "bypassed chain: unity");
+        return expect.Passed();
+    }
+
+    // Sends: a pre-fader mono aux ignores the fader, a post-fader stereo subgroup follows
+    // fader and pan, and a subgroup sent into the master scales by the send level
+    bool BusExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(1, 5, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 1.0f });
+
+        emp::MixEngine& engine = renderer.Engine();
+        engine.Parameters().SetVolume(0, 0.5f);
+        engine.Parameters().SetPan(0, 0.25f);
+
+        emp::BusGraph& buses = engine.Buses();
+        emp::BusConfig config;
+        config.type = emp::BusType::Master;
+        config.firstOutput = 2;
+        const int master = buses.CreateBus(config);
+        config.type = emp::BusType::Subgroup;
+        config.firstOutput = -1;
+        const int subgroup = buses.CreateBus(config);
+        config.type = emp::BusType::Aux;
+        config.channels = 1;
+        config.firstOutput = 4;
+        const int aux = buses.CreateBus(config);
+
+        buses.SetSend({ emp::SendSource::Channel, 0, aux, emp::SendTap::PreFader, 0.75f, 0.5f });
+        buses.SetSend({ emp::SendSource::Channel, 0, subgroup, emp::SendTap::PostFader, 1.0f, 0.5f });
+        buses.SetSend({ emp::SendSource::Bus, subgroup, master, emp::SendTap::PostFader, 0.5f, 0.5f });
+
+        Probe probe(renderer);
+        expect.Near(probe.At(kSettled, 0), 0.375f, 0.0f, "main mix unchanged by sends");
+        expect.Near(probe.At(kSettled, 4), 0.75f, 0.0f, "pre-fader aux ignores the fader");
+        expect.Near(probe.At(kSettled, 2), 0.1875f, 1.0e-7f, "master left: fader, pan and send level");
+        expect.Near(probe.At(kSettled, 3), 0.0625f, 1.0e-7f, "master right: fader, pan and send level");
+        return expect.Passed();
+    }
+
+    // Channels leave the mix with their ports and rejoin at default parameters; a new
+    // period or rate keeps a constant mix constant
+    bool ResizeExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(3, 2, 128, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 0.5f, 0.25f, 0.125f });
+
+        emp::MixEngine& engine = renderer.Engine();
+        engine.Parameters().SetVolume(2, 0.5f);
+
+        Probe probe(renderer);
+        expect.Near(probe.At(kSettled, 0), 0.40625f, 0.0f, "three channels");
+
+        engine.SetActivePorts(2, 2);
+        expect.Near(probe.At(2 * kSettled, 0), 0.375f, 0.0f, "third channel removed");
+
+        engine.SetActivePorts(3, 2);
+        expect.Near(probe.At(3 * kSettled, 0), 0.4375f, 0.0f, "third channel back at default volume");
+
+        engine.Prepare(32);
+        engine.SetSampleRate(44100);
+        expect.Near(probe.At(4 * kSettled, 0), 0.4375f, 0.0f, "new period and rate");
+        return expect.Passed();
+    }
+
+    // A device at the graph's rate delivering a constant settles to that constant
+    bool VirtualSourceExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(1, 2, 256, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+
+        emp::VirtualSourceConfig config;
+        config.firstChannel = 0;
+        config.channels = 1;
+        emp::MixEngine& engine = renderer.Engine();
+        const int id = engine.VirtualSources().Create(config);
+
+        const std::vector<float> packet(480, 0.5f);
+        uint64_t produced = 0;
+        uint64_t rendered = 0;
+        float sample = 0.0f;
+        renderer.Render(kSampleRate, [&](emp::OfflineRenderer& r) {
+            sample = r.GetOutput(0)[r.GetBlockSize() - 1];
+            rendered += r.GetBlockSize();
+            while (produced + packet.size() <= rendered) {
+                produced += packet.size();
+                engine.VirtualSources().Write(id, packet.data(), static_cast<uint32_t>(packet.size()), static_cast<double>(produced));
+            }
+        });
+        expect.Near(sample, 0.25f, 1.0e-4f, "constant through the resampler at unity gain");
+        return expect.Passed();
+    }
+
+    // Channel meters read the level after gain and fader, before pan
+    bool MeterExpectations(const emp::MixKernels& kernels, Expect& expect)
+    {
+        emp::OfflineRenderer renderer(2, 2, 250, kSampleRate);
+        renderer.Engine().SetKernels(kernels);
+        SetConstantInputs(renderer, { 0.5f, -1.0f });
+        renderer.Engine().Parameters().SetVolume(1, 0.25f);
+
+        Probe probe(renderer);
+        probe.Skip(kSettled * 4);
+        const emp::ChannelMeterFrame first = renderer.Engine().Meters().GetChannel(0);
+        const emp::ChannelMeterFrame second = renderer.Engine().Meters().GetChannel(1);
+        expect.Near(first.peak, 0.5f, 0.0f, "peak of a constant");
+        expect.Near(first.rms, 0.5f, 1.0e-6f, "rms of a constant");
+        expect.Near(second.peak, 0.25f, 0.0f, "peak after the fader");
+        expect.True(first.clipCount == 0 && second.clipCount == 0, "no clips below full scale");
+        return expect.Passed();
+    }
+
+    struct Expectation
+    {
+        const char* name;
+        std::function<bool(const emp::MixKernels&, Expect&)> check;
+    };
+
+    const Expectation kExpectations[] = {
+        { "PanLaw", PanLawExpectations },
+        { "SoloMute", SoloMuteExpectations },
+        { "Matrix", MatrixExpectations },
+        { "Ramps", RampExpectations },
+        { "SceneCrossfade", SceneExpectations },
+        { "Silence", SilenceExpectations },
+        { "Inserts", InsertExpectations },
+        { "Buses", BusExpectations },
+        { "Resize", ResizeExpectations },
+        { "VirtualSource", VirtualSourceExpectations },
+        { "Meters", MeterExpectations },
+    };
+
+    struct Scenario
+    {
+        const char* name;
+        uint64_t golden;
+        std::function<uint64_t(const emp::MixKernels&)> render;
+    };
+
+    const Scenario kScenarios[] = {
+        { "StereoPanMix", 0xF1CA1053B10606BCull, StereoPanMix },
+        { "SoloMix", 0x8797B1E36CECB0F7ull, SoloMix },
+        { "MatrixMix", 0x92503A1517B46239ull, MatrixMix },
+        { "ChunkedMix", 0x6E7115187178B60Bull, ChunkedMix },
+        { "UnchunkedMix", 0x6E7115187178B60Bull, UnchunkedMix },
+        { "ReconfigureMix", 0x6E7115187178B60Bull, ReconfigureMix },
+        { "AutomationMix", 0xD83CFF2BEAF6C718ull, AutomationMix },
+        { "SilentChannelsMix", 0xC9570A3A376D81FFull, SilentChannelsDetected },
+        { "SilentChannelsMixOff", 0xC9570A3A376D81FFull, SilentChannelsUndetected },
+        { "SceneRecallMix", 0xA03174D8CA67A336ull, SceneRecallMix },
+        { "InsertsMix", 0x0D51FF528168F16Full, InsertsMixSingleThread },
+        { "InsertsMixMT", 0x0D51FF528168F16Full, InsertsMixThreeWorkers },
+        { "HotResizeMix", 0xDBC720B662399BD7ull, HotResizeMix },
+        { "WideMatrixMix", 0x9F3FB0624B522474ull, WideMatrixMixSingleThread },
+        { "WideMatrixMixMT", 0x9F3FB0624B522474ull, WideMatrixMixThreeWorkers },
+        { "VirtualSourceMix", 0xB717B8795424C9B0ull, VirtualSourceMix },
+        { "BusMix", 0xDC27D6002EBFF9DEull, BusMix },
+        { "MeterMix", 0x42A63C4F2CF02292ull, MeterMix },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    const bool print = argc > 1 && std::strcmp(argv[1], "--print") == 0;
+
+    std::vector<const emp::MixKernels*> kernelSets;
+    for (emp::KernelIsa isa : { emp::KernelIsa::Scalar, emp::KernelIsa::Sse2, emp::KernelIsa::Avx2, emp::KernelIsa::Avx512 }) {
+        const emp::MixKernels* kernels = emp::GetMixKernels(isa);
+        if (kernels != nullptr) kernelSets.push_back(kernels);
+    }
+
+    int failures = 0;
+    for (const Scenario& scenario : kScenarios) {
+        for (const emp::MixKernels* kernels : kernelSets) {
+            const uint64_t hash = scenario.render(*kernels);
+
+            if (print) {
+                std::printf("%-14s %-8s 0x%016llXull\n", scenario.name, kernels->name, static_cast<unsigned long long>(hash));
+            }
+            else if (hash != scenario.golden) {
+                std::printf("FAIL %s [%s]: got 0x%016llX, expected 0x%016llX\n", scenario.name, kernels->name,
+                            static_cast<unsigned long long>(hash), static_cast<unsigned long long>(scenario.golden));
+                failures++;
+            }
+            else {
+                std::printf("ok   %s [%s]\n", scenario.name, kernels->name);
+            }
+        }
+    }
+
+    for (const Expectation& expectation : kExpectations) {
+        for (const emp::MixKernels* kernels : kernelSets) {
+            Expect expect;
+            if (expectation.check(*kernels, expect)) {
+                if (!print) std::printf("ok   %s [%s]\n", expectation.name, kernels->name);
+            }
+            else {
+                std::printf("FAIL %s [%s]\n", expectation.name, kernels->name);
+                failures++;
+            }
+        }
+    }
+
+    if (failures > 0) std::printf("%d golden output check(s) failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
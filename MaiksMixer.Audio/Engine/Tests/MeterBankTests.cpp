@@ -0,0 +1,154 @@
+// Checks MeterBank publishing: peak hold expiry, clip counting and its reset, and the
+// idle fall-off of channels that stop delivering levels. Levels are fed directly through
+// Accumulate/EndCycle, one publish per cycle.
+
+#include <cstdio>
+
+#include "../MeterBank.h"
+
+namespace {
+
+    constexpr uint32_t kSampleRate = 48000;
+
+    // 100 Hz refresh: one publish per 480-frame cycle
+    constexpr float kRefreshRateHz = 100.0f;
+    constexpr uint32_t kCycleFrames = 480;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    // Ends one window in which channel 0 peaked at peak with a constant level of rms
+    // (no levels at all when peak is negative) and returns its published meters
+    emp::ChannelMeterFrame PublishWindow(emp::MeterBank& meters, float peak, float rms)
+    {
+        if (peak >= 0.0f) meters.Accumulate(0, peak, rms * rms * kCycleFrames);
+        meters.EndCycle(1, kCycleFrames);
+        return meters.GetChannel(0);
+    }
+
+    emp::ChannelMeterFrame PublishIdle(emp::MeterBank& meters)
+    {
+        return PublishWindow(meters, -1.0f, 0.0f);
+    }
+
+    // A peak is held for the hold time (two windows here), then the hold follows the meter
+    void TestPeakHold()
+    {
+        emp::MeterBank meters;
+        meters.SetSampleRate(kSampleRate);
+        meters.Configure(kRefreshRateHz, 2.0f * kCycleFrames / kSampleRate);
+        meters.Reserve(1);
+
+        emp::ChannelMeterFrame meter = PublishWindow(meters, 0.8f, 0.5f);
+        Check(meter.peak == 0.8f && meter.rms == 0.5f, "peak hold: window levels published");
+        Check(meter.peakHold == 0.8f, "peak hold: new peak held");
+
+        meter = PublishWindow(meters, 0.1f, 0.05f);
+        Check(meter.peak == 0.1f && meter.peakHold == 0.8f, "peak hold: held after one window");
+        meter = PublishWindow(meters, 0.1f, 0.05f);
+        Check(meter.peakHold == 0.8f, "peak hold: held for the whole hold time");
+        meter = PublishWindow(meters, 0.1f, 0.05f);
+        Check(meter.peakHold == 0.1f, "peak hold: expires and follows the meter");
+
+        meter = PublishWindow(meters, 0.3f, 0.05f);
+        Check(meter.peakHold == 0.3f, "peak hold: a higher peak replaces the hold at once");
+    }
+
+    // Every window that reaches full scale counts once; a reset applies on the next publish
+    void TestClipCounting()
+    {
+        emp::MeterBank meters;
+        meters.SetSampleRate(kSampleRate);
+        meters.Configure(kRefreshRateHz, 0.0f);
+        meters.Reserve(1);
+
+        PublishWindow(meters, 1.0f, 0.5f);
+        Check(PublishWindow(meters, 1.25f, 0.5f).clipCount == 2, "clip count: one per clipping window");
+        Check(PublishWindow(meters, 0.99f, 0.5f).clipCount == 2, "clip count: quiet window leaves it");
+        Check(PublishIdle(meters).clipCount == 2, "clip count: kept while idle");
+
+        meters.ResetClipCounters();
+        Check(meters.GetChannel(0).clipCount == 2, "clip reset: applies on the next publish");
+        Check(PublishWindow(meters, 1.0f, 0.5f).clipCount == 1, "clip reset: clears before counting the window");
+        Check(PublishWindow(meters, 0.5f, 0.5f).clipCount == 1, "clip reset: counting resumes");
+    }
+
+    // Skipped channels fall by kIdleDecay per publish and read zero below kIdleFloor
+    void TestIdleDecay()
+    {
+        emp::MeterBank meters;
+        meters.SetSampleRate(kSampleRate);
+        meters.Configure(kRefreshRateHz, 0.0f);
+        meters.Reserve(1);
+
+        PublishWindow(meters, 0.5f, 0.25f);
+
+        float peak = 0.5f;
+        float rms = 0.25f;
+        bool decayed = true;
+        int publishes = 0;
+        while (peak > 0.0f || rms > 0.0f) {
+            peak *= emp::MeterBank::kIdleDecay;
+            rms *= emp::MeterBank::kIdleDecay;
+            if (peak < emp::MeterBank::kIdleFloor) peak = 0.0f;
+            if (rms < emp::MeterBank::kIdleFloor) rms = 0.0f;
+
+            const emp::ChannelMeterFrame meter = PublishIdle(meters);
+            decayed = decayed && meter.peak == peak && meter.rms == rms && meter.peakHold == peak;
+            publishes++;
+        }
+        Check(decayed, "idle decay: falls by kIdleDecay per publish");
+        Check(publishes == 10, "idle decay: reaches zero below kIdleFloor");
+
+        const emp::ChannelMeterFrame meter = PublishIdle(meters);
+        Check(meter.peak == 0.0f && meter.rms == 0.0f, "idle decay: stays at zero");
+
+        Check(PublishWindow(meters, 0.2f, 0.1f).peak == 0.2f, "idle decay: levels resume at once");
+    }
+
+    // One copy carries every channel with a new sequence per publish
+    void TestCopyTo()
+    {
+        emp::MeterBank meters;
+        meters.SetSampleRate(kSampleRate);
+        meters.Configure(kRefreshRateHz, 0.0f);
+        meters.Reserve(3);
+
+        meters.Accumulate(0, 0.5f, 0.0f);
+        meters.Accumulate(2, 1.0f, 0.0f);
+        meters.EndCycle(3, kCycleFrames / 2);
+
+        float values[3 * emp::MeterBank::kValuesPerChannel] = {};
+        uint64_t sequence = 1;
+        meters.CopyTo(values, 3 * emp::MeterBank::kValuesPerChannel, &sequence);
+        Check(sequence == 0, "copy: nothing published before the refresh interval");
+
+        meters.EndCycle(3, kCycleFrames / 2);
+        const int count = meters.CopyTo(values, 3 * emp::MeterBank::kValuesPerChannel, &sequence);
+        Check(count == 3 && sequence == 1, "copy: all channels of the first publish");
+        Check(values[0] == 0.5f && values[4] == 0.0f && values[8] == 1.0f && values[11] == 1.0f,
+              "copy: peak and clip count per channel");
+
+        Check(meters.CopyTo(values, 2 * emp::MeterBank::kValuesPerChannel) == 2, "copy: limited by capacity");
+    }
+}
+
+int main()
+{
+    TestPeakHold();
+    TestClipCounting();
+    TestIdleDecay();
+    TestCopyTo();
+
+    if (g_failures > 0) std::printf("%d meter bank check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+// Feeds synthetic JACK notifications into PortGraphCache and checks the change log a
+// reader fetches with GetChanges(): incremental diffs, the full snapshot once the log no
+// longer reaches back, stale notifications resolved through the resync source, and the
+// diff Reset() logs against the previous graph.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../PortGraphCache.h"
+
+namespace {
+
+    // JackPortIsInput / JackPortIsOutput
+    constexpr uint32_t kInput = 0x1;
+    constexpr uint32_t kOutput = 0x2;
+
+    const char* const kAudio = "32 bit float mono audio";
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    struct Expected
+    {
+        emp::PortGraphChangeKind kind;
+        const char* portName;
+        const char* otherPortName;
+    };
+
+    bool Matches(const std::vector<emp::PortGraphChange>& changes, const std::vector<Expected>& expected)
+    {
+        if (changes.size() != expected.size()) return false;
+        for (size_t i = 0; i < changes.size(); i++) {
+            if (changes[i].kind != expected[i].kind || changes[i].portName != expected[i].portName ||
+                changes[i].otherPortName != expected[i].otherPortName) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool VersionsAscend(const std::vector<emp::PortGraphChange>& changes, uint64_t after)
+    {
+        for (const emp::PortGraphChange& change : changes) {
+            if (change.version != after + 1) return false;
+            after = change.version;
+        }
+        return true;
+    }
+
+    // Registrations, connections, a rename and an unregistration, read back incrementally
+    void TestIncrementalChanges()
+    {
+        using Kind = emp::PortGraphChangeKind;
+
+        emp::PortGraphCache cache;
+        cache.Reset({ { "system:capture_1", kAudio, kOutput, {} },
+                      { "system:playback_1", kAudio, kInput, {} } });
+        Check(cache.IsSeeded() && cache.GetVersion() == 2, "seed: one change per port");
+
+        std::vector<emp::PortGraphChange> changes;
+        bool fullSnapshot = true;
+        uint64_t version = cache.GetChanges(2, changes, fullSnapshot);
+        Check(version == 2 && changes.empty() && !fullSnapshot, "no changes at the current version");
+
+        cache.OnPortRegistered("mixer:in_1", kAudio, kInput);
+        cache.OnPortRegistered("mixer:out_1", kAudio, kOutput);
+        cache.OnPortsConnected("system:capture_1", "mixer:in_1", true);
+        cache.OnPortsConnected("mixer:out_1", "system:playback_1", true);
+        cache.OnPortsConnected("mixer:out_1", "system:playback_1", true);
+
+        version = cache.GetChanges(2, changes, fullSnapshot);
+        Check(!fullSnapshot && version == 6 && VersionsAscend(changes, 2) &&
+              Matches(changes, { { Kind::PortAdded, "mixer:in_1", "" },
+                                 { Kind::PortAdded, "mixer:out_1", "" },
+                                 { Kind::Connected, "system:capture_1", "mixer:in_1" },
+                                 { Kind::Connected, "mixer:out_1", "system:playback_1" } }),
+              "registrations and connections logged once each");
+        Check(changes[1].type == kAudio && changes[1].flags == kOutput, "added ports carry type and flags");
+
+        cache.OnPortRenamed("mixer:in_1", "mixer:vocals");
+        cache.OnPortUnregistered("mixer:out_1");
+
+        version = cache.GetChanges(6, changes, fullSnapshot);
+        Check(version == 9 &&
+              Matches(changes, { { Kind::PortRenamed, "mixer:vocals", "mixer:in_1" },
+                                 { Kind::Disconnected, "mixer:out_1", "system:playback_1" },
+                                 { Kind::PortRemoved, "mixer:out_1", "" } }),
+              "rename, then removal reports its connections first");
+
+        bool connected = false;
+        Check(cache.TryGetConnected("system:capture_1", "mixer:vocals", connected) && connected,
+              "renamed port keeps its connections");
+        Check(!cache.TryGetConnected("mixer:out_1", "system:playback_1", connected), "removed port unknown");
+
+        // JACK's disconnect notification for the removed port arrives after the removal
+        cache.OnPortsConnected("mixer:out_1", "system:playback_1", false);
+        Check(cache.GetVersion() == 9, "late disconnect of a removed port ignored");
+    }
+
+    // A reader further behind than the log gets the whole graph
+    void TestFullSnapshot()
+    {
+        emp::PortGraphCache cache;
+        cache.Reset({ { "system:capture_1", kAudio, kOutput, {} },
+                      { "mixer:in_1", kAudio, kInput, {} } });
+        cache.OnPortsConnected("system:capture_1", "mixer:in_1", true);
+
+        for (size_t i = 0; i < emp::PortGraphCache::kMaxLogEntries; i++) {
+            cache.OnPortsConnected("system:capture_1", "mixer:in_1", i % 2 != 0);
+        }
+
+        std::vector<emp::PortGraphChange> changes;
+        bool fullSnapshot = false;
+        const uint64_t version = cache.GetChanges(1, changes, fullSnapshot);
+
+        using Kind = emp::PortGraphChangeKind;
+        Check(fullSnapshot && version == 3 + emp::PortGraphCache::kMaxLogEntries &&
+              Matches(changes, { { Kind::PortAdded, "mixer:in_1", "" },
+                                 { Kind::PortAdded, "system:capture_1", "" },
+                                 { Kind::Connected, "system:capture_1", "mixer:in_1" } }),
+              "snapshot once the log no longer reaches back");
+
+        cache.GetChanges(version + 5, changes, fullSnapshot);
+        Check(fullSnapshot, "snapshot for a version from another graph");
+
+        cache.GetChanges(version - 1, changes, fullSnapshot);
+        Check(!fullSnapshot && changes.size() == 1, "incremental within the log");
+    }
+
+    // A notification the cache cannot apply marks it stale; the next read resynchronizes
+    // and Reset() logs the difference to the re-enumerated graph
+    void TestResync()
+    {
+        using Kind = emp::PortGraphChangeKind;
+
+        emp::PortGraphCache cache;
+        cache.Reset({ { "system:capture_1", kAudio, kOutput, { "mixer:in_1" } },
+                      { "system:capture_2", kAudio, kOutput, {} },
+                      { "mixer:in_1", kAudio, kInput, { "system:capture_1" } } });
+        const uint64_t seeded = cache.GetVersion();
+
+        // The server's graph after notifications the cache missed
+        const std::vector<emp::PortGraphPort> server = {
+            { "system:capture_1", kAudio, kOutput, {} },
+            { "system:capture_2", kAudio, kOutput, { "mixer:in_1" } },
+            { "mixer:in_1", kAudio, kInput, { "system:capture_2" } },
+            { "mixer:in_2", kAudio, kInput, {} },
+        };
+        int resyncs = 0;
+        cache.SetResyncSource([&](emp::PortGraphCache& target) {
+            resyncs++;
+            target.Reset(server);
+        });
+
+        cache.OnPortsConnected("system:capture_2", "mixer:unknown", true);
+        bool connected = false;
+        Check(!cache.TryGetConnected("system:capture_1", "mixer:in_1", connected), "stale cache refuses lookups");
+
+        std::vector<emp::PortGraphChange> changes;
+        bool fullSnapshot = true;
+        cache.GetChanges(seeded, changes, fullSnapshot);
+        Check(resyncs == 1 && !fullSnapshot &&
+              Matches(changes, { { Kind::PortAdded, "mixer:in_2", "" },
+                                 { Kind::Disconnected, "system:capture_1", "mixer:in_1" },
+                                 { Kind::Connected, "system:capture_2", "mixer:in_1" } }),
+              "resync logs the difference to the server's graph");
+        Check(cache.TryGetConnected("system:capture_2", "mixer:in_1", connected) && connected, "lookups resume after resync");
+
+        cache.GetVersion();
+        Check(resyncs == 1, "no further resync once current");
+
+        cache.OnPortRenamed("mixer:missing", "mixer:other");
+        cache.GetVersion();
+        Check(resyncs == 2, "unresolvable rename triggers a resync");
+    }
+}
+
+int main()
+{
+    TestIncrementalChanges();
+    TestFullSnapshot();
+    TestResync();
+
+    if (g_failures > 0) std::printf("%d port graph check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,405 @@
+// Round-trips frames through SharedMemoryRing and SharedMemoryTransport and checks them
+// against the byte layout documented in CommunicationProtocol.md ("Shared-Memory Frame
+// Transport"), read and written through a separate raw mapping of the same name the way
+// the managed SharedMemoryRing sees it: header offsets, frame headers, slot wraparound,
+// the full ring, a header rewritten by the peer, the Meters and ParameterChanges payloads
+// and a TimedParameterChanges burst larger than the engine's command queue.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../OfflineRenderer.h"
+#include "../SharedMemoryRing.h"
+#include "../SharedMemoryTransport.h"
+
+namespace {
+
+    // Documented layout
+    constexpr size_t kMagicOffset = 0;
+    constexpr size_t kLayoutVersionOffset = 4;
+    constexpr size_t kSlotCountOffset = 8;
+    constexpr size_t kSlotSizeOffset = 12;
+    constexpr size_t kWriteIndexOffset = 64;
+    constexpr size_t kReadIndexOffset = 128;
+    constexpr size_t kDroppedFramesOffset = 192;
+    constexpr size_t kSlotsOffset = 256;
+    constexpr size_t kFrameHeaderSize = 16;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    // Unique per process so parallel test runs do not share a ring
+    std::string RingName(const char* suffix)
+    {
+#ifdef _WIN32
+        const unsigned long pid = GetCurrentProcessId();
+#else
+        const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+        return "emp_ring_test_" + std::to_string(pid) + "_" + suffix;
+    }
+
+    // Plain view of an existing mapping, independent of SharedMemoryRing
+    class RawMapping
+    {
+    public:
+        explicit RawMapping(const std::string& name)
+        {
+#ifdef _WIN32
+            _handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+            if (_handle == nullptr) return;
+            _base = static_cast<unsigned char*>(MapViewOfFile(_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+#else
+            const int fd = shm_open(("/" + name).c_str(), O_RDWR, 0600);
+            if (fd < 0) return;
+
+            struct stat info;
+            if (fstat(fd, &info) == 0) {
+                _size = static_cast<size_t>(info.st_size);
+                void* view = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (view != MAP_FAILED) _base = static_cast<unsigned char*>(view);
+            }
+            close(fd);
+#endif
+        }
+
+        ~RawMapping()
+        {
+#ifdef _WIN32
+            if (_base != nullptr) UnmapViewOfFile(_base);
+            if (_handle != nullptr) CloseHandle(_handle);
+#else
+            if (_base != nullptr) munmap(_base, _size);
+#endif
+        }
+
+        RawMapping(const RawMapping&) = delete;
+        RawMapping& operator=(const RawMapping&) = delete;
+
+        bool IsOpen() const { return _base != nullptr; }
+
+        template <typename T>
+        T Get(size_t offset) const
+        {
+            T value;
+            std::memcpy(&value, _base + offset, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void Set(size_t offset, T value)
+        {
+            std::memcpy(_base + offset, &value, sizeof(T));
+        }
+
+        unsigned char* At(size_t offset) { return _base + offset; }
+
+        size_t SlotOffset(uint64_t index) const
+        {
+            const uint32_t slotCount = Get<uint32_t>(kSlotCountOffset);
+            return kSlotsOffset + static_cast<size_t>(index & (slotCount - 1)) * Get<uint32_t>(kSlotSizeOffset);
+        }
+
+    private:
+        unsigned char* _base = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        HANDLE _handle = nullptr;
+#endif
+    };
+
+    // Header fields land at the documented offsets
+    void TestHeaderLayout()
+    {
+        const std::string name = RingName("header");
+        emp::SharedMemoryRing ring;
+        Check(ring.Create(name, 8, 100), "header: ring created");
+
+        RawMapping raw(name);
+        Check(raw.IsOpen(), "header: mapping opened by name");
+        if (!raw.IsOpen()) return;
+
+        Check(raw.Get<uint32_t>(kMagicOffset) == 0x524D5045, "header: magic at 0");
+        Check(raw.Get<uint32_t>(kLayoutVersionOffset) == 1, "header: layout version 1 at 4");
+        Check(raw.Get<uint32_t>(kSlotCountOffset) == 8, "header: slot count at 8");
+        Check(raw.Get<uint32_t>(kSlotSizeOffset) == 104, "header: slot size at 12, rounded to 8 bytes");
+        Check(ring.GetMaxPayload() == 104 - kFrameHeaderSize, "header: payload is the slot less the frame header");
+
+        const unsigned char payload[] = { 1, 2, 3, 4, 5 };
+        ring.TryWrite(7, payload, sizeof(payload));
+        Check(raw.Get<uint64_t>(kWriteIndexOffset) == 1 && raw.Get<uint64_t>(kReadIndexOffset) == 0,
+              "header: write index at 64, read index at 128");
+
+        emp::SharedMemoryRing reader;
+        Check(reader.Open(name), "header: second handle opens the ring");
+        uint32_t type = 0;
+        unsigned char buffer[16];
+        reader.TryRead(type, buffer, sizeof(buffer));
+        Check(raw.Get<uint64_t>(kReadIndexOffset) == 1, "header: read index advanced by the consumer");
+
+        // A mapping from another layout version is refused
+        raw.Set<uint32_t>(kLayoutVersionOffset, 2);
+        emp::SharedMemoryRing mismatched;
+        Check(!mismatched.Open(name), "header: other layout version refused");
+        raw.Set<uint32_t>(kLayoutVersionOffset, 1);
+    }
+
+    // Frames written natively appear in the slots as documented, and frames written into
+    // the slots by hand (as the managed side does) read back natively, across wraparound
+    void TestFrameRoundTrip()
+    {
+        const std::string name = RingName("frames");
+        emp::SharedMemoryRing ring;
+        ring.Create(name, 4, 64);
+        RawMapping raw(name);
+        if (!raw.IsOpen()) {
+            Check(false, "frames: mapping opened by name");
+            return;
+        }
+
+        bool native = true;
+        bool foreign = true;
+        for (uint64_t i = 0; i < 11; i++) {
+            // Native producer, raw consumer
+            uint32_t payload[3] = { static_cast<uint32_t>(i), 0xABCD0000u + static_cast<uint32_t>(i), 42 };
+            const uint32_t length = static_cast<uint32_t>(sizeof(uint32_t) * (1 + i % 3));
+            native = native && ring.TryWrite(static_cast<uint32_t>(emp::SharedFrameType::ParameterChanges), payload, length);
+
+            const uint64_t read = raw.Get<uint64_t>(kReadIndexOffset);
+            const size_t slot = raw.SlotOffset(read);
+            native = native && raw.Get<uint64_t>(slot) == read + 1 &&
+                     raw.Get<uint32_t>(slot + 8) == static_cast<uint32_t>(emp::SharedFrameType::ParameterChanges) &&
+                     raw.Get<uint32_t>(slot + 12) == length &&
+                     std::memcmp(raw.At(slot + kFrameHeaderSize), payload, length) == 0;
+            raw.Set<uint64_t>(kReadIndexOffset, read + 1);
+
+            // Raw producer, native consumer
+            const uint64_t write = raw.Get<uint64_t>(kWriteIndexOffset);
+            const size_t target = raw.SlotOffset(write);
+            const float values[2] = { 0.25f * i, -1.0f };
+            raw.Set<uint64_t>(target, write + 1);
+            raw.Set<uint32_t>(target + 8, static_cast<uint32_t>(emp::SharedFrameType::Meters));
+            raw.Set<uint32_t>(target + 12, sizeof(values));
+            std::memcpy(raw.At(target + kFrameHeaderSize), values, sizeof(values));
+            raw.Set<uint64_t>(kWriteIndexOffset, write + 1);
+
+            uint32_t type = 0;
+            float received[2] = {};
+            uint64_t sequence = 0;
+            foreign = foreign && ring.TryRead(type, received, sizeof(received), &sequence) == static_cast<int>(sizeof(values)) &&
+                      type == static_cast<uint32_t>(emp::SharedFrameType::Meters) && sequence == write + 1 &&
+                      received[0] == values[0] && received[1] == values[1];
+        }
+        Check(native, "frames: native writes match the documented slot layout");
+        Check(foreign, "frames: frames written at the documented offsets read back");
+        Check(raw.Get<uint64_t>(kWriteIndexOffset) == 22, "frames: indices run past the slot count");
+
+        // An oversized frame is skipped, not truncated
+        uint32_t type = 0;
+        unsigned char big[40] = {};
+        unsigned char small[8];
+        ring.TryWrite(2, big, sizeof(big));
+        ring.TryWrite(2, big, 4);
+        Check(ring.TryRead(type, small, sizeof(small)) == -1 && ring.TryRead(type, small, sizeof(small)) == 4,
+              "frames: frame larger than the buffer skipped");
+        Check(!ring.TryWrite(2, big, ring.GetMaxPayload() + 1), "frames: payload larger than a slot rejected");
+    }
+
+    // A full ring rejects and counts frames until the consumer frees a slot
+    void TestFullRing()
+    {
+        const std::string name = RingName("full");
+        emp::SharedMemoryRing ring;
+        ring.Create(name, 4, 32);
+        RawMapping raw(name);
+
+        bool accepted = true;
+        for (uint32_t i = 0; i < 4; i++) accepted = accepted && ring.TryWrite(1, &i, sizeof(i));
+        Check(accepted, "full: accepts one frame per slot");
+
+        const uint32_t extra = 99;
+        Check(!ring.TryWrite(1, &extra, sizeof(extra)) && !ring.TryWrite(1, &extra, sizeof(extra)), "full: further frames rejected");
+        Check(ring.GetDroppedCount() == 2 && raw.IsOpen() && raw.Get<uint64_t>(kDroppedFramesOffset) == 2,
+              "full: drops counted at offset 192");
+
+        uint32_t type = 0;
+        uint32_t value = 0;
+        ring.TryRead(type, &value, sizeof(value));
+        Check(value == 0 && ring.TryWrite(1, &extra, sizeof(extra)), "full: a read frees a slot");
+    }
+
+    // The geometry is taken from the header once: a peer rewriting it afterwards cannot
+    // move either side's slots past the mapping
+    void TestHeaderRewritten()
+    {
+        const std::string name = RingName("rewritten");
+        emp::SharedMemoryRing owner;
+        owner.Create(name, 4, 32);
+        emp::SharedMemoryRing peer;
+        Check(peer.Open(name), "rewritten: opened");
+
+        RawMapping raw(name);
+        if (raw.IsOpen()) {
+            raw.Set<uint32_t>(kSlotCountOffset, 1u << 30);
+            raw.Set<uint32_t>(kSlotSizeOffset, 1u << 30);
+        }
+
+        bool intact = owner.GetMaxPayload() == 16 && peer.GetMaxPayload() == 16;
+        for (uint32_t i = 0; intact && i < 10; i++) {
+            uint32_t type = 0;
+            uint32_t value = 0;
+            intact = owner.TryWrite(1, &i, sizeof(i)) && peer.TryRead(type, &value, sizeof(value)) == sizeof(value) && value == i;
+        }
+        for (uint32_t i = 0; intact && i < 4; i++) intact = owner.TryWrite(1, &i, sizeof(i));
+        Check(intact && !owner.TryWrite(1, &intact, sizeof(intact)), "rewritten: both sides keep the slots they validated");
+
+        emp::SharedMemoryRing late;
+        Check(!late.Open(name), "rewritten: a header larger than the mapping is refused");
+    }
+
+    // The transport's rings carry Meters frames out and ParameterChanges frames in
+    void TestTransport()
+    {
+        emp::OfflineRenderer renderer(3, 2, 256, 48000);
+        renderer.GenerateTestSignals(5, 1000);
+        emp::MixEngine& engine = renderer.Engine();
+
+        const std::string name = RingName("transport");
+        emp::SharedMemoryTransport transport(engine);
+        Check(transport.Start(name, 8, 256), "transport: started");
+
+        // UI side: one ParameterChanges frame of {int32 channel, int32 parameter, float value}
+        RawMapping toEngine(name + "_UiToEngine");
+        if (toEngine.IsOpen()) {
+            struct { int32_t channel; int32_t parameter; float value; } changes[2] = { { 1, 0, 0.25f }, { 2, 3, 1.0f } };
+            const size_t slot = toEngine.SlotOffset(0);
+            toEngine.Set<uint64_t>(slot, 1);
+            toEngine.Set<uint32_t>(slot + 8, 2);
+            toEngine.Set<uint32_t>(slot + 12, sizeof(changes));
+            std::memcpy(toEngine.At(slot + kFrameHeaderSize), changes, sizeof(changes));
+            toEngine.Set<uint64_t>(kWriteIndexOffset, 1);
+        }
+
+        bool applied = false;
+        for (int attempt = 0; attempt < 500 && !applied; attempt++) {
+            applied = engine.Parameters().GetChannel(1).volume == 0.25f && engine.Parameters().GetChannel(2).mute;
+            if (!applied) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        Check(applied && transport.GetFramesReceived() == 1, "transport: parameter changes frame applied as a batch");
+
+        // Render past a few meter publishes; the last Meters frame must carry the final meters
+        renderer.Render(48000 / 10, [](emp::OfflineRenderer&) {});
+        float expected[3 * emp::MeterBank::kValuesPerChannel];
+        engine.Meters().CopyTo(expected, 3 * emp::MeterBank::kValuesPerChannel);
+
+        RawMapping toUi(name + "_EngineToUi");
+        bool published = false;
+        size_t slot = 0;
+        for (int attempt = 0; attempt < 500 && !published && toUi.IsOpen(); attempt++) {
+            const uint64_t written = toUi.Get<uint64_t>(kWriteIndexOffset);
+            if (written > 0) {
+                slot = toUi.SlotOffset(written - 1);
+                published = std::memcmp(toUi.At(slot + kFrameHeaderSize + 8), expected, sizeof(expected)) == 0;
+            }
+            if (!published) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        Check(published, "transport: meters frame carries peak, rms, hold and clips per channel");
+
+        if (published) {
+            const uint32_t channels = toUi.Get<uint32_t>(slot + kFrameHeaderSize);
+            const uint32_t valuesPerChannel = toUi.Get<uint32_t>(slot + kFrameHeaderSize + 4);
+            Check(toUi.Get<uint32_t>(slot + 8) == 1 && channels == 3 && valuesPerChannel == 4 &&
+                  toUi.Get<uint32_t>(slot + 12) == 8 + channels * valuesPerChannel * sizeof(float),
+                  "transport: meters frame header and prefix");
+        }
+
+        transport.Stop();
+    }
+
+    // A burst of timed changes larger than the command queue is waited out, not dropped,
+    // and takes no acknowledgement slots from other posters
+    void TestTransportTimedBurst()
+    {
+        emp::OfflineRenderer renderer(1, 2, 256, 48000);
+        renderer.SetInput(0, std::vector<float>(256, 1.0f));
+        emp::MixEngine& engine = renderer.Engine();
+
+        const std::string name = RingName("timed");
+        emp::SharedMemoryTransport transport(engine);
+        Check(transport.Start(name, 64, 1024), "timed burst: transport started");
+
+        emp::SharedMemoryRing ui;
+        Check(ui.Open(name + "_UiToEngine"), "timed burst: UI side opened");
+
+        // Full volume throughout, then a quarter with the very last change
+        constexpr int kChanges = static_cast<int>(emp::EngineCommandQueue::kCapacity) + 200;
+        std::vector<emp::TimedParameterChange> changes(kChanges, { 0, { 0, emp::ParameterId::Volume, 1.0f }, emp::RampShape::Step, 0 });
+        changes.back().change.value = 0.25f;
+
+        const int perFrame = static_cast<int>(ui.GetMaxPayload() / sizeof(emp::TimedParameterChange));
+        int frames = 0;
+        bool written = ui.IsOpen();
+        for (int first = 0; written && first < kChanges; first += perFrame) {
+            const int count = std::min(perFrame, kChanges - first);
+            written = ui.TryWrite(static_cast<uint32_t>(emp::SharedFrameType::TimedParameterChanges), &changes[first],
+                                  static_cast<uint32_t>(count * sizeof(emp::TimedParameterChange)));
+            frames++;
+        }
+        Check(written, "timed burst: every frame fits the ring");
+
+        // The engine drains the queue while the worker waits for room
+        bool applied = false;
+        for (int attempt = 0; attempt < 2000 && !applied; attempt++) {
+            renderer.RenderBlock();
+            applied = renderer.GetOutput(0)[255] == 0.125f && transport.GetFramesReceived() == static_cast<uint64_t>(frames);
+            if (!applied) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        Check(applied, "timed burst: the last change applied");
+        emp::EngineCompletion completion;
+        Check(engine.Commands().ReadCompletions(&completion, 1) == 0 && engine.Commands().GetDroppedCompletions() == 0,
+              "timed burst: no acknowledgements queued");
+
+        ui.Close();
+        transport.Stop();
+    }
+}
+
+int main()
+{
+    TestHeaderLayout();
+    TestFrameRoundTrip();
+    TestFullRing();
+    TestHeaderRewritten();
+    TestTransport();
+    TestTransportTimedBurst();
+
+    if (g_failures > 0) std::printf("%d shared memory ring check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
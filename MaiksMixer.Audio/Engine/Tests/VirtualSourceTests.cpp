@@ -0,0 +1,238 @@
+// Checks virtual source clock tracking and the resampler behind it. A simulated device
+// running 200 ppm fast or slow writes stamped packets between engine cycles; the drift
+// loop must measure its rate and hold the buffer at the configured latency without
+// underruns. Pure tones through PolyphaseResampler must come out at their frequency with
+// nothing else in the output, and tones above the output's Nyquist frequency must not
+// alias back into the band.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../MixKernels.h"
+#include "../PolyphaseResampler.h"
+#include "../VirtualSources.h"
+
+namespace {
+
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr uint32_t kGraphRate = 48000;
+    constexpr uint32_t kCycleFrames = 256;
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) {
+            std::printf("ok   %s\n", what);
+            return;
+        }
+        std::printf("FAIL %s\n", what);
+        g_failures++;
+    }
+
+    void CheckBelow(double value, double limit, const char* what)
+    {
+        if (value < limit) {
+            std::printf("ok   %s (%.2f)\n", what, value);
+            return;
+        }
+        std::printf("FAIL %s (got %.2f, limit %.2f)\n", what, value, limit);
+        g_failures++;
+    }
+
+    // Clock tracking against a device whose clock is off by ppm: packets complete at the
+    // device's rate and are stamped with the graph time they were complete at
+    void TestDriftLoop(double ppm)
+    {
+        constexpr uint32_t kPacketFrames = 48;
+        constexpr double kSeconds = 60.0;
+        constexpr double kSettledSeconds = 30.0;
+
+        emp::VirtualSourceBank bank;
+        bank.Reserve(1);
+        bank.SetSampleRate(kGraphRate);
+
+        emp::VirtualSourceConfig config;
+        config.firstChannel = 0;
+        config.channels = 1;
+        config.sampleRate = kGraphRate;
+        const int id = bank.Create(config);
+
+        // Graph frames per device frame
+        const double devicePeriod = 1.0 / (1.0 + ppm * 1e-6);
+        const float* channelTable[1] = { nullptr };
+        std::vector<float> packet(kPacketFrames);
+        uint64_t packets = 0;
+
+        emp::VirtualSourceStatus status;
+        double worstError = 0.0;
+        double errorSum = 0.0;
+        int settledCycles = 0;
+        bool statusRead = true;
+
+        const int cycles = static_cast<int>(kSeconds * kGraphRate / kCycleFrames);
+        for (int cycle = 0; cycle < cycles; cycle++) {
+            const uint64_t frameTime = static_cast<uint64_t>(cycle) * kCycleFrames;
+
+            // Every packet the device finished before this cycle starts
+            for (;;) {
+                const double complete = (packets + 1) * kPacketFrames * devicePeriod;
+                if (complete > static_cast<double>(frameTime)) break;
+                for (uint32_t i = 0; i < kPacketFrames; i++) {
+                    packet[i] = static_cast<float>(std::sin(2.0 * kPi * 440.0 * (packets * kPacketFrames + i) / kGraphRate));
+                }
+                bank.Write(id, packet.data(), kPacketFrames, complete);
+                packets++;
+            }
+
+            // The buffer right after the device's writes, before the cycle reads from it;
+            // the packets' sawtooth averages out over the settled half
+            statusRead = statusRead && bank.GetStatus(id, status);
+            if (cycle * static_cast<double>(kCycleFrames) / kGraphRate >= kSeconds - kSettledSeconds) {
+                const double error = status.fillFrames - status.targetFrames;
+                worstError = std::max(worstError, std::abs(error));
+                errorSum += error;
+                settledCycles++;
+            }
+
+            bank.Render(emp::GetActiveMixKernels(), channelTable, 1, kCycleFrames, frameTime);
+        }
+        statusRead = statusRead && bank.GetStatus(id, status);
+
+        const double meanError = errorSum / settledCycles;
+        const std::string label = (ppm > 0.0 ? "drift +" : "drift ") + std::to_string(static_cast<int>(ppm)) + " ppm: ";
+
+        Check(statusRead && id != 0, (label + "source created and readable").c_str());
+        Check(status.streaming && status.locked, (label + "streaming and locked").c_str());
+        Check(status.underruns == 0 && status.overruns == 0, (label + "no underruns or overruns").c_str());
+        CheckBelow(std::abs(status.driftPpm - ppm), 5.0, (label + "measured drift within 5 ppm").c_str());
+        CheckBelow(std::abs(status.ratio - (1.0 + ppm * 1e-6)) * 1e6, 10.0, (label + "ratio within 10 ppm of the device's").c_str());
+        CheckBelow(std::abs(meanError), 0.25 * kCycleFrames, (label + "mean fill held at the target").c_str());
+        CheckBelow(worstError, kCycleFrames, (label + "fill stays within a cycle of the target").c_str());
+    }
+
+    // Amplitude of the fitted sine at frequency and the RMS of everything else, over the
+    // output past the filter's start-up
+    void FitTone(const std::vector<float>& output, double frequency, double rate, size_t start, double& amplitude,
+                 double& residual)
+    {
+        // Least squares on sin and cos: the two are near orthogonal over many periods
+        double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+        for (size_t i = start; i < output.size(); i++) {
+            const double phase = 2.0 * kPi * frequency * i / rate;
+            const double s = std::sin(phase);
+            const double c = std::cos(phase);
+            ss += s * s;
+            sc += s * c;
+            cc += c * c;
+            ys += output[i] * s;
+            yc += output[i] * c;
+        }
+        const double determinant = ss * cc - sc * sc;
+        const double a = (ys * cc - yc * sc) / determinant;
+        const double b = (yc * ss - ys * sc) / determinant;
+        amplitude = std::sqrt(a * a + b * b);
+
+        double energy = 0.0;
+        for (size_t i = start; i < output.size(); i++) {
+            const double phase = 2.0 * kPi * frequency * i / rate;
+            const double error = output[i] - (a * std::sin(phase) + b * std::cos(phase));
+            energy += error * error;
+        }
+        residual = std::sqrt(energy / (output.size() - start));
+    }
+
+    // Converts one second of a sine at half scale and returns the output
+    std::vector<float> Convert(uint32_t inputRate, uint32_t outputRate, double frequency, emp::ResamplerQuality quality)
+    {
+        constexpr uint32_t kOutputBlock = 256;
+        const double ratio = static_cast<double>(inputRate) / outputRate;
+
+        emp::PolyphaseResampler resampler;
+        resampler.Configure(1, inputRate, outputRate, quality, 2048);
+
+        std::vector<float> output(outputRate);
+        std::vector<float> input;
+        uint64_t consumed = 0;
+        for (size_t done = 0; done + kOutputBlock <= output.size(); done += kOutputBlock) {
+            const uint32_t needed = resampler.GetInputFrames(kOutputBlock, ratio);
+            input.resize(needed);
+            for (uint32_t i = 0; i < needed; i++) {
+                input[i] = static_cast<float>(0.5 * std::sin(2.0 * kPi * frequency * (consumed + i) / inputRate));
+            }
+            consumed += needed;
+
+            float* outputs[] = { output.data() + done };
+            resampler.Process(emp::GetActiveMixKernels(), input.data(), needed, outputs, kOutputBlock, ratio);
+        }
+        output.resize(output.size() / kOutputBlock * kOutputBlock);
+        return output;
+    }
+
+    double Db(double ratio)
+    {
+        return 20.0 * std::log10(std::max(ratio, 1e-12));
+    }
+
+    // A tone inside the passband comes out at its frequency and level with nothing else
+    // above the filter's stopband floor; one above the output's Nyquist frequency is
+    // removed instead of folding back
+    void TestPureTones()
+    {
+        struct Case
+        {
+            uint32_t inputRate;
+            uint32_t outputRate;
+            double frequency;
+            emp::ResamplerQuality quality;
+            double levelDb;         // Passband ripple allowed
+            double floorDb;         // Residual allowed relative to the tone
+            const char* what;
+        };
+
+        const Case passCases[] = {
+            { 44100, 48000, 1000.0, emp::ResamplerQuality::Medium, 0.05, -70.0, "tone 44.1 -> 48 kHz, 1 kHz" },
+            { 48000, 44100, 15000.0, emp::ResamplerQuality::Medium, 0.05, -70.0, "tone 48 -> 44.1 kHz, 15 kHz" },
+            { 96000, 48000, 10000.0, emp::ResamplerQuality::Low, 0.25, -50.0, "tone 96 -> 48 kHz, 10 kHz, low quality" },
+            { 96000, 48000, 10000.0, emp::ResamplerQuality::High, 0.05, -80.0, "tone 96 -> 48 kHz, 10 kHz, high quality" },
+        };
+
+        for (const Case& c : passCases) {
+            const std::vector<float> output = Convert(c.inputRate, c.outputRate, c.frequency, c.quality);
+            double amplitude;
+            double residual;
+            FitTone(output, c.frequency, c.outputRate, 1024, amplitude, residual);
+
+            char what[160];
+            std::snprintf(what, sizeof(what), "%s: level kept (dB)", c.what);
+            CheckBelow(std::abs(Db(amplitude / 0.5)), c.levelDb, what);
+            std::snprintf(what, sizeof(what), "%s: nothing but the tone (dB)", c.what);
+            CheckBelow(Db(residual / (amplitude / std::sqrt(2.0))), c.floorDb, what);
+        }
+
+        // 36 kHz at 96 kHz would alias to 12 kHz at 48 kHz
+        const std::vector<float> output = Convert(96000, 48000, 36000.0, emp::ResamplerQuality::Medium);
+        double aliasAmplitude;
+        double residual;
+        FitTone(output, 12000.0, 48000, 1024, aliasAmplitude, residual);
+        CheckBelow(Db(aliasAmplitude / 0.5), -70.0, "tone above Nyquist: alias at 12 kHz suppressed (dB)");
+
+        double energy = 0.0;
+        for (size_t i = 1024; i < output.size(); i++) energy += static_cast<double>(output[i]) * output[i];
+        CheckBelow(Db(std::sqrt(energy / (output.size() - 1024)) / (0.5 / std::sqrt(2.0))), -70.0,
+                   "tone above Nyquist: nothing else passes (dB)");
+    }
+}
+
+int main()
+{
+    TestDriftLoop(200.0);
+    TestDriftLoop(-200.0);
+    TestPureTones();
+
+    if (g_failures > 0) std::printf("%d virtual source check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
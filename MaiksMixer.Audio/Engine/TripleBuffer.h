@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace emp {
+
+    /// <summary>
+    /// Wait-free single-writer/single-reader triple buffer. The writer fills WriteBuffer()
+    /// and publishes it; the reader always gets the most recently published buffer with a
+    /// single atomic exchange, never blocking and never seeing a partially written value.
+    /// Storage is preallocated, so neither side allocates once the buffers are sized.
+    /// </summary>
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer()
+            : _middle(1), _back(2), _front(0)
+        {
+        }
+
+        /// <summary>
+        /// Applies fn to all three buffers (for sizing). Neither side may be active.
+        /// </summary>
+        template <typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (auto& buffer : _buffers) {
+                fn(buffer);
+            }
+
+            _front = 0;
+            _middle.store(1, std::memory_order_release);
+            _back = 2;
+        }
+
+        /// <summary>
+        /// Buffer the writer fills before calling Publish()
+        /// </summary>
+        T& WriteBuffer() { return _buffers[_back]; }
+
+        /// <summary>
+        /// Makes the write buffer the latest value and hands the writer a free buffer
+        /// </summary>
+        void Publish()
+        {
+            _back = _middle.exchange(_back | kDirtyFlag, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        /// <summary>
+        /// Returns the latest published buffer (reader side)
+        /// </summary>
+        const T& Read()
+        {
+            if (_middle.load(std::memory_order_relaxed) & kDirtyFlag) {
+                _front = _middle.exchange(_front, std::memory_order_acq_rel) & kIndexMask;
+            }
+
+            return _buffers[_front];
+        }
+
+        /// <summary>
+        /// Returns true if a buffer has been published since the reader last called Read()
+        /// </summary>
+        bool HasUpdate() const
+        {
+            return (_middle.load(std::memory_order_relaxed) & kDirtyFlag) != 0;
+        }
+
+    private:
+        static constexpr uint32_t kIndexMask = 0x3;
+        static constexpr uint32_t kDirtyFlag = 0x4;
+
+        std::array<T, 3> _buffers;
+
+        // Index of the latest published buffer, tagged with kDirtyFlag until consumed
+        std::atomic<uint32_t> _middle;
+        uint32_t _back;     // Owned by the writer
+        uint32_t _front;    // Owned by the reader
+    };
+}
@@ -0,0 +1,334 @@
+#include "VirtualSources.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace emp {
+
+    namespace {
+
+        constexpr double kPi = 3.14159265358979323846;
+
+        // Fill estimates are smoothed this many times above the loop bandwidth, which takes
+        // most of the stamps' jitter out of the ratio without slowing the loop
+        constexpr double kMeasurementBandwidthScale = 8.0;
+
+        // Widest resampler window, read ahead of the frames a cycle consumes
+        constexpr uint32_t kMaxTaps = 64;
+
+        // Attempts at reading a write stamp before the previous one is reused
+        constexpr int kStampRetries = 4;
+
+        int64_t SteadyNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    // Constructor
+    VirtualSourceBank::VirtualSourceBank()
+        : _clockSequence(0), _clockFrame(0), _clockNanoseconds(0), _numChannels(0), _sampleRate(48000), _nextId(1)
+    {
+    }
+
+    // Destructor
+    VirtualSourceBank::~VirtualSourceBank() = default;
+
+    // Reserve
+    void VirtualSourceBank::Reserve(int numChannels)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        _numChannels = std::max(numChannels, 0);
+        PublishLocked({});
+    }
+
+    // Set Sample Rate
+    void VirtualSourceBank::SetSampleRate(uint32_t sampleRate)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        if (sampleRate == 0 || sampleRate == _sampleRate) return;
+        _sampleRate = sampleRate;
+
+        const SourceSet* current = _set.Get();
+        if (current == nullptr) return;
+
+        std::vector<std::shared_ptr<Source>> sources;
+        for (const auto& source : current->sources) {
+            sources.push_back(Build(source->id, source->config));
+        }
+        PublishLocked(std::move(sources));
+    }
+
+    // Create
+    int VirtualSourceBank::Create(const VirtualSourceConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        if (config.channels < 1 || config.channels > kMaxSourceChannels) return 0;
+        if (config.firstChannel < 0 || config.firstChannel + config.channels > _numChannels) return 0;
+        if (config.sampleRate < 8000 || config.sampleRate > 384000) return 0;
+
+        std::vector<std::shared_ptr<Source>> sources;
+        if (const SourceSet* current = _set.Get()) sources = current->sources;
+        if (static_cast<int>(sources.size()) >= kMaxSources) return 0;
+
+        for (const auto& source : sources) {
+            const int first = source->config.firstChannel;
+            if (config.firstChannel < first + source->config.channels && first < config.firstChannel + config.channels) return 0;
+        }
+
+        const int id = _nextId++;
+        sources.push_back(Build(id, config));
+        PublishLocked(std::move(sources));
+        return id;
+    }
+
+    // Remove
+    bool VirtualSourceBank::Remove(int id)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        if (Find(id) == nullptr) return false;
+
+        std::vector<std::shared_ptr<Source>> sources = _set.Get()->sources;
+        sources.erase(std::remove_if(sources.begin(), sources.end(),
+                                     [id](const std::shared_ptr<Source>& source) { return source->id == id; }),
+                      sources.end());
+        PublishLocked(std::move(sources));
+        return true;
+    }
+
+    // Get Channels
+    int VirtualSourceBank::GetChannels(int id) const
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        const Source* source = Find(id);
+        return source != nullptr ? source->config.channels : 0;
+    }
+
+    // Write
+    bool VirtualSourceBank::Write(int id, const float* interleaved, uint32_t frames)
+    {
+        // Graph time now, extrapolated from the start of the last cycle
+        uint32_t sequence;
+        uint64_t frame;
+        int64_t started;
+        do {
+            sequence = _clockSequence.load(std::memory_order_acquire);
+            frame = _clockFrame.load(std::memory_order_relaxed);
+            started = _clockNanoseconds.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) != 0 || sequence != _clockSequence.load(std::memory_order_relaxed));
+
+        uint32_t sampleRate;
+        {
+            std::lock_guard<std::mutex> lock(_controlMutex);
+            sampleRate = _sampleRate;
+        }
+        const double graphTime = frame + (SteadyNanoseconds() - started) * 1e-9 * sampleRate;
+        return Write(id, interleaved, frames, graphTime);
+    }
+
+    // Write with a graph time
+    bool VirtualSourceBank::Write(int id, const float* interleaved, uint32_t frames, double graphTime)
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        Source* source = Find(id);
+        if (source == nullptr) return false;
+
+        if (!source->ring.TryWrite(interleaved, static_cast<size_t>(frames) * source->config.channels)) {
+            source->overruns.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        source->writtenFrames += frames;
+        const uint32_t sequence = source->stampSequence.load(std::memory_order_relaxed);
+        source->stampSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        source->stampFrames.store(source->writtenFrames, std::memory_order_relaxed);
+        source->stampTime.store(graphTime, std::memory_order_relaxed);
+        source->stampSequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+    // Get Status
+    bool VirtualSourceBank::GetStatus(int id, VirtualSourceStatus& status) const
+    {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+
+        const Source* source = Find(id);
+        if (source == nullptr) return false;
+
+        status.streaming = source->streamingFlag.load(std::memory_order_relaxed);
+        status.locked = source->lockedFlag.load(std::memory_order_relaxed);
+        status.ratio = source->ratio.load(std::memory_order_relaxed);
+        status.driftPpm = source->drift.load(std::memory_order_relaxed) * 1e6;
+        status.fillFrames = static_cast<float>(source->ring.GetPendingCount() / source->config.channels);
+        status.targetFrames = static_cast<float>(source->targetFrames);
+        status.underruns = source->underruns.load(std::memory_order_relaxed);
+        status.overruns = source->overruns.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    // Render (real-time thread)
+    void VirtualSourceBank::Render(const MixKernels& kernels, const float** channelTable, int numChannels, uint32_t nframes,
+                                   uint64_t frameTime)
+    {
+        RcuDomain::ReadScope cycleScope(_rcu);
+
+        SourceSet* set = _set.Load();
+        if (set == nullptr || set->sources.empty()) return;
+
+        const uint32_t sequence = _clockSequence.load(std::memory_order_relaxed);
+        _clockSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _clockFrame.store(frameTime, std::memory_order_relaxed);
+        _clockNanoseconds.store(SteadyNanoseconds(), std::memory_order_relaxed);
+        _clockSequence.store(sequence + 2, std::memory_order_release);
+
+        if (nframes > kMaxCycleFrames) return;
+
+        for (const auto& pointer : set->sources) {
+            Source& source = *pointer;
+            if (source.config.firstChannel + source.config.channels > numChannels) continue;
+
+            RenderSource(kernels, source, nframes, frameTime);
+            for (int c = 0; c < source.config.channels; c++) {
+                channelTable[source.config.firstChannel + c] = source.outputTable[c];
+            }
+        }
+    }
+
+    std::shared_ptr<VirtualSourceBank::Source> VirtualSourceBank::Build(int id, const VirtualSourceConfig& config) const
+    {
+        auto source = std::make_shared<Source>();
+        source->id = id;
+        source->config = config;
+        source->graphRate = _sampleRate;
+        source->nominalRatio = static_cast<double>(config.sampleRate) / _sampleRate;
+        source->targetFrames = std::max(std::max(config.latencyMs, 0.0f) * 0.001 * config.sampleRate, 64.0);
+
+        // Device frames the longest cycle can consume at the largest correction
+        const uint32_t maxInput =
+            static_cast<uint32_t>(std::ceil(kMaxCycleFrames * source->nominalRatio * (1.0 + kMaxCorrection))) + kMaxTaps;
+
+        const size_t ringFrames = static_cast<size_t>(std::max(source->targetFrames * 4.0, source->targetFrames + 2.0 * maxInput));
+        source->ring.Reserve(ringFrames * config.channels);
+        source->resampler.Configure(config.channels, config.sampleRate, _sampleRate, config.quality, maxInput);
+        source->input.assign(static_cast<size_t>(maxInput) * config.channels, 0.0f);
+        source->output.assign(static_cast<size_t>(kMaxCycleFrames) * config.channels, 0.0f);
+        for (int c = 0; c < config.channels; c++) {
+            source->outputTable.push_back(source->output.data() + static_cast<size_t>(c) * kMaxCycleFrames);
+        }
+        return source;
+    }
+
+    VirtualSourceBank::Source* VirtualSourceBank::Find(int id) const
+    {
+        const SourceSet* set = _set.Get();
+        if (set == nullptr) return nullptr;
+
+        for (const auto& source : set->sources) {
+            if (source->id == id) return source.get();
+        }
+        return nullptr;
+    }
+
+    void VirtualSourceBank::PublishLocked(std::vector<std::shared_ptr<Source>> sources)
+    {
+        auto set = std::make_unique<SourceSet>();
+        set->sources = std::move(sources);
+        _set.Publish(std::move(set), _rcu);
+    }
+
+    // Fill at the cycle start: the frames of the latest write stamp, plus what the device has
+    // produced since at the measured rate, minus what was read (audio thread)
+    double VirtualSourceBank::EstimateFill(const Source& source, size_t available, uint64_t frameTime)
+    {
+        uint64_t stampFrames = source.readFrames + available;
+        double stampTime = static_cast<double>(frameTime);
+        for (int attempt = 0; attempt < kStampRetries; attempt++) {
+            const uint32_t sequence = source.stampSequence.load(std::memory_order_acquire);
+            const uint64_t frames = source.stampFrames.load(std::memory_order_relaxed);
+            const double time = source.stampTime.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((sequence & 1) == 0 && sequence == source.stampSequence.load(std::memory_order_relaxed)) {
+                stampFrames = frames;
+                stampTime = time;
+                break;
+            }
+        }
+
+        const double measuredRatio = source.nominalRatio * (1.0 + source.integral);
+        return static_cast<double>(stampFrames) - static_cast<double>(source.readFrames) +
+               (frameTime - stampTime) * measuredRatio + source.resampler.GetBufferedFrames();
+    }
+
+    // Convert one cycle of a source and update its drift loop (audio thread)
+    void VirtualSourceBank::RenderSource(const MixKernels& kernels, Source& source, uint32_t nframes, uint64_t frameTime)
+    {
+        const size_t channels = static_cast<size_t>(source.config.channels);
+        size_t available = source.ring.GetPendingCount() / channels;
+
+        if (!source.streaming) {
+            if (available < source.targetFrames) {
+                for (float* output : source.outputTable) std::fill(output, output + nframes, 0.0f);
+                return;
+            }
+
+            // Start with the estimate on the target, so the loop begins without an error; the
+            // integrator keeps the rate learned before an underrun
+            source.resampler.Reset();
+            const double excess = std::floor(EstimateFill(source, available, frameTime) - source.targetFrames);
+            const size_t skipped = excess > 0.0 ? std::min(static_cast<size_t>(excess), available) : 0;
+            source.ring.Skip(skipped * channels);
+            source.readFrames += skipped;
+            available -= skipped;
+            source.streaming = true;
+            source.filteredError = 0.0;
+            source.elapsed = 0.0;
+            source.streamingFlag.store(true, std::memory_order_relaxed);
+        }
+
+        // Second-order loop on the fill error, in device frames per cycle's worth of input
+        const double seconds = static_cast<double>(nframes) / source.graphRate;
+        const double bandwidth = source.elapsed < kAcquireSeconds ? kAcquireBandwidthHz : kTrackBandwidthHz;
+        const double w = std::min(2.0 * kPi * bandwidth * seconds, 0.5);
+        const double smoothing = 1.0 - std::exp(-2.0 * kPi * bandwidth * kMeasurementBandwidthScale * seconds);
+
+        const double fill = EstimateFill(source, available, frameTime);
+        const double error = (fill - source.targetFrames) / (nframes * source.nominalRatio);
+        source.filteredError += smoothing * (error - source.filteredError);
+
+        source.integral = std::clamp(source.integral + w * w * source.filteredError, -kMaxCorrection, kMaxCorrection);
+        const double correction = std::clamp(std::sqrt(2.0) * w * source.filteredError + source.integral,
+                                             -kMaxCorrection, kMaxCorrection);
+        const double ratio = source.nominalRatio * (1.0 + correction);
+
+        const uint32_t needed = source.resampler.GetInputFrames(nframes, ratio);
+        if (available < needed) {
+            // Refill to the target before streaming again
+            source.underruns.fetch_add(1, std::memory_order_relaxed);
+            source.streaming = false;
+            source.streamingFlag.store(false, std::memory_order_relaxed);
+            source.lockedFlag.store(false, std::memory_order_relaxed);
+            for (float* output : source.outputTable) std::fill(output, output + nframes, 0.0f);
+            return;
+        }
+
+        source.ring.Read(source.input.data(), needed * channels);
+        source.readFrames += needed;
+        source.resampler.Process(kernels, source.input.data(), needed, source.outputTable.data(), nframes, ratio);
+        source.elapsed += seconds;
+
+        source.ratio.store(ratio, std::memory_order_relaxed);
+        source.drift.store(source.integral, std::memory_order_relaxed);
+        source.lockedFlag.store(source.elapsed >= kAcquireSeconds, std::memory_order_relaxed);
+    }
+}
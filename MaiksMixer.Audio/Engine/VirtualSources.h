@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "MixKernels.h"
+#include "PolyphaseResampler.h"
+#include "RcuDomain.h"
+#include "SampleRing.h"
+
+namespace emp {
+
+    /// <summary>
+    /// A device on its own clock that feeds a range of engine channels
+    /// </summary>
+    struct VirtualSourceConfig
+    {
+        int firstChannel = 0;       // Engine channel fed by the device's first channel
+        int channels = 2;
+        uint32_t sampleRate = 48000;    // The device's nominal rate
+        ResamplerQuality quality = ResamplerQuality::Medium;
+        float latencyMs = 20.0f;    // Audio the drift loop keeps buffered; must cover a server period plus a device packet
+    };
+
+    /// <summary>
+    /// Clock tracking state of a virtual source
+    /// </summary>
+    struct VirtualSourceStatus
+    {
+        bool streaming = false;     // False while the buffer (re)fills to its target
+        bool locked = false;        // Past the fast acquisition phase
+        double ratio = 0.0;         // Device frames consumed per graph frame
+        double driftPpm = 0.0;      // Device clock against its nominal rate, as measured
+        float fillFrames = 0.0f;    // Device frames buffered
+        float targetFrames = 0.0f;
+        uint64_t underruns = 0;     // Cycles the device had not delivered enough
+        uint64_t overruns = 0;      // Writes rejected because the buffer was full
+    };
+
+    /// <summary>
+    /// Devices whose clocks run independently of the server's (network streams, USB
+    /// interfaces, ...) feeding engine channels. The device side writes interleaved frames
+    /// into a sample ring at its own pace; every cycle the process callback converts them
+    /// to the graph rate with a PolyphaseResampler and substitutes the result for the
+    /// channels' port buffers.
+    ///
+    /// The conversion ratio comes from a second-order delay-locked loop on the buffer's
+    /// fill level: its integrator converges on the device's actual rate and its
+    /// proportional term holds the buffer at the configured latency. Every write is
+    /// stamped with the graph time it completed at, and the loop extrapolates the fill
+    /// from the latest stamp to the cycle start, so the sawtooth of the device's packets
+    /// never reaches the ratio; only the stamps' jitter does, which the loop filters. The
+    /// loop runs at kAcquireBandwidthHz for the first kAcquireSeconds and at
+    /// kTrackBandwidthHz after.
+    /// </summary>
+    class VirtualSourceBank
+    {
+    public:
+        static constexpr int kMaxSources = 64;
+        static constexpr int kMaxSourceChannels = 64;
+
+        // Longest cycle a source renders; longer cycles keep the port buffers
+        static constexpr uint32_t kMaxCycleFrames = 8192;
+
+        // Drift loop
+        static constexpr double kAcquireBandwidthHz = 0.5;
+        static constexpr double kTrackBandwidthHz = 0.03;
+        static constexpr double kAcquireSeconds = 4.0;
+        static constexpr double kMaxCorrection = 0.01;     // Largest deviation from the nominal ratio
+
+        VirtualSourceBank();
+        ~VirtualSourceBank();
+
+        VirtualSourceBank(const VirtualSourceBank&) = delete;
+        VirtualSourceBank& operator=(const VirtualSourceBank&) = delete;
+
+        /// <summary>
+        /// Sets the channel count sources may feed and removes every source
+        /// </summary>
+        void Reserve(int numChannels);
+
+        /// <summary>
+        /// Sets the graph rate; existing sources are redesigned for it and refill
+        /// </summary>
+        void SetSampleRate(uint32_t sampleRate);
+
+        /// <summary>
+        /// Adds a source. Returns its id, or 0 if the configuration is invalid or its
+        /// channels overlap another source's.
+        /// </summary>
+        int Create(const VirtualSourceConfig& config);
+
+        bool Remove(int id);
+
+        /// <summary>
+        /// Channels per frame a source's writes carry, or 0 if the id is unknown
+        /// </summary>
+        int GetChannels(int id) const;
+
+        /// <summary>
+        /// Queues interleaved frames from the device, stamped with the current graph time
+        /// extrapolated from the last cycle. Returns false, queuing nothing, if the id is
+        /// unknown or the buffer is full.
+        /// </summary>
+        bool Write(int id, const float* interleaved, uint32_t frames);
+
+        /// <summary>
+        /// Queues interleaved frames from the device that were complete at graphTime, in
+        /// frames of the engine's cycle clock (for devices with their own timestamps)
+        /// </summary>
+        bool Write(int id, const float* interleaved, uint32_t frames, double graphTime);
+
+        /// <summary>
+        /// Copies a source's clock tracking state. Returns false if the id is unknown.
+        /// </summary>
+        bool GetStatus(int id, VirtualSourceStatus& status) const;
+
+        /// <summary>
+        /// Renders every source into its buffers and points the channels it feeds at them
+        /// (audio thread). frameTime is the cycle's first frame on the engine clock.
+        /// Channels at or beyond numChannels are not bound this cycle.
+        /// </summary>
+        void Render(const MixKernels& kernels, const float** channelTable, int numChannels, uint32_t nframes,
+                    uint64_t frameTime);
+
+    private:
+        struct Source
+        {
+            int id = 0;
+            VirtualSourceConfig config;
+            uint32_t graphRate = 0;
+            double nominalRatio = 1.0;
+            double targetFrames = 0.0;
+
+            SampleRing ring;    // Interleaved device frames
+            PolyphaseResampler resampler;
+            std::vector<float> input;
+            std::vector<float> output;      // kMaxCycleFrames per channel
+            std::vector<float*> outputTable;
+
+            // Latest write stamp (sequence lock, odd while the writer updates it)
+            std::atomic<uint32_t> stampSequence{ 0 };
+            std::atomic<uint64_t> stampFrames{ 0 };     // Frames written in total
+            std::atomic<double> stampTime{ 0.0 };       // Graph time they were complete at
+            uint64_t writtenFrames = 0;                 // Writer
+
+            // Audio thread
+            uint64_t readFrames = 0;
+            bool streaming = false;
+            double filteredError = 0.0;     // Smoothed fill error, in cycles of input
+            double integral = 0.0;          // Measured rate deviation
+            double elapsed = 0.0;           // Seconds since streaming started
+
+            std::atomic<bool> streamingFlag{ false };
+            std::atomic<bool> lockedFlag{ false };
+            std::atomic<double> ratio{ 0.0 };
+            std::atomic<double> drift{ 0.0 };
+            std::atomic<uint64_t> underruns{ 0 };
+            std::atomic<uint64_t> overruns{ 0 };
+        };
+
+        struct SourceSet
+        {
+            std::vector<std::shared_ptr<Source>> sources;
+        };
+
+        std::shared_ptr<Source> Build(int id, const VirtualSourceConfig& config) const;
+        Source* Find(int id) const;
+        void PublishLocked(std::vector<std::shared_ptr<Source>> sources);
+        static double EstimateFill(const Source& source, size_t available, uint64_t frameTime);
+        static void RenderSource(const MixKernels& kernels, Source& source, uint32_t nframes, uint64_t frameTime);
+
+        RcuDomain _rcu;
+        RcuPointer<SourceSet> _set;
+
+        // Cycle clock for unstamped writes: the last cycle's first frame and when it started
+        std::atomic<uint32_t> _clockSequence;
+        std::atomic<uint64_t> _clockFrame;
+        std::atomic<int64_t> _clockNanoseconds;
+
+        int _numChannels;
+        uint32_t _sampleRate;
+        int _nextId;
+
+        // Serializes control threads and device writers; the audio thread never takes it
+        mutable std::mutex _controlMutex;
+    };
+}
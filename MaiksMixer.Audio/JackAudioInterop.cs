@@ -11,6 +11,422 @@ namespace MaiksMixer.Audio
         // The name of the native DLL
         private const string DllName = "MaiksMixerNative";
 
+        /// <summary>
+        /// Native interface version these declarations match (EMP_NATIVE_API_VERSION)
+        /// </summary>
+        public const int ApiVersion = 3;
+
+        #region Native Structures
+
+        /// <summary>
+        /// Port name size of the native interface, terminator included (EMP_PORT_NAME_SIZE)
+        /// </summary>
+        public const int PortNameSize = 320;
+        public const int PortTypeSize = 64;
+
+        /// <summary>
+        /// Fixed sizes of the engine (EMP_EQ_BANDS, EMP_SPECTRUM_BINS, EMP_TELEMETRY_BUCKETS)
+        /// </summary>
+        public const int EqBands = 4;
+        public const int SpectrumBins = 1025;
+        public const int TelemetryBuckets = 32;
+
+        /// <summary>
+        /// Channel parameter of a ParameterChange (EmpParameter)
+        /// </summary>
+        public enum Parameter : int
+        {
+            Volume = 0,
+            Pan = 1,
+            GainDb = 2,
+            Mute = 3,
+            Solo = 4
+        }
+
+        /// <summary>
+        /// One parameter edit (EmpParameterChange)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ParameterChange
+        {
+            public int Channel;
+            public Parameter Parameter;
+            public float Value;
+        }
+
+        /// <summary>
+        /// Acknowledgement of a posted parameter change (EmpCommandCompletion); Status is 0
+        /// when applied and -1 when rejected
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct CommandCompletion
+        {
+            public uint Id;
+            public int Status;
+            public ulong Cycle;
+        }
+
+        /// <summary>
+        /// Latest meter values of one channel (EmpChannelMeter)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ChannelMeter
+        {
+            public float Peak;
+            public float Rms;
+            public float PeakHold;
+            public uint ClipCount;
+        }
+
+        /// <summary>
+        /// State of the JACK server (EmpServerStatus)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ServerStatus
+        {
+            public int IsRunning;
+            public int SampleRate;
+            public int BufferSize;
+            public float CpuLoad;
+            public ulong Xruns;
+            public double LatencyMs;
+        }
+
+        /// <summary>
+        /// One port of the JACK graph (EmpPortInfo)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public unsafe struct PortInfo
+        {
+            public fixed byte Name[PortNameSize];
+            public fixed byte Type[PortTypeSize];
+            public uint Flags;
+            public int ConnectionCount;
+
+            public string GetName()
+            {
+                fixed (byte* name = Name) return Marshal.PtrToStringUTF8((IntPtr)name) ?? string.Empty;
+            }
+
+            public string GetPortType()
+            {
+                fixed (byte* type = Type) return Marshal.PtrToStringUTF8((IntPtr)type) ?? string.Empty;
+            }
+        }
+
+        /// <summary>
+        /// Name of a connected port (EmpPortName)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public unsafe struct PortName
+        {
+            public fixed byte Name[PortNameSize];
+
+            public string GetName()
+            {
+                fixed (byte* name = Name) return Marshal.PtrToStringUTF8((IntPtr)name) ?? string.Empty;
+            }
+        }
+
+        /// <summary>
+        /// Shape of a parameter ramp (EmpRampShape)
+        /// </summary>
+        public enum RampShape : int
+        {
+            Step = 0,
+            Linear = 1,
+            Exponential = 2
+        }
+
+        /// <summary>
+        /// Parameter change that lands on a given frame (EmpTimedParameterChange)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct TimedParameterChange
+        {
+            public ulong FrameTime;
+            public ParameterChange Change;
+            public RampShape Shape;
+            public uint RampFrames;
+        }
+
+        /// <summary>
+        /// Channel parameters of a scene (EmpSceneChannel)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct SceneChannel
+        {
+            public float Volume;
+            public float Pan;
+            public float GainDb;
+            public int Mute;
+            public int Solo;
+        }
+
+        /// <summary>
+        /// Sizes of a scene's channel and route arrays (EmpSceneLayout)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct SceneLayout
+        {
+            public int ChannelCount;
+            public int RouteInputs;
+            public int RouteOutputs;
+            public int RoutingEnabled;
+        }
+
+        /// <summary>
+        /// Filter type of an EQ band (EmpEqBandType)
+        /// </summary>
+        public enum EqBandType : int
+        {
+            Peak = 0,
+            LowShelf = 1,
+            HighShelf = 2,
+            HighPass = 3,
+            LowPass = 4
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct EqBand
+        {
+            public EqBandType Type;
+            public float Frequency;
+            public float GainDb;
+            public float Q;
+            public int Enabled;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct Gate
+        {
+            public float ThresholdDb;
+            public float RangeDb;
+            public float AttackMs;
+            public float ReleaseMs;
+            public int Enabled;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct Compressor
+        {
+            public float ThresholdDb;
+            public float Ratio;
+            public float AttackMs;
+            public float ReleaseMs;
+            public float MakeupDb;
+            public int Enabled;
+        }
+
+        /// <summary>
+        /// Insert chain of one channel (EmpChannelInserts)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ChannelInserts
+        {
+            // The EqBands bands in order, as separate fields to keep the struct blittable
+            public EqBand Eq0;
+            public EqBand Eq1;
+            public EqBand Eq2;
+            public EqBand Eq3;
+            public Gate Gate;
+            public Compressor Compressor;
+            public int Bypass;
+        }
+
+        /// <summary>
+        /// Bus graph types (EmpBusType, EmpSendSource, EmpSendTap, EmpBusGraphStatus)
+        /// </summary>
+        public enum BusType : int
+        {
+            Aux = 0,
+            Subgroup = 1,
+            Master = 2
+        }
+
+        public enum SendSource : int
+        {
+            Channel = 0,
+            Bus = 1
+        }
+
+        public enum SendTap : int
+        {
+            PreFader = 0,
+            PostFader = 1
+        }
+
+        public enum BusGraphStatus : int
+        {
+            Applied = 0,
+            NotFound = -1,
+            Invalid = -2,
+            Cycle = -3,
+            Full = -4
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct BusConfig
+        {
+            public BusType Type;
+            public int Channels;
+            public float Volume;
+            public int Mute;
+            public int FirstOutput;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct BusSend
+        {
+            public SendSource SourceType;
+            public int Source;
+            public int Destination;
+            public SendTap Tap;
+            public float Level;
+            public float Pan;
+        }
+
+        /// <summary>
+        /// Signal an analysis tap or recorder track takes (EmpTapSource)
+        /// </summary>
+        public enum TapSource : int
+        {
+            Channel = 0,
+            Output = 1
+        }
+
+        /// <summary>
+        /// Analysis results of one tap (EmpAnalysis)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct Analysis
+        {
+            public uint SampleRate;
+            public float MomentaryLufs;
+            public float ShortTermLufs;
+            public float IntegratedLufs;
+            public float TruePeakDb;
+            public ulong DroppedBlocks;
+            public ulong Sequence;
+        }
+
+        /// <summary>
+        /// Recording file format (EmpRecordFormat)
+        /// </summary>
+        public enum RecordFormat : int
+        {
+            Wav = 0,
+            Wave64 = 1
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RecordTrack
+        {
+            public TapSource Source;
+            public int Index;
+        }
+
+        /// <summary>
+        /// State of the disk recorder (EmpRecorderStatus)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RecorderStatus
+        {
+            public int IsRecording;
+            public uint SampleRate;
+            public ulong CapturedFrames;
+            public ulong WrittenFrames;
+            public ulong BytesWritten;
+            public ulong DroppedBlocks;
+            public int WriteFailed;
+            public int LimitReached;
+        }
+
+        /// <summary>
+        /// Cycle timing and engine state counters (EmpTelemetry)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public unsafe struct Telemetry
+        {
+            public ulong Cycles;
+            public ulong Frames;
+            public ulong TotalNs;
+            public ulong LastNs;
+            public ulong WorstNs;
+            public ulong WorstBudgetNs;
+            public ulong OverBudgetCycles;
+            public fixed ulong Histogram[TelemetryBuckets];
+            public uint SampleRate;
+            public int ArenasLocked;
+            public uint MixedChannels;
+            public uint IdleChannels;
+            public uint InsertChannels;
+            public uint BypassedInserts;
+            public ulong XrunCount;
+            public ulong DroppedCompletions;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct XrunEvent
+        {
+            public ulong TimestampUs;
+            public ulong Cycle;
+            public float DelayedUs;
+        }
+
+        /// <summary>
+        /// Latency range of one of the client's ports, in frames (EmpPortLatency)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public unsafe struct PortLatency
+        {
+            public fixed byte PortName[PortNameSize];
+            public uint CaptureMin;
+            public uint CaptureMax;
+            public uint PlaybackMin;
+            public uint PlaybackMax;
+
+            public string GetPortName()
+            {
+                fixed (byte* name = PortName) return Marshal.PtrToStringUTF8((IntPtr)name) ?? string.Empty;
+            }
+        }
+
+        /// <summary>
+        /// Resampler quality of a virtual source (EmpResamplerQuality)
+        /// </summary>
+        public enum ResamplerQuality : int
+        {
+            Low = 0,
+            Medium = 1,
+            High = 2
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct VirtualSourceConfig
+        {
+            public int FirstChannel;
+            public int Channels;
+            public uint SampleRate;
+            public ResamplerQuality Quality;
+            public float LatencyMs;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct VirtualSourceStatus
+        {
+            public double Ratio;
+            public double DriftPpm;
+            public ulong Underruns;
+            public ulong Overruns;
+            public float FillFrames;
+            public float TargetFrames;
+            public int IsStreaming;
+            public int IsLocked;
+        }
+
+        #endregion
+
         #region Native Methods
 
         /// <summary>
@@ -18,7 +434,7 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="clientName">Name of the JACK client</param>
         /// <returns>True if successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_initialize")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool Initialize([MarshalAs(UnmanagedType.LPStr)] string clientName);
 
@@ -28,7 +444,7 @@ namespace MaiksMixer.Audio
         /// <param name="numInputs">Number of input ports to create</param>
         /// <param name="numOutputs">Number of output ports to create</param>
         /// <returns>True if successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_create_ports")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool CreatePorts(int numInputs, int numOutputs);
 
@@ -36,7 +452,7 @@ namespace MaiksMixer.Audio
         /// Activates the JACK client
         /// </summary>
         /// <returns>True if successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_activate")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool Activate();
 
@@ -44,7 +460,7 @@ namespace MaiksMixer.Audio
         /// Deactivates the JACK client
         /// </summary>
         /// <returns>True if successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_deactivate")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool Deactivate();
 
@@ -53,7 +469,7 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="channel">Channel index</param>
         /// <param name="volume">Volume value (0.0 - 1.0)</param>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_volume")]
         public static extern void SetChannelVolume(int channel, float volume);
 
         /// <summary>
@@ -61,7 +477,7 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="channel">Channel index</param>
         /// <param name="pan">Pan value (0.0 left, 0.5 center, 1.0 right)</param>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_pan")]
         public static extern void SetChannelPan(int channel, float pan);
 
         /// <summary>
@@ -69,7 +485,7 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="channel">Channel index</param>
         /// <param name="gainDB">Gain value in dB</param>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_gain")]
         public static extern void SetChannelGain(int channel, float gainDB);
 
         /// <summary>
@@ -77,7 +493,7 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="channel">Channel index</param>
         /// <param name="mute">Mute state</param>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_mute")]
         public static extern void SetChannelMute(int channel, [MarshalAs(UnmanagedType.I1)] bool mute);
 
         /// <summary>
@@ -85,35 +501,35 @@ namespace MaiksMixer.Audio
         /// </summary>
         /// <param name="channel">Channel index</param>
         /// <param name="solo">Solo state</param>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_solo")]
         public static extern void SetChannelSolo(int channel, [MarshalAs(UnmanagedType.I1)] bool solo);
 
         /// <summary>
         /// Gets the sample rate from the JACK server
         /// </summary>
         /// <returns>Sample rate in Hz</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_sample_rate")]
         public static extern int GetSampleRate();
 
         /// <summary>
         /// Gets the buffer size from the JACK server
         /// </summary>
         /// <returns>Buffer size in frames</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_buffer_size")]
         public static extern int GetBufferSize();
 
         /// <summary>
         /// Gets the CPU load from the JACK server
         /// </summary>
         /// <returns>CPU load as a percentage (0.0 - 100.0)</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_cpu_load")]
         public static extern float GetCpuLoad();
 
         /// <summary>
         /// Checks if the JACK server is running
         /// </summary>
         /// <returns>True if running, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_is_server_running")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool IsServerRunning();
 
@@ -123,7 +539,7 @@ namespace MaiksMixer.Audio
         /// <param name="sourcePort">Source port name</param>
         /// <param name="destPort">Destination port name</param>
         /// <returns>True if connection was successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_connect_ports")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool ConnectPorts(
             [MarshalAs(UnmanagedType.LPStr)] string sourcePort, 
@@ -135,22 +551,348 @@ namespace MaiksMixer.Audio
         /// <param name="sourcePort">Source port name</param>
         /// <param name="destPort">Destination port name</param>
         /// <returns>True if disconnection was successful, false otherwise</returns>
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_disconnect_ports")]
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool DisconnectPorts(
             [MarshalAs(UnmanagedType.LPStr)] string sourcePort, 
             [MarshalAs(UnmanagedType.LPStr)] string destPort);
 
+        /// <summary>
+        /// Gets the version of the native interface
+        /// </summary>
+        /// <returns>Interface version, bumped on every layout or signature change</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_api_version")]
+        public static extern int GetApiVersion();
+
+        /// <summary>
+        /// Copies the latest error message of the calling thread
+        /// </summary>
+        /// <param name="buffer">Destination buffer, always terminated</param>
+        /// <param name="size">Size of the buffer in bytes</param>
+        /// <returns>Full length of the message, 0 if no call has failed</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_last_error")]
+        public static extern int GetLastError(byte[] buffer, int size);
+
+        /// <summary>
+        /// Deactivates and closes the JACK client and frees the engine
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_shutdown")]
+        public static extern void Shutdown();
+
+        /// <summary>
+        /// Applies parameter changes together
+        /// </summary>
+        /// <param name="changes">Changes to apply</param>
+        /// <param name="count">Number of changes</param>
+        /// <returns>Number of changes applied</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_apply_parameter_batch")]
+        public static extern int ApplyParameterBatch([In] ParameterChange[] changes, int count);
+
+        /// <summary>
+        /// Queues parameter changes for the start of the next process cycle
+        /// </summary>
+        /// <param name="changes">Changes to queue</param>
+        /// <param name="commandIds">Receives a command id per change (0 if the queue was full)</param>
+        /// <param name="count">Number of changes</param>
+        /// <returns>Number of changes queued</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_post_parameter_changes")]
+        public static extern int PostParameterChanges([In] ParameterChange[] changes, [Out] uint[] commandIds, int count);
+
+        /// <summary>
+        /// Reads acknowledgements of posted parameter changes
+        /// </summary>
+        /// <param name="completions">Destination array</param>
+        /// <param name="capacity">Length of the array</param>
+        /// <returns>Number of acknowledgements written</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_read_command_completions")]
+        public static extern int ReadCommandCompletions([Out] CommandCompletion[] completions, int capacity);
+
+        /// <summary>
+        /// Copies the latest meters of all channels
+        /// </summary>
+        /// <param name="meters">Destination array</param>
+        /// <param name="capacity">Length of the array</param>
+        /// <param name="sequence">Publish count, unchanged between meter updates</param>
+        /// <returns>Number of channels written, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_channel_meters")]
+        public static extern int GetChannelMeters([Out] ChannelMeter[] meters, int capacity, out ulong sequence);
+
+        /// <summary>
+        /// Gets the state of the JACK server
+        /// </summary>
+        /// <param name="status">Receives the status</param>
+        /// <returns>True if successful, false otherwise</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_server_status")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool GetServerStatus(out ServerStatus status);
+
+        /// <summary>
+        /// Copies the ports of the JACK graph
+        /// </summary>
+        /// <param name="ports">Destination array, or null to count</param>
+        /// <param name="capacity">Length of the array</param>
+        /// <returns>Total number of ports, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_ports")]
+        public static extern int GetPorts([Out] PortInfo[]? ports, int capacity);
+
+        /// <summary>
+        /// Copies the names of the ports connected to a port
+        /// </summary>
+        /// <param name="portName">Full port name</param>
+        /// <param name="connections">Destination array, or null to count</param>
+        /// <param name="capacity">Length of the array</param>
+        /// <returns>Total number of connections, or -1 if the port is unknown</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_port_connections")]
+        public static extern int GetPortConnections(
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string portName,
+            [Out] PortName[]? connections,
+            int capacity);
+
+        /// <summary>
+        /// Resizes the port set of an open client
+        /// </summary>
+        /// <param name="numInputs">Number of input ports</param>
+        /// <param name="numOutputs">Number of output ports</param>
+        /// <returns>True if successful, false otherwise</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_resize_ports")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool ResizePorts(int numInputs, int numOutputs);
+
+        /// <summary>
+        /// Sets the worker threads started by the next Activate()
+        /// </summary>
+        /// <param name="workerCount">Worker threads, 0 to render on the process thread only</param>
+        /// <param name="realtimePriority">Real-time priority of the workers</param>
+        /// <returns>True if successful, false otherwise</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_worker_threads")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool SetWorkerThreads(int workerCount, int realtimePriority);
+
+        /// <summary>
+        /// Sets the meter refresh rate and peak hold time
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_configure_meters")]
+        public static extern void ConfigureMeters(float refreshRateHz, float peakHoldSeconds);
+
+        /// <summary>
+        /// Clears the meter clip counters
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_reset_clip_counters")]
+        public static extern void ResetClipCounters();
+
+        /// <summary>
+        /// Gets the server frame time of the last cycle's first frame
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_frame_time")]
+        public static extern ulong GetFrameTime();
+
+        /// <summary>
+        /// Queues parameter changes for the frames they are stamped with
+        /// </summary>
+        /// <param name="changes">Changes to queue</param>
+        /// <param name="commandIds">Receives a command id per change (0 if rejected or the queue was full)</param>
+        /// <param name="count">Number of changes</param>
+        /// <returns>Number of changes queued</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_post_timed_parameter_changes")]
+        public static extern int PostTimedParameterChanges([In] TimedParameterChange[] changes, [Out] uint[] commandIds, int count);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_parameter_smoothing")]
+        public static extern void SetParameterSmoothing(RampShape shape, float milliseconds);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_silence_detection")]
+        public static extern void SetSilenceDetection([MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        /// <summary>
+        /// Sets the peak level below which a channel counts as silent (0 skips exact silence only)
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_silence_threshold")]
+        public static extern void SetSilenceThreshold(float threshold);
+
+        /// <summary>
+        /// Sets the gain of a crosspoint of the routing matrix; 0 removes the route
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_route")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool SetRoute(int input, int output, float gain);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_clear_routes")]
+        public static extern void ClearRoutes();
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_routing_enabled")]
+        public static extern void SetRoutingEnabled([MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        /// <summary>
+        /// Copies the routing matrix, input-major, if it fits
+        /// </summary>
+        /// <param name="gains">Destination array, or null to size</param>
+        /// <param name="capacity">Length of the array</param>
+        /// <param name="numInputs">Receives the matrix rows</param>
+        /// <param name="numOutputs">Receives the matrix columns</param>
+        /// <returns>Number of gains in the matrix, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_routing_matrix")]
+        public static extern int GetRoutingMatrix([Out] float[]? gains, int capacity, out int numInputs, out int numOutputs);
+
+        /// <summary>
+        /// Captures the current scene; the arrays are filled if they fit the sizes stored in layout
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_capture_scene")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool CaptureScene(out SceneLayout layout, [Out] SceneChannel[]? channels, int channelCapacity,
+            [Out] float[]? routes, int routeCapacity);
+
+        /// <summary>
+        /// Compiles a scene for recall
+        /// </summary>
+        /// <returns>Scene handle to pass to RecallScene and FreeScene, or IntPtr.Zero</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_compile_scene")]
+        public static extern IntPtr CompileScene(in SceneLayout layout, [In] SceneChannel[]? channels, [In] float[]? routes);
+
+        /// <summary>
+        /// Recalls a compiled scene
+        /// </summary>
+        /// <returns>Command id, acknowledged through ReadCommandCompletions, or 0</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_recall_scene")]
+        public static extern uint RecallScene(IntPtr scene, float crossfadeMs);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_free_scene")]
+        public static extern void FreeScene(IntPtr scene);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_channel_inserts")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool SetChannelInserts(int channel, in ChannelInserts inserts);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_channel_inserts")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool GetChannelInserts(int channel, out ChannelInserts inserts);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_insert_bypass")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool SetInsertBypass(int channel, [MarshalAs(UnmanagedType.I1)] bool bypass);
+
+        /// <summary>
+        /// Adds a bus
+        /// </summary>
+        /// <returns>Bus id, or 0 if the configuration is invalid or the graph is full</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_create_bus")]
+        public static extern int CreateBus(in BusConfig config);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_remove_bus")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool RemoveBus(int id);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_bus")]
+        public static extern BusGraphStatus SetBus(int id, in BusConfig config);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_bus")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool GetBus(int id, out BusConfig config);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_send")]
+        public static extern BusGraphStatus SetSend(in BusSend send);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_remove_send")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool RemoveSend(SendSource sourceType, int source, int destination);
+
+        /// <summary>
+        /// Copies the sends of the bus graph
+        /// </summary>
+        /// <returns>Total number of sends, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_sends")]
+        public static extern int GetSends([Out] BusSend[]? sends, int capacity);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_set_analysis_tap")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool SetAnalysisTap(TapSource source, int index, [MarshalAs(UnmanagedType.I1)] bool enabled);
+
+        /// <summary>
+        /// Copies a tap's latest results and spectrum (dBFS per bin)
+        /// </summary>
+        /// <returns>Number of spectrum bins, or -1 if the tap is not enabled</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_analysis")]
+        public static extern int GetAnalysis(TapSource source, int index, out Analysis analysis, [Out] float[]? spectrum, int capacity);
+
+        /// <summary>
+        /// Starts recording tracks to path (without extension)
+        /// </summary>
+        /// <param name="ringSeconds">Audio buffered per track, 0 for the default</param>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_start_recording")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool StartRecording([MarshalAs(UnmanagedType.LPUTF8Str)] string path, RecordFormat format,
+            [MarshalAs(UnmanagedType.I1)] bool polyphonic, [In] RecordTrack[] tracks, int trackCount, float ringSeconds);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_stop_recording")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool StopRecording();
+
+        /// <summary>
+        /// Copies the recorder's status and per-track ring fill (0 to 1)
+        /// </summary>
+        /// <returns>Number of tracks, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_recorder_status")]
+        public static extern int GetRecorderStatus(out RecorderStatus status, [Out] float[]? ringFill, int capacity);
+
+        /// <summary>
+        /// Copies the telemetry counters and the latest xruns, oldest first
+        /// </summary>
+        /// <returns>Number of xruns kept, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_telemetry")]
+        public static extern int GetTelemetry(out Telemetry telemetry, [Out] XrunEvent[]? xruns, int capacity);
+
+        /// <summary>
+        /// Copies the latency ranges of the client's ports
+        /// </summary>
+        /// <returns>Number of ports, or -1</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_port_latencies")]
+        public static extern int GetPortLatencies([Out] PortLatency[]? latencies, int capacity);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_reset_telemetry")]
+        public static extern void ResetTelemetry();
+
+        /// <summary>
+        /// Adds a virtual source
+        /// </summary>
+        /// <returns>Source id, or 0 if the configuration is invalid or overlaps another source</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_create_virtual_source")]
+        public static extern int CreateVirtualSource(in VirtualSourceConfig config);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_remove_virtual_source")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool RemoveVirtualSource(int id);
+
+        /// <summary>
+        /// Queues interleaved frames from the device
+        /// </summary>
+        /// <returns>False if the id is unknown or the buffer is full</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_write_virtual_source")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool WriteVirtualSource(int id, [In] float[] interleaved, int frames);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_get_virtual_source_status")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool GetVirtualSourceStatus(int id, out VirtualSourceStatus status);
+
+        /// <summary>
+        /// Gets the message of the latest failed call on this thread
+        /// </summary>
+        /// <returns>Error message, empty if no call has failed</returns>
+        public static string GetLastErrorMessage()
+        {
+            var buffer = new byte[512];
+            int length = GetLastError(buffer, buffer.Length);
+            return System.Text.Encoding.UTF8.GetString(buffer, 0, Math.Min(length, buffer.Length - 1));
+        }
+
         #endregion
 
         #region Callback Delegates and Events
 
         // Define delegate types for callbacks from native code
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public delegate void ServerStatusChangedCallback([MarshalAs(UnmanagedType.I1)] bool isRunning);
+        public delegate void ServerStatusChangedCallback([MarshalAs(UnmanagedType.I1)] bool isRunning, IntPtr userData);
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public delegate void MeterUpdateCallback(int channel, float peak, float rms);
+        public delegate void MeterUpdateCallback(int channel, float peak, float rms, IntPtr userData);
 
         // Events that will be raised when callbacks are received
         public static event EventHandler<bool>? ServerStatusChanged;
@@ -161,19 +903,19 @@ namespace MaiksMixer.Audio
         private static readonly MeterUpdateCallback _meterUpdateCallback = OnMeterUpdate;
 
         // Methods to register callbacks with native code
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern void RegisterServerStatusCallback(ServerStatusChangedCallback callback);
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_register_server_status_callback")]
+        private static extern void RegisterServerStatusCallback(ServerStatusChangedCallback? callback, IntPtr userData);
 
-        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern void RegisterMeterUpdateCallback(MeterUpdateCallback callback);
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "emp_register_meter_update_callback")]
+        private static extern void RegisterMeterUpdateCallback(MeterUpdateCallback? callback, IntPtr userData);
 
         // Static constructor to register callbacks when the class is first used
         static JackAudioInterop()
         {
             try
             {
-                RegisterServerStatusCallback(_serverStatusChangedCallback);
-                RegisterMeterUpdateCallback(_meterUpdateCallback);
+                RegisterServerStatusCallback(_serverStatusChangedCallback, IntPtr.Zero);
+                RegisterMeterUpdateCallback(_meterUpdateCallback, IntPtr.Zero);
             }
             catch (Exception ex)
             {
@@ -183,12 +925,12 @@ namespace MaiksMixer.Audio
         }
 
         // Callback methods that will be called from native code
-        private static void OnServerStatusChanged([MarshalAs(UnmanagedType.I1)] bool isRunning)
+        private static void OnServerStatusChanged([MarshalAs(UnmanagedType.I1)] bool isRunning, IntPtr userData)
         {
             ServerStatusChanged?.Invoke(null, isRunning);
         }
 
-        private static void OnMeterUpdate(int channel, float peak, float rms)
+        private static void OnMeterUpdate(int channel, float peak, float rms, IntPtr userData)
         {
             MeterUpdated?.Invoke(null, (channel, peak, rms));
         }
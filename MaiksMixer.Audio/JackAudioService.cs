@@ -61,6 +61,20 @@ namespace MaiksMixer.Audio
             return _jackBridge.CreatePorts(numInputs, numOutputs);
         }
 
+        /// <summary>
+        /// Adds or removes ports while the client may be active
+        /// </summary>
+        /// <param name="numInputs">New number of input ports</param>
+        /// <param name="numOutputs">New number of output ports</param>
+        /// <returns>True if the ports were changed, false otherwise</returns>
+        public bool ResizePorts(int numInputs, int numOutputs)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.ResizePorts(numInputs, numOutputs);
+        }
+
         /// <summary>
         /// Activates the JACK client
         /// </summary>
@@ -85,6 +99,19 @@ namespace MaiksMixer.Audio
             return _jackBridge.Deactivate();
         }
 
+        /// <summary>
+        /// Sets the worker threads that share the channel strips of large graphs with the
+        /// JACK process thread. Takes effect on the next activation.
+        /// </summary>
+        /// <param name="workerCount">Worker threads, 0 for single-threaded processing</param>
+        /// <param name="realtimePriority">Real-time priority of the workers, 0 for none</param>
+        public void SetWorkerThreads(int workerCount, int realtimePriority)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            _jackBridge.SetWorkerThreads(workerCount, realtimePriority);
+        }
+
         /// <summary>
         /// Sets the volume for a channel
         /// </summary>
@@ -150,6 +177,445 @@ namespace MaiksMixer.Audio
             _jackBridge.SetChannelSolo(channel, solo);
         }
 
+        /// <summary>
+        /// Applies a block of channel parameter changes in one call; the audio thread sees
+        /// all of them in the same cycle
+        /// </summary>
+        /// <param name="changes">Parameter changes, applied in order</param>
+        /// <returns>Number of changes that addressed a valid channel and parameter</returns>
+        public int ApplyParameterBatch(global::MaiksMixer.ParameterChange[] changes)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.ApplyParameterBatch(changes);
+        }
+
+        /// <summary>
+        /// Queues parameter changes for the audio thread without waiting for them; each one
+        /// is acknowledged through <see cref="ReadCommandCompletions"/>
+        /// </summary>
+        /// <param name="changes">Parameter changes, applied in order</param>
+        /// <param name="commandIds">Receives one command id per change (0 if not queued)</param>
+        /// <returns>Number of changes queued</returns>
+        public int PostParameterChanges(global::MaiksMixer.ParameterChange[] changes, uint[] commandIds)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.PostParameterChanges(changes, commandIds);
+        }
+
+        /// <summary>
+        /// Copies the acknowledgements of executed commands into a reusable array
+        /// </summary>
+        /// <param name="completions">Destination array, reused between calls</param>
+        /// <returns>Number of acknowledgements written</returns>
+        public int ReadCommandCompletions(global::MaiksMixer.CommandCompletion[] completions)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            return _jackBridge.ReadCommandCompletions(completions);
+        }
+
+        /// <summary>
+        /// Queues parameter changes that land on the engine frames they are stamped with;
+        /// each one is acknowledged through <see cref="ReadCommandCompletions"/> once scheduled
+        /// </summary>
+        /// <param name="changes">Timed parameter changes</param>
+        /// <param name="commandIds">Receives one command id per change (0 if not queued)</param>
+        /// <returns>Number of changes queued</returns>
+        public int PostTimedParameterChanges(global::MaiksMixer.TimedParameterChange[] changes, uint[] commandIds)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.PostTimedParameterChanges(changes, commandIds);
+        }
+
+        /// <summary>
+        /// Gets the engine frame time of the most recent cycle, the reference for stamping
+        /// timed parameter changes
+        /// </summary>
+        /// <returns>Frame time in frames</returns>
+        public ulong GetFrameTime()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetFrameTime();
+        }
+
+        /// <summary>
+        /// Sets the ramp applied to untimed volume, pan and gain changes
+        /// </summary>
+        /// <param name="shape">Ramp shape, Step for hard changes</param>
+        /// <param name="milliseconds">Ramp length</param>
+        public void SetParameterSmoothing(global::MaiksMixer.RampShape shape, float milliseconds)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            _jackBridge.SetParameterSmoothing(shape, milliseconds);
+        }
+
+        /// <summary>
+        /// Enables or disables skipping channels whose input has been silent
+        /// </summary>
+        /// <param name="enabled">Whether silent channels are skipped</param>
+        public void SetSilenceDetection(bool enabled)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            _jackBridge.SetSilenceDetection(enabled);
+        }
+
+        /// <summary>
+        /// Sets the post-fader peak at or below which a channel counts as silent
+        /// </summary>
+        /// <param name="threshold">Linear peak; 0 (the default) skips only exact silence</param>
+        public void SetSilenceThreshold(float threshold)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            _jackBridge.SetSilenceThreshold(threshold);
+        }
+
+        /// <summary>
+        /// Sets a crosspoint of the native routing matrix
+        /// </summary>
+        /// <param name="inputChannel">Input channel index</param>
+        /// <param name="outputPort">Output port index</param>
+        /// <param name="enabled">Whether the route is enabled</param>
+        /// <param name="volume">Route gain (0.0 - 1.0)</param>
+        /// <returns>True if the crosspoint exists, false otherwise</returns>
+        public bool SetAudioRoute(int inputChannel, int outputPort, bool enabled, float volume)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetAudioRoute(inputChannel, outputPort, enabled, volume);
+        }
+
+        /// <summary>
+        /// Enables or disables native matrix routing
+        /// </summary>
+        /// <param name="enabled">Whether matrix routing is enabled</param>
+        public void SetRoutingMatrixEnabled(bool enabled)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            _jackBridge.SetRoutingMatrixEnabled(enabled);
+        }
+
+        /// <summary>
+        /// Gets the native routing matrix
+        /// </summary>
+        /// <returns>Route gains indexed by [input channel, output port]</returns>
+        public float[,] GetRoutingMatrix()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetRoutingMatrix();
+        }
+
+        /// <summary>
+        /// Replaces a channel's insert chain (EQ, gate and compressor)
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <param name="settings">Chain settings</param>
+        /// <returns>False if the channel is out of range</returns>
+        public bool SetChannelInserts(int channel, global::MaiksMixer.ChannelInsertSettings settings)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetChannelInserts(channel, settings);
+        }
+
+        /// <summary>
+        /// Gets a channel's insert chain
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <returns>Chain settings, or null if the channel is out of range</returns>
+        public global::MaiksMixer.ChannelInsertSettings GetChannelInserts(int channel)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetChannelInserts(channel);
+        }
+
+        /// <summary>
+        /// Bypasses or restores a channel's whole insert chain
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <param name="bypass">True to skip the chain</param>
+        /// <returns>False if the channel is out of range</returns>
+        public bool SetInsertBypass(int channel, bool bypass)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetInsertBypass(channel, bypass);
+        }
+
+        /// <summary>
+        /// Captures the current channel parameters and routing matrix
+        /// </summary>
+        /// <returns>Scene holding the mixer's full state</returns>
+        public global::MaiksMixer.MixerScene CaptureScene()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.CaptureScene();
+        }
+
+        /// <summary>
+        /// Compiles a scene for recall; may be called from a background thread
+        /// </summary>
+        /// <param name="scene">Scene to compile</param>
+        /// <returns>Compiled scene for RecallScene</returns>
+        public global::MaiksMixer.CompiledMixerScene CompileScene(global::MaiksMixer.MixerScene scene)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.CompileScene(scene);
+        }
+
+        /// <summary>
+        /// Applies a compiled scene in one audio cycle, optionally crossfading from the current mix
+        /// </summary>
+        /// <param name="scene">Compiled scene</param>
+        /// <param name="crossfadeMs">Equal-power crossfade length, 0 for a hard swap</param>
+        /// <returns>Command id, or 0 if the scene could not be queued</returns>
+        public uint RecallScene(global::MaiksMixer.CompiledMixerScene scene, float crossfadeMs)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.RecallScene(scene, crossfadeMs);
+        }
+
+        /// <summary>
+        /// Enables or disables spectrum and loudness analysis of a channel or output
+        /// </summary>
+        /// <param name="source">Channel or output</param>
+        /// <param name="index">Channel or output index</param>
+        /// <param name="enabled">True to analyze the signal</param>
+        /// <returns>False if the index is out of range</returns>
+        public bool SetAnalysisTap(global::MaiksMixer.TapSource source, int index, bool enabled)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetAnalysisTap(source, index, enabled);
+        }
+
+        /// <summary>
+        /// Gets the latest spectrum and loudness of an analysis tap
+        /// </summary>
+        /// <param name="source">Channel or output</param>
+        /// <param name="index">Channel or output index</param>
+        /// <returns>Analysis results, or null if the tap has never been enabled</returns>
+        public global::MaiksMixer.AnalysisData GetAnalysis(global::MaiksMixer.TapSource source, int index)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetAnalysis(source, index);
+        }
+
+        /// <summary>
+        /// Starts recording channels and outputs to disk
+        /// </summary>
+        /// <param name="options">Tracks, format and file path</param>
+        /// <returns>False if a recording is running or a track is out of range</returns>
+        public bool StartRecording(global::MaiksMixer.RecordOptions options)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.StartRecording(options);
+        }
+
+        /// <summary>
+        /// Stops recording and closes the files
+        /// </summary>
+        /// <returns>False if nothing was recording</returns>
+        public bool StopRecording()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.StopRecording();
+        }
+
+        /// <summary>
+        /// Gets the progress of the current or last recording
+        /// </summary>
+        /// <returns>Recorder status</returns>
+        public global::MaiksMixer.RecorderStatus GetRecorderStatus()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetRecorderStatus();
+        }
+
+        /// <summary>
+        /// Adds a device on its own clock that feeds a range of input channels
+        /// </summary>
+        /// <param name="config">Channels, nominal rate, quality and latency</param>
+        /// <returns>Id of the source, or 0 if the configuration is invalid</returns>
+        public int CreateVirtualSource(global::MaiksMixer.VirtualSourceConfig config)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.CreateVirtualSource(config);
+        }
+
+        /// <summary>
+        /// Removes a virtual source
+        /// </summary>
+        /// <param name="id">Virtual source id</param>
+        /// <returns>False if the id is unknown</returns>
+        public bool RemoveVirtualSource(int id)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.RemoveVirtualSource(id);
+        }
+
+        /// <summary>
+        /// Queues audio received from a virtual source's device
+        /// </summary>
+        /// <param name="id">Virtual source id</param>
+        /// <param name="interleaved">Interleaved samples</param>
+        /// <param name="frames">Frames to queue</param>
+        /// <returns>False if the id is unknown or the buffer is full</returns>
+        public bool WriteVirtualSource(int id, float[] interleaved, int frames)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.WriteVirtualSource(id, interleaved, frames);
+        }
+
+        /// <summary>
+        /// Gets the clock tracking state of a virtual source
+        /// </summary>
+        /// <param name="id">Virtual source id</param>
+        /// <returns>Virtual source status, or null if the id is unknown</returns>
+        public global::MaiksMixer.VirtualSourceStatus GetVirtualSourceStatus(int id)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetVirtualSourceStatus(id);
+        }
+
+        /// <summary>
+        /// Adds an aux, subgroup or master bus
+        /// </summary>
+        /// <param name="config">Type, channels, volume and outputs</param>
+        /// <returns>Id of the bus, or 0 if the configuration is invalid</returns>
+        public int CreateBus(global::MaiksMixer.BusConfig config)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.CreateBus(config);
+        }
+
+        /// <summary>
+        /// Removes a bus with every send into or out of it
+        /// </summary>
+        /// <param name="id">Bus id</param>
+        /// <returns>False if the id is unknown</returns>
+        public bool RemoveBus(int id)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.RemoveBus(id);
+        }
+
+        /// <summary>
+        /// Changes a bus's settings
+        /// </summary>
+        /// <param name="id">Bus id</param>
+        /// <param name="config">New settings</param>
+        /// <returns>Whether the change was applied</returns>
+        public global::MaiksMixer.BusGraphStatus SetBus(int id, global::MaiksMixer.BusConfig config)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetBus(id, config);
+        }
+
+        /// <summary>
+        /// Gets a bus's settings
+        /// </summary>
+        /// <param name="id">Bus id</param>
+        /// <returns>Bus settings, or null if the id is unknown</returns>
+        public global::MaiksMixer.BusConfig GetBus(int id)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetBus(id);
+        }
+
+        /// <summary>
+        /// Adds or replaces a send into a bus
+        /// </summary>
+        /// <param name="send">Source, destination, tap and level</param>
+        /// <returns>Whether the send was applied, or Cycle if it would make a bus feed itself</returns>
+        public global::MaiksMixer.BusGraphStatus SetSend(global::MaiksMixer.BusSend send)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.SetSend(send);
+        }
+
+        /// <summary>
+        /// Removes a send
+        /// </summary>
+        /// <param name="sourceType">Whether the source is a channel or a bus</param>
+        /// <param name="source">Channel index or bus id</param>
+        /// <param name="destination">Bus id</param>
+        /// <returns>False if there is no such send</returns>
+        public bool RemoveSend(global::MaiksMixer.SendSource sourceType, int source, int destination)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.RemoveSend(sourceType, source, destination);
+        }
+
+        /// <summary>
+        /// Gets every send of the bus graph
+        /// </summary>
+        /// <returns>Sends</returns>
+        public global::MaiksMixer.BusSend[] GetSends()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetSends();
+        }
+
         /// <summary>
         /// Gets the meter data for a channel
         /// </summary>
@@ -168,6 +634,57 @@ namespace MaiksMixer.Audio
             };
         }
 
+        /// <summary>
+        /// Copies the latest meters of all channels into a reusable array in one call.
+        /// Each channel occupies <see cref="global::MaiksMixer.JackBridge.MeterValuesPerChannel"/>
+        /// values: peak, RMS, peak hold and clip count.
+        /// </summary>
+        /// <param name="meters">Destination array, reused between calls</param>
+        /// <returns>Number of channels written</returns>
+        public int GetAllMeters(float[] meters)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetAllMeters(meters);
+        }
+
+        /// <summary>
+        /// Sets how often the native engine publishes meters and how long peaks are held
+        /// </summary>
+        /// <param name="refreshRateHz">Meter refresh rate in Hz</param>
+        /// <param name="peakHoldSeconds">Peak hold time in seconds</param>
+        public void SetMeterRefreshRate(float refreshRateHz, float peakHoldSeconds)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            _jackBridge.SetMeterRefreshRate(refreshRateHz, peakHoldSeconds);
+        }
+
+        /// <summary>
+        /// Starts the native shared-memory transport, which publishes binary meter frames and
+        /// accepts parameter change frames through the rings "&lt;name&gt;_EngineToUi" and
+        /// "&lt;name&gt;_UiToEngine"
+        /// </summary>
+        /// <param name="name">Base name of the shared-memory mappings</param>
+        /// <returns>True if the transport was started, false otherwise</returns>
+        public bool StartSharedMemoryTransport(string name)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            return _jackBridge.StartSharedMemoryTransport(name);
+        }
+
+        /// <summary>
+        /// Stops the native shared-memory transport
+        /// </summary>
+        public void StopSharedMemoryTransport()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            _jackBridge.StopSharedMemoryTransport();
+        }
+
         /// <summary>
         /// Connects two JACK ports
         /// </summary>
@@ -196,6 +713,43 @@ namespace MaiksMixer.Audio
             return _jackBridge.DisconnectPorts(sourcePort, destPort);
         }
 
+        /// <summary>
+        /// Gets the handle for a port name, for use with <see cref="ApplyConnectionChanges"/>
+        /// </summary>
+        /// <param name="portName">Full JACK port name</param>
+        /// <returns>Port handle</returns>
+        public int GetPortHandle(string portName)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            return _jackBridge.GetPortHandle(portName);
+        }
+
+        /// <summary>
+        /// Gets the handles for several port names in one call
+        /// </summary>
+        /// <param name="portNames">Full JACK port names</param>
+        /// <returns>Port handles in the same order</returns>
+        public int[] GetPortHandles(string[] portNames)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+
+            return _jackBridge.GetPortHandles(portNames);
+        }
+
+        /// <summary>
+        /// Applies a batch of connect/disconnect operations in one call
+        /// </summary>
+        /// <param name="changes">Connection changes addressed by port handles</param>
+        /// <returns>One result per change</returns>
+        public global::MaiksMixer.PortConnectionResult[] ApplyConnectionChanges(global::MaiksMixer.PortConnectionChange[] changes)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.ApplyConnectionChanges(changes);
+        }
+
         /// <summary>
         /// Gets a list of all available JACK ports
         /// </summary>
@@ -227,19 +781,19 @@ namespace MaiksMixer.Audio
             if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
             if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
 
-            var allPorts = _jackBridge.GetPortList("", 0);
-            var result = new List<JackPort>();
+            var allPorts = _jackBridge.GetPorts();
+            var result = new List<JackPort>(allPorts.Count);
 
-            foreach (var portName in allPorts)
+            foreach (var nativePort in allPorts)
             {
                 var port = new JackPort
                 {
-                    Name = portName,
-                    Type = "audio", // This would need to be determined from the actual port
-                    IsInput = portName.Contains("input"),
-                    IsOutput = portName.Contains("output"),
-                    IsPhysical = portName.Contains("system"),
-                    Connections = new List<string>()
+                    Name = (string)nativePort["Name"],
+                    Type = (string)nativePort["Type"],
+                    IsInput = (bool)nativePort["IsInput"],
+                    IsOutput = (bool)nativePort["IsOutput"],
+                    IsPhysical = (bool)nativePort["IsPhysical"],
+                    Connections = new List<string>((List<string>)nativePort["Connections"])
                 };
                 
                 result.Add(port);
@@ -248,6 +802,19 @@ namespace MaiksMixer.Audio
             return result;
         }
 
+        /// <summary>
+        /// Gets the changes to the port graph since a version returned by an earlier call
+        /// </summary>
+        /// <param name="sinceVersion">Last version seen by the caller, 0 for the whole graph</param>
+        /// <returns>Changes since sinceVersion and the current version</returns>
+        public global::MaiksMixer.PortGraphChanges GetPortGraphChanges(ulong sinceVersion)
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetPortGraphChanges(sinceVersion);
+        }
+
         /// <summary>
         /// Gets the sample rate from the JACK server
         /// </summary>
@@ -311,10 +878,35 @@ namespace MaiksMixer.Audio
                 IsRunning = nativeStatus.IsRunning,
                 SampleRate = nativeStatus.SampleRate,
                 BufferSize = nativeStatus.BufferSize,
-                CpuLoad = nativeStatus.CpuLoad
+                CpuLoad = nativeStatus.CpuLoad,
+                Xruns = nativeStatus.Xruns,
+                Latency = nativeStatus.Latency
             };
         }
 
+        /// <summary>
+        /// Gets the engine's cycle timing histogram, xrun history and port latencies
+        /// </summary>
+        /// <returns>Telemetry since the engine started or the last reset</returns>
+        public global::MaiksMixer.DspTelemetry GetTelemetry()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            return _jackBridge.GetTelemetry();
+        }
+
+        /// <summary>
+        /// Clears the cycle statistics and xrun history
+        /// </summary>
+        public void ResetTelemetry()
+        {
+            if (_isDisposed) throw new ObjectDisposedException(nameof(JackAudioService));
+            if (!_isInitialized) throw new InvalidOperationException("JACK client is not initialized");
+
+            _jackBridge.ResetTelemetry();
+        }
+
         /// <summary>
         /// Handles the server status changed event from the native bridge
         /// </summary>
@@ -439,6 +1031,16 @@ namespace MaiksMixer.Audio
         /// CPU load as a percentage (0.0 - 100.0)
         /// </summary>
         public float CpuLoad { get; set; }
+
+        /// <summary>
+        /// Xruns since the engine started or telemetry was last reset
+        /// </summary>
+        public ulong Xruns { get; set; }
+
+        /// <summary>
+        /// Output latency in milliseconds
+        /// </summary>
+        public double Latency { get; set; }
     }
 
     /// <summary>
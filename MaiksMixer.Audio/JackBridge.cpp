@@ -1,11 +1,16 @@
 #include "JackBridge.h"
 #include <msclr/marshal_cppstd.h>
+#include <vcclr.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
 // Include the native C++ headers
-#include "cpp/emp/src/Bridge/MaiksMixerBridge.h"
-#include "cpp/emp/src/JackClient/JackMixerClient.h"
+#include "Engine/JackEngineClient.h"
+#include "Engine/MixEngine.h"
+#include "Engine/SharedMemoryTransport.h"
 
 using namespace System::Runtime::InteropServices;
 using namespace msclr::interop;
@@ -18,18 +23,40 @@ namespace MaiksMixer {
         float rms;
     };
 
+    // Compiled Mixer Scene Finalizer
+    CompiledMixerScene::~CompiledMixerScene()
+    {
+        this->!CompiledMixerScene();
+    }
+
+    // Compiled Mixer Scene Destructor
+    CompiledMixerScene::!CompiledMixerScene()
+    {
+        // The engine keeps its own reference while a recall is pending
+        delete static_cast<std::shared_ptr<const emp::CompiledScene>*>(_nativeScene);
+        _nativeScene = nullptr;
+    }
+
     // Constructor
     JackBridge::JackBridge()
-        : _nativeImpl(nullptr), _isInitialized(false), _isDisposed(false)
+        : _nativeImpl(nullptr), _nativeEngine(nullptr), _nativeTransport(nullptr),
+          _workerThreadCount(0), _workerPriority(0), _isInitialized(false), _isDisposed(false)
     {
         // Create the native implementation
         try {
-            _nativeImpl = new emp::MaiksMixerBridge();
+            _nativeEngine = new emp::MixEngine();
+            _nativeImpl = new emp::JackEngineClient(*static_cast<emp::MixEngine*>(_nativeEngine));
+            _nativeTransport = new emp::SharedMemoryTransport(*static_cast<emp::MixEngine*>(_nativeEngine));
             
-            // Register callbacks
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetServerStatusCallback(ServerStatusChangedCallback, this);
-            bridge->SetMeterUpdateCallback(MeterUpdateCallback, this);
+            // Register callbacks; they run on client threads and hold the bridge through a
+            // GC root
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            gcroot<JackBridge^> self(this);
+            client->SetShutdownHandler([self]() { self->OnNativeServerStatusChanged(false); });
+            client->SetMeterHandler([self](int channel, const emp::ChannelMeterFrame& meter) {
+                NativeMeterData data{ meter.peak, meter.rms };
+                self->OnNativeMeterUpdated(channel, data);
+            });
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -49,16 +76,19 @@ namespace MaiksMixer {
 
         if (_nativeImpl != nullptr) {
             try {
-                auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-                
-                // Deactivate if initialized
-                if (_isInitialized) {
-                    bridge->Deactivate();
-                }
+                auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
                 
-                // Delete the native implementation
-                delete bridge;
+                // Deactivate and close the client
+                delete client;
                 _nativeImpl = nullptr;
+
+                // The transport's worker reads the engine, so it goes first
+                delete static_cast<emp::SharedMemoryTransport*>(_nativeTransport);
+                _nativeTransport = nullptr;
+
+                // The engine must outlive the client that renders through it
+                delete static_cast<emp::MixEngine*>(_nativeEngine);
+                _nativeEngine = nullptr;
             }
             catch (...) {
                 // Ignore exceptions during cleanup
@@ -75,10 +105,10 @@ namespace MaiksMixer {
         if (_isInitialized) return true;
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
             std::string nativeClientName = marshal_as<std::string>(clientName);
             
-            bool result = bridge->Initialize(nativeClientName);
+            bool result = client->Open(nativeClientName);
             _isInitialized = result;
             return result;
         }
@@ -94,8 +124,27 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->CreatePorts(numInputs, numOutputs);
+            // The client sizes the engine before registering the ports, with headroom for
+            // ports added later with ResizePorts
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            return client->CreatePorts(numInputs, numOutputs);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Resize Ports
+    bool JackBridge::ResizePorts(int numInputs, int numOutputs)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (numInputs < 0) throw gcnew ArgumentOutOfRangeException("numInputs");
+        if (numOutputs < 0) throw gcnew ArgumentOutOfRangeException("numOutputs");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->ResizePorts(numInputs, numOutputs);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -109,8 +158,24 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->Activate();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            // Workers are (re)started only while the process callback is not running
+            emp::WorkerPoolConfig workers;
+            workers.workerCount = _workerThreadCount;
+            workers.realtimePriority = _workerPriority;
+            workers.pinThreads = _workerThreadCount > 0;
+            engine->Workers().Start(workers);
+            engine->Analysis().Start(emp::AnalysisTaps::kDefaultWorkerCount);
+
+            // The client builds the per-cycle layout for the server's period and rate before
+            // processing starts; later changes arrive through its buffer size and sample rate
+            // callbacks (JackServerListener). Its arenas and the RT stacks lock their own
+            // pages, so only those are locked, never the managed heap.
+            const bool activated = client->Activate();
+            engine->LockMemory();
+            return activated;
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -124,14 +189,32 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->Deactivate();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            bool result = client->Deactivate();
+            if (result) {
+                engine->Workers().Stop();
+                engine->Analysis().Stop();
+                engine->Recorder().Stop();
+            }
+            return result;
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
         }
     }
 
+    // Set Worker Threads
+    void JackBridge::SetWorkerThreads(int workerCount, int realtimePriority)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (workerCount < 0 || workerCount > emp::RtWorkerPool::kMaxWorkers) throw gcnew ArgumentOutOfRangeException("workerCount");
+
+        _workerThreadCount = workerCount;
+        _workerPriority = std::max(realtimePriority, 0);
+    }
+
     // Set Channel Volume
     void JackBridge::SetChannelVolume(int channel, float volume)
     {
@@ -139,8 +222,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetChannelVolume(channel, volume);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Parameters().SetVolume(channel, volume);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -154,8 +237,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetChannelPan(channel, pan);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Parameters().SetPan(channel, pan);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -169,8 +252,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetChannelGain(channel, gainDB);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Parameters().SetGainDb(channel, gainDB);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -184,8 +267,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetChannelMute(channel, mute);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Parameters().SetMute(channel, mute);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -199,8 +282,150 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            bridge->SetChannelSolo(channel, solo);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Parameters().SetSolo(channel, solo);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Apply Parameter Batch
+    int JackBridge::ApplyParameterBatch(array<ParameterChange>^ changes)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (changes == nullptr) throw gcnew ArgumentNullException("changes");
+        if (changes->Length == 0) return 0;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            // The array is blittable and shares the native layout
+            pin_ptr<ParameterChange> pinnedChanges = &changes[0];
+            return engine->Parameters().ApplyBatch(
+                reinterpret_cast<const emp::ParameterChange*>(pinnedChanges), changes->Length);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Post Parameter Changes
+    int JackBridge::PostParameterChanges(array<ParameterChange>^ changes, array<UInt32>^ commandIds)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (changes == nullptr) throw gcnew ArgumentNullException("changes");
+        if (commandIds == nullptr) throw gcnew ArgumentNullException("commandIds");
+        if (commandIds->Length < changes->Length) throw gcnew ArgumentException("commandIds is shorter than changes");
+        if (changes->Length == 0) return 0;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            pin_ptr<ParameterChange> pinnedChanges = &changes[0];
+            pin_ptr<UInt32> pinnedIds = &commandIds[0];
+            auto nativeChanges = reinterpret_cast<const emp::ParameterChange*>(pinnedChanges);
+            uint32_t* ids = pinnedIds;
+
+            int queued = 0;
+            for (int i = 0; i < changes->Length; i++) {
+                ids[i] = engine->PostParameterChange(nativeChanges[i]);
+                if (ids[i] != 0) queued++;
+            }
+
+            return queued;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Post Timed Parameter Changes
+    int JackBridge::PostTimedParameterChanges(array<TimedParameterChange>^ changes, array<UInt32>^ commandIds)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (changes == nullptr) throw gcnew ArgumentNullException("changes");
+        if (commandIds == nullptr) throw gcnew ArgumentNullException("commandIds");
+        if (commandIds->Length < changes->Length) throw gcnew ArgumentException("commandIds is shorter than changes");
+        if (changes->Length == 0) return 0;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            pin_ptr<TimedParameterChange> pinnedChanges = &changes[0];
+            pin_ptr<UInt32> pinnedIds = &commandIds[0];
+            auto nativeChanges = reinterpret_cast<const emp::TimedParameterChange*>(pinnedChanges);
+            uint32_t* ids = pinnedIds;
+
+            int queued = 0;
+            for (int i = 0; i < changes->Length; i++) {
+                ids[i] = engine->ScheduleParameterChange(nativeChanges[i]);
+                if (ids[i] != 0) queued++;
+            }
+
+            return queued;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Frame Time
+    UInt64 JackBridge::GetFrameTime()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+        return engine->GetFrameTime();
+    }
+
+    // Set Parameter Smoothing
+    void JackBridge::SetParameterSmoothing(RampShape shape, float milliseconds)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+        engine->SetSmoothing(static_cast<emp::RampShape>(shape), milliseconds);
+    }
+
+    // Set Silence Detection
+    void JackBridge::SetSilenceDetection(bool enabled)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+        engine->SetSilenceDetection(enabled);
+    }
+
+    // Set Silence Threshold
+    void JackBridge::SetSilenceThreshold(float threshold)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+        engine->SetSilenceThreshold(threshold);
+    }
+
+    // Read Command Completions
+    int JackBridge::ReadCommandCompletions(array<CommandCompletion>^ completions)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (completions == nullptr) throw gcnew ArgumentNullException("completions");
+        if (completions->Length == 0) return 0;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            pin_ptr<CommandCompletion> pinnedCompletions = &completions[0];
+            return engine->Commands().ReadCompletions(
+                reinterpret_cast<emp::EngineCompletion*>(pinnedCompletions), completions->Length);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -214,8 +439,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->GetSampleRate();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            return static_cast<int>(client->GetSampleRate());
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -229,8 +454,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->GetBufferSize();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            return static_cast<int>(client->GetBufferSize());
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -244,8 +469,8 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->GetCpuLoad();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            return client->GetCpuLoad();
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -258,8 +483,8 @@ namespace MaiksMixer {
         if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            return bridge->IsServerRunning();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            return client->IsServerRunning();
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -272,14 +497,90 @@ namespace MaiksMixer {
         if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            auto status = bridge->GetServerStatus();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            const int sampleRate = static_cast<int>(client->GetSampleRate());
+            const int bufferSize = static_cast<int>(client->GetBufferSize());
 
             auto result = gcnew System::Collections::Generic::Dictionary<String^, Object^>();
-            result->Add("IsRunning", status.isRunning);
-            result->Add("SampleRate", status.sampleRate);
-            result->Add("BufferSize", status.bufferSize);
-            result->Add("CpuLoad", status.cpuLoad);
+            result->Add("IsRunning", client->IsServerRunning());
+            result->Add("SampleRate", sampleRate);
+            result->Add("BufferSize", bufferSize);
+            result->Add("CpuLoad", client->GetCpuLoad());
+
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            emp::TelemetrySnapshot telemetry;
+            engine->Telemetry().GetSnapshot(telemetry);
+
+            // Output latency: the longest playback path from one of our ports, or one
+            // period before the ports exist
+            uint32_t latencyFrames = static_cast<uint32_t>(bufferSize);
+            if (!telemetry.portLatencies.empty()) {
+                latencyFrames = 0;
+                for (const auto& port : telemetry.portLatencies) {
+                    latencyFrames = std::max(latencyFrames, port.playbackMax);
+                }
+            }
+
+            result->Add("Xruns", telemetry.xrunCount);
+            result->Add("Latency", sampleRate > 0 ? latencyFrames * 1000.0 / sampleRate : 0.0);
+
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Telemetry
+    DspTelemetry^ JackBridge::GetTelemetry()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            emp::TelemetrySnapshot snapshot;
+            engine->Telemetry().GetSnapshot(snapshot);
+
+            auto result = gcnew DspTelemetry();
+            result->Cycles = snapshot.cycles;
+            result->MeanCycleMicroseconds = snapshot.cycles > 0 ? snapshot.totalNs / 1000.0 / snapshot.cycles : 0.0;
+            result->LastCycleMicroseconds = snapshot.lastNs / 1000.0;
+            result->WorstCycleMicroseconds = snapshot.worstNs / 1000.0;
+            result->WorstCycleBudgetPercent = snapshot.worstBudgetNs > 0 ? snapshot.worstNs * 100.0 / snapshot.worstBudgetNs : 0.0;
+            result->OverBudgetCycles = snapshot.overBudgetCycles;
+
+            const int buckets = emp::TelemetrySnapshot::kHistogramBuckets;
+            result->HistogramUpperBoundsMicroseconds = gcnew array<double>(buckets);
+            result->HistogramCounts = gcnew array<UInt64>(buckets);
+            for (int i = 0; i < buckets; i++) {
+                result->HistogramUpperBoundsMicroseconds[i] = i < buckets - 1 ? static_cast<double>(2ull << i) / 1000.0 : Double::PositiveInfinity;
+                result->HistogramCounts[i] = snapshot.histogram[i];
+            }
+
+            result->ArenasLocked = snapshot.arenasLocked;
+            result->MixedChannels = snapshot.mixedChannels;
+            result->IdleChannels = snapshot.idleChannels;
+            result->InsertChannels = snapshot.insertChannels;
+            result->BypassedInserts = snapshot.bypassedInserts;
+            result->DroppedCompletions = snapshot.droppedCompletions;
+            result->XrunCount = snapshot.xrunCount;
+            result->RecentXruns = gcnew array<XrunEvent>(static_cast<int>(snapshot.recentXruns.size()));
+            for (int i = 0; i < result->RecentXruns->Length; i++) {
+                const auto& xrun = snapshot.recentXruns[i];
+                result->RecentXruns[i].TimestampUtc = DateTime(1970, 1, 1, 0, 0, 0, DateTimeKind::Utc).AddTicks(static_cast<Int64>(xrun.timestampUs) * 10);
+                result->RecentXruns[i].DelayedMicroseconds = xrun.delayedUs;
+                result->RecentXruns[i].Cycle = xrun.cycle;
+            }
+
+            result->PortLatencies = gcnew array<PortLatency>(static_cast<int>(snapshot.portLatencies.size()));
+            for (int i = 0; i < result->PortLatencies->Length; i++) {
+                const auto& port = snapshot.portLatencies[i];
+                result->PortLatencies[i].PortName = gcnew String(port.portName.c_str());
+                result->PortLatencies[i].CaptureMin = port.captureMin;
+                result->PortLatencies[i].CaptureMax = port.captureMax;
+                result->PortLatencies[i].PlaybackMin = port.playbackMin;
+                result->PortLatencies[i].PlaybackMax = port.playbackMax;
+            }
 
             return result;
         }
@@ -288,6 +589,20 @@ namespace MaiksMixer {
         }
     }
 
+    // Reset Telemetry
+    void JackBridge::ResetTelemetry()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Telemetry().Reset();
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
     // Connect Ports
     bool JackBridge::ConnectPorts(String^ sourcePort, String^ destPort)
     {
@@ -295,11 +610,11 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
             std::string nativeSourcePort = marshal_as<std::string>(sourcePort);
             std::string nativeDestPort = marshal_as<std::string>(destPort);
             
-            return bridge->ConnectPorts(nativeSourcePort, nativeDestPort);
+            return client->ConnectPorts(nativeSourcePort, nativeDestPort);
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -313,11 +628,98 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
             std::string nativeSourcePort = marshal_as<std::string>(sourcePort);
             std::string nativeDestPort = marshal_as<std::string>(destPort);
             
-            return bridge->DisconnectPorts(nativeSourcePort, nativeDestPort);
+            return client->DisconnectPorts(nativeSourcePort, nativeDestPort);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Port Handle
+    int JackBridge::GetPortHandle(String^ portName)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (portName == nullptr) throw gcnew ArgumentNullException("portName");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->PortHandles().Intern(marshal_as<std::string>(portName));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Port Handles
+    array<int>^ JackBridge::GetPortHandles(array<String^>^ portNames)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (portNames == nullptr) throw gcnew ArgumentNullException("portNames");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            array<int>^ result = gcnew array<int>(portNames->Length);
+            for (int i = 0; i < portNames->Length; i++) {
+                result[i] = portNames[i] != nullptr
+                    ? engine->PortHandles().Intern(marshal_as<std::string>(portNames[i]))
+                    : emp::PortHandleTable::kInvalidHandle;
+            }
+
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Port Name
+    String^ JackBridge::GetPortName(int handle)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            std::string nativeName;
+            if (!engine->PortHandles().GetName(handle, nativeName)) return nullptr;
+            return gcnew String(nativeName.c_str());
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Apply Connection Changes
+    array<PortConnectionResult>^ JackBridge::ApplyConnectionChanges(array<PortConnectionChange>^ changes)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (changes == nullptr) throw gcnew ArgumentNullException("changes");
+
+        array<PortConnectionResult>^ results = gcnew array<PortConnectionResult>(changes->Length);
+        if (changes->Length == 0) return results;
+
+        try {
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            // Both arrays are blittable and share the native layouts
+            pin_ptr<PortConnectionChange> pinnedChanges = &changes[0];
+            pin_ptr<PortConnectionResult> pinnedResults = &results[0];
+
+            engine->PortHandles().ApplyConnectionChanges(
+                reinterpret_cast<const emp::PortConnectionChange*>(pinnedChanges), changes->Length,
+                reinterpret_cast<emp::PortConnectionResult*>(pinnedResults), engine->PortGraph(),
+                [client](const std::string& source, const std::string& destination, bool connect) {
+                    return connect ? client->ConnectPorts(source, destination) : client->DisconnectPorts(source, destination);
+                });
+
+            return results;
         }
         catch (const std::exception& ex) {
             throw gcnew System::Exception(gcnew String(ex.what()));
@@ -331,10 +733,10 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
             std::string nativePortType = marshal_as<std::string>(portType);
             
-            auto nativePorts = bridge->GetPortList(nativePortType, flags);
+            auto nativePorts = client->GetPortList(nativePortType, flags);
             
             // Convert to managed array
             array<String^>^ result = gcnew array<String^>(nativePorts.size());
@@ -356,8 +758,13 @@ namespace MaiksMixer {
         if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
 
         try {
-            auto bridge = static_cast<emp::MaiksMixerBridge*>(_nativeImpl);
-            auto nativePorts = bridge->GetPorts();
+            auto client = static_cast<emp::JackEngineClient*>(_nativeImpl);
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            // Use the notification-driven cache once it has been seeded
+            std::vector<emp::PortGraphPort> nativePorts = engine->PortGraph().IsSeeded()
+                ? engine->PortGraph().GetPorts()
+                : client->QueryPorts();
             
             // Convert to managed list
             auto result = gcnew System::Collections::Generic::List<System::Collections::Generic::Dictionary<String^, Object^>^>();
@@ -390,18 +797,791 @@ namespace MaiksMixer {
         }
     }
 
-    // Callback for server status changes
-    void JackBridge::ServerStatusChangedCallback(bool isRunning, void* userData)
+    // Get Port Graph Changes
+    PortGraphChanges^ JackBridge::GetPortGraphChanges(UInt64 sinceVersion)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            std::vector<emp::PortGraphChange> nativeChanges;
+            bool fullSnapshot = false;
+            uint64_t version = engine->PortGraph().GetChanges(sinceVersion, nativeChanges, fullSnapshot);
+
+            auto result = gcnew PortGraphChanges();
+            result->Version = version;
+            result->IsFullSnapshot = fullSnapshot;
+            result->Changes = gcnew System::Collections::Generic::List<PortGraphChange^>(static_cast<int>(nativeChanges.size()));
+
+            for (const auto& nativeChange : nativeChanges) {
+                auto change = gcnew PortGraphChange();
+                change->Version = nativeChange.version;
+                change->Kind = static_cast<PortGraphChangeKind>(nativeChange.kind);
+                change->PortName = gcnew String(nativeChange.portName.c_str());
+                change->OtherPortName = gcnew String(nativeChange.otherPortName.c_str());
+                change->Type = gcnew String(nativeChange.type.c_str());
+                change->Flags = nativeChange.flags;
+                result->Changes->Add(change);
+            }
+
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Audio Route
+    bool JackBridge::SetAudioRoute(int inputChannel, int outputPort, bool enabled, float volume)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Routing().SetRoute(inputChannel, outputPort, enabled ? volume : 0.0f);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Clear Audio Routes
+    void JackBridge::ClearAudioRoutes()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Routing().Clear();
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Routing Matrix Enabled
+    void JackBridge::SetRoutingMatrixEnabled(bool enabled)
     {
-        JackBridge^ bridge = static_cast<JackBridge^>(GCHandle::FromIntPtr(IntPtr(userData)).Target);
-        bridge->OnNativeServerStatusChanged(isRunning);
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Routing().SetEnabled(enabled);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
     }
 
-    // Callback for meter updates
-    void JackBridge::MeterUpdateCallback(int channel, const NativeMeterData& data, void* userData)
+    // Get Routing Matrix
+    array<float, 2>^ JackBridge::GetRoutingMatrix()
     {
-        JackBridge^ bridge = static_cast<JackBridge^>(GCHandle::FromIntPtr(IntPtr(userData)).Target);
-        bridge->OnNativeMeterUpdated(channel, data);
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            std::vector<float> gains;
+            int numInputs = 0;
+            int numOutputs = 0;
+            engine->Routing().GetMatrix(gains, numInputs, numOutputs);
+
+            // Convert to managed array
+            array<float, 2>^ result = gcnew array<float, 2>(numInputs, numOutputs);
+            for (int i = 0; i < numInputs; i++) {
+                for (int o = 0; o < numOutputs; o++) {
+                    result[i, o] = gains[static_cast<size_t>(i) * numOutputs + o];
+                }
+            }
+
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Channel Inserts
+    bool JackBridge::SetChannelInserts(int channel, ChannelInsertSettings^ settings)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (settings == nullptr) throw gcnew ArgumentNullException("settings");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::ChannelInsertParams params;
+            const int bands = settings->Eq != nullptr ? std::min(settings->Eq->Length, emp::ChannelInsertParams::kEqBands) : 0;
+            for (int b = 0; b < bands; b++) {
+                EqBand band = settings->Eq[b];
+                params.eq[b].type = static_cast<emp::EqBandType>(band.Type);
+                params.eq[b].frequency = band.Frequency;
+                params.eq[b].gainDb = band.GainDb;
+                params.eq[b].q = band.Q;
+                params.eq[b].enabled = band.Enabled;
+            }
+
+            GateSettings gate = settings->Gate;
+            params.gate.thresholdDb = gate.ThresholdDb;
+            params.gate.rangeDb = gate.RangeDb;
+            params.gate.attackMs = gate.AttackMs;
+            params.gate.releaseMs = gate.ReleaseMs;
+            params.gate.enabled = gate.Enabled;
+
+            CompressorSettings compressor = settings->Compressor;
+            params.compressor.thresholdDb = compressor.ThresholdDb;
+            params.compressor.ratio = compressor.Ratio;
+            params.compressor.attackMs = compressor.AttackMs;
+            params.compressor.releaseMs = compressor.ReleaseMs;
+            params.compressor.makeupDb = compressor.MakeupDb;
+            params.compressor.enabled = compressor.Enabled;
+
+            params.bypass = settings->Bypass;
+            return engine->Inserts().SetChannel(channel, params);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Channel Inserts
+    ChannelInsertSettings^ JackBridge::GetChannelInserts(int channel)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::ChannelInsertParams params;
+            if (!engine->Inserts().GetChannel(channel, params)) return nullptr;
+
+            ChannelInsertSettings^ result = gcnew ChannelInsertSettings();
+            result->Eq = gcnew array<EqBand>(emp::ChannelInsertParams::kEqBands);
+            for (int b = 0; b < emp::ChannelInsertParams::kEqBands; b++) {
+                EqBand band;
+                band.Type = static_cast<EqBandType>(params.eq[b].type);
+                band.Frequency = params.eq[b].frequency;
+                band.GainDb = params.eq[b].gainDb;
+                band.Q = params.eq[b].q;
+                band.Enabled = params.eq[b].enabled;
+                result->Eq[b] = band;
+            }
+
+            GateSettings gate;
+            gate.ThresholdDb = params.gate.thresholdDb;
+            gate.RangeDb = params.gate.rangeDb;
+            gate.AttackMs = params.gate.attackMs;
+            gate.ReleaseMs = params.gate.releaseMs;
+            gate.Enabled = params.gate.enabled;
+            result->Gate = gate;
+
+            CompressorSettings compressor;
+            compressor.ThresholdDb = params.compressor.thresholdDb;
+            compressor.Ratio = params.compressor.ratio;
+            compressor.AttackMs = params.compressor.attackMs;
+            compressor.ReleaseMs = params.compressor.releaseMs;
+            compressor.MakeupDb = params.compressor.makeupDb;
+            compressor.Enabled = params.compressor.enabled;
+            result->Compressor = compressor;
+
+            result->Bypass = params.bypass;
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Insert Bypass
+    bool JackBridge::SetInsertBypass(int channel, bool bypass)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Inserts().SetBypass(channel, bypass);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Capture Scene
+    MixerScene^ JackBridge::CaptureScene()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            const emp::SceneSnapshot snapshot = engine->CaptureScene();
+
+            MixerScene^ result = gcnew MixerScene();
+            result->Channels = gcnew array<SceneChannel>(static_cast<int>(snapshot.channels.size()));
+            for (int i = 0; i < result->Channels->Length; i++) {
+                const emp::ChannelParams& params = snapshot.channels[i];
+                SceneChannel channel;
+                channel.Volume = params.volume;
+                channel.Pan = params.pan;
+                channel.GainDb = 20.0f * std::log10(std::max(params.gain, 1.0e-6f));
+                channel.Mute = params.mute;
+                channel.Solo = params.solo;
+                result->Channels[i] = channel;
+            }
+
+            result->Routes = gcnew array<float, 2>(snapshot.routeInputs, snapshot.routeOutputs);
+            for (int i = 0; i < snapshot.routeInputs; i++) {
+                for (int o = 0; o < snapshot.routeOutputs; o++) {
+                    result->Routes[i, o] = snapshot.routes[static_cast<size_t>(i) * snapshot.routeOutputs + o];
+                }
+            }
+            result->RoutingEnabled = snapshot.routingEnabled;
+
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Compile Scene
+    CompiledMixerScene^ JackBridge::CompileScene(MixerScene^ scene)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (scene == nullptr) throw gcnew ArgumentNullException("scene");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::SceneSnapshot snapshot;
+            if (scene->Channels != nullptr) {
+                snapshot.channels.resize(scene->Channels->Length);
+                for (int i = 0; i < scene->Channels->Length; i++) {
+                    SceneChannel channel = scene->Channels[i];
+                    emp::ChannelParams& params = snapshot.channels[i];
+                    emp::ApplyParameterChange(params, emp::ParameterId::Volume, channel.Volume);
+                    emp::ApplyParameterChange(params, emp::ParameterId::Pan, channel.Pan);
+                    emp::ApplyParameterChange(params, emp::ParameterId::GainDb, channel.GainDb);
+                    params.mute = channel.Mute;
+                    params.solo = channel.Solo;
+                }
+            }
+
+            if (scene->Routes != nullptr) {
+                snapshot.routeInputs = scene->Routes->GetLength(0);
+                snapshot.routeOutputs = scene->Routes->GetLength(1);
+                snapshot.routes.resize(static_cast<size_t>(snapshot.routeInputs) * snapshot.routeOutputs);
+                for (int i = 0; i < snapshot.routeInputs; i++) {
+                    for (int o = 0; o < snapshot.routeOutputs; o++) {
+                        snapshot.routes[static_cast<size_t>(i) * snapshot.routeOutputs + o] = scene->Routes[i, o];
+                    }
+                }
+            }
+            snapshot.routingEnabled = scene->RoutingEnabled;
+
+            return gcnew CompiledMixerScene(new std::shared_ptr<const emp::CompiledScene>(engine->CompileScene(snapshot)));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Recall Scene
+    UInt32 JackBridge::RecallScene(CompiledMixerScene^ scene, float crossfadeMs)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (scene == nullptr) throw gcnew ArgumentNullException("scene");
+
+        auto nativeScene = static_cast<std::shared_ptr<const emp::CompiledScene>*>(scene->GetNativeScene());
+        if (nativeScene == nullptr) throw gcnew ObjectDisposedException("CompiledMixerScene");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->RecallScene(*nativeScene, crossfadeMs);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Analysis Tap
+    bool JackBridge::SetAnalysisTap(TapSource source, int index, bool enabled)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Analysis().SetEnabled(static_cast<emp::TapSource>(source), index, enabled);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Analysis
+    AnalysisData^ JackBridge::GetAnalysis(TapSource source, int index)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::AnalysisFrame frame;
+            if (!engine->Analysis().GetFrame(static_cast<emp::TapSource>(source), index, frame)) return nullptr;
+
+            AnalysisData^ data = gcnew AnalysisData();
+            data->Spectrum = gcnew array<float>(static_cast<int>(frame.spectrum.size()));
+            if (!frame.spectrum.empty()) {
+                pin_ptr<float> destination = &data->Spectrum[0];
+                std::copy(frame.spectrum.begin(), frame.spectrum.end(), static_cast<float*>(destination));
+            }
+            data->SampleRate = frame.sampleRate;
+            data->MomentaryLufs = frame.momentaryLufs;
+            data->ShortTermLufs = frame.shortTermLufs;
+            data->IntegratedLufs = frame.integratedLufs;
+            data->TruePeakDb = frame.truePeakDb;
+            data->DroppedBlocks = frame.droppedBlocks;
+            data->Sequence = frame.sequence;
+            return data;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Start Recording
+    bool JackBridge::StartRecording(RecordOptions^ options)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (options == nullptr) throw gcnew ArgumentNullException("options");
+        if (options->Path == nullptr) throw gcnew ArgumentNullException("options.Path");
+        if (options->Tracks == nullptr) return false;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::RecordOptions nativeOptions;
+            nativeOptions.path = marshal_as<std::string>(options->Path);
+            nativeOptions.format = static_cast<emp::RecordFormat>(options->Format);
+            nativeOptions.polyphonic = options->Polyphonic;
+            nativeOptions.tracks.reserve(options->Tracks->Length);
+            for (int i = 0; i < options->Tracks->Length; i++) {
+                RecordTrack track = options->Tracks[i];
+                emp::RecordTrack nativeTrack;
+                nativeTrack.source = static_cast<emp::TapSource>(track.Source);
+                nativeTrack.index = track.Index;
+                nativeOptions.tracks.push_back(nativeTrack);
+            }
+
+            return engine->Recorder().Start(nativeOptions);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Stop Recording
+    bool JackBridge::StopRecording()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Recorder().Stop();
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Recorder Status
+    RecorderStatus^ JackBridge::GetRecorderStatus()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::RecorderStatus status;
+            engine->Recorder().GetStatus(status);
+
+            RecorderStatus^ result = gcnew RecorderStatus();
+            result->IsRecording = status.recording;
+            result->SampleRate = status.sampleRate;
+            result->CapturedFrames = status.capturedFrames;
+            result->WrittenFrames = status.writtenFrames;
+            result->BytesWritten = status.bytesWritten;
+            result->DroppedBlocks = status.droppedBlocks;
+            result->RingFill = gcnew array<float>(static_cast<int>(status.ringFill.size()));
+            if (!status.ringFill.empty()) {
+                pin_ptr<float> destination = &result->RingFill[0];
+                std::copy(status.ringFill.begin(), status.ringFill.end(), static_cast<float*>(destination));
+            }
+            result->WriteFailed = status.writeFailed;
+            result->LimitReached = status.limitReached;
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Create Virtual Source
+    int JackBridge::CreateVirtualSource(VirtualSourceConfig^ config)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (config == nullptr) throw gcnew ArgumentNullException("config");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::VirtualSourceConfig nativeConfig;
+            nativeConfig.firstChannel = config->FirstChannel;
+            nativeConfig.channels = config->Channels;
+            nativeConfig.sampleRate = config->SampleRate;
+            nativeConfig.quality = static_cast<emp::ResamplerQuality>(config->Quality);
+            nativeConfig.latencyMs = config->LatencyMs;
+            return engine->VirtualSources().Create(nativeConfig);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Remove Virtual Source
+    bool JackBridge::RemoveVirtualSource(int id)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->VirtualSources().Remove(id);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Write Virtual Source
+    bool JackBridge::WriteVirtualSource(int id, array<float>^ interleaved, int frames)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (interleaved == nullptr) throw gcnew ArgumentNullException("interleaved");
+        if (frames < 0) throw gcnew ArgumentOutOfRangeException("frames");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            const int channels = engine->VirtualSources().GetChannels(id);
+            if (channels == 0) return false;
+            if (static_cast<int64_t>(frames) * channels > interleaved->Length) throw gcnew ArgumentException("interleaved is shorter than frames");
+            if (frames == 0) return true;
+
+            pin_ptr<float> samples = &interleaved[0];
+            return engine->VirtualSources().Write(id, samples, static_cast<uint32_t>(frames));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Virtual Source Status
+    VirtualSourceStatus^ JackBridge::GetVirtualSourceStatus(int id)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::VirtualSourceStatus status;
+            if (!engine->VirtualSources().GetStatus(id, status)) return nullptr;
+
+            VirtualSourceStatus^ result = gcnew VirtualSourceStatus();
+            result->IsStreaming = status.streaming;
+            result->IsLocked = status.locked;
+            result->Ratio = status.ratio;
+            result->DriftPpm = status.driftPpm;
+            result->FillFrames = status.fillFrames;
+            result->TargetFrames = status.targetFrames;
+            result->Underruns = status.underruns;
+            result->Overruns = status.overruns;
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Create Bus
+    int JackBridge::CreateBus(BusConfig^ config)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (config == nullptr) throw gcnew ArgumentNullException("config");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::BusConfig nativeConfig;
+            nativeConfig.type = static_cast<emp::BusType>(config->Type);
+            nativeConfig.channels = config->Channels;
+            nativeConfig.volume = config->Volume;
+            nativeConfig.mute = config->Mute;
+            nativeConfig.firstOutput = config->FirstOutput;
+            return engine->Buses().CreateBus(nativeConfig);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Remove Bus
+    bool JackBridge::RemoveBus(int id)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Buses().RemoveBus(id);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Bus
+    BusGraphStatus JackBridge::SetBus(int id, BusConfig^ config)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (config == nullptr) throw gcnew ArgumentNullException("config");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::BusConfig nativeConfig;
+            nativeConfig.type = static_cast<emp::BusType>(config->Type);
+            nativeConfig.channels = config->Channels;
+            nativeConfig.volume = config->Volume;
+            nativeConfig.mute = config->Mute;
+            nativeConfig.firstOutput = config->FirstOutput;
+            return static_cast<BusGraphStatus>(engine->Buses().SetBus(id, nativeConfig));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Bus
+    BusConfig^ JackBridge::GetBus(int id)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::BusConfig config;
+            if (!engine->Buses().GetBus(id, config)) return nullptr;
+
+            BusConfig^ result = gcnew BusConfig();
+            result->Type = static_cast<BusType>(config.type);
+            result->Channels = config.channels;
+            result->Volume = config.volume;
+            result->Mute = config.mute;
+            result->FirstOutput = config.firstOutput;
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Send
+    BusGraphStatus JackBridge::SetSend(BusSend^ send)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (send == nullptr) throw gcnew ArgumentNullException("send");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            emp::BusSend nativeSend;
+            nativeSend.sourceType = static_cast<emp::SendSource>(send->SourceType);
+            nativeSend.source = send->Source;
+            nativeSend.destination = send->Destination;
+            nativeSend.tap = static_cast<emp::SendTap>(send->Tap);
+            nativeSend.level = send->Level;
+            nativeSend.pan = send->Pan;
+            return static_cast<BusGraphStatus>(engine->Buses().SetSend(nativeSend));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Remove Send
+    bool JackBridge::RemoveSend(SendSource sourceType, int source, int destination)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            return engine->Buses().RemoveSend(static_cast<emp::SendSource>(sourceType), source, destination);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Sends
+    array<BusSend^>^ JackBridge::GetSends()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            std::vector<emp::BusSend> sends;
+            engine->Buses().GetSends(sends);
+
+            array<BusSend^>^ result = gcnew array<BusSend^>(static_cast<int>(sends.size()));
+            for (size_t i = 0; i < sends.size(); i++) {
+                BusSend^ send = gcnew BusSend();
+                send->SourceType = static_cast<SendSource>(sends[i].sourceType);
+                send->Source = sends[i].source;
+                send->Destination = sends[i].destination;
+                send->Tap = static_cast<SendTap>(sends[i].tap);
+                send->Level = sends[i].level;
+                send->Pan = sends[i].pan;
+                result[static_cast<int>(i)] = send;
+            }
+            return result;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get Channel Meter
+    MeterData^ JackBridge::GetChannelMeter(int channel)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            auto meter = engine->GetChannelMeter(channel);
+
+            MeterData^ meterData = gcnew MeterData();
+            meterData->Peak = meter.peak;
+            meterData->Rms = meter.rms;
+            return meterData;
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Get All Meters
+    int JackBridge::GetAllMeters(array<float>^ meters)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (!_isInitialized) throw gcnew System::InvalidOperationException("JACK client is not initialized");
+        if (meters == nullptr) throw gcnew ArgumentNullException("meters");
+        if (meters->Length == 0) return 0;
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+
+            // Pin the caller's array and let the engine copy straight into it
+            pin_ptr<float> destination = &meters[0];
+            return engine->Meters().CopyTo(destination, meters->Length);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Set Meter Refresh Rate
+    void JackBridge::SetMeterRefreshRate(float refreshRateHz, float peakHoldSeconds)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Meters().Configure(refreshRateHz, peakHoldSeconds);
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Reset Meter Clips
+    void JackBridge::ResetMeterClips()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto engine = static_cast<emp::MixEngine*>(_nativeEngine);
+            engine->Meters().ResetClipCounters();
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Start Shared Memory Transport
+    bool JackBridge::StartSharedMemoryTransport(String^ name)
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+        if (name == nullptr) throw gcnew ArgumentNullException("name");
+
+        try {
+            auto transport = static_cast<emp::SharedMemoryTransport*>(_nativeTransport);
+            return transport->Start(marshal_as<std::string>(name));
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
+    }
+
+    // Stop Shared Memory Transport
+    void JackBridge::StopSharedMemoryTransport()
+    {
+        if (_isDisposed) throw gcnew ObjectDisposedException("JackBridge");
+
+        try {
+            auto transport = static_cast<emp::SharedMemoryTransport*>(_nativeTransport);
+            transport->Stop();
+        }
+        catch (const std::exception& ex) {
+            throw gcnew System::Exception(gcnew String(ex.what()));
+        }
     }
 
     // Handle server status change
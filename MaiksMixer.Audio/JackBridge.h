@@ -25,18 +25,863 @@ namespace MaiksMixer {
         property float Rms;
     };
 
+    /// <summary>
+    /// Kind of change to the JACK port graph
+    /// </summary>
+    public enum class PortGraphChangeKind
+    {
+        PortAdded,
+        PortRemoved,
+        PortRenamed,
+        Connected,
+        Disconnected
+    };
+
+    /// <summary>
+    /// One change to the JACK port graph
+    /// </summary>
+    public ref class PortGraphChange
+    {
+    public:
+        /// <summary>
+        /// Graph version produced by this change
+        /// </summary>
+        property UInt64 Version;
+
+        /// <summary>
+        /// Kind of change
+        /// </summary>
+        property PortGraphChangeKind Kind;
+
+        /// <summary>
+        /// Port the change applies to (the source port for connection changes)
+        /// </summary>
+        property String^ PortName;
+
+        /// <summary>
+        /// Destination port for connection changes, previous name for renames
+        /// </summary>
+        property String^ OtherPortName;
+
+        /// <summary>
+        /// Port type (PortAdded only)
+        /// </summary>
+        property String^ Type;
+
+        /// <summary>
+        /// JACK port flags (PortAdded only)
+        /// </summary>
+        property unsigned int Flags;
+    };
+
+    /// <summary>
+    /// Changes to the JACK port graph since a given version
+    /// </summary>
+    public ref class PortGraphChanges
+    {
+    public:
+        /// <summary>
+        /// Current graph version, to pass as sinceVersion on the next call
+        /// </summary>
+        property UInt64 Version;
+
+        /// <summary>
+        /// True if Changes describes the whole graph (PortAdded and Connected entries)
+        /// rather than a delta, because the requested version is too old
+        /// </summary>
+        property bool IsFullSnapshot;
+
+        /// <summary>
+        /// Changes in the order they happened
+        /// </summary>
+        property System::Collections::Generic::List<PortGraphChange^>^ Changes;
+    };
+
+    /// <summary>
+    /// Channel parameter addressed by a ParameterChange
+    /// </summary>
+    public enum class ChannelParameter : int
+    {
+        Volume = 0,     // 0.0 - 1.0
+        Pan = 1,        // 0.0 left, 0.5 center, 1.0 right
+        GainDb = 2,     // Gain in dB
+        Mute = 3,       // Non-zero mutes
+        Solo = 4        // Non-zero solos
+    };
+
+    /// <summary>
+    /// One channel parameter edit. Blittable; its layout matches the native
+    /// emp::ParameterChange.
+    /// </summary>
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct ParameterChange
+    {
+        /// <summary>
+        /// Channel index
+        /// </summary>
+        int Channel;
+
+        /// <summary>
+        /// Parameter to set
+        /// </summary>
+        ChannelParameter Parameter;
+
+        /// <summary>
+        /// New value
+        /// </summary>
+        float Value;
+
+        ParameterChange(int channel, ChannelParameter parameter, float value)
+            : Channel(channel), Parameter(parameter), Value(value)
+        {
+        }
+    };
+
+    /// <summary>
+    /// Curve a parameter follows to a new value (matches the native emp::RampShape)
+    /// </summary>
+    public enum class RampShape : int
+    {
+        Step = 0,           // Jumps to the new value
+        Linear = 1,         // Constant rate over the ramp time
+        Exponential = 2     // One-pole approach, within -60 dB of the distance at the end
+    };
+
+    /// <summary>
+    /// Parameter change that lands on a given engine frame. Blittable; its layout matches
+    /// the native emp::TimedParameterChange.
+    /// </summary>
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct TimedParameterChange
+    {
+        /// <summary>
+        /// Engine frame time of the first frame using the new value (see GetFrameTime)
+        /// </summary>
+        UInt64 FrameTime;
+
+        /// <summary>
+        /// Parameter edit
+        /// </summary>
+        ParameterChange Change;
+
+        /// <summary>
+        /// Ramp from the current value; mute and solo always step
+        /// </summary>
+        RampShape Shape;
+
+        /// <summary>
+        /// Ramp length in frames, 0 for a step
+        /// </summary>
+        UInt32 RampFrames;
+
+        TimedParameterChange(UInt64 frameTime, ParameterChange change, RampShape shape, UInt32 rampFrames)
+            : FrameTime(frameTime), Change(change), Shape(shape), RampFrames(rampFrames)
+        {
+        }
+    };
+
+    /// <summary>
+    /// Parameters of one channel in a MixerScene
+    /// </summary>
+    public value struct SceneChannel
+    {
+        /// <summary>
+        /// Fader position (0.0 - 1.0)
+        /// </summary>
+        float Volume;
+
+        /// <summary>
+        /// 0.0 left, 0.5 center, 1.0 right
+        /// </summary>
+        float Pan;
+
+        /// <summary>
+        /// Input gain in dB
+        /// </summary>
+        float GainDb;
+
+        bool Mute;
+        bool Solo;
+    };
+
+    /// <summary>
+    /// Complete mixer state: every channel's parameters and the routing matrix
+    /// </summary>
+    public ref class MixerScene
+    {
+    public:
+        /// <summary>
+        /// Channel parameters by channel index; channels beyond the array get defaults
+        /// </summary>
+        property array<SceneChannel>^ Channels;
+
+        /// <summary>
+        /// Route gains indexed by [input channel, output port]; may be null for no routes
+        /// </summary>
+        property array<float, 2>^ Routes;
+
+        /// <summary>
+        /// Whether matrix routing is enabled
+        /// </summary>
+        property bool RoutingEnabled;
+    };
+
+    /// <summary>
+    /// Scene compiled for the native engine, ready to be recalled any number of times.
+    /// Only valid for the port capacity it was compiled for.
+    /// </summary>
+    public ref class CompiledMixerScene
+    {
+    private:
+        // Owning pointer to the native std::shared_ptr<const emp::CompiledScene>
+        void* _nativeScene;
+
+    internal:
+        CompiledMixerScene(void* nativeScene) : _nativeScene(nativeScene) {}
+        void* GetNativeScene() { return _nativeScene; }
+
+    public:
+        /// <summary>
+        /// Finalizer
+        /// </summary>
+        ~CompiledMixerScene();
+
+        /// <summary>
+        /// Destructor
+        /// </summary>
+        !CompiledMixerScene();
+    };
+
+    /// <summary>
+    /// Filter shape of an EQ band (matches the native emp::EqBandType)
+    /// </summary>
+    public enum class EqBandType : int
+    {
+        Peak = 0,
+        LowShelf = 1,
+        HighShelf = 2,
+        HighPass = 3,       // 12 dB/octave, gain unused
+        LowPass = 4         // 12 dB/octave, gain unused
+    };
+
+    /// <summary>
+    /// One band of a channel's parametric EQ
+    /// </summary>
+    public value struct EqBand
+    {
+        EqBandType Type;
+
+        /// <summary>
+        /// Center or corner frequency in Hz
+        /// </summary>
+        float Frequency;
+
+        float GainDb;
+
+        /// <summary>
+        /// Bandwidth, or shelf slope
+        /// </summary>
+        float Q;
+
+        bool Enabled;
+    };
+
+    /// <summary>
+    /// Noise gate settings: attenuates by RangeDb while the signal stays below ThresholdDb
+    /// </summary>
+    public value struct GateSettings
+    {
+        float ThresholdDb;
+        float RangeDb;
+        float AttackMs;
+        float ReleaseMs;
+        bool Enabled;
+    };
+
+    /// <summary>
+    /// Compressor settings (feed-forward, hard knee)
+    /// </summary>
+    public value struct CompressorSettings
+    {
+        float ThresholdDb;
+        float Ratio;
+        float AttackMs;
+        float ReleaseMs;
+        float MakeupDb;
+        bool Enabled;
+    };
+
+    /// <summary>
+    /// Insert chain of one channel, run before its fader: EQ, then gate, then compressor
+    /// </summary>
+    public ref class ChannelInsertSettings
+    {
+    public:
+        /// <summary>
+        /// EQ bands in processing order (JackBridge::EqBandsPerChannel entries)
+        /// </summary>
+        property array<EqBand>^ Eq;
+
+        property GateSettings Gate;
+        property CompressorSettings Compressor;
+
+        /// <summary>
+        /// Skips the whole chain, keeping its settings
+        /// </summary>
+        property bool Bypass;
+    };
+
+    /// <summary>
+    /// Signal an analysis tap measures (matches the native emp::TapSource)
+    /// </summary>
+    public enum class TapSource : int
+    {
+        Channel = 0,    // Input channel, pre-fader
+        Output = 1      // Output port
+    };
+
+    /// <summary>
+    /// Latest spectrum and loudness of an analysis tap
+    /// </summary>
+    public ref class AnalysisData
+    {
+    public:
+        /// <summary>
+        /// Magnitude spectrum in dBFS; bin k is at k * SampleRate / ((Spectrum.Length - 1) * 2) Hz
+        /// </summary>
+        property array<float>^ Spectrum;
+
+        /// <summary>
+        /// Sample rate the tap was measured at
+        /// </summary>
+        property UInt32 SampleRate;
+
+        /// <summary>
+        /// EBU R128 momentary (400 ms), short-term (3 s) and gated integrated loudness in LUFS
+        /// </summary>
+        property float MomentaryLufs;
+        property float ShortTermLufs;
+        property float IntegratedLufs;
+
+        /// <summary>
+        /// Highest true peak since the tap was enabled, in dBTP
+        /// </summary>
+        property float TruePeakDb;
+
+        /// <summary>
+        /// Audio cycles lost because analysis fell behind
+        /// </summary>
+        property UInt64 DroppedBlocks;
+
+        /// <summary>
+        /// Increments with every update, 0 before the first
+        /// </summary>
+        property UInt64 Sequence;
+    };
+
+    /// <summary>
+    /// Container of a recording, always 32-bit float (matches the native emp::RecordFormat)
+    /// </summary>
+    public enum class RecordFormat : int
+    {
+        Wav = 0,        // Limited to 4 GiB per file
+        Wave64 = 1
+    };
+
+    /// <summary>
+    /// Signal recorded to one track
+    /// </summary>
+    public value struct RecordTrack
+    {
+        /// <summary>
+        /// Input channel (pre-insert, pre-fader) or output bus
+        /// </summary>
+        TapSource Source;
+
+        int Index;
+    };
+
+    /// <summary>
+    /// What a recording captures and where it goes
+    /// </summary>
+    public ref class RecordOptions
+    {
+    public:
+        /// <summary>
+        /// Path without extension. A polyphonic recording writes Path.wav/.w64; otherwise each
+        /// track gets its own file named after its source, e.g. Path-in03.wav or Path-out01.wav.
+        /// </summary>
+        property String^ Path;
+
+        property RecordFormat Format;
+
+        /// <summary>
+        /// One interleaved file instead of one file per track
+        /// </summary>
+        property bool Polyphonic;
+
+        property array<RecordTrack>^ Tracks;
+    };
+
+    /// <summary>
+    /// Progress of the current or last recording
+    /// </summary>
+    public ref class RecorderStatus
+    {
+    public:
+        property bool IsRecording;
+        property UInt32 SampleRate;
+
+        /// <summary>
+        /// Frames per track queued by the audio thread and written to disk
+        /// </summary>
+        property UInt64 CapturedFrames;
+        property UInt64 WrittenFrames;
+
+        /// <summary>
+        /// Sample data written to all files
+        /// </summary>
+        property UInt64 BytesWritten;
+
+        /// <summary>
+        /// Audio cycles lost because the disk fell behind
+        /// </summary>
+        property UInt64 DroppedBlocks;
+
+        /// <summary>
+        /// Fill level of each track's buffer, 0 to 1
+        /// </summary>
+        property array<float>^ RingFill;
+
+        /// <summary>
+        /// A write failed (disk full or removed); the recording keeps running without being stored
+        /// </summary>
+        property bool WriteFailed;
+
+        /// <summary>
+        /// A WAV file reached its 4 GiB limit
+        /// </summary>
+        property bool LimitReached;
+    };
+
+    /// <summary>
+    /// Filter length of a virtual source's resampler, trading alias rejection for CPU time
+    /// (matches the native emp::ResamplerQuality)
+    /// </summary>
+    public enum class ResamplerQuality : int
+    {
+        Low = 0,        // 16 taps
+        Medium = 1,     // 32 taps
+        High = 2        // 64 taps
+    };
+
+    /// <summary>
+    /// A device on its own clock that feeds a range of input channels
+    /// </summary>
+    public ref class VirtualSourceConfig
+    {
+    public:
+        VirtualSourceConfig()
+        {
+            Channels = 2;
+            SampleRate = 48000;
+            Quality = ResamplerQuality::Medium;
+            LatencyMs = 20.0f;
+        }
+
+        /// <summary>
+        /// Input channel fed by the device's first channel
+        /// </summary>
+        property int FirstChannel;
+
+        property int Channels;
+
+        /// <summary>
+        /// The device's nominal sample rate
+        /// </summary>
+        property UInt32 SampleRate;
+
+        property ResamplerQuality Quality;
+
+        /// <summary>
+        /// Audio kept buffered between the device and the mixer; must cover the server's period
+        /// plus the device's packet period
+        /// </summary>
+        property float LatencyMs;
+    };
+
+    /// <summary>
+    /// Clock tracking state of a virtual source
+    /// </summary>
+    public ref class VirtualSourceStatus
+    {
+    public:
+        /// <summary>
+        /// False while the buffer (re)fills to its target
+        /// </summary>
+        property bool IsStreaming;
+
+        /// <summary>
+        /// Past the fast acquisition phase
+        /// </summary>
+        property bool IsLocked;
+
+        /// <summary>
+        /// Device frames consumed per mixer frame
+        /// </summary>
+        property double Ratio;
+
+        /// <summary>
+        /// Measured deviation of the device's clock from its nominal rate
+        /// </summary>
+        property double DriftPpm;
+
+        property float FillFrames;
+        property float TargetFrames;
+
+        /// <summary>
+        /// Cycles the device had not delivered enough
+        /// </summary>
+        property UInt64 Underruns;
+
+        /// <summary>
+        /// Writes rejected because the buffer was full
+        /// </summary>
+        property UInt64 Overruns;
+    };
+
+    /// <summary>
+    /// Role of a bus (matches the native emp::BusType)
+    /// </summary>
+    public enum class BusType : int
+    {
+        Aux = 0,            // Monitor or effect mix fed by pre- or post-fader sends
+        Subgroup = 1,       // Post-fader channel assignments, usually sent on to the master
+        Master = 2          // At most one; sends to nothing but its outputs
+    };
+
+    /// <summary>
+    /// Where a send leaves its source (matches the native emp::SendTap)
+    /// </summary>
+    public enum class SendTap : int
+    {
+        PreFader = 0,       // After the source's gain and inserts, before its volume
+        PostFader = 1
+    };
+
+    /// <summary>
+    /// Kind of node a send starts from (matches the native emp::SendSource)
+    /// </summary>
+    public enum class SendSource : int
+    {
+        Channel = 0,
+        Bus = 1
+    };
+
+    /// <summary>
+    /// Result of a bus graph edit (matches the native emp::BusGraphStatus)
+    /// </summary>
+    public enum class BusGraphStatus : int
+    {
+        Applied = 0,
+        NotFound = -1,      // Unknown bus, or a channel beyond the capacity
+        Invalid = -2,       // The edit breaks a rule of the bus types
+        Cycle = -3,         // The edit would make a bus feed itself
+        Full = -4
+    };
+
+    /// <summary>
+    /// Settings of an aux, subgroup or master bus
+    /// </summary>
+    public ref class BusConfig
+    {
+    public:
+        BusConfig()
+        {
+            Type = BusType::Aux;
+            Channels = 2;
+            Volume = 1.0f;
+            FirstOutput = -1;
+        }
+
+        property BusType Type;
+
+        /// <summary>
+        /// 1 or 2
+        /// </summary>
+        property int Channels;
+
+        property float Volume;
+        property bool Mute;
+
+        /// <summary>
+        /// Output port of the bus's first channel, -1 if the bus only feeds other buses
+        /// </summary>
+        property int FirstOutput;
+    };
+
+    /// <summary>
+    /// A send from a channel or bus into a bus
+    /// </summary>
+    public ref class BusSend
+    {
+    public:
+        BusSend()
+        {
+            SourceType = SendSource::Channel;
+            Tap = SendTap::PostFader;
+            Level = 1.0f;
+            Pan = 0.5f;
+        }
+
+        property SendSource SourceType;
+
+        /// <summary>
+        /// Channel index or bus id
+        /// </summary>
+        property int Source;
+
+        /// <summary>
+        /// Bus id
+        /// </summary>
+        property int Destination;
+
+        property SendTap Tap;
+        property float Level;
+
+        /// <summary>
+        /// Mono sources into stereo buses; post-fader channel sends follow the channel's pan
+        /// </summary>
+        property float Pan;
+    };
+
+    /// <summary>
+    /// Result of a command executed by the audio thread
+    /// </summary>
+    public enum class CommandStatus : int
+    {
+        Applied = 0,
+        Rejected = -1
+    };
+
+    /// <summary>
+    /// Acknowledgement of a queued command. Blittable; its layout matches the native
+    /// emp::EngineCompletion.
+    /// </summary>
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct CommandCompletion
+    {
+        /// <summary>
+        /// Id returned when the command was queued
+        /// </summary>
+        UInt32 CommandId;
+
+        /// <summary>
+        /// Execution result
+        /// </summary>
+        CommandStatus Status;
+
+        /// <summary>
+        /// Process cycle the command took effect in
+        /// </summary>
+        UInt64 Cycle;
+    };
+
+    /// <summary>
+    /// Whether a PortConnectionChange connects or disconnects its ports
+    /// </summary>
+    public enum class PortConnectionAction : int
+    {
+        Disconnect = 0,
+        Connect = 1
+    };
+
+    /// <summary>
+    /// Outcome of one PortConnectionChange
+    /// </summary>
+    public enum class PortConnectionResult : int
+    {
+        Applied = 0,
+        Unchanged = 1,
+        InvalidHandle = -1,
+        Failed = -2
+    };
+
+    /// <summary>
+    /// One connection change, addressed by port handles. Blittable; its layout matches
+    /// the native emp::PortConnectionChange.
+    /// </summary>
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct PortConnectionChange
+    {
+        /// <summary>
+        /// Source port handle
+        /// </summary>
+        int SourceHandle;
+
+        /// <summary>
+        /// Destination port handle
+        /// </summary>
+        int DestinationHandle;
+
+        /// <summary>
+        /// Connect or disconnect
+        /// </summary>
+        PortConnectionAction Action;
+
+        PortConnectionChange(int sourceHandle, int destinationHandle, PortConnectionAction action)
+            : SourceHandle(sourceHandle), DestinationHandle(destinationHandle), Action(action)
+        {
+        }
+    };
+
+    /// <summary>
+    /// One xrun reported by the JACK server
+    /// </summary>
+    public value struct XrunEvent
+    {
+        /// <summary>
+        /// When the xrun was reported (UTC)
+        /// </summary>
+        DateTime TimestampUtc;
+
+        /// <summary>
+        /// Lateness reported by the server in microseconds (0 if unknown)
+        /// </summary>
+        float DelayedMicroseconds;
+
+        /// <summary>
+        /// Engine process cycles completed when the xrun was reported
+        /// </summary>
+        UInt64 Cycle;
+    };
+
+    /// <summary>
+    /// Capture and playback latency range of one of the client's ports, in frames
+    /// </summary>
+    public value struct PortLatency
+    {
+        String^ PortName;
+        UInt32 CaptureMin;
+        UInt32 CaptureMax;
+        UInt32 PlaybackMin;
+        UInt32 PlaybackMax;
+    };
+
+    /// <summary>
+    /// Real-time performance counters of the mix engine since start or the last reset
+    /// </summary>
+    public ref class DspTelemetry
+    {
+    public:
+        /// <summary>
+        /// Process cycles recorded
+        /// </summary>
+        property UInt64 Cycles;
+
+        /// <summary>
+        /// Mean, last and worst processing time of a cycle in microseconds
+        /// </summary>
+        property double MeanCycleMicroseconds;
+        property double LastCycleMicroseconds;
+        property double WorstCycleMicroseconds;
+
+        /// <summary>
+        /// Worst cycle as a percentage of its real-time budget (the period length)
+        /// </summary>
+        property double WorstCycleBudgetPercent;
+
+        /// <summary>
+        /// Cycles that took longer than their period
+        /// </summary>
+        property UInt64 OverBudgetCycles;
+
+        /// <summary>
+        /// Upper bound in microseconds of each histogram bucket (the last is open-ended)
+        /// </summary>
+        property array<double>^ HistogramUpperBoundsMicroseconds;
+
+        /// <summary>
+        /// Number of cycles per processing-time bucket (log2 buckets)
+        /// </summary>
+        property array<UInt64>^ HistogramCounts;
+
+        /// <summary>
+        /// True if the engine's per-cycle arenas are locked in RAM (the whole process when
+        /// locked with lockProcess); the rest of the engine heap can still page fault
+        /// </summary>
+        property bool ArenasLocked;
+
+        /// <summary>
+        /// Channels mixed in the last cycle
+        /// </summary>
+        property UInt32 MixedChannels;
+
+        /// <summary>
+        /// Audible channels skipped as silent in the last cycle
+        /// </summary>
+        property UInt32 IdleChannels;
+
+        /// <summary>
+        /// Channels whose insert chains ran in the last cycle
+        /// </summary>
+        property UInt32 InsertChannels;
+
+        /// <summary>
+        /// Channels whose insert chains are bypassed
+        /// </summary>
+        property UInt32 BypassedInserts;
+
+        /// <summary>
+        /// Command acknowledgements overwritten before anyone read them
+        /// </summary>
+        property UInt64 DroppedCompletions;
+
+        /// <summary>
+        /// Xruns reported by the server
+        /// </summary>
+        property UInt64 XrunCount;
+
+        /// <summary>
+        /// Most recent xruns, oldest first
+        /// </summary>
+        property array<XrunEvent>^ RecentXruns;
+
+        /// <summary>
+        /// Latency ranges of the client's ports
+        /// </summary>
+        property array<PortLatency>^ PortLatencies;
+    };
+
     /// <summary>
     /// Bridge class for interacting with the JACK audio system
     /// </summary>
     public ref class JackBridge
     {
     private:
-        // Pointer to the native implementation
+        // Pointer to the native JACK client (emp::JackEngineClient) that renders the engine
         void* _nativeImpl;
+        // Pointer to the native mix engine rendered by the JACK process callback
+        void* _nativeEngine;
+        // Shared-memory transport feeding the engine's meters and parameters to the UI
+        void* _nativeTransport;
+        // Channel-strip worker threads started on activation
+        int _workerThreadCount;
+        int _workerPriority;
         bool _isInitialized;
         bool _isDisposed;
 
     public:
+        /// <summary>
+        /// Number of values per channel written by GetAllMeters (peak, RMS, peak hold, clip count)
+        /// </summary>
+        literal int MeterValuesPerChannel = 4;
+
+        /// <summary>
+        /// Number of EQ bands in each channel's insert chain
+        /// </summary>
+        literal int EqBandsPerChannel = 4;
+
         /// <summary>
         /// Event raised when the JACK server status changes
         /// </summary>
@@ -77,6 +922,15 @@ namespace MaiksMixer {
         /// <returns>True if port creation was successful, false otherwise</returns>
         bool CreatePorts(int numInputs, int numOutputs);
 
+        /// <summary>
+        /// Adds or removes ports while the client may be active. Existing ports keep their
+        /// connections; removed channels lose their routes and parameters.
+        /// </summary>
+        /// <param name="numInputs">New number of input ports</param>
+        /// <param name="numOutputs">New number of output ports</param>
+        /// <returns>True if the ports were changed, false if a port could not be registered</returns>
+        bool ResizePorts(int numInputs, int numOutputs);
+
         /// <summary>
         /// Activates the JACK client
         /// </summary>
@@ -89,6 +943,14 @@ namespace MaiksMixer {
         /// <returns>True if deactivation was successful, false otherwise</returns>
         bool Deactivate();
 
+        /// <summary>
+        /// Sets the worker threads that share the channel strips of large graphs with the
+        /// process callback. Takes effect on the next Activate().
+        /// </summary>
+        /// <param name="workerCount">Threads besides the JACK process thread, 0 for single-threaded processing</param>
+        /// <param name="realtimePriority">SCHED_FIFO priority of the workers, 0 to leave them unprivileged</param>
+        void SetWorkerThreads(int workerCount, int realtimePriority);
+
         /// <summary>
         /// Sets the volume for a channel
         /// </summary>
@@ -124,6 +986,69 @@ namespace MaiksMixer {
         /// <param name="solo">Solo state</param>
         void SetChannelSolo(int channel, bool solo);
 
+        /// <summary>
+        /// Applies a block of channel parameter changes in one native call. The changes
+        /// are published to the audio thread together and take effect in the same cycle.
+        /// </summary>
+        /// <param name="changes">Parameter changes, applied in order</param>
+        /// <returns>Number of changes that addressed a valid channel and parameter</returns>
+        int ApplyParameterBatch(array<ParameterChange>^ changes);
+
+        /// <summary>
+        /// Queues parameter changes for the audio thread without waiting for them to be
+        /// applied. Each change is acknowledged through ReadCommandCompletions once the
+        /// process callback has executed it.
+        /// </summary>
+        /// <param name="changes">Parameter changes, applied in order</param>
+        /// <param name="commandIds">Receives one command id per change; 0 if the change was
+        /// invalid or the queue was full</param>
+        /// <returns>Number of changes queued</returns>
+        int PostParameterChanges(array<ParameterChange>^ changes, array<UInt32>^ commandIds);
+
+        /// <summary>
+        /// Copies the acknowledgements of executed commands into a caller-owned array
+        /// </summary>
+        /// <param name="completions">Destination array, reused between calls</param>
+        /// <returns>Number of acknowledgements written</returns>
+        int ReadCommandCompletions(array<CommandCompletion>^ completions);
+
+        /// <summary>
+        /// Queues parameter changes that land on the frames they are stamped with,
+        /// whatever the buffer size; the process callback splits its cycle at those frames.
+        /// Each change is acknowledged through ReadCommandCompletions once it is scheduled.
+        /// </summary>
+        /// <param name="changes">Timed parameter changes</param>
+        /// <param name="commandIds">Receives one command id per change; 0 if the change was
+        /// invalid or the queue was full</param>
+        /// <returns>Number of changes queued</returns>
+        int PostTimedParameterChanges(array<TimedParameterChange>^ changes, array<UInt32>^ commandIds);
+
+        /// <summary>
+        /// Gets the engine frame time of the first frame of the most recent cycle, the
+        /// reference for stamping TimedParameterChanges
+        /// </summary>
+        /// <returns>Frame time in frames since the server started</returns>
+        UInt64 GetFrameTime();
+
+        /// <summary>
+        /// Sets the ramp applied to untimed volume, pan and gain changes
+        /// </summary>
+        /// <param name="shape">Ramp shape, Step for hard changes</param>
+        /// <param name="milliseconds">Ramp length</param>
+        void SetParameterSmoothing(RampShape shape, float milliseconds);
+
+        /// <summary>
+        /// Enables or disables skipping channels whose input has been silent
+        /// </summary>
+        /// <param name="enabled">Whether silent channels are skipped</param>
+        void SetSilenceDetection(bool enabled);
+
+        /// <summary>
+        /// Sets the post-fader peak at or below which a channel counts as silent
+        /// </summary>
+        /// <param name="threshold">Linear peak; 0 (the default) skips only exact silence</param>
+        void SetSilenceThreshold(float threshold);
+
         /// <summary>
         /// Gets the sample rate from the JACK server
         /// </summary>
@@ -154,6 +1079,17 @@ namespace MaiksMixer {
         /// <returns>JackServerStatus object with server information</returns>
         System::Collections::Generic::Dictionary<String^, Object^>^ GetServerStatus();
 
+        /// <summary>
+        /// Gets the engine's cycle timing histogram, xrun history and port latencies
+        /// </summary>
+        /// <returns>Telemetry since the engine started or the last ResetTelemetry</returns>
+        DspTelemetry^ GetTelemetry();
+
+        /// <summary>
+        /// Clears the cycle statistics and xrun history
+        /// </summary>
+        void ResetTelemetry();
+
         /// <summary>
         /// Connects two JACK ports
         /// </summary>
@@ -170,6 +1106,37 @@ namespace MaiksMixer {
         /// <returns>True if disconnection was successful, false otherwise</returns>
         bool DisconnectPorts(String^ sourcePort, String^ destPort);
 
+        /// <summary>
+        /// Gets the handle for a port name. Handles are resolved once and stay valid for
+        /// the lifetime of the bridge.
+        /// </summary>
+        /// <param name="portName">Full JACK port name</param>
+        /// <returns>Port handle</returns>
+        int GetPortHandle(String^ portName);
+
+        /// <summary>
+        /// Gets the handles for several port names in one call
+        /// </summary>
+        /// <param name="portNames">Full JACK port names</param>
+        /// <returns>Port handles in the same order</returns>
+        array<int>^ GetPortHandles(array<String^>^ portNames);
+
+        /// <summary>
+        /// Gets the port name behind a handle
+        /// </summary>
+        /// <param name="handle">Port handle</param>
+        /// <returns>Port name, or nullptr for unknown handles</returns>
+        String^ GetPortName(int handle);
+
+        /// <summary>
+        /// Applies a batch of connect/disconnect operations in one native call, in order.
+        /// Changes that are already in effect are reported as Unchanged without contacting
+        /// the server.
+        /// </summary>
+        /// <param name="changes">Connection changes addressed by port handles</param>
+        /// <returns>One result per change</returns>
+        array<PortConnectionResult>^ ApplyConnectionChanges(array<PortConnectionChange>^ changes);
+
         /// <summary>
         /// Gets a list of all available JACK ports
         /// </summary>
@@ -184,13 +1151,242 @@ namespace MaiksMixer {
         /// <returns>List of JackPort objects</returns>
         System::Collections::Generic::List<System::Collections::Generic::Dictionary<String^, Object^>^>^ GetPorts();
 
+        /// <summary>
+        /// Gets the changes to the port graph since a version returned by an earlier call.
+        /// Served from the engine's cached graph without querying the JACK server.
+        /// </summary>
+        /// <param name="sinceVersion">Last version seen by the caller, 0 for the whole graph</param>
+        /// <returns>Changes since sinceVersion and the current version</returns>
+        PortGraphChanges^ GetPortGraphChanges(UInt64 sinceVersion);
+
+        /// <summary>
+        /// Sets a crosspoint of the native routing matrix
+        /// </summary>
+        /// <param name="inputChannel">Input channel index</param>
+        /// <param name="outputPort">Output port index</param>
+        /// <param name="enabled">Whether the route is enabled</param>
+        /// <param name="volume">Route gain (0.0 - 1.0)</param>
+        /// <returns>True if the crosspoint exists, false otherwise</returns>
+        bool SetAudioRoute(int inputChannel, int outputPort, bool enabled, float volume);
+
+        /// <summary>
+        /// Removes every route from the native routing matrix
+        /// </summary>
+        void ClearAudioRoutes();
+
+        /// <summary>
+        /// Enables or disables matrix routing. While disabled, inputs are panned across the
+        /// first two outputs.
+        /// </summary>
+        /// <param name="enabled">Whether matrix routing is enabled</param>
+        void SetRoutingMatrixEnabled(bool enabled);
+
+        /// <summary>
+        /// Gets the native routing matrix
+        /// </summary>
+        /// <returns>Route gains indexed by [input channel, output port]</returns>
+        array<float, 2>^ GetRoutingMatrix();
+
+        /// <summary>
+        /// Replaces a channel's insert chain (EQ, gate and compressor); values are clamped
+        /// to their ranges
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <param name="settings">Chain settings</param>
+        /// <returns>False if the channel is out of range</returns>
+        bool SetChannelInserts(int channel, ChannelInsertSettings^ settings);
+
+        /// <summary>
+        /// Gets a channel's insert chain as clamped
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <returns>Chain settings, or nullptr if the channel is out of range</returns>
+        ChannelInsertSettings^ GetChannelInserts(int channel);
+
+        /// <summary>
+        /// Bypasses or restores a channel's whole insert chain
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <param name="bypass">True to skip the chain</param>
+        /// <returns>False if the channel is out of range</returns>
+        bool SetInsertBypass(int channel, bool bypass);
+
+        /// <summary>
+        /// Captures the current channel parameters and routing matrix
+        /// </summary>
+        /// <returns>Scene holding the mixer's full state</returns>
+        MixerScene^ CaptureScene();
+
+        /// <summary>
+        /// Compiles a scene into the form the audio thread applies. Safe to call from a
+        /// background thread while audio is running, so recalls only swap.
+        /// </summary>
+        /// <param name="scene">Scene to compile</param>
+        /// <returns>Compiled scene for RecallScene</returns>
+        CompiledMixerScene^ CompileScene(MixerScene^ scene);
+
+        /// <summary>
+        /// Applies a compiled scene in one audio cycle, all parameters and routes at once,
+        /// optionally with an equal-power crossfade from the current mix
+        /// </summary>
+        /// <param name="scene">Compiled scene</param>
+        /// <param name="crossfadeMs">Crossfade length, 0 for a hard swap</param>
+        /// <returns>Command id acknowledged through ReadCommandCompletions, or 0 if the scene
+        /// does not fit the current port capacity or the queue is full</returns>
+        UInt32 RecallScene(CompiledMixerScene^ scene, float crossfadeMs);
+
+        /// <summary>
+        /// Enables or disables spectrum and loudness analysis of a channel or output. Analysis
+        /// runs on background threads; enabling restarts the tap's measurements.
+        /// </summary>
+        /// <param name="source">Channel or output</param>
+        /// <param name="index">Channel or output index</param>
+        /// <param name="enabled">True to analyze the signal</param>
+        /// <returns>False if the index is out of range</returns>
+        bool SetAnalysisTap(TapSource source, int index, bool enabled);
+
+        /// <summary>
+        /// Gets the latest analysis results of a tap
+        /// </summary>
+        /// <param name="source">Channel or output</param>
+        /// <param name="index">Channel or output index</param>
+        /// <returns>AnalysisData, or nullptr if the tap has never been enabled</returns>
+        AnalysisData^ GetAnalysis(TapSource source, int index);
+
+        /// <summary>
+        /// Starts recording channels and outputs to disk from the next cycle. The audio thread
+        /// only queues samples; a background writer stores them.
+        /// </summary>
+        /// <param name="options">Tracks, format and file path</param>
+        /// <returns>False if a recording is running or a track is out of range</returns>
+        bool StartRecording(RecordOptions^ options);
+
+        /// <summary>
+        /// Stops recording, writes everything still buffered and closes the files
+        /// </summary>
+        /// <returns>False if nothing was recording</returns>
+        bool StopRecording();
+
+        /// <summary>
+        /// Gets the progress of the current recording, or the final figures of the last one
+        /// </summary>
+        RecorderStatus^ GetRecorderStatus();
+
+        /// <summary>
+        /// Adds a device on its own clock whose audio replaces a range of input channels.
+        /// Its frames are resampled to the server rate, following the device's drift.
+        /// </summary>
+        /// <param name="config">Channels, nominal rate, quality and latency</param>
+        /// <returns>Id of the source, or 0 if the configuration is invalid or overlaps another source</returns>
+        int CreateVirtualSource(VirtualSourceConfig^ config);
+
+        /// <summary>
+        /// Removes a virtual source; its channels go back to their ports
+        /// </summary>
+        /// <returns>False if the id is unknown</returns>
+        bool RemoveVirtualSource(int id);
+
+        /// <summary>
+        /// Queues audio received from a virtual source's device
+        /// </summary>
+        /// <param name="id">Virtual source id</param>
+        /// <param name="interleaved">Interleaved samples, Channels per frame</param>
+        /// <param name="frames">Frames to queue</param>
+        /// <returns>False, queuing nothing, if the id is unknown or the buffer is full</returns>
+        bool WriteVirtualSource(int id, array<float>^ interleaved, int frames);
+
+        /// <summary>
+        /// Gets the clock tracking state of a virtual source
+        /// </summary>
+        /// <returns>VirtualSourceStatus, or nullptr if the id is unknown</returns>
+        VirtualSourceStatus^ GetVirtualSourceStatus(int id);
+
+        /// <summary>
+        /// Adds an aux, subgroup or master bus. Its outputs are summed onto the main mix.
+        /// </summary>
+        /// <param name="config">Type, channels, volume and outputs</param>
+        /// <returns>Id of the bus, or 0 if the configuration is invalid or the graph is full</returns>
+        int CreateBus(BusConfig^ config);
+
+        /// <summary>
+        /// Removes a bus with every send into or out of it
+        /// </summary>
+        /// <returns>False if the id is unknown</returns>
+        bool RemoveBus(int id);
+
+        /// <summary>
+        /// Changes a bus's settings
+        /// </summary>
+        BusGraphStatus SetBus(int id, BusConfig^ config);
+
+        /// <summary>
+        /// Gets a bus's settings
+        /// </summary>
+        /// <returns>BusConfig, or nullptr if the id is unknown</returns>
+        BusConfig^ GetBus(int id);
+
+        /// <summary>
+        /// Adds a send, or replaces the one with the same source and destination. Sends that
+        /// would make a bus feed itself are rejected with BusGraphStatus::Cycle.
+        /// </summary>
+        BusGraphStatus SetSend(BusSend^ send);
+
+        /// <summary>
+        /// Removes a send
+        /// </summary>
+        /// <returns>False if there is no such send</returns>
+        bool RemoveSend(SendSource sourceType, int source, int destination);
+
+        /// <summary>
+        /// Gets every send of the bus graph
+        /// </summary>
+        array<BusSend^>^ GetSends();
+
+        /// <summary>
+        /// Gets the latest meter data for a channel
+        /// </summary>
+        /// <param name="channel">Channel index</param>
+        /// <returns>MeterData object with peak and RMS values</returns>
+        MeterData^ GetChannelMeter(int channel);
+
+        /// <summary>
+        /// Copies the latest meters of all channels into a caller-owned array in one call.
+        /// Each channel occupies MeterValuesPerChannel consecutive values: peak, RMS,
+        /// peak hold and clip count.
+        /// </summary>
+        /// <param name="meters">Destination array, reused between calls</param>
+        /// <returns>Number of channels written</returns>
+        int GetAllMeters(array<float>^ meters);
+
+        /// <summary>
+        /// Sets how often the native engine publishes meters and how long peaks are held
+        /// </summary>
+        /// <param name="refreshRateHz">Meter refresh rate in Hz</param>
+        /// <param name="peakHoldSeconds">Peak hold time in seconds</param>
+        void SetMeterRefreshRate(float refreshRateHz, float peakHoldSeconds);
+
+        /// <summary>
+        /// Resets the clip counters of all channels
+        /// </summary>
+        void ResetMeterClips();
+
+        /// <summary>
+        /// Creates the shared-memory rings "&lt;name&gt;_EngineToUi" and
+        /// "&lt;name&gt;_UiToEngine" and starts publishing binary meter frames and applying
+        /// parameter change frames through them
+        /// </summary>
+        /// <param name="name">Base name of the shared-memory mappings</param>
+        /// <returns>True if the transport was started, false otherwise</returns>
+        bool StartSharedMemoryTransport(String^ name);
+
+        /// <summary>
+        /// Stops the shared-memory transport and removes its rings
+        /// </summary>
+        void StopSharedMemoryTransport();
+
     private:
         // Callback methods for native events
         void OnNativeServerStatusChanged(bool isRunning);
         void OnNativeMeterUpdated(int channel, const NativeMeterData& data);
-
-        // Static callback functions that will be passed to native code
-        static void ServerStatusChangedCallback(bool isRunning, void* userData);
-        static void MeterUpdateCallback(int channel, const NativeMeterData& data, void* userData);
     };
 }
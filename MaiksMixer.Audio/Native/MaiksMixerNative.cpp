@@ -0,0 +1,1141 @@
+#include "MaiksMixerNative.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Engine/JackEngineClient.h"
+#include "Engine/MixEngine.h"
+
+namespace {
+
+    // The blittable structs share the engine's layouts, so arrays pass without conversion
+    static_assert(sizeof(EmpParameterChange) == sizeof(emp::ParameterChange), "EmpParameterChange layout");
+    static_assert(sizeof(EmpCommandCompletion) == sizeof(emp::EngineCompletion), "EmpCommandCompletion layout");
+    static_assert(offsetof(EmpCommandCompletion, cycle) == offsetof(emp::EngineCompletion, cycle), "EmpCommandCompletion layout");
+    static_assert(sizeof(EmpChannelMeter) == sizeof(emp::ChannelMeterFrame), "EmpChannelMeter layout");
+    static_assert(emp::MeterBank::kValuesPerChannel == 4, "EmpChannelMeter holds four values");
+    static_assert(sizeof(EmpTimedParameterChange) == sizeof(emp::TimedParameterChange), "EmpTimedParameterChange layout");
+    static_assert(offsetof(EmpTimedParameterChange, change) == offsetof(emp::TimedParameterChange, change), "EmpTimedParameterChange layout");
+    static_assert(offsetof(EmpTimedParameterChange, shape) == offsetof(emp::TimedParameterChange, shape), "EmpTimedParameterChange layout");
+    static_assert(offsetof(EmpTimedParameterChange, rampFrames) == offsetof(emp::TimedParameterChange, rampFrames), "EmpTimedParameterChange layout");
+    static_assert(EMP_EQ_BANDS == emp::ChannelInsertParams::kEqBands, "EMP_EQ_BANDS");
+    static_assert(EMP_SPECTRUM_BINS == emp::SpectrumAnalyzer::kBins, "EMP_SPECTRUM_BINS");
+    static_assert(EMP_TELEMETRY_BUCKETS == emp::TelemetrySnapshot::kHistogramBuckets, "EMP_TELEMETRY_BUCKETS");
+
+    /// <summary>
+    /// The process-wide client: the JACK client and the engine it renders
+    /// </summary>
+    struct NativeContext
+    {
+        std::unique_ptr<emp::MixEngine> engine;
+        std::unique_ptr<emp::JackEngineClient> client;      // Declared last: closed before the engine goes
+        bool initialized = false;
+        bool active = false;
+        int workerCount = 0;
+        int workerPriority = 0;
+        std::vector<float> meterScratch;
+    };
+
+    // Serializes every call into the context; callbacks use their own lock, so the client
+    // may call them while a control call holds this one
+    std::mutex g_contextMutex;
+    std::unique_ptr<NativeContext> g_context;
+
+    std::mutex g_callbackMutex;
+    EmpServerStatusCallback g_serverStatusCallback = nullptr;
+    void* g_serverStatusUserData = nullptr;
+    EmpMeterUpdateCallback g_meterUpdateCallback = nullptr;
+    void* g_meterUpdateUserData = nullptr;
+
+    thread_local std::string t_lastError;
+
+    void SetLastError(const char* message)
+    {
+        try {
+            t_lastError = message;
+        }
+        catch (...) {
+        }
+    }
+
+    void CopyString(const std::string& source, char* destination, size_t size)
+    {
+        const size_t length = std::min(source.size(), size - 1);
+        std::memcpy(destination, source.data(), length);
+        destination[length] = '\0';
+    }
+
+    // Callback for server status changes
+    void ServerStatusChanged(bool isRunning)
+    {
+        EmpServerStatusCallback callback;
+        void* userData;
+        {
+            std::lock_guard<std::mutex> lock(g_callbackMutex);
+            callback = g_serverStatusCallback;
+            userData = g_serverStatusUserData;
+        }
+        if (callback != nullptr) callback(isRunning, userData);
+    }
+
+    // Callback for meter updates
+    void MeterUpdated(int channel, const emp::ChannelMeterFrame& meter)
+    {
+        EmpMeterUpdateCallback callback;
+        void* userData;
+        {
+            std::lock_guard<std::mutex> lock(g_callbackMutex);
+            callback = g_meterUpdateCallback;
+            userData = g_meterUpdateUserData;
+        }
+        if (callback != nullptr) callback(channel, meter.peak, meter.rms, userData);
+    }
+
+    /// <summary>
+    /// Runs body on the initialized context under the context lock. Exceptions and a
+    /// missing client become fallback, with the reason kept for emp_get_last_error().
+    /// </summary>
+    template <typename Result, typename Body>
+    Result WithContext(Result fallback, Body body)
+    {
+        try {
+            std::lock_guard<std::mutex> lock(g_contextMutex);
+            if (!g_context || !g_context->initialized) {
+                SetLastError("JACK client is not initialized");
+                return fallback;
+            }
+            return body(*g_context);
+        }
+        catch (const std::exception& ex) {
+            SetLastError(ex.what());
+        }
+        catch (...) {
+            SetLastError("Unknown native error");
+        }
+        return fallback;
+    }
+
+    emp::BusConfig ToBusConfig(const EmpBusConfig& config)
+    {
+        emp::BusConfig result;
+        result.type = static_cast<emp::BusType>(config.type);
+        result.channels = config.channels;
+        result.volume = config.volume;
+        result.mute = config.mute != 0;
+        result.firstOutput = config.firstOutput;
+        return result;
+    }
+
+    // Stops processing and the engine's threads; the caller holds the context lock
+    bool DeactivateLocked(NativeContext& context)
+    {
+        if (!context.active) return true;
+
+        const bool result = context.client->Deactivate();
+        if (result) {
+            context.engine->Workers().Stop();
+            context.engine->Analysis().Stop();
+            context.engine->Recorder().Stop();
+            context.active = false;
+        }
+        return result;
+    }
+
+    // Ports from the notification-driven cache once it has been seeded, else queried from
+    // the server; the caller holds the context lock
+    std::vector<emp::PortGraphPort> GetPortsLocked(NativeContext& context)
+    {
+        if (context.engine->PortGraph().IsSeeded()) return context.engine->PortGraph().GetPorts();
+        return context.client->QueryPorts();
+    }
+}
+
+/// <summary>
+/// Compiled scene handed out as an opaque EmpScene*
+/// </summary>
+struct EmpScene
+{
+    std::shared_ptr<const emp::CompiledScene> scene;
+};
+
+extern "C" {
+
+    // Get API Version
+    int32_t EMP_CALL emp_get_api_version(void)
+    {
+        return EMP_NATIVE_API_VERSION;
+    }
+
+    // Get Last Error
+    int32_t EMP_CALL emp_get_last_error(char* buffer, int32_t size)
+    {
+        if (buffer != nullptr && size > 0) CopyString(t_lastError, buffer, static_cast<size_t>(size));
+        return static_cast<int32_t>(t_lastError.size());
+    }
+
+    // Initialize
+    bool EMP_CALL emp_initialize(const char* clientName)
+    {
+        if (clientName == nullptr) {
+            SetLastError("clientName is null");
+            return false;
+        }
+
+        try {
+            std::lock_guard<std::mutex> lock(g_contextMutex);
+            if (g_context && g_context->initialized) return true;
+
+            if (!g_context) {
+                auto context = std::make_unique<NativeContext>();
+                context->engine = std::make_unique<emp::MixEngine>();
+                context->client = std::make_unique<emp::JackEngineClient>(*context->engine);
+                context->client->SetShutdownHandler([] { ServerStatusChanged(false); });
+                context->client->SetMeterHandler(MeterUpdated);
+                g_context = std::move(context);
+            }
+
+            g_context->initialized = g_context->client->Open(std::string(clientName));
+            if (!g_context->initialized) SetLastError("Could not open the JACK client (is the server running?)");
+            return g_context->initialized;
+        }
+        catch (const std::exception& ex) {
+            SetLastError(ex.what());
+        }
+        catch (...) {
+            SetLastError("Unknown native error");
+        }
+        return false;
+    }
+
+    // Shutdown
+    void EMP_CALL emp_shutdown(void)
+    {
+        try {
+            std::lock_guard<std::mutex> lock(g_contextMutex);
+            if (!g_context) return;
+
+            if (g_context->initialized) DeactivateLocked(*g_context);
+
+            // The engine must outlive the client that renders through it
+            g_context->client.reset();
+            g_context.reset();
+        }
+        catch (const std::exception& ex) {
+            SetLastError(ex.what());
+        }
+        catch (...) {
+            SetLastError("Unknown native error");
+        }
+    }
+
+    // Create Ports
+    bool EMP_CALL emp_create_ports(int32_t numInputs, int32_t numOutputs)
+    {
+        return WithContext(false, [&](NativeContext& context) {
+            if (numInputs < 0 || numOutputs < 0) {
+                SetLastError("Port counts must not be negative");
+                return false;
+            }
+
+            // The client sizes the engine before the ports exist so the process callback
+            // never sees a port without matching parameter and meter storage
+            return context.client->CreatePorts(numInputs, numOutputs);
+        });
+    }
+
+    // Resize Ports
+    bool EMP_CALL emp_resize_ports(int32_t numInputs, int32_t numOutputs)
+    {
+        return WithContext(false, [&](NativeContext& context) {
+            if (numInputs < 0 || numOutputs < 0) {
+                SetLastError("Port counts must not be negative");
+                return false;
+            }
+            return context.engine->ResizePorts(numInputs, numOutputs);
+        });
+    }
+
+    // Activate
+    bool EMP_CALL emp_activate(void)
+    {
+        return WithContext(false, [](NativeContext& context) {
+            if (context.active) return true;
+
+            // Same order as the managed bridge: start the engine's threads, let the client
+            // build the layout for the server's period and rate and start processing, then
+            // report whether the engine's memory is locked
+            emp::MixEngine& engine = *context.engine;
+            emp::WorkerPoolConfig workers;
+            workers.workerCount = context.workerCount;
+            workers.realtimePriority = context.workerPriority;
+            workers.pinThreads = context.workerCount > 0;
+            engine.Workers().Start(workers);
+            engine.Analysis().Start(emp::AnalysisTaps::kDefaultWorkerCount);
+
+            context.active = context.client->Activate();
+            engine.LockMemory();
+            return context.active;
+        });
+    }
+
+    // Deactivate
+    bool EMP_CALL emp_deactivate(void)
+    {
+        return WithContext(false, [](NativeContext& context) { return DeactivateLocked(context); });
+    }
+
+    // Set Worker Threads
+    bool EMP_CALL emp_set_worker_threads(int32_t workerCount, int32_t realtimePriority)
+    {
+        if (workerCount < 0 || workerCount > emp::RtWorkerPool::kMaxWorkers) {
+            SetLastError("workerCount is out of range");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            context.workerCount = workerCount;
+            context.workerPriority = std::max(realtimePriority, 0);
+            return true;
+        });
+    }
+
+    // Set Channel Volume
+    void EMP_CALL emp_set_channel_volume(int32_t channel, float volume)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Parameters().SetVolume(channel, volume); return 0; });
+    }
+
+    // Set Channel Pan
+    void EMP_CALL emp_set_channel_pan(int32_t channel, float pan)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Parameters().SetPan(channel, pan); return 0; });
+    }
+
+    // Set Channel Gain
+    void EMP_CALL emp_set_channel_gain(int32_t channel, float gainDb)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Parameters().SetGainDb(channel, gainDb); return 0; });
+    }
+
+    // Set Channel Mute
+    void EMP_CALL emp_set_channel_mute(int32_t channel, bool mute)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Parameters().SetMute(channel, mute); return 0; });
+    }
+
+    // Set Channel Solo
+    void EMP_CALL emp_set_channel_solo(int32_t channel, bool solo)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Parameters().SetSolo(channel, solo); return 0; });
+    }
+
+    // Apply Parameter Batch
+    int32_t EMP_CALL emp_apply_parameter_batch(const EmpParameterChange* changes, int32_t count)
+    {
+        if (changes == nullptr || count <= 0) return 0;
+
+        return WithContext(-1, [&](NativeContext& context) {
+            return context.engine->Parameters().ApplyBatch(reinterpret_cast<const emp::ParameterChange*>(changes), count);
+        });
+    }
+
+    // Post Parameter Changes
+    int32_t EMP_CALL emp_post_parameter_changes(const EmpParameterChange* changes, uint32_t* commandIds, int32_t count)
+    {
+        if (changes == nullptr || commandIds == nullptr || count <= 0) return 0;
+
+        return WithContext(-1, [&](NativeContext& context) {
+            auto nativeChanges = reinterpret_cast<const emp::ParameterChange*>(changes);
+
+            int32_t queued = 0;
+            for (int32_t i = 0; i < count; i++) {
+                commandIds[i] = context.engine->PostParameterChange(nativeChanges[i]);
+                if (commandIds[i] != 0) queued++;
+            }
+            return queued;
+        });
+    }
+
+    // Read Command Completions
+    int32_t EMP_CALL emp_read_command_completions(EmpCommandCompletion* completions, int32_t capacity)
+    {
+        if (completions == nullptr || capacity <= 0) return 0;
+
+        return WithContext(-1, [&](NativeContext& context) {
+            return context.engine->Commands().ReadCompletions(reinterpret_cast<emp::EngineCompletion*>(completions), capacity);
+        });
+    }
+
+    // Get Channel Meters
+    int32_t EMP_CALL emp_get_channel_meters(EmpChannelMeter* meters, int32_t capacity, uint64_t* sequence)
+    {
+        if (meters == nullptr || capacity <= 0) return 0;
+
+        return WithContext(-1, [&](NativeContext& context) {
+            // The bank writes the clip count as a float; convert it back while copying out
+            std::vector<float>& scratch = context.meterScratch;
+            const int values = capacity * emp::MeterBank::kValuesPerChannel;
+            scratch.resize(static_cast<size_t>(values));
+            const int count = context.engine->Meters().CopyTo(scratch.data(), values, sequence);
+
+            for (int i = 0; i < count; i++) {
+                const float* values = scratch.data() + static_cast<size_t>(i) * emp::MeterBank::kValuesPerChannel;
+                meters[i].peak = values[0];
+                meters[i].rms = values[1];
+                meters[i].peakHold = values[2];
+                meters[i].clipCount = static_cast<uint32_t>(values[3]);
+            }
+            return count;
+        });
+    }
+
+    // Configure Meters
+    void EMP_CALL emp_configure_meters(float refreshRateHz, float peakHoldSeconds)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Meters().Configure(refreshRateHz, peakHoldSeconds); return 0; });
+    }
+
+    // Reset Clip Counters
+    void EMP_CALL emp_reset_clip_counters(void)
+    {
+        WithContext(0, [](NativeContext& context) { context.engine->Meters().ResetClipCounters(); return 0; });
+    }
+
+    // Get Sample Rate
+    int32_t EMP_CALL emp_get_sample_rate(void)
+    {
+        return WithContext(-1, [](NativeContext& context) { return static_cast<int32_t>(context.client->GetSampleRate()); });
+    }
+
+    // Get Buffer Size
+    int32_t EMP_CALL emp_get_buffer_size(void)
+    {
+        return WithContext(-1, [](NativeContext& context) { return static_cast<int32_t>(context.client->GetBufferSize()); });
+    }
+
+    // Get CPU Load
+    float EMP_CALL emp_get_cpu_load(void)
+    {
+        return WithContext(0.0f, [](NativeContext& context) { return context.client->GetCpuLoad(); });
+    }
+
+    // Is Server Running
+    bool EMP_CALL emp_is_server_running(void)
+    {
+        try {
+            std::lock_guard<std::mutex> lock(g_contextMutex);
+            return g_context && g_context->client->IsServerRunning();
+        }
+        catch (const std::exception& ex) {
+            SetLastError(ex.what());
+        }
+        catch (...) {
+            SetLastError("Unknown native error");
+        }
+        return false;
+    }
+
+    // Get Server Status
+    bool EMP_CALL emp_get_server_status(EmpServerStatus* status)
+    {
+        if (status == nullptr) return false;
+
+        return WithContext(false, [&](NativeContext& context) {
+            const uint32_t sampleRate = context.client->GetSampleRate();
+            const uint32_t bufferSize = context.client->GetBufferSize();
+
+            emp::TelemetrySnapshot telemetry;
+            context.engine->Telemetry().GetSnapshot(telemetry);
+
+            // Output latency: the longest playback path from one of our ports, or one
+            // period before the ports exist
+            uint32_t latencyFrames = bufferSize;
+            if (!telemetry.portLatencies.empty()) {
+                latencyFrames = 0;
+                for (const auto& port : telemetry.portLatencies) {
+                    latencyFrames = std::max(latencyFrames, port.playbackMax);
+                }
+            }
+
+            status->isRunning = context.client->IsServerRunning() ? 1 : 0;
+            status->sampleRate = static_cast<int32_t>(sampleRate);
+            status->bufferSize = static_cast<int32_t>(bufferSize);
+            status->cpuLoad = context.client->GetCpuLoad();
+            status->xruns = telemetry.xrunCount;
+            status->latencyMs = sampleRate > 0 ? latencyFrames * 1000.0 / sampleRate : 0.0;
+            return true;
+        });
+    }
+
+    // Get Frame Time
+    uint64_t EMP_CALL emp_get_frame_time(void)
+    {
+        return WithContext(uint64_t{ 0 }, [](NativeContext& context) { return context.engine->GetFrameTime(); });
+    }
+
+    // Connect Ports
+    bool EMP_CALL emp_connect_ports(const char* sourcePort, const char* destinationPort)
+    {
+        if (sourcePort == nullptr || destinationPort == nullptr) {
+            SetLastError("Port name is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            return context.client->ConnectPorts(std::string(sourcePort), std::string(destinationPort));
+        });
+    }
+
+    // Disconnect Ports
+    bool EMP_CALL emp_disconnect_ports(const char* sourcePort, const char* destinationPort)
+    {
+        if (sourcePort == nullptr || destinationPort == nullptr) {
+            SetLastError("Port name is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            return context.client->DisconnectPorts(std::string(sourcePort), std::string(destinationPort));
+        });
+    }
+
+    // Get Ports
+    int32_t EMP_CALL emp_get_ports(EmpPortInfo* ports, int32_t capacity)
+    {
+        return WithContext(-1, [&](NativeContext& context) {
+            const std::vector<emp::PortGraphPort> nativePorts = GetPortsLocked(context);
+
+            const int32_t count = ports != nullptr ? std::min(capacity, static_cast<int32_t>(nativePorts.size())) : 0;
+            for (int32_t i = 0; i < count; i++) {
+                CopyString(nativePorts[i].name, ports[i].name, sizeof(ports[i].name));
+                CopyString(nativePorts[i].type, ports[i].type, sizeof(ports[i].type));
+                ports[i].flags = nativePorts[i].flags;
+                ports[i].connectionCount = static_cast<int32_t>(nativePorts[i].connections.size());
+            }
+            return static_cast<int32_t>(nativePorts.size());
+        });
+    }
+
+    // Get Port Connections
+    int32_t EMP_CALL emp_get_port_connections(const char* portName, EmpPortName* connections, int32_t capacity)
+    {
+        if (portName == nullptr) {
+            SetLastError("Port name is null");
+            return -1;
+        }
+
+        return WithContext(-1, [&](NativeContext& context) {
+            for (const auto& port : GetPortsLocked(context)) {
+                if (port.name != portName) continue;
+
+                const int32_t count = connections != nullptr ? std::min(capacity, static_cast<int32_t>(port.connections.size())) : 0;
+                for (int32_t i = 0; i < count; i++) {
+                    CopyString(port.connections[i], connections[i].name, sizeof(connections[i].name));
+                }
+                return static_cast<int32_t>(port.connections.size());
+            }
+
+            SetLastError("Unknown port");
+            return -1;
+        });
+    }
+
+    // Post Timed Parameter Changes
+    int32_t EMP_CALL emp_post_timed_parameter_changes(const EmpTimedParameterChange* changes, uint32_t* commandIds, int32_t count)
+    {
+        if (changes == nullptr || commandIds == nullptr || count <= 0) return 0;
+
+        return WithContext(-1, [&](NativeContext& context) {
+            auto nativeChanges = reinterpret_cast<const emp::TimedParameterChange*>(changes);
+
+            int32_t queued = 0;
+            for (int32_t i = 0; i < count; i++) {
+                commandIds[i] = context.engine->ScheduleParameterChange(nativeChanges[i]);
+                if (commandIds[i] != 0) queued++;
+            }
+            return queued;
+        });
+    }
+
+    // Set Parameter Smoothing
+    void EMP_CALL emp_set_parameter_smoothing(int32_t shape, float milliseconds)
+    {
+        WithContext(0, [&](NativeContext& context) {
+            context.engine->SetSmoothing(static_cast<emp::RampShape>(shape), milliseconds);
+            return 0;
+        });
+    }
+
+    // Set Silence Detection
+    void EMP_CALL emp_set_silence_detection(bool enabled)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->SetSilenceDetection(enabled); return 0; });
+    }
+
+    // Set Silence Threshold
+    void EMP_CALL emp_set_silence_threshold(float threshold)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->SetSilenceThreshold(threshold); return 0; });
+    }
+
+    // Set Route
+    bool EMP_CALL emp_set_route(int32_t input, int32_t output, float gain)
+    {
+        return WithContext(false, [&](NativeContext& context) { return context.engine->Routing().SetRoute(input, output, gain); });
+    }
+
+    // Clear Routes
+    void EMP_CALL emp_clear_routes(void)
+    {
+        WithContext(0, [](NativeContext& context) { context.engine->Routing().Clear(); return 0; });
+    }
+
+    // Set Routing Enabled
+    void EMP_CALL emp_set_routing_enabled(bool enabled)
+    {
+        WithContext(0, [&](NativeContext& context) { context.engine->Routing().SetEnabled(enabled); return 0; });
+    }
+
+    // Get Routing Matrix
+    int32_t EMP_CALL emp_get_routing_matrix(float* gains, int32_t capacity, int32_t* numInputs, int32_t* numOutputs)
+    {
+        return WithContext(-1, [&](NativeContext& context) {
+            std::vector<float> matrix;
+            int inputs = 0;
+            int outputs = 0;
+            context.engine->Routing().GetMatrix(matrix, inputs, outputs);
+
+            if (numInputs != nullptr) *numInputs = inputs;
+            if (numOutputs != nullptr) *numOutputs = outputs;
+            const int32_t size = static_cast<int32_t>(matrix.size());
+            if (gains != nullptr && size <= capacity) std::copy(matrix.begin(), matrix.end(), gains);
+            return size;
+        });
+    }
+
+    // Capture Scene
+    bool EMP_CALL emp_capture_scene(EmpSceneLayout* layout, EmpSceneChannel* channels, int32_t channelCapacity,
+                                    float* routes, int32_t routeCapacity)
+    {
+        if (layout == nullptr) {
+            SetLastError("layout is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            const emp::SceneSnapshot snapshot = context.engine->CaptureScene();
+            layout->channelCount = static_cast<int32_t>(snapshot.channels.size());
+            layout->routeInputs = snapshot.routeInputs;
+            layout->routeOutputs = snapshot.routeOutputs;
+            layout->routingEnabled = snapshot.routingEnabled ? 1 : 0;
+
+            if (channels != nullptr && layout->channelCount <= channelCapacity) {
+                for (int32_t i = 0; i < layout->channelCount; i++) {
+                    const emp::ChannelParams& params = snapshot.channels[i];
+                    channels[i].volume = params.volume;
+                    channels[i].pan = params.pan;
+                    channels[i].gainDb = 20.0f * std::log10(std::max(params.gain, 1.0e-6f));
+                    channels[i].mute = params.mute ? 1 : 0;
+                    channels[i].solo = params.solo ? 1 : 0;
+                }
+            }
+            if (routes != nullptr && static_cast<int32_t>(snapshot.routes.size()) <= routeCapacity) {
+                std::copy(snapshot.routes.begin(), snapshot.routes.end(), routes);
+            }
+            return true;
+        });
+    }
+
+    // Compile Scene
+    EmpScene* EMP_CALL emp_compile_scene(const EmpSceneLayout* layout, const EmpSceneChannel* channels, const float* routes)
+    {
+        if (layout == nullptr) {
+            SetLastError("layout is null");
+            return nullptr;
+        }
+
+        return WithContext(static_cast<EmpScene*>(nullptr), [&](NativeContext& context) {
+            emp::SceneSnapshot snapshot;
+            if (channels != nullptr && layout->channelCount > 0) {
+                snapshot.channels.resize(static_cast<size_t>(layout->channelCount));
+                for (int32_t i = 0; i < layout->channelCount; i++) {
+                    emp::ChannelParams& params = snapshot.channels[i];
+                    emp::ApplyParameterChange(params, emp::ParameterId::Volume, channels[i].volume);
+                    emp::ApplyParameterChange(params, emp::ParameterId::Pan, channels[i].pan);
+                    emp::ApplyParameterChange(params, emp::ParameterId::GainDb, channels[i].gainDb);
+                    params.mute = channels[i].mute != 0;
+                    params.solo = channels[i].solo != 0;
+                }
+            }
+            if (routes != nullptr && layout->routeInputs > 0 && layout->routeOutputs > 0) {
+                snapshot.routeInputs = layout->routeInputs;
+                snapshot.routeOutputs = layout->routeOutputs;
+                snapshot.routes.assign(routes, routes + static_cast<size_t>(layout->routeInputs) * layout->routeOutputs);
+            }
+            snapshot.routingEnabled = layout->routingEnabled != 0;
+
+            return new EmpScene{ context.engine->CompileScene(snapshot) };
+        });
+    }
+
+    // Recall Scene
+    uint32_t EMP_CALL emp_recall_scene(const EmpScene* scene, float crossfadeMs)
+    {
+        if (scene == nullptr) {
+            SetLastError("scene is null");
+            return 0;
+        }
+
+        return WithContext(uint32_t{ 0 }, [&](NativeContext& context) { return context.engine->RecallScene(scene->scene, crossfadeMs); });
+    }
+
+    // Free Scene
+    void EMP_CALL emp_free_scene(EmpScene* scene)
+    {
+        delete scene;
+    }
+
+    // Set Channel Inserts
+    bool EMP_CALL emp_set_channel_inserts(int32_t channel, const EmpChannelInserts* inserts)
+    {
+        if (inserts == nullptr) {
+            SetLastError("inserts is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            emp::ChannelInsertParams params;
+            for (int b = 0; b < EMP_EQ_BANDS; b++) {
+                params.eq[b].type = static_cast<emp::EqBandType>(inserts->eq[b].type);
+                params.eq[b].frequency = inserts->eq[b].frequency;
+                params.eq[b].gainDb = inserts->eq[b].gainDb;
+                params.eq[b].q = inserts->eq[b].q;
+                params.eq[b].enabled = inserts->eq[b].enabled != 0;
+            }
+
+            params.gate.thresholdDb = inserts->gate.thresholdDb;
+            params.gate.rangeDb = inserts->gate.rangeDb;
+            params.gate.attackMs = inserts->gate.attackMs;
+            params.gate.releaseMs = inserts->gate.releaseMs;
+            params.gate.enabled = inserts->gate.enabled != 0;
+
+            params.compressor.thresholdDb = inserts->compressor.thresholdDb;
+            params.compressor.ratio = inserts->compressor.ratio;
+            params.compressor.attackMs = inserts->compressor.attackMs;
+            params.compressor.releaseMs = inserts->compressor.releaseMs;
+            params.compressor.makeupDb = inserts->compressor.makeupDb;
+            params.compressor.enabled = inserts->compressor.enabled != 0;
+
+            params.bypass = inserts->bypass != 0;
+            return context.engine->Inserts().SetChannel(channel, params);
+        });
+    }
+
+    // Get Channel Inserts
+    bool EMP_CALL emp_get_channel_inserts(int32_t channel, EmpChannelInserts* inserts)
+    {
+        if (inserts == nullptr) {
+            SetLastError("inserts is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            emp::ChannelInsertParams params;
+            if (!context.engine->Inserts().GetChannel(channel, params)) {
+                SetLastError("Channel is out of range");
+                return false;
+            }
+
+            for (int b = 0; b < EMP_EQ_BANDS; b++) {
+                inserts->eq[b].type = static_cast<int32_t>(params.eq[b].type);
+                inserts->eq[b].frequency = params.eq[b].frequency;
+                inserts->eq[b].gainDb = params.eq[b].gainDb;
+                inserts->eq[b].q = params.eq[b].q;
+                inserts->eq[b].enabled = params.eq[b].enabled ? 1 : 0;
+            }
+
+            inserts->gate.thresholdDb = params.gate.thresholdDb;
+            inserts->gate.rangeDb = params.gate.rangeDb;
+            inserts->gate.attackMs = params.gate.attackMs;
+            inserts->gate.releaseMs = params.gate.releaseMs;
+            inserts->gate.enabled = params.gate.enabled ? 1 : 0;
+
+            inserts->compressor.thresholdDb = params.compressor.thresholdDb;
+            inserts->compressor.ratio = params.compressor.ratio;
+            inserts->compressor.attackMs = params.compressor.attackMs;
+            inserts->compressor.releaseMs = params.compressor.releaseMs;
+            inserts->compressor.makeupDb = params.compressor.makeupDb;
+            inserts->compressor.enabled = params.compressor.enabled ? 1 : 0;
+
+            inserts->bypass = params.bypass ? 1 : 0;
+            return true;
+        });
+    }
+
+    // Set Insert Bypass
+    bool EMP_CALL emp_set_insert_bypass(int32_t channel, bool bypass)
+    {
+        return WithContext(false, [&](NativeContext& context) { return context.engine->Inserts().SetBypass(channel, bypass); });
+    }
+
+    // Create Bus
+    int32_t EMP_CALL emp_create_bus(const EmpBusConfig* config)
+    {
+        if (config == nullptr) {
+            SetLastError("config is null");
+            return 0;
+        }
+
+        return WithContext(0, [&](NativeContext& context) { return context.engine->Buses().CreateBus(ToBusConfig(*config)); });
+    }
+
+    // Remove Bus
+    bool EMP_CALL emp_remove_bus(int32_t id)
+    {
+        return WithContext(false, [&](NativeContext& context) { return context.engine->Buses().RemoveBus(id); });
+    }
+
+    // Set Bus
+    int32_t EMP_CALL emp_set_bus(int32_t id, const EmpBusConfig* config)
+    {
+        if (config == nullptr) {
+            SetLastError("config is null");
+            return EMP_BUS_INVALID;
+        }
+
+        return WithContext(static_cast<int32_t>(EMP_BUS_INVALID), [&](NativeContext& context) {
+            return static_cast<int32_t>(context.engine->Buses().SetBus(id, ToBusConfig(*config)));
+        });
+    }
+
+    // Get Bus
+    bool EMP_CALL emp_get_bus(int32_t id, EmpBusConfig* config)
+    {
+        if (config == nullptr) {
+            SetLastError("config is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            emp::BusConfig bus;
+            if (!context.engine->Buses().GetBus(id, bus)) {
+                SetLastError("Unknown bus");
+                return false;
+            }
+
+            config->type = static_cast<int32_t>(bus.type);
+            config->channels = bus.channels;
+            config->volume = bus.volume;
+            config->mute = bus.mute ? 1 : 0;
+            config->firstOutput = bus.firstOutput;
+            return true;
+        });
+    }
+
+    // Set Send
+    int32_t EMP_CALL emp_set_send(const EmpBusSend* send)
+    {
+        if (send == nullptr) {
+            SetLastError("send is null");
+            return EMP_BUS_INVALID;
+        }
+
+        return WithContext(static_cast<int32_t>(EMP_BUS_INVALID), [&](NativeContext& context) {
+            emp::BusSend nativeSend;
+            nativeSend.sourceType = static_cast<emp::SendSource>(send->sourceType);
+            nativeSend.source = send->source;
+            nativeSend.destination = send->destination;
+            nativeSend.tap = static_cast<emp::SendTap>(send->tap);
+            nativeSend.level = send->level;
+            nativeSend.pan = send->pan;
+            return static_cast<int32_t>(context.engine->Buses().SetSend(nativeSend));
+        });
+    }
+
+    // Remove Send
+    bool EMP_CALL emp_remove_send(int32_t sourceType, int32_t source, int32_t destination)
+    {
+        return WithContext(false, [&](NativeContext& context) {
+            return context.engine->Buses().RemoveSend(static_cast<emp::SendSource>(sourceType), source, destination);
+        });
+    }
+
+    // Get Sends
+    int32_t EMP_CALL emp_get_sends(EmpBusSend* sends, int32_t capacity)
+    {
+        return WithContext(-1, [&](NativeContext& context) {
+            std::vector<emp::BusSend> nativeSends;
+            context.engine->Buses().GetSends(nativeSends);
+
+            const int32_t count = sends != nullptr ? std::min(capacity, static_cast<int32_t>(nativeSends.size())) : 0;
+            for (int32_t i = 0; i < count; i++) {
+                sends[i].sourceType = static_cast<int32_t>(nativeSends[i].sourceType);
+                sends[i].source = nativeSends[i].source;
+                sends[i].destination = nativeSends[i].destination;
+                sends[i].tap = static_cast<int32_t>(nativeSends[i].tap);
+                sends[i].level = nativeSends[i].level;
+                sends[i].pan = nativeSends[i].pan;
+            }
+            return static_cast<int32_t>(nativeSends.size());
+        });
+    }
+
+    // Set Analysis Tap
+    bool EMP_CALL emp_set_analysis_tap(int32_t source, int32_t index, bool enabled)
+    {
+        return WithContext(false, [&](NativeContext& context) {
+            return context.engine->Analysis().SetEnabled(static_cast<emp::TapSource>(source), index, enabled);
+        });
+    }
+
+    // Get Analysis
+    int32_t EMP_CALL emp_get_analysis(int32_t source, int32_t index, EmpAnalysis* analysis, float* spectrum, int32_t capacity)
+    {
+        if (analysis == nullptr) {
+            SetLastError("analysis is null");
+            return -1;
+        }
+
+        return WithContext(-1, [&](NativeContext& context) {
+            emp::AnalysisFrame frame;
+            if (!context.engine->Analysis().GetFrame(static_cast<emp::TapSource>(source), index, frame)) {
+                SetLastError("Analysis tap is not enabled");
+                return -1;
+            }
+
+            analysis->sampleRate = frame.sampleRate;
+            analysis->momentaryLufs = frame.momentaryLufs;
+            analysis->shortTermLufs = frame.shortTermLufs;
+            analysis->integratedLufs = frame.integratedLufs;
+            analysis->truePeakDb = frame.truePeakDb;
+            analysis->droppedBlocks = frame.droppedBlocks;
+            analysis->sequence = frame.sequence;
+
+            const int32_t bins = spectrum != nullptr ? std::min(capacity, static_cast<int32_t>(frame.spectrum.size())) : 0;
+            if (bins > 0) std::copy(frame.spectrum.begin(), frame.spectrum.begin() + bins, spectrum);
+            return static_cast<int32_t>(frame.spectrum.size());
+        });
+    }
+
+    // Start Recording
+    bool EMP_CALL emp_start_recording(const char* path, int32_t format, bool polyphonic, const EmpRecordTrack* tracks,
+                                      int32_t trackCount, float ringSeconds)
+    {
+        if (path == nullptr || tracks == nullptr || trackCount <= 0) {
+            SetLastError("Recording needs a path and at least one track");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            emp::RecordOptions options;
+            options.path = path;
+            options.format = static_cast<emp::RecordFormat>(format);
+            options.polyphonic = polyphonic;
+            if (ringSeconds > 0.0f) options.ringSeconds = ringSeconds;
+            options.tracks.reserve(static_cast<size_t>(trackCount));
+            for (int32_t i = 0; i < trackCount; i++) {
+                emp::RecordTrack track;
+                track.source = static_cast<emp::TapSource>(tracks[i].source);
+                track.index = tracks[i].index;
+                options.tracks.push_back(track);
+            }
+
+            if (!context.engine->Recorder().Start(options)) {
+                SetLastError("Could not start recording");
+                return false;
+            }
+            return true;
+        });
+    }
+
+    // Stop Recording
+    bool EMP_CALL emp_stop_recording(void)
+    {
+        return WithContext(false, [](NativeContext& context) { return context.engine->Recorder().Stop(); });
+    }
+
+    // Get Recorder Status
+    int32_t EMP_CALL emp_get_recorder_status(EmpRecorderStatus* status, float* ringFill, int32_t capacity)
+    {
+        if (status == nullptr) {
+            SetLastError("status is null");
+            return -1;
+        }
+
+        return WithContext(-1, [&](NativeContext& context) {
+            emp::RecorderStatus recorder;
+            context.engine->Recorder().GetStatus(recorder);
+
+            status->isRecording = recorder.recording ? 1 : 0;
+            status->sampleRate = recorder.sampleRate;
+            status->capturedFrames = recorder.capturedFrames;
+            status->writtenFrames = recorder.writtenFrames;
+            status->bytesWritten = recorder.bytesWritten;
+            status->droppedBlocks = recorder.droppedBlocks;
+            status->writeFailed = recorder.writeFailed ? 1 : 0;
+            status->limitReached = recorder.limitReached ? 1 : 0;
+
+            const int32_t tracks = ringFill != nullptr ? std::min(capacity, static_cast<int32_t>(recorder.ringFill.size())) : 0;
+            if (tracks > 0) std::copy(recorder.ringFill.begin(), recorder.ringFill.begin() + tracks, ringFill);
+            return static_cast<int32_t>(recorder.ringFill.size());
+        });
+    }
+
+    // Get Telemetry
+    int32_t EMP_CALL emp_get_telemetry(EmpTelemetry* telemetry, EmpXrunEvent* xruns, int32_t capacity)
+    {
+        if (telemetry == nullptr) {
+            SetLastError("telemetry is null");
+            return -1;
+        }
+
+        return WithContext(-1, [&](NativeContext& context) {
+            emp::TelemetrySnapshot snapshot;
+            context.engine->Telemetry().GetSnapshot(snapshot);
+
+            telemetry->cycles = snapshot.cycles;
+            telemetry->frames = snapshot.frames;
+            telemetry->totalNs = snapshot.totalNs;
+            telemetry->lastNs = snapshot.lastNs;
+            telemetry->worstNs = snapshot.worstNs;
+            telemetry->worstBudgetNs = snapshot.worstBudgetNs;
+            telemetry->overBudgetCycles = snapshot.overBudgetCycles;
+            std::copy(snapshot.histogram, snapshot.histogram + EMP_TELEMETRY_BUCKETS, telemetry->histogram);
+            telemetry->sampleRate = snapshot.sampleRate;
+            telemetry->arenasLocked = snapshot.arenasLocked ? 1 : 0;
+            telemetry->mixedChannels = snapshot.mixedChannels;
+            telemetry->idleChannels = snapshot.idleChannels;
+            telemetry->insertChannels = snapshot.insertChannels;
+            telemetry->bypassedInserts = snapshot.bypassedInserts;
+            telemetry->xrunCount = snapshot.xrunCount;
+            telemetry->droppedCompletions = snapshot.droppedCompletions;
+
+            const int32_t count = xruns != nullptr ? std::min(capacity, static_cast<int32_t>(snapshot.recentXruns.size())) : 0;
+            for (int32_t i = 0; i < count; i++) {
+                xruns[i].timestampUs = snapshot.recentXruns[i].timestampUs;
+                xruns[i].cycle = snapshot.recentXruns[i].cycle;
+                xruns[i].delayedUs = snapshot.recentXruns[i].delayedUs;
+            }
+            return static_cast<int32_t>(snapshot.recentXruns.size());
+        });
+    }
+
+    // Get Port Latencies
+    int32_t EMP_CALL emp_get_port_latencies(EmpPortLatency* latencies, int32_t capacity)
+    {
+        return WithContext(-1, [&](NativeContext& context) {
+            emp::TelemetrySnapshot snapshot;
+            context.engine->Telemetry().GetSnapshot(snapshot);
+
+            const int32_t count = latencies != nullptr ? std::min(capacity, static_cast<int32_t>(snapshot.portLatencies.size())) : 0;
+            for (int32_t i = 0; i < count; i++) {
+                const emp::PortLatencyRange& port = snapshot.portLatencies[i];
+                CopyString(port.portName, latencies[i].portName, sizeof(latencies[i].portName));
+                latencies[i].captureMin = port.captureMin;
+                latencies[i].captureMax = port.captureMax;
+                latencies[i].playbackMin = port.playbackMin;
+                latencies[i].playbackMax = port.playbackMax;
+            }
+            return static_cast<int32_t>(snapshot.portLatencies.size());
+        });
+    }
+
+    // Reset Telemetry
+    void EMP_CALL emp_reset_telemetry(void)
+    {
+        WithContext(0, [](NativeContext& context) { context.engine->Telemetry().Reset(); return 0; });
+    }
+
+    // Create Virtual Source
+    int32_t EMP_CALL emp_create_virtual_source(const EmpVirtualSourceConfig* config)
+    {
+        if (config == nullptr) {
+            SetLastError("config is null");
+            return 0;
+        }
+
+        return WithContext(0, [&](NativeContext& context) {
+            emp::VirtualSourceConfig nativeConfig;
+            nativeConfig.firstChannel = config->firstChannel;
+            nativeConfig.channels = config->channels;
+            nativeConfig.sampleRate = config->sampleRate;
+            nativeConfig.quality = static_cast<emp::ResamplerQuality>(config->quality);
+            nativeConfig.latencyMs = config->latencyMs;
+            return context.engine->VirtualSources().Create(nativeConfig);
+        });
+    }
+
+    // Remove Virtual Source
+    bool EMP_CALL emp_remove_virtual_source(int32_t id)
+    {
+        return WithContext(false, [&](NativeContext& context) { return context.engine->VirtualSources().Remove(id); });
+    }
+
+    // Write Virtual Source
+    bool EMP_CALL emp_write_virtual_source(int32_t id, const float* interleaved, int32_t frames)
+    {
+        if (frames < 0 || (interleaved == nullptr && frames > 0)) {
+            SetLastError("Invalid sample buffer");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            if (context.engine->VirtualSources().GetChannels(id) == 0) {
+                SetLastError("Unknown virtual source");
+                return false;
+            }
+            if (frames == 0) return true;
+            return context.engine->VirtualSources().Write(id, interleaved, static_cast<uint32_t>(frames));
+        });
+    }
+
+    // Get Virtual Source Status
+    bool EMP_CALL emp_get_virtual_source_status(int32_t id, EmpVirtualSourceStatus* status)
+    {
+        if (status == nullptr) {
+            SetLastError("status is null");
+            return false;
+        }
+
+        return WithContext(false, [&](NativeContext& context) {
+            emp::VirtualSourceStatus source;
+            if (!context.engine->VirtualSources().GetStatus(id, source)) {
+                SetLastError("Unknown virtual source");
+                return false;
+            }
+
+            status->ratio = source.ratio;
+            status->driftPpm = source.driftPpm;
+            status->underruns = source.underruns;
+            status->overruns = source.overruns;
+            status->fillFrames = source.fillFrames;
+            status->targetFrames = source.targetFrames;
+            status->isStreaming = source.streaming ? 1 : 0;
+            status->isLocked = source.locked ? 1 : 0;
+            return true;
+        });
+    }
+
+    // Register Server Status Callback
+    void EMP_CALL emp_register_server_status_callback(EmpServerStatusCallback callback, void* userData)
+    {
+        std::lock_guard<std::mutex> lock(g_callbackMutex);
+        g_serverStatusCallback = callback;
+        g_serverStatusUserData = userData;
+    }
+
+    // Register Meter Update Callback
+    void EMP_CALL emp_register_meter_update_callback(EmpMeterUpdateCallback callback, void* userData)
+    {
+        std::lock_guard<std::mutex> lock(g_callbackMutex);
+        g_meterUpdateCallback = callback;
+        g_meterUpdateUserData = userData;
+    }
+}
@@ -0,0 +1,676 @@
+/*
+ * Flat C interface to the native mixer (MaiksMixerNative), for P/Invoke
+ * (JackAudioInterop) and for C hosts such as headless Linux servers. It drives
+ * one emp::JackEngineClient and the emp::MixEngine it renders per process.
+ *
+ * Every struct is blittable: fixed-size fields only, booleans as int32_t and
+ * strings as fixed char arrays. Variable-length results are copied into
+ * caller-provided arrays, and the functions return the full count so callers
+ * can retry with a larger array. Functions never throw; failures return false
+ * or -1, and emp_get_last_error() describes the latest one on the calling
+ * thread.
+ */
+
+#ifndef MAIKSMIXER_NATIVE_H
+#define MAIKSMIXER_NATIVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(EMP_NATIVE_EXPORTS)
+#define EMP_API __declspec(dllexport)
+#else
+#define EMP_API __declspec(dllimport)
+#endif
+#define EMP_CALL __cdecl
+#else
+#define EMP_API __attribute__((visibility("default")))
+#define EMP_CALL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// <summary>
+/// Bumped whenever a signature or struct layout changes
+/// </summary>
+#define EMP_NATIVE_API_VERSION 3
+
+/// <summary>
+/// Full port name size of JACK2 (jack_port_name_size()), terminator included
+/// </summary>
+#define EMP_PORT_NAME_SIZE 320
+#define EMP_PORT_TYPE_SIZE 64
+
+/// <summary>
+/// Fixed sizes of the engine (emp::ChannelInsertParams::kEqBands,
+/// emp::SpectrumAnalyzer::kBins and emp::TelemetrySnapshot::kHistogramBuckets)
+/// </summary>
+#define EMP_EQ_BANDS 4
+#define EMP_SPECTRUM_BINS 1025
+#define EMP_TELEMETRY_BUCKETS 32
+
+/// <summary>
+/// Port flags as reported by JACK
+/// </summary>
+enum EmpPortFlags
+{
+    EMP_PORT_IS_INPUT = 0x1,
+    EMP_PORT_IS_OUTPUT = 0x2,
+    EMP_PORT_IS_PHYSICAL = 0x4
+};
+
+/// <summary>
+/// Channel parameter of an EmpParameterChange (matches emp::ParameterId)
+/// </summary>
+enum EmpParameter
+{
+    EMP_PARAMETER_VOLUME = 0,
+    EMP_PARAMETER_PAN = 1,
+    EMP_PARAMETER_GAIN_DB = 2,
+    EMP_PARAMETER_MUTE = 3,         // Non-zero value mutes
+    EMP_PARAMETER_SOLO = 4          // Non-zero value solos
+};
+
+/// <summary>
+/// Result of a posted parameter change (matches emp::EngineCommandStatus)
+/// </summary>
+enum EmpCommandStatus
+{
+    EMP_COMMAND_APPLIED = 0,
+    EMP_COMMAND_REJECTED = -1
+};
+
+/// <summary>
+/// One parameter edit (layout of emp::ParameterChange)
+/// </summary>
+typedef struct EmpParameterChange
+{
+    int32_t channel;
+    int32_t parameter;              // EmpParameter
+    float value;
+} EmpParameterChange;
+
+/// <summary>
+/// Acknowledgement of a posted parameter change (layout of emp::EngineCompletion)
+/// </summary>
+typedef struct EmpCommandCompletion
+{
+    uint32_t id;
+    int32_t status;                 // EmpCommandStatus
+    uint64_t cycle;                 // Process cycle the change took effect in
+} EmpCommandCompletion;
+
+/// <summary>
+/// Latest meter values of one channel (layout of emp::ChannelMeterFrame)
+/// </summary>
+typedef struct EmpChannelMeter
+{
+    float peak;
+    float rms;
+    float peakHold;
+    uint32_t clipCount;             // Windows that reached full scale since the last reset
+} EmpChannelMeter;
+
+/// <summary>
+/// State of the JACK server as seen by the client
+/// </summary>
+typedef struct EmpServerStatus
+{
+    int32_t isRunning;
+    int32_t sampleRate;
+    int32_t bufferSize;
+    float cpuLoad;                  // Percent
+    uint64_t xruns;
+    double latencyMs;               // Longest playback path from one of our ports
+} EmpServerStatus;
+
+/// <summary>
+/// One port of the JACK graph
+/// </summary>
+typedef struct EmpPortInfo
+{
+    char name[EMP_PORT_NAME_SIZE];
+    char type[EMP_PORT_TYPE_SIZE];
+    uint32_t flags;                 // EmpPortFlags
+    int32_t connectionCount;
+} EmpPortInfo;
+
+typedef struct EmpPortName
+{
+    char name[EMP_PORT_NAME_SIZE];
+} EmpPortName;
+
+/// <summary>
+/// Shape of a parameter ramp (matches emp::RampShape)
+/// </summary>
+enum EmpRampShape
+{
+    EMP_RAMP_STEP = 0,
+    EMP_RAMP_LINEAR = 1,
+    EMP_RAMP_EXPONENTIAL = 2
+};
+
+/// <summary>
+/// Parameter change that lands on a given frame (layout of emp::TimedParameterChange)
+/// </summary>
+typedef struct EmpTimedParameterChange
+{
+    uint64_t frameTime;             // Server frame time of the first frame using the new value
+    EmpParameterChange change;
+    int32_t shape;                  // EmpRampShape; volume, pan and gain only
+    uint32_t rampFrames;            // 0 for a step
+} EmpTimedParameterChange;
+
+/// <summary>
+/// Channel parameters of a scene
+/// </summary>
+typedef struct EmpSceneChannel
+{
+    float volume;
+    float pan;
+    float gainDb;
+    int32_t mute;
+    int32_t solo;
+} EmpSceneChannel;
+
+/// <summary>
+/// Sizes of a scene's arrays: channelCount EmpSceneChannel values and a routeInputs x
+/// routeOutputs gain matrix, input-major
+/// </summary>
+typedef struct EmpSceneLayout
+{
+    int32_t channelCount;
+    int32_t routeInputs;
+    int32_t routeOutputs;
+    int32_t routingEnabled;
+} EmpSceneLayout;
+
+/// <summary>
+/// Scene compiled for recall; owned by the caller until emp_free_scene()
+/// </summary>
+typedef struct EmpScene EmpScene;
+
+/// <summary>
+/// Filter type of an EQ band (matches emp::EqBandType)
+/// </summary>
+enum EmpEqBandType
+{
+    EMP_EQ_PEAK = 0,
+    EMP_EQ_LOW_SHELF = 1,
+    EMP_EQ_HIGH_SHELF = 2,
+    EMP_EQ_HIGH_PASS = 3,           // 12 dB/octave, gain unused
+    EMP_EQ_LOW_PASS = 4             // 12 dB/octave, gain unused
+};
+
+typedef struct EmpEqBand
+{
+    int32_t type;                   // EmpEqBandType
+    float frequency;                // Hz
+    float gainDb;
+    float q;                        // Bandwidth, or shelf slope
+    int32_t enabled;
+} EmpEqBand;
+
+typedef struct EmpGate
+{
+    float thresholdDb;
+    float rangeDb;
+    float attackMs;
+    float releaseMs;
+    int32_t enabled;
+} EmpGate;
+
+typedef struct EmpCompressor
+{
+    float thresholdDb;
+    float ratio;
+    float attackMs;
+    float releaseMs;
+    float makeupDb;
+    int32_t enabled;
+} EmpCompressor;
+
+/// <summary>
+/// Insert chain of one channel: EQ, then gate, then compressor
+/// </summary>
+typedef struct EmpChannelInserts
+{
+    EmpEqBand eq[EMP_EQ_BANDS];
+    EmpGate gate;
+    EmpCompressor compressor;
+    int32_t bypass;                 // Skips the whole chain, keeping its settings
+} EmpChannelInserts;
+
+/// <summary>
+/// Bus graph types (match emp::BusType, emp::SendSource, emp::SendTap and
+/// emp::BusGraphStatus)
+/// </summary>
+enum EmpBusType
+{
+    EMP_BUS_AUX = 0,
+    EMP_BUS_SUBGROUP = 1,
+    EMP_BUS_MASTER = 2
+};
+
+enum EmpSendSource
+{
+    EMP_SEND_FROM_CHANNEL = 0,
+    EMP_SEND_FROM_BUS = 1
+};
+
+enum EmpSendTap
+{
+    EMP_SEND_PRE_FADER = 0,
+    EMP_SEND_POST_FADER = 1
+};
+
+enum EmpBusGraphStatus
+{
+    EMP_BUS_APPLIED = 0,
+    EMP_BUS_NOT_FOUND = -1,
+    EMP_BUS_INVALID = -2,
+    EMP_BUS_CYCLE = -3,
+    EMP_BUS_FULL = -4
+};
+
+typedef struct EmpBusConfig
+{
+    int32_t type;                   // EmpBusType
+    int32_t channels;               // 1 or 2
+    float volume;
+    int32_t mute;
+    int32_t firstOutput;            // Output port of the bus's first channel, -1 for none
+} EmpBusConfig;
+
+typedef struct EmpBusSend
+{
+    int32_t sourceType;             // EmpSendSource
+    int32_t source;                 // Channel index or bus id
+    int32_t destination;            // Bus id
+    int32_t tap;                    // EmpSendTap
+    float level;
+    float pan;                      // Mono sources into stereo buses
+} EmpBusSend;
+
+/// <summary>
+/// Signal an analysis tap or recorder track takes (matches emp::TapSource)
+/// </summary>
+enum EmpTapSource
+{
+    EMP_TAP_CHANNEL = 0,            // Input channel, pre-fader
+    EMP_TAP_OUTPUT = 1              // Output port as sent to the server
+};
+
+/// <summary>
+/// Analysis results of one tap; the spectrum is copied separately
+/// </summary>
+typedef struct EmpAnalysis
+{
+    uint32_t sampleRate;
+    float momentaryLufs;
+    float shortTermLufs;
+    float integratedLufs;
+    float truePeakDb;
+    uint64_t droppedBlocks;
+    uint64_t sequence;              // Increments with every publish
+} EmpAnalysis;
+
+/// <summary>
+/// Recording file format (matches emp::RecordFormat)
+/// </summary>
+enum EmpRecordFormat
+{
+    EMP_RECORD_WAV = 0,             // RIFF WAVE, limited to 4 GiB per file
+    EMP_RECORD_WAVE64 = 1
+};
+
+typedef struct EmpRecordTrack
+{
+    int32_t source;                 // EmpTapSource
+    int32_t index;
+} EmpRecordTrack;
+
+/// <summary>
+/// State of the disk recorder; the per-track ring fill is copied separately
+/// </summary>
+typedef struct EmpRecorderStatus
+{
+    int32_t isRecording;
+    uint32_t sampleRate;
+    uint64_t capturedFrames;        // Frames the audio thread queued per track
+    uint64_t writtenFrames;         // Frames on disk per track
+    uint64_t bytesWritten;
+    uint64_t droppedBlocks;
+    int32_t writeFailed;
+    int32_t limitReached;           // A WAV file hit its 4 GiB limit
+} EmpRecorderStatus;
+
+/// <summary>
+/// Cycle timing and engine state counters (emp::TelemetrySnapshot without its lists)
+/// </summary>
+typedef struct EmpTelemetry
+{
+    uint64_t cycles;
+    uint64_t frames;
+    uint64_t totalNs;
+    uint64_t lastNs;
+    uint64_t worstNs;
+    uint64_t worstBudgetNs;         // Real-time budget of the worst cycle
+    uint64_t overBudgetCycles;
+    uint64_t histogram[EMP_TELEMETRY_BUCKETS];  // Bucket i counts cycles of [2^i, 2^(i+1)) ns
+    uint32_t sampleRate;
+    int32_t arenasLocked;           // Per-cycle arenas locked in RAM, not all engine memory
+    uint32_t mixedChannels;
+    uint32_t idleChannels;
+    uint32_t insertChannels;
+    uint32_t bypassedInserts;
+    uint64_t xrunCount;
+    uint64_t droppedCompletions;    // Command acknowledgements overwritten before anyone read them
+} EmpTelemetry;
+
+typedef struct EmpXrunEvent
+{
+    uint64_t timestampUs;           // Microseconds since the Unix epoch
+    uint64_t cycle;                 // Engine cycles processed when the xrun was reported
+    float delayedUs;                // 0 if unknown
+} EmpXrunEvent;
+
+/// <summary>
+/// Latency range of one of the client's ports, in frames
+/// </summary>
+typedef struct EmpPortLatency
+{
+    char portName[EMP_PORT_NAME_SIZE];
+    uint32_t captureMin;
+    uint32_t captureMax;
+    uint32_t playbackMin;
+    uint32_t playbackMax;
+} EmpPortLatency;
+
+/// <summary>
+/// Resampler quality of a virtual source (matches emp::ResamplerQuality)
+/// </summary>
+enum EmpResamplerQuality
+{
+    EMP_RESAMPLER_LOW = 0,
+    EMP_RESAMPLER_MEDIUM = 1,
+    EMP_RESAMPLER_HIGH = 2
+};
+
+typedef struct EmpVirtualSourceConfig
+{
+    int32_t firstChannel;           // Engine channel fed by the device's first channel
+    int32_t channels;
+    uint32_t sampleRate;            // The device's nominal rate
+    int32_t quality;                // EmpResamplerQuality
+    float latencyMs;                // Audio the drift loop keeps buffered
+} EmpVirtualSourceConfig;
+
+typedef struct EmpVirtualSourceStatus
+{
+    double ratio;                   // Device frames consumed per graph frame
+    double driftPpm;                // Device clock against its nominal rate
+    uint64_t underruns;
+    uint64_t overruns;
+    float fillFrames;
+    float targetFrames;
+    int32_t isStreaming;            // 0 while the buffer (re)fills to its target
+    int32_t isLocked;               // Past the fast acquisition phase
+} EmpVirtualSourceStatus;
+
+/// <summary>
+/// Callbacks run on a client thread, never the process callback. A callback may still
+/// run once after being replaced, so userData must outlive the registration.
+/// </summary>
+typedef void (EMP_CALL *EmpServerStatusCallback)(bool isRunning, void* userData);
+typedef void (EMP_CALL *EmpMeterUpdateCallback)(int32_t channel, float peak, float rms, void* userData);
+
+EMP_API int32_t EMP_CALL emp_get_api_version(void);
+
+/// <summary>
+/// Copies the latest error message of the calling thread (truncated to size, always
+/// terminated) and returns its full length, 0 if no call has failed
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_last_error(char* buffer, int32_t size);
+
+// Lifecycle
+
+/// <summary>
+/// Creates the engine and opens the JACK client. Returns true if the client is open,
+/// including when it already was.
+/// </summary>
+EMP_API bool EMP_CALL emp_initialize(const char* clientName);
+
+/// <summary>
+/// Deactivates and closes the client and frees the engine; emp_initialize() may follow
+/// </summary>
+EMP_API void EMP_CALL emp_shutdown(void);
+
+EMP_API bool EMP_CALL emp_create_ports(int32_t numInputs, int32_t numOutputs);
+EMP_API bool EMP_CALL emp_resize_ports(int32_t numInputs, int32_t numOutputs);
+EMP_API bool EMP_CALL emp_activate(void);
+EMP_API bool EMP_CALL emp_deactivate(void);
+
+/// <summary>
+/// Sets the worker threads started by the next emp_activate() (0 renders on the process
+/// thread only)
+/// </summary>
+EMP_API bool EMP_CALL emp_set_worker_threads(int32_t workerCount, int32_t realtimePriority);
+
+// Channel parameters
+
+EMP_API void EMP_CALL emp_set_channel_volume(int32_t channel, float volume);
+EMP_API void EMP_CALL emp_set_channel_pan(int32_t channel, float pan);
+EMP_API void EMP_CALL emp_set_channel_gain(int32_t channel, float gainDb);
+EMP_API void EMP_CALL emp_set_channel_mute(int32_t channel, bool mute);
+EMP_API void EMP_CALL emp_set_channel_solo(int32_t channel, bool solo);
+
+/// <summary>
+/// Applies changes together (one snapshot publish) and returns how many were applied
+/// </summary>
+EMP_API int32_t EMP_CALL emp_apply_parameter_batch(const EmpParameterChange* changes, int32_t count);
+
+/// <summary>
+/// Queues changes for the process callback, which applies them at the start of a cycle. Writes a
+/// command id per change into commandIds (0 if the queue was full) and returns how many
+/// were queued.
+/// </summary>
+EMP_API int32_t EMP_CALL emp_post_parameter_changes(const EmpParameterChange* changes, uint32_t* commandIds, int32_t count);
+
+/// <summary>
+/// Moves up to capacity acknowledgements of posted changes into completions and returns
+/// how many were written
+/// </summary>
+EMP_API int32_t EMP_CALL emp_read_command_completions(EmpCommandCompletion* completions, int32_t capacity);
+
+// Meters
+
+/// <summary>
+/// Copies the latest meters of up to capacity channels and returns how many were written,
+/// or -1. sequence (optional) receives the publish count, unchanged between publishes.
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_channel_meters(EmpChannelMeter* meters, int32_t capacity, uint64_t* sequence);
+
+EMP_API void EMP_CALL emp_configure_meters(float refreshRateHz, float peakHoldSeconds);
+EMP_API void EMP_CALL emp_reset_clip_counters(void);
+
+// Server
+
+EMP_API int32_t EMP_CALL emp_get_sample_rate(void);
+EMP_API int32_t EMP_CALL emp_get_buffer_size(void);
+EMP_API float EMP_CALL emp_get_cpu_load(void);
+EMP_API bool EMP_CALL emp_is_server_running(void);
+EMP_API bool EMP_CALL emp_get_server_status(EmpServerStatus* status);
+
+/// <summary>
+/// Server frame time of the last cycle's first frame, for scheduling changes
+/// </summary>
+EMP_API uint64_t EMP_CALL emp_get_frame_time(void);
+
+// Ports
+
+EMP_API bool EMP_CALL emp_connect_ports(const char* sourcePort, const char* destinationPort);
+EMP_API bool EMP_CALL emp_disconnect_ports(const char* sourcePort, const char* destinationPort);
+
+/// <summary>
+/// Copies up to capacity ports of the graph and returns the total number of ports, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_ports(EmpPortInfo* ports, int32_t capacity);
+
+/// <summary>
+/// Copies up to capacity names of the ports connected to portName and returns the total
+/// number of connections, or -1 if the port is unknown
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_port_connections(const char* portName, EmpPortName* connections, int32_t capacity);
+
+// Engine settings
+
+/// <summary>
+/// Queues changes for the frames they are stamped with, like
+/// emp_post_parameter_changes(), and returns how many were queued
+/// </summary>
+EMP_API int32_t EMP_CALL emp_post_timed_parameter_changes(const EmpTimedParameterChange* changes, uint32_t* commandIds, int32_t count);
+
+EMP_API void EMP_CALL emp_set_parameter_smoothing(int32_t shape, float milliseconds);
+EMP_API void EMP_CALL emp_set_silence_detection(bool enabled);
+
+/// <summary>
+/// Peak level below which a channel counts as silent (0 skips exact silence only)
+/// </summary>
+EMP_API void EMP_CALL emp_set_silence_threshold(float threshold);
+
+// Routing matrix
+
+/// <summary>
+/// Sets the gain of a crosspoint; a gain of 0 removes the route
+/// </summary>
+EMP_API bool EMP_CALL emp_set_route(int32_t input, int32_t output, float gain);
+EMP_API void EMP_CALL emp_clear_routes(void);
+EMP_API void EMP_CALL emp_set_routing_enabled(bool enabled);
+
+/// <summary>
+/// Copies the matrix (input-major) if it fits in capacity gains, stores its dimensions
+/// and returns its size, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_routing_matrix(float* gains, int32_t capacity, int32_t* numInputs, int32_t* numOutputs);
+
+// Scenes
+
+/// <summary>
+/// Stores the current scene's sizes in layout and copies the channels and routes if
+/// they fit in the given capacities
+/// </summary>
+EMP_API bool EMP_CALL emp_capture_scene(EmpSceneLayout* layout, EmpSceneChannel* channels, int32_t channelCapacity,
+                                        float* routes, int32_t routeCapacity);
+
+/// <summary>
+/// Compiles a scene for recall off the audio thread, or returns NULL
+/// </summary>
+EMP_API EmpScene* EMP_CALL emp_compile_scene(const EmpSceneLayout* layout, const EmpSceneChannel* channels, const float* routes);
+
+/// <summary>
+/// Recalls a compiled scene, crossfading for crossfadeMs. Returns the command id, or 0
+/// if the scene was compiled for another capacity or the queue is full.
+/// </summary>
+EMP_API uint32_t EMP_CALL emp_recall_scene(const EmpScene* scene, float crossfadeMs);
+EMP_API void EMP_CALL emp_free_scene(EmpScene* scene);
+
+// Channel inserts
+
+EMP_API bool EMP_CALL emp_set_channel_inserts(int32_t channel, const EmpChannelInserts* inserts);
+EMP_API bool EMP_CALL emp_get_channel_inserts(int32_t channel, EmpChannelInserts* inserts);
+EMP_API bool EMP_CALL emp_set_insert_bypass(int32_t channel, bool bypass);
+
+// Buses
+
+/// <summary>
+/// Adds a bus and returns its id, or 0 if the configuration is invalid or the graph is
+/// full
+/// </summary>
+EMP_API int32_t EMP_CALL emp_create_bus(const EmpBusConfig* config);
+EMP_API bool EMP_CALL emp_remove_bus(int32_t id);
+
+/// <summary>
+/// Bus graph edits return an EmpBusGraphStatus
+/// </summary>
+EMP_API int32_t EMP_CALL emp_set_bus(int32_t id, const EmpBusConfig* config);
+EMP_API bool EMP_CALL emp_get_bus(int32_t id, EmpBusConfig* config);
+EMP_API int32_t EMP_CALL emp_set_send(const EmpBusSend* send);
+EMP_API bool EMP_CALL emp_remove_send(int32_t sourceType, int32_t source, int32_t destination);
+
+/// <summary>
+/// Copies up to capacity sends and returns the total number of sends, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_sends(EmpBusSend* sends, int32_t capacity);
+
+// Analysis
+
+EMP_API bool EMP_CALL emp_set_analysis_tap(int32_t source, int32_t index, bool enabled);
+
+/// <summary>
+/// Copies a tap's latest results and up to capacity spectrum bins (dBFS; bin k is at
+/// k * sampleRate / 2048 Hz) and returns the number of bins, or -1 if the tap is not
+/// enabled
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_analysis(int32_t source, int32_t index, EmpAnalysis* analysis, float* spectrum, int32_t capacity);
+
+// Recorder
+
+/// <summary>
+/// Starts recording tracks to path (without extension): one interleaved file when
+/// polyphonic, else one file per track. ringSeconds of audio are buffered per track
+/// between the audio thread and the disk.
+/// </summary>
+EMP_API bool EMP_CALL emp_start_recording(const char* path, int32_t format, bool polyphonic, const EmpRecordTrack* tracks,
+                                          int32_t trackCount, float ringSeconds);
+EMP_API bool EMP_CALL emp_stop_recording(void);
+
+/// <summary>
+/// Copies the recorder's status and up to capacity per-track ring fills (0 to 1) and
+/// returns the number of tracks, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_recorder_status(EmpRecorderStatus* status, float* ringFill, int32_t capacity);
+
+// Telemetry
+
+/// <summary>
+/// Copies the counters and up to capacity of the latest xruns (oldest first) and returns
+/// the number of xruns kept, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_telemetry(EmpTelemetry* telemetry, EmpXrunEvent* xruns, int32_t capacity);
+
+/// <summary>
+/// Copies up to capacity port latencies and returns the number of ports, or -1
+/// </summary>
+EMP_API int32_t EMP_CALL emp_get_port_latencies(EmpPortLatency* latencies, int32_t capacity);
+EMP_API void EMP_CALL emp_reset_telemetry(void);
+
+// Virtual sources
+
+/// <summary>
+/// Adds a source fed by emp_write_virtual_source() and returns its id, or 0 if the
+/// configuration is invalid or its channels overlap another source's
+/// </summary>
+EMP_API int32_t EMP_CALL emp_create_virtual_source(const EmpVirtualSourceConfig* config);
+EMP_API bool EMP_CALL emp_remove_virtual_source(int32_t id);
+
+/// <summary>
+/// Queues frames of interleaved samples from the device; false if the id is unknown or
+/// the buffer is full
+/// </summary>
+EMP_API bool EMP_CALL emp_write_virtual_source(int32_t id, const float* interleaved, int32_t frames);
+EMP_API bool EMP_CALL emp_get_virtual_source_status(int32_t id, EmpVirtualSourceStatus* status);
+
+// Callbacks (pass NULL to unregister)
+
+EMP_API void EMP_CALL emp_register_server_status_callback(EmpServerStatusCallback callback, void* userData);
+EMP_API void EMP_CALL emp_register_meter_update_callback(EmpMeterUpdateCallback callback, void* userData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
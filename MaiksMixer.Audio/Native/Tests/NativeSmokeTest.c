@@ -0,0 +1,196 @@
+/*
+ * Drives MaiksMixerNative through its C interface against a running JACK server (the
+ * dummy backend is enough): opens the client, processes for a moment and reads back
+ * status, meters and ports, round-trips routing, inserts, buses, scenes and virtual
+ * sources, reads analysis, recorder and telemetry state, and resizes the port set.
+ * Exits with 77 (skipped) when no server is running.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MaiksMixerNative.h"
+
+#define INPUTS 4
+#define OUTPUTS 2
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+    if (condition) return;
+
+    char error[256];
+    emp_get_last_error(error, (int32_t)sizeof(error));
+    printf("FAIL %s (%s)\n", what, error);
+    g_failures++;
+}
+
+static void SleepMilliseconds(long milliseconds)
+{
+    struct timespec duration;
+    duration.tv_sec = milliseconds / 1000;
+    duration.tv_nsec = (milliseconds % 1000) * 1000000L;
+    nanosleep(&duration, NULL);
+}
+
+/* Ports of this client in the cached graph */
+static int32_t CountOwnPorts(void)
+{
+    EmpPortInfo ports[64];
+    const int32_t copied = emp_get_ports(ports, 64);
+    int32_t ours = 0;
+    for (int32_t i = 0; i < copied && i < 64; i++) {
+        if (strncmp(ports[i].name, "emp_native_smoke:", 17) == 0) ours++;
+    }
+    return ours;
+}
+
+int main(void)
+{
+    Check(emp_get_api_version() == EMP_NATIVE_API_VERSION, "API version");
+
+    if (!emp_initialize("emp_native_smoke")) {
+        printf("No JACK server running; start one with: jackd -d dummy -r 48000 -p 256\n");
+        emp_shutdown();
+        return 77;
+    }
+
+    Check(emp_create_ports(INPUTS, OUTPUTS), "create ports");
+    Check(emp_activate(), "activate");
+
+    EmpParameterChange changes[INPUTS];
+    for (int i = 0; i < INPUTS; i++) {
+        changes[i].channel = i;
+        changes[i].parameter = EMP_PARAMETER_PAN;
+        changes[i].value = (float)i / (INPUTS - 1);
+    }
+    Check(emp_apply_parameter_batch(changes, INPUTS) == INPUTS, "parameter batch");
+    emp_set_channel_volume(0, 0.5f);
+    emp_set_channel_mute(1, true);
+
+    uint32_t commandIds[1];
+    EmpParameterChange solo = { 2, EMP_PARAMETER_SOLO, 1.0f };
+    Check(emp_post_parameter_changes(&solo, commandIds, 1) == 1, "post parameter change");
+
+    SleepMilliseconds(300);
+
+    EmpCommandCompletion completions[4];
+    const int32_t completed = emp_read_command_completions(completions, 4);
+    Check(completed == 1 && completions[0].id == commandIds[0] && completions[0].status == EMP_COMMAND_APPLIED,
+          "command completion");
+
+    EmpServerStatus status;
+    Check(emp_get_server_status(&status), "server status");
+    Check(status.isRunning == 1 && status.sampleRate > 0 && status.bufferSize > 0, "server status values");
+    Check(emp_get_sample_rate() == status.sampleRate, "sample rate");
+    Check(emp_get_frame_time() > 0, "frame time");
+
+    EmpChannelMeter meters[INPUTS];
+    uint64_t sequence = 0;
+    Check(emp_get_channel_meters(meters, INPUTS, &sequence) == INPUTS, "channel meters");
+    Check(sequence > 0, "meters published by the process callback");
+
+    // Count first, then copy into an array of that size
+    const int32_t portCount = emp_get_ports(NULL, 0);
+    Check(portCount >= INPUTS + OUTPUTS, "port count");
+
+    Check(CountOwnPorts() == INPUTS + OUTPUTS, "own ports listed");
+
+    // Routing matrix, sized for the engine's port capacity: size first, then copy
+    Check(emp_set_route(1, 1, 0.25f), "set route");
+    int32_t routeInputs = 0;
+    int32_t routeOutputs = 0;
+    const int32_t routeCount = emp_get_routing_matrix(NULL, 0, &routeInputs, &routeOutputs);
+    Check(routeInputs >= INPUTS && routeOutputs >= OUTPUTS && routeCount == routeInputs * routeOutputs,
+          "routing matrix size");
+    float* gains = malloc(sizeof(float) * (size_t)(routeCount > 0 ? routeCount : 1));
+    Check(emp_get_routing_matrix(gains, routeCount, &routeInputs, &routeOutputs) == routeCount
+          && gains[1 * routeOutputs + 1] == 0.25f, "routing matrix values");
+
+    // Inserts
+    EmpChannelInserts inserts;
+    Check(emp_get_channel_inserts(0, &inserts), "get inserts");
+    inserts.compressor.enabled = 1;
+    inserts.compressor.ratio = 2.0f;
+    Check(emp_set_channel_inserts(0, &inserts), "set inserts");
+    Check(emp_get_channel_inserts(0, &inserts) && inserts.compressor.enabled == 1 && inserts.compressor.ratio == 2.0f,
+          "inserts read back");
+
+    // Buses and sends
+    EmpBusConfig busConfig = { EMP_BUS_AUX, 2, 0.8f, 0, 0 };
+    const int32_t bus = emp_create_bus(&busConfig);
+    Check(bus > 0, "create bus");
+    EmpBusSend send = { EMP_SEND_FROM_CHANNEL, 0, bus, EMP_SEND_PRE_FADER, 0.5f, 0.5f };
+    Check(emp_set_send(&send) == EMP_BUS_APPLIED, "set send");
+    EmpBusSend sends[4];
+    Check(emp_get_sends(sends, 4) == 1 && sends[0].destination == bus && sends[0].level == 0.5f, "sends read back");
+    EmpBusConfig busRead;
+    Check(emp_get_bus(bus, &busRead) && busRead.volume == 0.8f, "bus read back");
+
+    // Scenes: capture the mix, recall it and wait for the command
+    EmpSceneLayout layout;
+    EmpSceneChannel sceneChannels[INPUTS];
+    Check(emp_capture_scene(&layout, sceneChannels, INPUTS, gains, routeCount), "capture scene");
+    Check(layout.channelCount == INPUTS && sceneChannels[0].volume == 0.5f && sceneChannels[1].mute == 1,
+          "scene channels");
+    Check(layout.routeInputs * layout.routeOutputs == routeCount && gains[1 * layout.routeOutputs + 1] == 0.25f,
+          "scene routes");
+    EmpScene* scene = emp_compile_scene(&layout, sceneChannels, gains);
+    Check(scene != NULL, "compile scene");
+    const uint32_t recallId = emp_recall_scene(scene, 10.0f);
+    Check(recallId != 0, "recall scene");
+    emp_free_scene(scene);
+    free(gains);
+
+    // Virtual source on the last channel
+    EmpVirtualSourceConfig sourceConfig = { INPUTS - 1, 1, 48000, EMP_RESAMPLER_MEDIUM, 20.0f };
+    const int32_t source = emp_create_virtual_source(&sourceConfig);
+    Check(source > 0, "create virtual source");
+    float packet[480] = { 0 };
+    Check(emp_write_virtual_source(source, packet, 480), "write virtual source");
+
+    Check(emp_set_analysis_tap(EMP_TAP_CHANNEL, 0, true), "enable analysis tap");
+
+    SleepMilliseconds(300);
+
+    Check(emp_read_command_completions(completions, 4) == 1 && completions[0].id == recallId, "scene recalled");
+
+    EmpVirtualSourceStatus sourceStatus;
+    Check(emp_get_virtual_source_status(source, &sourceStatus), "virtual source status");
+    Check(emp_remove_virtual_source(source), "remove virtual source");
+    Check(emp_remove_bus(bus) && emp_get_sends(NULL, 0) == 0, "remove bus and its sends");
+
+    EmpAnalysis analysis;
+    static float spectrum[EMP_SPECTRUM_BINS];
+    Check(emp_get_analysis(EMP_TAP_CHANNEL, 0, &analysis, spectrum, EMP_SPECTRUM_BINS) == EMP_SPECTRUM_BINS, "analysis");
+    Check(emp_get_analysis(EMP_TAP_OUTPUT, 0, &analysis, NULL, 0) == -1, "analysis of a disabled tap");
+
+    EmpRecorderStatus recorder;
+    Check(emp_get_recorder_status(&recorder, NULL, 0) == 0 && recorder.isRecording == 0, "recorder idle");
+
+    EmpTelemetry telemetry;
+    Check(emp_get_telemetry(&telemetry, NULL, 0) >= 0, "telemetry");
+    Check(telemetry.cycles > 0 && telemetry.sampleRate == (uint32_t)status.sampleRate, "telemetry counts cycles");
+    Check(emp_get_port_latencies(NULL, 0) == INPUTS + OUTPUTS, "port latencies");
+
+    // Resizing goes through the port registrar, which registers and unregisters JACK ports
+    Check(emp_resize_ports(INPUTS + 2, OUTPUTS + 1), "grow ports");
+    SleepMilliseconds(100);
+    Check(CountOwnPorts() == INPUTS + OUTPUTS + 3, "own ports registered after growing");
+
+    Check(emp_resize_ports(INPUTS - 1, OUTPUTS), "shrink ports");
+    SleepMilliseconds(100);
+    Check(CountOwnPorts() == INPUTS + OUTPUTS - 1, "own ports unregistered after shrinking");
+
+    Check(emp_deactivate(), "deactivate");
+    emp_shutdown();
+
+    if (g_failures > 0) printf("%d native interface check(s) failed\n", g_failures);
+    else printf("ok   native interface (%d Hz, %d frames)\n", status.sampleRate, status.bufferSize);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+using System;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+using System.Threading;
+using MaiksMixer.Core.Logging;
+
+namespace MaiksMixer.Core.Communication
+{
+    /// <summary>
+    /// Frame types carried by the engine's shared-memory rings.
+    /// </summary>
+    public enum SharedFrameType : uint
+    {
+        /// <summary>
+        /// uint channel count, uint values per channel, then float values.
+        /// </summary>
+        Meters = 1,
+
+        /// <summary>
+        /// Array of <see cref="SharedParameterChange"/> records.
+        /// </summary>
+        ParameterChanges = 2,
+
+        /// <summary>
+        /// Array of <see cref="SharedTimedParameterChange"/> records.
+        /// </summary>
+        TimedParameterChanges = 3
+    }
+
+    /// <summary>
+    /// Channel parameter edit as carried by a ParameterChanges frame.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SharedParameterChange
+    {
+        /// <summary>
+        /// Channel index.
+        /// </summary>
+        public int Channel;
+
+        /// <summary>
+        /// Parameter id (0 volume, 1 pan, 2 gain dB, 3 mute, 4 solo).
+        /// </summary>
+        public int Parameter;
+
+        /// <summary>
+        /// New value.
+        /// </summary>
+        public float Value;
+    }
+
+    /// <summary>
+    /// Channel parameter edit stamped with the engine frame it lands on, as carried by a
+    /// TimedParameterChanges frame.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SharedTimedParameterChange
+    {
+        /// <summary>
+        /// Engine frame time of the first frame using the new value.
+        /// </summary>
+        public ulong FrameTime;
+
+        /// <summary>
+        /// Channel index.
+        /// </summary>
+        public int Channel;
+
+        /// <summary>
+        /// Parameter id (0 volume, 1 pan, 2 gain dB, 3 mute, 4 solo).
+        /// </summary>
+        public int Parameter;
+
+        /// <summary>
+        /// New value.
+        /// </summary>
+        public float Value;
+
+        /// <summary>
+        /// Ramp shape (0 step, 1 linear, 2 exponential).
+        /// </summary>
+        public int Shape;
+
+        /// <summary>
+        /// Ramp length in frames, 0 for a step.
+        /// </summary>
+        public uint RampFrames;
+    }
+
+    /// <summary>
+    /// Client side of a lock-free ring of length-prefixed binary frames created by the C++
+    /// engine in shared memory. One side only writes and the other only reads; no kernel
+    /// mutex is taken per frame. The layout mirrors emp::SharedMemoryRing.
+    /// </summary>
+    public sealed unsafe class SharedMemoryRing : IDisposable
+    {
+        private const uint Magic = 0x524D5045;
+        private const uint LayoutVersion = 1;
+
+        private const int SlotCountOffset = 8;
+        private const int SlotSizeOffset = 12;
+        private const int WriteIndexOffset = 64;
+        private const int ReadIndexOffset = 128;
+        private const int DroppedFramesOffset = 192;
+        private const int SlotOffset = 256;
+        private const int FrameHeaderSize = 16;
+
+        private MemoryMappedFile? _mappedFile;
+        private MemoryMappedViewAccessor? _accessor;
+        private byte* _base;
+        private uint _slotCount;
+        private uint _slotSize;
+        private bool _isDisposed;
+
+        /// <summary>
+        /// Gets the largest payload a frame can carry.
+        /// </summary>
+        public int MaxPayload => (int)_slotSize - FrameHeaderSize;
+
+        /// <summary>
+        /// Gets the number of frames rejected because the ring was full.
+        /// </summary>
+        public long DroppedFrames => _base == null ? 0 : Volatile.Read(ref *(long*)(_base + DroppedFramesOffset));
+
+        /// <summary>
+        /// Opens a ring created by the engine. Named mappings exist on Windows only; elsewhere
+        /// this fails without touching the platform.
+        /// </summary>
+        /// <param name="name">The mapping name, e.g. "MaiksMixerRing_EngineToUi".</param>
+        /// <returns>True if the ring was opened; otherwise, false.</returns>
+        public bool Open(string name)
+        {
+            Close();
+
+            if (!OperatingSystem.IsWindows())
+            {
+                LogManager.Warn($"Shared memory ring {name} not opened: named mappings require Windows");
+                return false;
+            }
+
+            try
+            {
+                _mappedFile = MemoryMappedFile.OpenExisting(name, MemoryMappedFileRights.ReadWrite);
+                _accessor = _mappedFile.CreateViewAccessor();
+                _accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref _base);
+                _base += _accessor.PointerOffset;
+
+                uint magic = Volatile.Read(ref *(uint*)_base);
+                _slotCount = *(uint*)(_base + SlotCountOffset);
+                _slotSize = *(uint*)(_base + SlotSizeOffset);
+
+                bool valid = magic == Magic && *(uint*)(_base + 4) == LayoutVersion &&
+                             _slotCount >= 2 && (_slotCount & (_slotCount - 1)) == 0 &&
+                             _slotSize > FrameHeaderSize &&
+                             SlotOffset + (long)_slotCount * _slotSize <= _accessor.Capacity;
+                if (!valid)
+                {
+                    LogManager.Warn($"Shared memory ring {name} has an unexpected layout");
+                    Close();
+                    return false;
+                }
+
+                return true;
+            }
+            catch (Exception ex)
+            {
+                LogManager.Error($"Failed to open shared memory ring {name}: {ex.Message}", ex);
+                Close();
+                return false;
+            }
+        }
+
+        /// <summary>
+        /// Appends a frame (writer side).
+        /// </summary>
+        /// <param name="type">The frame type.</param>
+        /// <param name="payload">The frame payload.</param>
+        /// <returns>True if the frame was written; false if the ring is full or the payload is too large.</returns>
+        public bool TryWrite(SharedFrameType type, ReadOnlySpan<byte> payload)
+        {
+            if (_base == null || payload.Length > MaxPayload) return false;
+
+            long write = Volatile.Read(ref *(long*)(_base + WriteIndexOffset));
+            if (write - Volatile.Read(ref *(long*)(_base + ReadIndexOffset)) >= _slotCount)
+            {
+                Interlocked.Increment(ref *(long*)(_base + DroppedFramesOffset));
+                return false;
+            }
+
+            byte* slot = SlotAt(write);
+            *(long*)slot = write + 1;
+            *(uint*)(slot + 8) = (uint)type;
+            *(uint*)(slot + 12) = (uint)payload.Length;
+            payload.CopyTo(new Span<byte>(slot + FrameHeaderSize, payload.Length));
+
+            Volatile.Write(ref *(long*)(_base + WriteIndexOffset), write + 1);
+            return true;
+        }
+
+        /// <summary>
+        /// Removes the oldest frame (reader side).
+        /// </summary>
+        /// <param name="type">Receives the frame type.</param>
+        /// <param name="payload">Receives the payload.</param>
+        /// <param name="sequence">Receives the frame sequence number.</param>
+        /// <returns>The payload length, 0 if the ring is empty, or -1 if the frame did not fit and was skipped.</returns>
+        public int TryRead(out SharedFrameType type, Span<byte> payload, out long sequence)
+        {
+            type = 0;
+            sequence = 0;
+            if (_base == null) return 0;
+
+            long read = Volatile.Read(ref *(long*)(_base + ReadIndexOffset));
+            if (read == Volatile.Read(ref *(long*)(_base + WriteIndexOffset))) return 0;
+
+            byte* slot = SlotAt(read);
+            uint length = *(uint*)(slot + 12);
+
+            int result = -1;
+            if (length <= payload.Length && length <= MaxPayload)
+            {
+                new ReadOnlySpan<byte>(slot + FrameHeaderSize, (int)length).CopyTo(payload);
+                sequence = *(long*)slot;
+                type = (SharedFrameType)(*(uint*)(slot + 8));
+                result = (int)length;
+            }
+
+            Volatile.Write(ref *(long*)(_base + ReadIndexOffset), read + 1);
+            return result;
+        }
+
+        /// <summary>
+        /// Writes a block of parameter changes as one ParameterChanges frame.
+        /// </summary>
+        /// <param name="changes">The parameter changes.</param>
+        /// <returns>True if the frame was written; otherwise, false.</returns>
+        public bool TryWriteParameterChanges(ReadOnlySpan<SharedParameterChange> changes)
+        {
+            return TryWrite(SharedFrameType.ParameterChanges, MemoryMarshal.AsBytes(changes));
+        }
+
+        /// <summary>
+        /// Writes a block of timed parameter changes as one TimedParameterChanges frame.
+        /// </summary>
+        /// <param name="changes">The timed parameter changes.</param>
+        /// <returns>True if the frame was written; otherwise, false.</returns>
+        public bool TryWriteTimedParameterChanges(ReadOnlySpan<SharedTimedParameterChange> changes)
+        {
+            return TryWrite(SharedFrameType.TimedParameterChanges, MemoryMarshal.AsBytes(changes));
+        }
+
+        /// <summary>
+        /// Unmaps the ring.
+        /// </summary>
+        public void Close()
+        {
+            if (_accessor != null)
+            {
+                if (_base != null) _accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+                _accessor.Dispose();
+            }
+
+            _mappedFile?.Dispose();
+            _accessor = null;
+            _mappedFile = null;
+            _base = null;
+            _slotCount = 0;
+            _slotSize = 0;
+        }
+
+        /// <summary>
+        /// Disposes the ring.
+        /// </summary>
+        public void Dispose()
+        {
+            if (_isDisposed) return;
+
+            Close();
+            _isDisposed = true;
+        }
+
+        private byte* SlotAt(long index)
+        {
+            return _base + SlotOffset + (index & (_slotCount - 1)) * _slotSize;
+        }
+    }
+}
@@ -0,0 +1,160 @@
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+using MaiksMixer.Core.Communication;
+
+namespace MaiksMixer.Tests;
+
+/// <summary>
+/// Checks the managed SharedMemoryRing against the layout documented in
+/// CommunicationProtocol.md: a mapping initialized at the documented offsets (as
+/// emp::SharedMemoryRing::Create does) is opened, written and read, and every field is
+/// verified through a separate view of the same mapping. Named mappings exist on Windows
+/// only, where the engine runs its rings, so the tests are skipped elsewhere.
+/// </summary>
+public class SharedMemoryRingTests
+{
+    private const uint Magic = 0x524D5045;
+    private const int SlotOffset = 256;
+    private const int FrameHeaderSize = 16;
+
+    private const long WriteIndexOffset = 64;
+    private const long ReadIndexOffset = 128;
+    private const long DroppedFramesOffset = 192;
+
+    private static MemoryMappedFile CreateEngineRing(string name, uint slotCount, uint slotSize, out MemoryMappedViewAccessor view)
+    {
+        var file = MemoryMappedFile.CreateNew(name, SlotOffset + slotCount * slotSize);
+        view = file.CreateViewAccessor();
+        view.Write(4, 1u);
+        view.Write(8, slotCount);
+        view.Write(12, slotSize);
+        view.Write(0, Magic);
+        return file;
+    }
+
+    private static string UniqueName() => $"emp_ring_test_{Guid.NewGuid():N}";
+
+    [WindowsFact]
+    public void Open_RejectsUnexpectedLayout()
+    {
+        string name = UniqueName();
+        using var file = CreateEngineRing(name, 4, 64, out var view);
+        using var ring = new SharedMemoryRing();
+        using (view)
+        {
+            Assert.True(ring.Open(name));
+
+            view.Write(4, 2u);
+            Assert.False(ring.Open(name));
+
+            view.Write(4, 1u);
+            view.Write(8, 3u);
+            Assert.False(ring.Open(name));
+        }
+    }
+
+    [WindowsFact]
+    public void TryWrite_UsesDocumentedSlotLayout()
+    {
+        string name = UniqueName();
+        using var file = CreateEngineRing(name, 4, 64, out var view);
+        using var ring = new SharedMemoryRing();
+        using (view)
+        {
+            Assert.True(ring.Open(name));
+            Assert.Equal(64 - FrameHeaderSize, ring.MaxPayload);
+
+            // Enough frames to run the indices round the four slots twice
+            for (long i = 0; i < 9; i++)
+            {
+                var changes = new[]
+                {
+                    new SharedParameterChange { Channel = (int)i, Parameter = 0, Value = 0.5f },
+                    new SharedParameterChange { Channel = 2, Parameter = 3, Value = 1.0f }
+                };
+                Assert.True(ring.TryWriteParameterChanges(changes));
+
+                long read = view.ReadInt64(ReadIndexOffset);
+                long slot = SlotOffset + (read & 3) * 64;
+                Assert.Equal(read + 1, view.ReadInt64(WriteIndexOffset));
+                Assert.Equal(read + 1, view.ReadInt64(slot));
+                Assert.Equal((uint)SharedFrameType.ParameterChanges, view.ReadUInt32(slot + 8));
+                Assert.Equal(24u, view.ReadUInt32(slot + 12));
+
+                // {int32 channel, int32 parameter, float value} records
+                Assert.Equal((int)i, view.ReadInt32(slot + FrameHeaderSize));
+                Assert.Equal(0, view.ReadInt32(slot + FrameHeaderSize + 4));
+                Assert.Equal(0.5f, view.ReadSingle(slot + FrameHeaderSize + 8));
+                Assert.Equal(2, view.ReadInt32(slot + FrameHeaderSize + 12));
+                Assert.Equal(3, view.ReadInt32(slot + FrameHeaderSize + 16));
+                Assert.Equal(1.0f, view.ReadSingle(slot + FrameHeaderSize + 20));
+
+                view.Write(ReadIndexOffset, read + 1);
+            }
+        }
+    }
+
+    [WindowsFact]
+    public void TryRead_ReadsFramesWrittenAtDocumentedOffsets()
+    {
+        string name = UniqueName();
+        using var file = CreateEngineRing(name, 4, 64, out var view);
+        using var ring = new SharedMemoryRing();
+        using (view)
+        {
+            Assert.True(ring.Open(name));
+            Span<byte> payload = stackalloc byte[48];
+
+            for (long i = 0; i < 9; i++)
+            {
+                // One channel of meters: count, values per channel, peak, rms, hold, clips
+                long write = view.ReadInt64(WriteIndexOffset);
+                long slot = SlotOffset + (write & 3) * 64;
+                view.Write(slot, write + 1);
+                view.Write(slot + 8, (uint)SharedFrameType.Meters);
+                view.Write(slot + 12, 24u);
+                view.Write(slot + FrameHeaderSize, 1u);
+                view.Write(slot + FrameHeaderSize + 4, 4u);
+                view.Write(slot + FrameHeaderSize + 8, 0.125f * i);
+                view.Write(slot + FrameHeaderSize + 12, 0.0625f);
+                view.Write(slot + FrameHeaderSize + 16, 0.5f);
+                view.Write(slot + FrameHeaderSize + 20, 2.0f);
+                view.Write(WriteIndexOffset, write + 1);
+
+                Assert.Equal(24, ring.TryRead(out var type, payload, out long sequence));
+                Assert.Equal(SharedFrameType.Meters, type);
+                Assert.Equal(write + 1, sequence);
+                Assert.Equal(view.ReadInt64(WriteIndexOffset), view.ReadInt64(ReadIndexOffset));
+
+                var values = MemoryMarshal.Cast<byte, float>(payload.Slice(8, 16));
+                Assert.Equal(1u, MemoryMarshal.Read<uint>(payload));
+                Assert.Equal(4u, MemoryMarshal.Read<uint>(payload.Slice(4)));
+                Assert.Equal(0.125f * i, values[0]);
+                Assert.Equal(2.0f, values[3]);
+            }
+
+            Assert.Equal(0, ring.TryRead(out _, payload, out _));
+        }
+    }
+
+    [WindowsFact]
+    public void TryWrite_CountsDropsWhenFull()
+    {
+        string name = UniqueName();
+        using var file = CreateEngineRing(name, 2, 32, out var view);
+        using var ring = new SharedMemoryRing();
+        using (view)
+        {
+            Assert.True(ring.Open(name));
+
+            byte[] frame = { 1, 2, 3, 4 };
+            Assert.True(ring.TryWrite(SharedFrameType.Meters, frame));
+            Assert.True(ring.TryWrite(SharedFrameType.Meters, frame));
+            Assert.False(ring.TryWrite(SharedFrameType.Meters, frame));
+            Assert.False(ring.TryWrite(SharedFrameType.Meters, new byte[ring.MaxPayload + 1]));
+
+            Assert.Equal(1, ring.DroppedFrames);
+            Assert.Equal(1, view.ReadInt64(DroppedFramesOffset));
+        }
+    }
+}
@@ -0,0 +1,15 @@
+namespace MaiksMixer.Tests;
+
+/// <summary>
+/// A fact that runs on Windows only and is reported as skipped elsewhere
+/// </summary>
+public sealed class WindowsFactAttribute : FactAttribute
+{
+    public WindowsFactAttribute()
+    {
+        if (!OperatingSystem.IsWindows())
+        {
+            Skip = "Requires Windows";
+        }
+    }
+}